@@ -7,12 +7,20 @@
 #include "1_Internal.hpp"      // IWYU pragma: associated
 #include "api/ThreadPool.hpp"  // IWYU pragma: associated
 
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <memory>
 #include <thread>
 
 #include "internal/api/Factory.hpp"
+#include "opentxs/Pimpl.hpp"
 #include "opentxs/Types.hpp"
 #include "opentxs/core/Log.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/Frame.hpp"
 #include "opentxs/network/zeromq/FrameSection.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
 
 #define OT_METHOD "opentxs::api::implementation::ThreadPool::"
 
@@ -27,6 +35,52 @@ auto ThreadPool(const zmq::Context& zmq) noexcept
 }
 }  // namespace opentxs::factory
 
+namespace
+{
+// Shared state for one call to internal::ThreadPool::Parallel(). Sub-ranges
+// are claimed in order by the calling thread and by any workers which receive
+// the job before every sub-range has been claimed.
+struct ParallelJob {
+    using Range = opentxs::api::internal::ThreadPool::Range;
+
+    auto Run() noexcept -> void
+    {
+        for (auto i = next_++; i < chunks_; i = next_++) {
+            const auto first = i * chunk_;
+            job_(first, std::min(first + chunk_, count_));
+
+            if (chunks_ == ++finished_) { promise_.set_value(); }
+        }
+    }
+    auto Wait() noexcept -> void { future_.wait(); }
+
+    ParallelJob(
+        const Range& job,
+        const std::size_t count,
+        const std::size_t chunks) noexcept
+        : job_(job)
+        , count_(count)
+        , chunk_((count + chunks - 1u) / chunks)
+        , chunks_((count + chunk_ - 1u) / chunk_)
+        , next_(0)
+        , finished_(0)
+        , promise_()
+        , future_(promise_.get_future())
+    {
+    }
+
+private:
+    const Range job_;
+    const std::size_t count_;
+    const std::size_t chunk_;
+    const std::size_t chunks_;
+    std::atomic<std::size_t> next_;
+    std::atomic<std::size_t> finished_;
+    std::promise<void> promise_;
+    std::future<void> future_;
+};
+}  // namespace
+
 namespace opentxs::api
 {
 auto ThreadPool::Capacity() noexcept -> std::size_t
@@ -44,6 +98,46 @@ auto ThreadPool::MakeWork(const zmq::Context& zmq, WorkType type) noexcept
 }
 }  // namespace opentxs::api
 
+namespace opentxs::api::internal
+{
+auto ThreadPool::Parallel(
+    const api::Core& api,
+    const std::size_t count,
+    const std::size_t minimum,
+    const Range& job) noexcept -> void
+{
+    const auto threads = std::max<std::size_t>(
+        std::min<std::size_t>(
+            Capacity(), count / std::max<std::size_t>(minimum, 1u)),
+        1u);
+
+    if (1u == threads) {
+        job(0, count);
+
+        return;
+    }
+
+    auto data = std::make_shared<ParallelJob>(job, count, threads);
+    auto socket =
+        api.ZeroMQ().PushSocket(zmq::socket::Socket::Direction::Connect);
+
+    if (socket->Start(api.ThreadPool().Endpoint())) {
+        for (auto i = std::size_t{1}; i < threads; ++i) {
+            auto work = MakeWork(api.ZeroMQ(), value(Work::ParallelRange));
+            auto pJob = std::make_unique<std::shared_ptr<ParallelJob>>(data);
+            work->AddFrame(reinterpret_cast<std::uintptr_t>(pJob.get()));
+
+            if (false == socket->Send(work)) { break; }
+
+            pJob.release();
+        }
+    }
+
+    data->Run();
+    data->Wait();
+}
+}  // namespace opentxs::api::internal
+
 namespace opentxs::api::implementation
 {
 constexpr auto endpoint_{"inproc://opentxs//thread_pool/1"};
@@ -91,6 +185,24 @@ ThreadPool::ThreadPool(const zmq::Context& zmq) noexcept
         return out;
     }())
 {
+    Register(value(Work::ParallelRange), [](const auto& in) {
+        const auto body = in.Body();
+
+        if (1 > body.size()) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid message").Flush();
+
+            return;
+        }
+
+        auto pJob = std::unique_ptr<std::shared_ptr<ParallelJob>>{
+            reinterpret_cast<std::shared_ptr<ParallelJob>*>(
+                body.at(0).as<std::uintptr_t>())};
+
+        OT_ASSERT(pJob);
+        OT_ASSERT(*pJob);
+
+        (*pJob)->Run();
+    });
 }
 
 auto ThreadPool::callback(zmq::Message& in) noexcept -> void
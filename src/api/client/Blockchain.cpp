@@ -263,6 +263,115 @@ Blockchain::Blockchain(
         } catch (...) {
         }
 
+        try {
+            const auto& arg = args.at("disableblockchaincompactblocks");
+
+            if (0 < arg.size()) { output.disable_compact_blocks_ = true; }
+        } catch (...) {
+        }
+
+        try {
+            const auto& arg = args.at("blockchaincompacthighbandwidth");
+
+            if (0 < arg.size()) {
+                output.compact_blocks_high_bandwidth_ = true;
+            }
+        } catch (...) {
+        }
+
+        try {
+            const auto& arg = args.at("disableblockchainsegmentedheaders");
+
+            if (0 < arg.size()) { output.disable_segmented_headers_ = true; }
+        } catch (...) {
+        }
+
+        try {
+            const auto& arg = args.at("blockchainpeertargetkb");
+
+            if (0 < arg.size()) {
+                output.peer_target_bytes_ = std::stoull(*arg.begin()) * 1024u;
+            }
+        } catch (...) {
+        }
+
+        try {
+            const auto& arg = args.at("blockchainblockcachemb");
+
+            if (0 < arg.size()) {
+                output.block_cache_bytes_ =
+                    std::stoull(*arg.begin()) * 1024u * 1024u;
+            }
+        } catch (...) {
+        }
+
+        try {
+            const auto& arg = args.at("blockchainpruneblocks");
+
+            if (0 < arg.size()) {
+                output.block_prune_blocks_ = std::stoull(*arg.begin());
+            }
+        } catch (...) {
+        }
+
+        try {
+            const auto& arg = args.at("blockchainprunegb");
+
+            if (0 < arg.size()) {
+                output.block_prune_bytes_ =
+                    std::stoull(*arg.begin()) * 1024u * 1024u * 1024u;
+            }
+        } catch (...) {
+        }
+
+        try {
+            const auto& arg = args.at("blockchainfiltercachemb");
+
+            if (0 < arg.size()) {
+                output.filter_cache_bytes_ =
+                    std::stoull(*arg.begin()) * 1024u * 1024u;
+            }
+        } catch (...) {
+        }
+
+        try {
+            const auto& arg = args.at("blockchainmempoolmb");
+
+            if (0 < arg.size()) {
+                output.mempool_bytes_ =
+                    std::stoull(*arg.begin()) * 1024u * 1024u;
+            }
+        } catch (...) {
+        }
+
+        try {
+            const auto& arg = args.at("blockchainmempoolexpiry");
+
+            if (0 < arg.size()) {
+                output.mempool_expiry_hours_ = std::stoull(*arg.begin());
+            }
+        } catch (...) {
+        }
+
+        try {
+            const auto& arg = args.at("blockchainscanthreads");
+
+            if (0 < arg.size()) {
+                output.scan_parallelism_ = std::stoull(*arg.begin());
+            }
+        } catch (...) {
+        }
+
+        try {
+            const auto& arg = args.at("blockchainprefetchblocks");
+
+            if (0 < arg.size()) {
+                output.block_prefetch_ =
+                    std::max<std::size_t>(std::stoull(*arg.begin()), 1u);
+            }
+        } catch (...) {
+        }
+
         return output;
     }())
     , config_()
@@ -300,6 +409,15 @@ Blockchain::Blockchain(
 
         return output;
     }())
+    , last_request_([&] {
+        auto output = LastRequest{};
+
+        for (const auto& chain : opentxs::blockchain::SupportedChains()) {
+            output.emplace(chain, -1);
+        }
+
+        return output;
+    }())
     , running_(true)
     , heartbeat_(&Blockchain::heartbeat, this)
 #endif  // OT_BLOCKCHAIN
@@ -1042,17 +1160,15 @@ auto Blockchain::Hello() const noexcept -> proto::BlockchainP2PHello
     return hello(lock, chains);
 }
 
-auto Blockchain::hello(const Lock&, const Chains& chains) const noexcept
+auto Blockchain::hello(const Lock& lock, const Chains& chains) const noexcept
     -> proto::BlockchainP2PHello
 {
     auto output = proto::BlockchainP2PHello{};
     output.set_version(opentxs::blockchain::client::sync_hello_version_);
 
     for (const auto chain : chains) {
-        const auto& network = networks_.at(chain);
-        const auto& filter = network->FilterOracle();
-        const auto type = filter.DefaultType();
-        const auto best = filter.FilterTip(type);
+        const auto best = sync_position(lock, chain);
+        last_request_[chain] = best.first;
         auto& state = *output.add_state();
         state.set_version(opentxs::blockchain::client::sync_state_version_);
         state.set_chain(static_cast<std::uint32_t>(chain));
@@ -1692,14 +1808,33 @@ auto Blockchain::ReportProgress(
     work->AddFrame(current);
     work->AddFrame(target);
     sync_updates_->Send(work);
+    request_sync_data(chain, false);
+}
 
+auto Blockchain::request_sync_data(const Chain chain, const bool force)
+    const noexcept -> void
+{
     if (sync_client_ && sync_client_->IsActive(chain)) {
         auto lock = Lock{lock_};
+
+        // The sync pipeline asks for the next range as soon as the headers
+        // are connected, so a progress report usually finds that range has
+        // already been requested
+        if ((false == force) &&
+            (last_request_.at(chain) == sync_position(lock, chain).first)) {
+            return;
+        }
+
         last_hello_[chain] = Clock::now();
         sync_client_->Heartbeat(hello(lock, {chain}));
     }
 }
 
+auto Blockchain::RequestSyncData(const Chain chain) const noexcept -> void
+{
+    request_sync_data(chain, true);
+}
+
 auto Blockchain::RestoreNetworks() const noexcept -> void
 {
     for (const auto& [chain, peer] : db_.LoadEnabledChains()) {
@@ -1895,6 +2030,21 @@ auto Blockchain::stop(const Lock& lock, const Chain type) const noexcept -> bool
 
     return true;
 }
+
+auto Blockchain::sync_position(const Lock&, const Chain chain) const noexcept
+    -> opentxs::blockchain::block::Position
+{
+    const auto& network = networks_.at(chain);
+    const auto& filter = network->FilterOracle();
+    auto output = filter.FilterTip(filter.DefaultType());
+    // Headers which have been received from the sync server may be ahead of
+    // the filters which are still being stored
+    auto pending = network->SyncPosition();
+
+    if (pending.first > output.first) { return pending; }
+
+    return output;
+}
 #endif  // OT_BLOCKCHAIN
 
 auto Blockchain::UpdateElement(
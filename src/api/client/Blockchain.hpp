@@ -306,6 +306,7 @@ public:
         const opentxs::blockchain::block::Height current,
         const opentxs::blockchain::block::Height target) const noexcept
         -> void final;
+    auto RequestSyncData(const Chain chain) const noexcept -> void final;
     auto RestoreNetworks() const noexcept -> void final;
 #endif  // OT_BLOCKCHAIN
     auto SenderContact(const blockchain::Key& key) const noexcept
@@ -372,6 +373,7 @@ private:
     using Txid = opentxs::blockchain::block::Txid;
     using pTxid = opentxs::blockchain::block::pTxid;
     using LastHello = std::map<Chain, Time>;
+    using LastRequest = std::map<Chain, opentxs::blockchain::block::Height>;
     using Chains = std::vector<Chain>;
     using Config = opentxs::blockchain::client::internal::Config;
 #endif  // OT_BLOCKCHAIN
@@ -524,6 +526,7 @@ private:
     BalanceOracle balances_;
     OTZMQPublishSocket chain_state_publisher_;
     mutable LastHello last_hello_;
+    mutable LastRequest last_request_;
     std::atomic_bool running_;
     std::thread heartbeat_;
 #endif  // OT_BLOCKCHAIN
@@ -580,6 +583,8 @@ private:
         -> std::string;
 #if OT_BLOCKCHAIN
     auto publish_chain_state(Chain type, bool state) const -> void;
+    auto request_sync_data(const Chain chain, const bool force) const noexcept
+        -> void;
     auto reconcile_activity_threads(const Lock& lock, const Txid& txid)
         const noexcept -> bool;
     auto reconcile_activity_threads(
@@ -589,6 +594,8 @@ private:
     auto start(const Lock& lock, const Chain type, const std::string& seednode)
         const noexcept -> bool;
     auto stop(const Lock& lock, const Chain type) const noexcept -> bool;
+    auto sync_position(const Lock& lock, const Chain chain) const noexcept
+        -> opentxs::blockchain::block::Position;
 #endif  // OT_BLOCKCHAIN
     auto validate_nym(const identifier::Nym& nymID) const noexcept -> bool;
 
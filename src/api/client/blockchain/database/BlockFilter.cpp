@@ -13,6 +13,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "api/client/blockchain/database/Database.hpp"
 #include "internal/api/Api.hpp"  // IWYU pragma: keep
 #include "internal/blockchain/Blockchain.hpp"
 #include "opentxs/Proto.tpp"
@@ -30,11 +31,28 @@
 
 namespace opentxs::api::client::blockchain::database::implementation
 {
+using Mode = opentxs::storage::lmdb::LMDB::Mode;
+
+template <typename Input>
+auto tsv(const Input& in) noexcept -> ReadView
+{
+    return {reinterpret_cast<const char*>(&in), sizeof(in)};
+}
+
 BlockFilter::BlockFilter(
     const api::Core& api,
-    opentxs::storage::lmdb::LMDB& lmdb) noexcept(false)
-    : api_(api)
-    , lmdb_(lmdb)
+    opentxs::storage::lmdb::LMDB& lmdb,
+    const std::string& path) noexcept(false)
+    : MappedFileStorage(
+          lmdb,
+          path,
+          "cfilter",
+          Table::Config,
+          static_cast<std::size_t>(Database::Key::NextFilterAddress),
+          Table::FreeFilterSpace)
+    , api_(api)
+    , lock_()
+    , file_lock_()
 {
 }
 
@@ -42,7 +60,8 @@ auto BlockFilter::HaveFilter(const FilterType type, const ReadView blockHash)
     const noexcept -> bool
 {
     try {
-        return lmdb_.Exists(translate_filter(type), blockHash);
+        return lmdb_.Exists(translate_index(type), blockHash) ||
+               lmdb_.Exists(translate_filter(type), blockHash);
     } catch (const std::exception& e) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
 
@@ -65,6 +84,55 @@ auto BlockFilter::HaveFilterHeader(
 
 auto BlockFilter::LoadFilter(const FilterType type, const ReadView blockHash)
     const noexcept -> std::unique_ptr<const opentxs::blockchain::client::GCS>
+{
+    try {
+        const auto bytes = [&] {
+            const auto index = load_index(type, blockHash);
+
+            if (0 == index.size_) { return ReadView{}; }
+
+            auto lock = Lock{file_lock_};
+
+            return get_read_view(index);
+        }();
+
+        if (0 == bytes.size()) { return load_legacy(type, blockHash); }
+
+        // Mapped files are never unmapped or moved while the database exists
+        // so the filter can refer to them directly
+        return factory::GCSView(
+            api_,
+            type,
+            opentxs::blockchain::internal::BlockHashToFilterKey(blockHash),
+            bytes);
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return {};
+    }
+}
+
+auto BlockFilter::load_index(
+    const FilterType type,
+    const ReadView blockHash,
+    MDB_txn* parent) const noexcept(false) -> IndexData
+{
+    auto output = IndexData{};
+    auto cb = [&output](const auto in) {
+        if (sizeof(output) != in.size()) { return; }
+
+        std::memcpy(static_cast<void*>(&output), in.data(), in.size());
+    };
+    lmdb_.Load(translate_index(type), blockHash, cb, Mode::One, parent);
+
+    return output;
+}
+
+auto BlockFilter::load_legacy(
+    const FilterType type,
+    const ReadView blockHash,
+    MDB_txn* parent) const noexcept(false)
+    -> std::unique_ptr<const opentxs::blockchain::client::GCS>
 {
     auto output = std::unique_ptr<const opentxs::blockchain::client::GCS>{};
     auto cb = [this, &output](const auto in) {
@@ -72,12 +140,7 @@ auto BlockFilter::LoadFilter(const FilterType type, const ReadView blockHash)
 
         output = factory::GCS(api_, proto::Factory<proto::GCS>(in));
     };
-
-    try {
-        lmdb_.Load(translate_filter(type), blockHash, cb);
-    } catch (const std::exception& e) {
-        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
-    }
+    lmdb_.Load(translate_filter(type), blockHash, cb, Mode::One, parent);
 
     return output;
 }
@@ -140,6 +203,99 @@ auto BlockFilter::LoadFilterHeader(
     return output;
 }
 
+auto BlockFilter::LoadFilterHeaders(
+    const FilterType type,
+    const std::vector<ReadView>& blocks) const noexcept -> std::vector<OTData>
+{
+    auto output = std::vector<OTData>{};
+    output.reserve(blocks.size());
+
+    for (auto i = std::size_t{0}; i < blocks.size(); ++i) {
+        output.emplace_back(api_.Factory().Data());
+    }
+
+    try {
+        const auto table = translate_header(type);
+        auto txn = lmdb_.TransactionRO();
+
+        for (auto i = std::size_t{0}; i < blocks.size(); ++i) {
+            auto& header = output.at(i);
+            auto cb = [&header](const auto in) {
+                if ((nullptr == in.data()) || (0 == in.size())) { return; }
+
+                auto proto = proto::BlockchainFilterHeader{};
+                proto.ParseFromArray(in.data(), in.size());
+                const auto& field = proto.header();
+                header->Assign(field.data(), field.size());
+            };
+            lmdb_.Load(table, blocks.at(i), cb, Mode::One, txn);
+        }
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+    }
+
+    return output;
+}
+
+auto BlockFilter::LoadFilters(
+    const FilterType type,
+    const std::vector<ReadView>& blocks) const noexcept
+    -> std::vector<std::unique_ptr<const opentxs::blockchain::client::GCS>>
+{
+    auto output =
+        std::vector<std::unique_ptr<const opentxs::blockchain::client::GCS>>(
+            blocks.size());
+
+    try {
+        auto views = std::vector<ReadView>(blocks.size());
+
+        {
+            auto indices = std::vector<IndexData>(blocks.size());
+
+            {
+                auto txn = lmdb_.TransactionRO();
+
+                for (auto i = std::size_t{0}; i < blocks.size(); ++i) {
+                    const auto& block = blocks.at(i);
+                    auto& index = indices.at(i);
+                    index = load_index(type, block, txn);
+
+                    if (0 == index.size_) {
+                        output.at(i) = load_legacy(type, block, txn);
+                    }
+                }
+            }
+
+            auto lock = Lock{file_lock_};
+
+            for (auto i = std::size_t{0}; i < blocks.size(); ++i) {
+                const auto& index = indices.at(i);
+
+                if (0 == index.size_) { continue; }
+
+                views.at(i) = get_read_view(index);
+            }
+        }
+
+        for (auto i = std::size_t{0}; i < blocks.size(); ++i) {
+            const auto& bytes = views.at(i);
+
+            if (0 == bytes.size()) { continue; }
+
+            output.at(i) = factory::GCSView(
+                api_,
+                type,
+                opentxs::blockchain::internal::BlockHashToFilterKey(
+                    blocks.at(i)),
+                bytes);
+        }
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+    }
+
+    return output;
+}
+
 auto BlockFilter::StoreFilterHeaders(
     const FilterType type,
     const std::vector<FilterHeader>& headers) const noexcept -> bool
@@ -159,7 +315,26 @@ auto BlockFilter::StoreFilters(
     const std::vector<FilterHeader>& headers,
     const std::vector<FilterData>& filters) const noexcept -> bool
 {
+    auto lock = Lock{lock_};
+    // NOTE existing index records must be read before the write transaction
+    // is opened
+    auto encoded = std::vector<std::pair<IndexData, OTData>>{};
+    encoded.reserve(filters.size());
+
+    try {
+        for (const auto& [block, pFilter] : filters) {
+            OT_ASSERT(pFilter);
+
+            encoded.emplace_back(load_index(type, block), pFilter->Encode());
+        }
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return false;
+    }
+
     auto parentTxn = lmdb_.TransactionRW();
+    auto pending = Pending{};
 
     for (const auto& [block, header, hash] : headers) {
         auto proto = proto::BlockchainFilterHeader();
@@ -183,18 +358,28 @@ auto BlockFilter::StoreFilters(
         }
     }
 
-    for (auto& [block, pFilter] : filters) {
-        OT_ASSERT(pFilter);
+    for (auto i = std::size_t{0}; i < filters.size(); ++i) {
+        const auto& block = filters.at(i).first;
+        auto& [index, bytes] = encoded.at(i);
+        auto view = [&] {
+            auto fileLock = Lock{file_lock_};
 
-        const auto& filter = *pFilter;
-        const auto proto = filter.Serialize();
-        auto bytes = space(proto.ByteSize());
-        proto.SerializeWithCachedSizesToArray(
-            reinterpret_cast<std::uint8_t*>(bytes.data()));
+            return get_write_view(parentTxn, index, bytes->size(), pending);
+        }();
+
+        if (false == view.valid(bytes->size())) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to get write position for filter")
+                .Flush();
+
+            return false;
+        }
+
+        std::memcpy(view.data(), bytes->data(), bytes->size());
 
         try {
             const auto stored = lmdb_.Store(
-                translate_filter(type), block, reader(bytes), parentTxn);
+                translate_index(type), block, tsv(index), parentTxn);
 
             if (false == stored.first) { return false; }
         } catch (const std::exception& e) {
@@ -202,7 +387,11 @@ auto BlockFilter::StoreFilters(
         }
     }
 
-    return parentTxn.Finalize(true);
+    if (false == parentTxn.Finalize(true)) { return false; }
+
+    apply(pending);
+
+    return true;
 }
 
 auto BlockFilter::translate_filter(const FilterType type) noexcept(false)
@@ -224,6 +413,25 @@ auto BlockFilter::translate_filter(const FilterType type) noexcept(false)
     }
 }
 
+auto BlockFilter::translate_index(const FilterType type) noexcept(false)
+    -> Table
+{
+    switch (type) {
+        case FilterType::Basic_BIP158: {
+            return FilterIndexBasic;
+        }
+        case FilterType::Basic_BCHVariant: {
+            return FilterIndexBCH;
+        }
+        case FilterType::Extended_opentxs: {
+            return FilterIndexOpentxs;
+        }
+        default: {
+            throw std::runtime_error("Unsupported filter type");
+        }
+    }
+}
+
 auto BlockFilter::translate_header(const FilterType type) noexcept(false)
     -> Table
 {
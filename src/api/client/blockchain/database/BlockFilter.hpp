@@ -7,13 +7,17 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "internal/api/client/blockchain/Blockchain.hpp"
 #include "internal/blockchain/client/Client.hpp"
 #include "opentxs/Bytes.hpp"
 #include "opentxs/api/client/Manager.hpp"
+#include "opentxs/core/Data.hpp"
 #include "util/LMDB.hpp"
+#include "util/MappedFileStorage.hpp"
 
 namespace opentxs
 {
@@ -41,7 +45,11 @@ class LMDB;
 
 namespace opentxs::api::client::blockchain::database::implementation
 {
-class BlockFilter
+// Encoded filters are stored as raw bytes in memory mapped files. LMDB only
+// holds a fixed size index record per block which locates the filter in those
+// files. Filters which were stored as serialized protobuf by earlier versions
+// remain readable.
+class BlockFilter final : private util::MappedFileStorage
 {
 public:
     auto HaveFilter(const FilterType type, const ReadView blockHash)
@@ -58,6 +66,17 @@ public:
         const FilterType type,
         const ReadView blockHash,
         const AllocateOutput header) const noexcept -> bool;
+    /// Element i of the output is the header for blocks[i], or empty if not
+    /// found. All records are read in a single transaction.
+    auto LoadFilterHeaders(
+        const FilterType type,
+        const std::vector<ReadView>& blocks) const noexcept
+        -> std::vector<OTData>;
+    /// Element i of the output is the filter for blocks[i], or nullptr if not
+    /// found. All records are read in a single transaction.
+    auto LoadFilters(const FilterType type, const std::vector<ReadView>& blocks)
+        const noexcept
+        -> std::vector<std::unique_ptr<const opentxs::blockchain::client::GCS>>;
     auto StoreFilterHeaders(
         const FilterType type,
         const std::vector<FilterHeader>& headers) const noexcept -> bool;
@@ -70,7 +89,8 @@ public:
 
     BlockFilter(
         const api::Core& api,
-        opentxs::storage::lmdb::LMDB& lmdb) noexcept(false);
+        opentxs::storage::lmdb::LMDB& lmdb,
+        const std::string& path) noexcept(false);
 
 private:
     static const std::uint32_t blockchain_filter_header_version_{1};
@@ -79,11 +99,28 @@ private:
     static const std::uint32_t blockchain_filters_version_{1};
 
     const api::Core& api_;
-    opentxs::storage::lmdb::LMDB& lmdb_;
+    // Serializes writers. Readers rely on the LMDB read transaction for a
+    // consistent view of the index and never wait for this lock.
+    mutable std::mutex lock_;
+    // Protects the mapped files for the duration of a single get_read_view
+    // or get_write_view call
+    mutable std::mutex file_lock_;
 
     static auto translate_filter(const FilterType type) noexcept(false)
         -> Table;
+    static auto translate_index(const FilterType type) noexcept(false)
+        -> Table;
     static auto translate_header(const FilterType type) noexcept(false)
         -> Table;
+
+    auto load_index(
+        const FilterType type,
+        const ReadView blockHash,
+        MDB_txn* parent = nullptr) const noexcept(false) -> IndexData;
+    auto load_legacy(
+        const FilterType type,
+        const ReadView blockHash,
+        MDB_txn* parent = nullptr) const noexcept(false)
+        -> std::unique_ptr<const opentxs::blockchain::client::GCS>;
 };
 }  // namespace opentxs::api::client::blockchain::database::implementation
@@ -9,6 +9,7 @@
 
 #include <cstring>
 #include <memory>
+#include <vector>
 #include <type_traits>
 #include <utility>
 
@@ -38,10 +39,13 @@ Blocks::Blocks(
           path,
           "blk",
           Table::Config,
-          static_cast<std::size_t>(Database::Key::NextBlockAddress))
+          static_cast<std::size_t>(Database::Key::NextBlockAddress),
+          Table::FreeBlockSpace)
     , table_(Table::BlockIndex)
     , lock_()
     , block_locks_()
+    , pin_lock_()
+    , pins_()
 {
 }
 
@@ -50,16 +54,80 @@ auto Blocks::Exists(const Hash& block) const noexcept -> bool
     return lmdb_.Exists(table_, block.Bytes());
 }
 
-auto Blocks::Load(const Hash& block) const noexcept -> BlockReader
+auto Blocks::Forget(const std::vector<pHash>& blocks) const noexcept
+    -> std::size_t
 {
     auto lock = Lock{lock_};
-    auto index = IndexData{};
-    auto cb = [&index](const auto in) {
-        if (sizeof(index) != in.size()) { return; }
+    auto removed = std::size_t{0};
+    auto items = std::vector<IndexData>{};
+
+    for (const auto& block : blocks) {
+        if (in_use(lock, block)) {
+            LogVerbose(OT_METHOD)(__FUNCTION__)(": Block ")(block->asHex())(
+                " is in use")
+                .Flush();
+
+            break;
+        }
+
+        items.emplace_back(load_index(block));
+        ++removed;
+    }
+
+    if (0 == removed) { return removed; }
 
-        std::memcpy(static_cast<void*>(&index), in.data(), in.size());
+    auto cb = [&](auto& tx) -> bool {
+        for (auto i = std::size_t{0}; i < removed; ++i) {
+            if (0 == items.at(i).size_) { continue; }
+
+            if (false == lmdb_.Delete(table_, blocks.at(i)->Bytes(), tx)) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Failed to remove index for block ")(
+                    blocks.at(i)->asHex())
+                    .Flush();
+
+                return false;
+            }
+        }
+
+        return true;
     };
-    lmdb_.Load(table_, block.Bytes(), cb);
+
+    if (false == release(items, std::move(cb))) { return 0; }
+
+    for (auto i = std::size_t{0}; i < removed; ++i) {
+        block_locks_.erase(blocks.at(i));
+    }
+
+    return removed;
+}
+
+auto Blocks::in_use(const Lock&, const pHash& block) const noexcept -> bool
+{
+    {
+        auto lock = Lock{pin_lock_};
+
+        if (0 < pins_.count(block)) { return true; }
+    }
+
+    auto it = block_locks_.find(block);
+
+    if (block_locks_.end() == it) { return false; }
+
+    // New readers and writers can not be created while lock_ is held
+    auto& mutex = it->second;
+
+    if (false == mutex.try_lock()) { return true; }
+
+    mutex.unlock();
+
+    return false;
+}
+
+auto Blocks::Load(const Hash& block) const noexcept -> BlockReader
+{
+    auto lock = Lock{lock_};
+    const auto index = load_index(block);
 
     if (0 == index.size_) {
         LogTrace(OT_METHOD)(__FUNCTION__)(": Block ")(block.asHex())(
@@ -72,6 +140,39 @@ auto Blocks::Load(const Hash& block) const noexcept -> BlockReader
     return BlockReader{get_read_view(index), block_locks_[block]};
 }
 
+auto Blocks::load_index(const Hash& block) const noexcept -> IndexData
+{
+    auto output = IndexData{};
+    auto cb = [&output](const auto in) {
+        if (sizeof(output) != in.size()) { return; }
+
+        std::memcpy(static_cast<void*>(&output), in.data(), in.size());
+    };
+    lmdb_.Load(table_, block.Bytes(), cb);
+
+    return output;
+}
+
+auto Blocks::Pin(const Hash& block) const noexcept
+    -> std::shared_ptr<const void>
+{
+    auto id = std::make_unique<const pHash>(block);
+
+    {
+        auto lock = Lock{pin_lock_};
+        ++pins_[*id];
+    }
+
+    // The deleter only acquires pin_lock_ so the last reference may be
+    // released by any thread
+    auto deleter = [this](const pHash* pin) {
+        unpin(*pin);
+        delete pin;
+    };
+
+    return std::shared_ptr<const pHash>{id.release(), deleter};
+}
+
 auto Blocks::Store(const Hash& block, const std::size_t bytes) const noexcept
     -> BlockWriter
 {
@@ -85,17 +186,7 @@ auto Blocks::Store(const Hash& block, const std::size_t bytes) const noexcept
         return {};
     }
 
-    auto index = [&] {
-        auto output = IndexData{};
-        auto cb = [&output](const auto in) {
-            if (sizeof(output) != in.size()) { return; }
-
-            std::memcpy(static_cast<void*>(&output), in.data(), in.size());
-        };
-        lmdb_.Load(table_, block.Bytes(), cb);
-
-        return output;
-    }();
+    auto index = load_index(block);
     auto cb = [&](auto& tx) -> bool {
         const auto result = lmdb_.Store(table_, block.Bytes(), tsv(index), tx);
 
@@ -121,4 +212,14 @@ auto Blocks::Store(const Hash& block, const std::size_t bytes) const noexcept
 
     return BlockWriter{std::move(view), block_locks_[block]};
 }
+
+auto Blocks::unpin(const Hash& block) const noexcept -> void
+{
+    auto lock = Lock{pin_lock_};
+    auto it = pins_.find(block);
+
+    OT_ASSERT(pins_.end() != it);
+
+    if (0 == --it->second) { pins_.erase(it); }
+}
 }  // namespace opentxs::api::client::blockchain::database::implementation
@@ -5,8 +5,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iosfwd>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
@@ -40,7 +42,14 @@ public:
     using pHash = opentxs::blockchain::block::pHash;
 
     auto Exists(const Hash& block) const noexcept -> bool;
+    // Removes the blocks in order and returns the number of blocks removed.
+    // Removal stops at the first block which is being read or is pinned.
+    auto Forget(const std::vector<pHash>& blocks) const noexcept
+        -> std::size_t;
     auto Load(const Hash& block) const noexcept -> BlockReader;
+    // Prevents the block from being removed while a view of the stored bytes
+    // exists after the BlockReader is released
+    auto Pin(const Hash& block) const noexcept -> std::shared_ptr<const void>;
     auto Store(const Hash& block, const std::size_t bytes) const noexcept
         -> BlockWriter;
 
@@ -52,5 +61,11 @@ private:
     const int table_;
     mutable std::mutex lock_;
     mutable std::map<pHash, std::shared_mutex> block_locks_;
+    mutable std::mutex pin_lock_;
+    mutable std::map<pHash, std::size_t> pins_;
+
+    auto in_use(const Lock& lock, const pHash& block) const noexcept -> bool;
+    auto load_index(const Hash& block) const noexcept -> IndexData;
+    auto unpin(const Hash& block) const noexcept -> void;
 };
 }  // namespace opentxs::api::client::blockchain::database::implementation
@@ -60,6 +60,7 @@ struct Database::Imp {
     const api::Legacy& legacy_;
     const OTString blockchain_path_;
     const OTString common_path_;
+    const OTString filters_path_;
 #if OPENTXS_BLOCK_STORAGE_ENABLED
     const OTString blocks_path_;
 #endif  // OPENTXS_BLOCK_STORAGE_ENABLED
@@ -236,6 +237,8 @@ struct Database::Imp {
         , blockchain_path_(init_storage_path(legacy, dataFolder))
         , common_path_(
               init_folder(legacy, blockchain_path_, String::Factory("common")))
+        , filters_path_(
+              init_folder(legacy, common_path_, String::Factory("filters")))
 #if OPENTXS_BLOCK_STORAGE_ENABLED
         , blocks_path_(
               init_folder(legacy, common_path_, String::Factory("blocks")))
@@ -262,6 +265,13 @@ struct Database::Imp {
                       {BlockIndex, 0},
                       {Enabled, MDB_INTEGERKEY},
                       {SyncTips, MDB_INTEGERKEY},
+                      {FilterIndexBasic, 0},
+                      {FilterIndexBCH, 0},
+                      {FilterIndexOpentxs, 0},
+                      {PeerStatistics, 0},
+                      {FreeBlockSpace, MDB_INTEGERKEY},
+                      {FreeSyncSpace, MDB_INTEGERKEY},
+                      {FreeFilterSpace, MDB_INTEGERKEY},
                   };
 
                   for (const auto& [table, name] : SyncTables()) {
@@ -274,7 +284,7 @@ struct Database::Imp {
         , siphash_key_(siphash_key(lmdb_))
         , headers_(api_, lmdb_)
         , peers_(api_, lmdb_)
-        , filters_(api_, lmdb_)
+        , filters_(api_, lmdb_, filters_path_->Get())
 #if OPENTXS_BLOCK_STORAGE_ENABLED
         , blocks_(lmdb_, blocks_path_->Get())
         , sync_(api_, lmdb_, blocks_path_->Get())
@@ -307,6 +317,13 @@ const opentxs::storage::lmdb::TableNames Database::Imp::table_names_ = [] {
         {BlockIndex, "blocks"},
         {Enabled, "enabled_chains_2"},
         {SyncTips, "sync_tips"},
+        {FilterIndexBasic, "block_filter_index_basic"},
+        {FilterIndexBCH, "block_filter_index_bch"},
+        {FilterIndexOpentxs, "block_filter_index_opentxs"},
+        {PeerStatistics, "peer_statistics"},
+        {FreeBlockSpace, "free_block_space"},
+        {FreeSyncSpace, "free_sync_space"},
+        {FreeFilterSpace, "free_filter_space"},
     };
 
     for (const auto& [table, name] : SyncTables()) {
@@ -360,6 +377,17 @@ auto Database::BlockExists(const BlockHash& block) const noexcept -> bool
 #endif
 }
 
+auto Database::BlockForget(
+    const std::vector<opentxs::blockchain::block::pHash>& blocks) const noexcept
+    -> std::size_t
+{
+#if OPENTXS_BLOCK_STORAGE_ENABLED
+    return imp_.blocks_.Forget(blocks);
+#else
+    return 0;
+#endif
+}
+
 auto Database::BlockLoad(const BlockHash& block) const noexcept -> BlockReader
 {
 #if OPENTXS_BLOCK_STORAGE_ENABLED
@@ -369,6 +397,16 @@ auto Database::BlockLoad(const BlockHash& block) const noexcept -> BlockReader
 #endif
 }
 
+auto Database::BlockPin(const BlockHash& block) const noexcept
+    -> std::shared_ptr<const void>
+{
+#if OPENTXS_BLOCK_STORAGE_ENABLED
+    return imp_.blocks_.Pin(block);
+#else
+    return {};
+#endif
+}
+
 auto Database::BlockPolicy() const noexcept -> BlockStorage
 {
     return imp_.block_policy_;
@@ -469,6 +507,27 @@ auto Database::LoadFilterHeader(
     return imp_.filters_.LoadFilterHeader(type, blockHash, header);
 }
 
+auto Database::LoadFilterHeaders(
+    const FilterType type,
+    const std::vector<ReadView>& blocks) const noexcept -> std::vector<OTData>
+{
+    return imp_.filters_.LoadFilterHeaders(type, blocks);
+}
+
+auto Database::LoadFilters(
+    const FilterType type,
+    const std::vector<ReadView>& blocks) const noexcept
+    -> std::vector<std::unique_ptr<const opentxs::blockchain::client::GCS>>
+{
+    return imp_.filters_.LoadFilters(type, blocks);
+}
+
+auto Database::LoadPeerStatistics(const Identifier& id) const noexcept
+    -> PeerStats
+{
+    return imp_.peers_.LoadStatistics(id);
+}
+
 auto Database::LoadTransaction(const ReadView txid) const noexcept
     -> std::optional<proto::BlockchainTransaction>
 {
@@ -575,6 +634,13 @@ auto Database::StoreFilters(
     return imp_.filters_.StoreFilters(type, headers, filters);
 }
 
+auto Database::StorePeerStatistics(
+    const Identifier& id,
+    const PeerStats& stats) const noexcept -> bool
+{
+    return imp_.peers_.StoreStatistics(id, stats);
+}
+
 auto Database::StoreSync(const Chain chain, const SyncItems& items)
     const noexcept -> bool
 {
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <iosfwd>
 #include <memory>
@@ -90,6 +91,7 @@ public:
         NextBlockAddress = 1,
         SiphashKey = 2,
         NextSyncAddress = 3,
+        NextFilterAddress = 4,
     };
 
     using BlockHash = opentxs::blockchain::block::Hash;
@@ -100,6 +102,7 @@ public:
     using EnabledChain = std::pair<Chain, std::string>;
     using Height = opentxs::blockchain::block::Height;
     using SyncItems = std::vector<proto::BlockchainP2PSync>;
+    using PeerStats = opentxs::blockchain::p2p::internal::PeerStatistics;
 
     auto AddOrUpdate(Address_p address) const noexcept -> bool;
     auto AllocateStorageFolder(const std::string& dir) const noexcept
@@ -109,7 +112,12 @@ public:
         const std::vector<PatternID>& patterns) const noexcept -> bool;
     auto BlockHeaderExists(const BlockHash& hash) const noexcept -> bool;
     auto BlockExists(const BlockHash& block) const noexcept -> bool;
+    auto BlockForget(
+        const std::vector<opentxs::blockchain::block::pHash>& blocks)
+        const noexcept -> std::size_t;
     auto BlockLoad(const BlockHash& block) const noexcept -> BlockReader;
+    auto BlockPin(const BlockHash& block) const noexcept
+        -> std::shared_ptr<const void>;
     auto BlockPolicy() const noexcept -> BlockStorage;
     auto BlockStore(const BlockHash& block, const std::size_t bytes)
         const noexcept -> BlockWriter;
@@ -140,6 +148,15 @@ public:
         const FilterType type,
         const ReadView blockHash,
         const AllocateOutput header) const noexcept -> bool;
+    auto LoadFilterHeaders(
+        const FilterType type,
+        const std::vector<ReadView>& blocks) const noexcept
+        -> std::vector<OTData>;
+    auto LoadFilters(const FilterType type, const std::vector<ReadView>& blocks)
+        const noexcept
+        -> std::vector<std::unique_ptr<const opentxs::blockchain::client::GCS>>;
+    auto LoadPeerStatistics(const Identifier& id) const noexcept
+        -> PeerStats;
     auto LoadSync(
         const Chain chain,
         const Height height,
@@ -164,6 +181,8 @@ public:
         const FilterType type,
         const std::vector<FilterHeader>& headers,
         const std::vector<FilterData>& filters) const noexcept -> bool;
+    auto StorePeerStatistics(const Identifier& id, const PeerStats& stats)
+        const noexcept -> bool;
     auto StoreSync(const Chain chain, const SyncItems& items) const noexcept
         -> bool;
     auto StoreTransaction(const proto::BlockchainTransaction& tx) const noexcept
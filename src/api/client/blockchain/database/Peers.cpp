@@ -9,7 +9,6 @@
 
 #include <algorithm>
 #include <chrono>
-#include <iterator>
 #include <memory>
 #include <optional>
 #include <random>
@@ -41,6 +40,7 @@ Peers::Peers(const api::Core& api, opentxs::storage::lmdb::LMDB& lmdb) noexcept(
     , services_()
     , networks_()
     , connected_()
+    , statistics_()
 {
     using Dir = opentxs::storage::lmdb::LMDB::Dir;
 
@@ -68,12 +68,34 @@ Peers::Peers(const api::Core& api, opentxs::storage::lmdb::LMDB& lmdb) noexcept(
 
         return true;
     };
+    auto invalid = std::vector<std::string>{};
+    auto statistics = [&](const auto key, const auto value) {
+        auto input = PeerStats::Deserialize(value);
+
+        if (input.has_value()) {
+            statistics_.emplace(key, input.value());
+        } else {
+            invalid.emplace_back(key);
+        }
+
+        return true;
+    };
 
     lmdb_.Read(PeerChainIndex, chain, Dir::Forward);
     lmdb_.Read(PeerProtocolIndex, protocol, Dir::Forward);
     lmdb_.Read(PeerServiceIndex, service, Dir::Forward);
     lmdb_.Read(PeerNetworkIndex, type, Dir::Forward);
     lmdb_.Read(PeerConnectedIndex, last, Dir::Forward);
+    lmdb_.Read(PeerStatistics, statistics, Dir::Forward);
+
+    // Statistics are only an input to peer selection, so records which can
+    // not be parsed are discarded rather than preventing startup
+    for (const auto& key : invalid) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Removing invalid statistics for peer ")(key)
+            .Flush();
+        lmdb_.Delete(PeerStatistics, key);
+    }
 }
 
 auto Peers::Find(
@@ -148,11 +170,12 @@ auto Peers::Find(
                 .Flush();
         }
 
-        auto weighted = std::vector<std::string>{};
+        auto ids = std::vector<std::string>{};
+        auto weights = std::vector<double>{};
         const auto now = Clock::now();
 
         for (const auto& id : haveServices) {
-            auto weight = std::size_t{1};
+            auto weight = double{1};
 
             try {
                 const auto& last = connected_.at(id);
@@ -167,24 +190,26 @@ auto Peers::Find(
             } catch (...) {
             }
 
-            weighted.insert(weighted.end(), weight, id);
-        }
+            // Addresses which performed well on previous connections are
+            // preferred over addresses which were slow or unreliable
+            if (auto it = statistics_.find(id); statistics_.end() != it) {
+                weight *= it->second.Weight();
+            } else {
+                weight *= PeerStats{}.Weight();
+            }
 
-        std::vector<std::string> output;
-        const std::size_t count{1};
-        std::sample(
-            weighted.begin(),
-            weighted.end(),
-            std::back_inserter(output),
-            count,
-            std::mt19937{std::random_device{}()});
+            ids.emplace_back(id);
+            weights.emplace_back(weight);
+        }
 
-        OT_ASSERT(count == output.size());
+        auto rng = std::mt19937{std::random_device{}()};
+        auto distribution = std::discrete_distribution<std::size_t>{
+            weights.begin(), weights.end()};
+        const auto& output = ids.at(distribution(rng));
 
-        LogTrace(OT_METHOD)(__FUNCTION__)(": Loading peer ")(output.front())
-            .Flush();
+        LogTrace(OT_METHOD)(__FUNCTION__)(": Loading peer ")(output).Flush();
 
-        return load_address(output.front());
+        return load_address(output);
     } catch (...) {
 
         return {};
@@ -363,6 +388,17 @@ auto Peers::insert(const Lock& lock, std::vector<Address_p> peers) noexcept
     return true;
 }
 
+auto Peers::LoadStatistics(const Identifier& id) const noexcept -> PeerStats
+{
+    Lock lock(lock_);
+
+    if (auto it = statistics_.find(id.str()); statistics_.end() != it) {
+        return it->second;
+    }
+
+    return {};
+}
+
 auto Peers::load_address(const std::string& id) const noexcept(false)
     -> Address_p
 {
@@ -388,4 +424,27 @@ auto Peers::load_address(const std::string& id) const noexcept(false)
 
     return factory::BlockchainAddress(api_, serialized);
 }
+
+auto Peers::StoreStatistics(
+    const Identifier& id,
+    const PeerStats& statistics) noexcept -> bool
+{
+    const auto key = id.str();
+    Lock lock(lock_);
+    const auto bytes = statistics.Serialize();
+    const auto result =
+        lmdb_.Store(Table::PeerStatistics, key, reader(bytes));
+
+    if (false == result.first) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Failed to save statistics for peer ")(key)
+            .Flush();
+
+        return false;
+    }
+
+    statistics_[key] = statistics;
+
+    return true;
+}
 }  // namespace opentxs::api::client::blockchain::database::implementation
@@ -28,6 +28,8 @@ namespace api
 class Core;
 }  // namespace api
 
+class Identifier;
+
 namespace storage
 {
 namespace lmdb
@@ -42,14 +44,20 @@ namespace opentxs::api::client::blockchain::database::implementation
 class Peers
 {
 public:
+    using PeerStats = opentxs::blockchain::p2p::internal::PeerStatistics;
+
     auto Find(
         const Chain chain,
         const Protocol protocol,
         const std::set<Type> onNetworks,
         const std::set<Service> withServices) const noexcept -> Address_p;
+    auto LoadStatistics(const Identifier& id) const noexcept -> PeerStats;
 
     auto Import(std::vector<Address_p> peers) noexcept -> bool;
     auto Insert(Address_p address) noexcept -> bool;
+    auto StoreStatistics(
+        const Identifier& id,
+        const PeerStats& statistics) noexcept -> bool;
 
     Peers(const api::Core& api, opentxs::storage::lmdb::LMDB& lmdb) noexcept(
         false);
@@ -60,6 +68,7 @@ private:
     using ServiceIndexMap = std::map<Service, std::set<std::string>>;
     using TypeIndexMap = std::map<Type, std::set<std::string>>;
     using ConnectedIndexMap = std::map<std::string, Time>;
+    using StatisticsMap = std::map<std::string, PeerStats>;
 
     const api::Core& api_;
     opentxs::storage::lmdb::LMDB& lmdb_;
@@ -69,6 +78,7 @@ private:
     ServiceIndexMap services_;
     TypeIndexMap networks_;
     ConnectedIndexMap connected_;
+    StatisticsMap statistics_;
 
     auto insert(const Lock& lock, std::vector<Address_p> peers) noexcept
         -> bool;
@@ -9,6 +9,7 @@
 
 #include <boost/container/flat_map.hpp>
 #include <algorithm>
+#include <cstddef>
 #include <cstring>
 #include <iosfwd>
 #include <limits>
@@ -26,6 +27,7 @@ extern "C" {
 #include "internal/blockchain/Blockchain.hpp"
 #include "internal/blockchain/Params.hpp"
 #include "internal/blockchain/client/Client.hpp"
+#include "internal/network/Factory.hpp"
 #include "opentxs/Bytes.hpp"
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/Types.hpp"
@@ -37,6 +39,7 @@ extern "C" {
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/LogSource.hpp"
+#include "opentxs/network/zeromq/Frame.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
 #include "opentxs/protobuf/BlockchainP2PSync.pb.h"
 #include "opentxs/protobuf/Check.hpp"
@@ -55,8 +58,45 @@ auto tsv(const Input& in) noexcept -> ReadView
     return {reinterpret_cast<const char*>(&in), sizeof(in)};
 }
 
+// Replies are limited to approximately this many bytes
+constexpr auto sync_reply_limit_ = std::size_t{1_MiB};
+// Bytes of recently used sync packets retained in memory
+constexpr auto sync_cache_limit_ = std::size_t{128_MiB};
+
 const std::array<unsigned char, 16> Sync::checksum_key_{};
 
+Sync::Cache::Cache(const std::size_t limit) noexcept
+    : lru_(limit)
+{
+}
+
+auto Sync::Cache::Add(
+    const Chain chain,
+    const Height height,
+    Packet packet) noexcept -> void
+{
+    OT_ASSERT(packet);
+
+    const auto bytes = packet->size();
+    lru_.Insert({chain, height}, std::move(packet), bytes);
+}
+
+auto Sync::Cache::Find(const Chain chain, const Height height) const noexcept
+    -> Packet
+{
+    return lru_.Find({chain, height}).value_or(Packet{});
+}
+
+auto Sync::Cache::Reorg(
+    const Chain chain,
+    const Height height,
+    const Height tip) noexcept -> void
+{
+    for (auto key = Height{height + 1}; key <= tip; ++key) {
+        lru_.Erase({chain, key});
+    }
+}
+
 Sync::Sync(
     const api::Core& api,
     opentxs::storage::lmdb::LMDB& lmdb,
@@ -66,7 +106,8 @@ Sync::Sync(
           path,
           "sync",
           Table::Config,
-          static_cast<std::size_t>(Database::Key::NextSyncAddress))
+          static_cast<std::size_t>(Database::Key::NextSyncAddress),
+          Table::FreeSyncSpace)
     , api_(api)
     , tip_table_(Table::SyncTips)
     , lock_()
@@ -79,6 +120,7 @@ Sync::Sync(
 
         return output;
     }())
+    , cache_(sync_cache_limit_)
 {
     auto cb = [&](const auto key, const auto value) {
         auto chain = std::size_t{};
@@ -109,6 +151,25 @@ Sync::Sync(
     import_genesis(Chain::UnitTest);
 }
 
+auto Sync::add_frame(const Packet& packet, zmq::Message& output) noexcept
+    -> void
+{
+    // The frame keeps the packet alive until the message has been sent
+    auto* hint = new Packet{packet};
+    constexpr auto cleanup = [](void*, void* hint) {
+        delete static_cast<Packet*>(hint);
+    };
+    output.AddFrame();
+    output.Replace(
+        output.size() - 1,
+        OTZMQFrame{factory::ZMQFrame(
+                       const_cast<std::byte*>(packet->data()),
+                       packet->size(),
+                       cleanup,
+                       hint)
+                       .release()});
+}
+
 auto Sync::import_genesis(const Chain chain) noexcept -> void
 {
     if (0 <= tips_.at(chain)) { return; }
@@ -157,10 +218,28 @@ auto Sync::import_genesis(const Chain chain) noexcept -> void
 auto Sync::Load(const Chain chain, const Height height, zmq::Message& output)
     const noexcept -> bool
 {
-    const auto start = static_cast<std::size_t>(height + 1);
     auto haveOne{false};
     auto total = std::size_t{};
     auto lock = SharedLock{lock_};
+    const auto add = [&](const Packet& packet) {
+        add_frame(packet, output);
+        haveOne = true;
+        total += packet->size();
+
+        return total < sync_reply_limit_;
+    };
+    auto next = Height{height + 1};
+
+    // Popular ranges are served entirely from memory without opening a
+    // database transaction or verifying checksums again
+    for (const auto tip = tips_.at(chain); next <= tip; ++next) {
+        const auto packet = cache_.Find(chain, next);
+
+        if (false == bool(packet)) { break; }
+
+        if (false == add(packet)) { return haveOne; }
+    }
+
     const auto cb = [&](const auto key, const auto value) {
         if ((nullptr == key.data()) || (sizeof(std::size_t) != key.size())) {
             throw std::runtime_error("Invalid key");
@@ -174,6 +253,12 @@ auto Sync::Load(const Chain chain, const Height height, zmq::Message& output)
         }();
 
         try {
+            if (auto packet = cache_.Find(chain, static_cast<Height>(height));
+                packet) {
+
+                return add(packet);
+            }
+
             const auto data = Data{value};
             const auto view = get_read_view(data.index_);
 
@@ -199,11 +284,11 @@ auto Sync::Load(const Chain chain, const Height height, zmq::Message& output)
                 throw std::runtime_error("checksum failure");
             }
 
-            output.AddFrame(view.data(), view.size());
-            haveOne = true;
-            total += view.size();
+            const auto* it = reinterpret_cast<const std::byte*>(view.data());
+            auto packet = std::make_shared<const Space>(it, it + view.size());
+            cache_.Add(chain, static_cast<Height>(height), packet);
 
-            return total < 1_MiB;
+            return add(packet);
         } catch (const std::exception& e) {
             LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
 
@@ -213,7 +298,11 @@ auto Sync::Load(const Chain chain, const Height height, zmq::Message& output)
 
     try {
         using Dir = opentxs::storage::lmdb::LMDB::Dir;
-        lmdb_.ReadFrom(ChainToSyncTable(chain), start, cb, Dir::Forward);
+        lmdb_.ReadFrom(
+            ChainToSyncTable(chain),
+            static_cast<std::size_t>(next),
+            cb,
+            Dir::Forward);
     } catch (const std::exception& e) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
     }
@@ -262,6 +351,7 @@ auto Sync::reorg(const Chain chain, const Height height) const noexcept -> bool
         return false;
     }
 
+    cache_.Reorg(chain, height, tip);
     tip = height;
 
     return true;
@@ -309,6 +399,9 @@ auto Sync::Store(const Chain chain, const Items& items) const noexcept -> bool
     OT_ASSERT(-2 < previous);
 
     auto txn = lmdb_.TransactionRW();
+    auto pending = Pending{};
+    auto packets = std::vector<Packet>{};
+    packets.reserve(items.size());
     LogTrace(OT_METHOD)(__FUNCTION__)(": previous tip height: ")(previous)
         .Flush();
 
@@ -332,7 +425,7 @@ auto Sync::Store(const Chain chain, const Items& items) const noexcept -> bool
             return false;
         }
 
-        auto write = get_write_view(txn, data.index_, size);
+        auto write = get_write_view(txn, data.index_, size, pending);
 
         if (false == write.valid(size)) {
             LogOutput(OT_METHOD)(__FUNCTION__)(
@@ -357,6 +450,8 @@ auto Sync::Store(const Chain chain, const Items& items) const noexcept -> bool
             return false;
         }
 
+        const auto* it = write.as<std::byte>();
+        packets.emplace_back(std::make_shared<const Space>(it, it + size));
         const auto result =
             lmdb_.Store(ChainToSyncTable(chain), dbKey, data, txn);
 
@@ -377,14 +472,23 @@ auto Sync::Store(const Chain chain, const Items& items) const noexcept -> bool
         return false;
     }
 
-    tips_.at(chain) = tip;
-
     if (false == txn.Finalize(true)) {
         LogOutput(OT_METHOD)(__FUNCTION__)(": Finalize error").Flush();
 
         return false;
     }
 
+    tips_.at(chain) = tip;
+    apply(pending);
+
+    // Packets were checksummed as they were written so they can be served
+    // without further verification
+    auto next = static_cast<Height>(items.front().height());
+
+    for (auto& packet : packets) {
+        cache_.Add(chain, next++, std::move(packet));
+    }
+
     return true;
 }
 
@@ -12,10 +12,11 @@
 #include <iosfwd>
 #include <iterator>
 #include <map>
-#include <mutex>
+#include <memory>
 #include <shared_mutex>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "internal/blockchain/client/Client.hpp"
@@ -28,6 +29,7 @@
 #include "opentxs/core/Data.hpp"
 #include "opentxs/protobuf/BlockchainP2PSync.pb.h"
 #include "util/LMDB.hpp"
+#include "util/LRU.hpp"
 #include "util/MappedFileStorage.hpp"
 
 namespace opentxs
@@ -69,6 +71,30 @@ public:
     using Chain = opentxs::blockchain::Type;
     using Height = opentxs::blockchain::block::Height;
     using Items = std::vector<proto::BlockchainP2PSync>;
+    using Packet = std::shared_ptr<const Space>;
+
+    // Recently stored or served packets which have already passed checksum
+    // verification. Replies are assembled from these without copying.
+    class Cache
+    {
+    public:
+        auto Find(const Chain chain, const Height height) const noexcept
+            -> Packet;
+
+        auto Add(const Chain chain, const Height height, Packet packet) noexcept
+            -> void;
+        // Remove all entries with a height greater than height and not
+        // greater than tip
+        auto Reorg(
+            const Chain chain,
+            const Height height,
+            const Height tip) noexcept -> void;
+
+        Cache(const std::size_t limit) noexcept;
+
+    private:
+        LRU<std::pair<Chain, Height>, Packet> lru_;
+    };
 
     auto Load(const Chain chain, const Height height, zmq::Message& output)
         const noexcept -> bool;
@@ -129,6 +155,10 @@ private:
     const int tip_table_;
     mutable Mutex lock_;
     mutable Tips tips_;
+    mutable Cache cache_;
+
+    static auto add_frame(const Packet& packet, zmq::Message& output) noexcept
+        -> void;
 
     auto import_genesis(const Chain chain) noexcept -> void;
     // WARNING make sure an exclusive lock is held
@@ -0,0 +1,166 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "opentxs/Bytes.hpp"
+#include "opentxs/Types.hpp"
+
+namespace opentxs::blockchain
+{
+/// Reusable receive buffers grouped into power of two size classes
+///
+/// A buffer returns to the pool when it is destroyed, which may happen on any
+/// thread. Idle buffers are retained up to a fixed number of bytes. Requests
+/// larger than the biggest size class are allocated exactly and never cached.
+class BufferPool final : public std::enable_shared_from_this<BufferPool>
+{
+public:
+    class Buffer
+    {
+    public:
+        /// Bytes available for use, which may be less than the capacity
+        auto size() const noexcept -> std::size_t { return size_; }
+        auto Capacity() const noexcept -> std::size_t { return space_.size(); }
+
+        auto data() noexcept -> std::byte* { return space_.data(); }
+
+        Buffer(
+            std::shared_ptr<BufferPool> pool,
+            Space&& space,
+            const std::size_t size) noexcept
+            : pool_(std::move(pool))
+            , space_(std::move(space))
+            , size_(size)
+        {
+        }
+
+        ~Buffer() { pool_->recycle(std::move(space_)); }
+
+    private:
+        const std::shared_ptr<BufferPool> pool_;
+        Space space_;
+        const std::size_t size_;
+
+        Buffer() = delete;
+        Buffer(const Buffer&) = delete;
+        Buffer(Buffer&&) = delete;
+        auto operator=(const Buffer&) -> Buffer& = delete;
+        auto operator=(Buffer&&) -> Buffer& = delete;
+    };
+
+    using Pointer = std::unique_ptr<Buffer>;
+
+    // Smallest size class
+    static constexpr std::size_t minimum_{512};
+    // Largest size class, which holds the largest possible bitcoin message
+    static constexpr std::size_t maximum_{32u * 1024u * 1024u};
+    static constexpr std::size_t default_limit_{64u * 1024u * 1024u};
+
+    static auto Factory(const std::size_t limit = default_limit_) noexcept
+        -> std::shared_ptr<BufferPool>
+    {
+        return std::shared_ptr<BufferPool>{new BufferPool{limit}};
+    }
+
+    /// Returns the number of bytes held by idle buffers
+    auto Idle() const noexcept -> std::size_t
+    {
+        auto lock = Lock{lock_};
+
+        return idle_;
+    }
+
+    auto Get(const std::size_t bytes) noexcept -> Pointer
+    {
+        const auto index = size_class(bytes);
+        auto space = Space{};
+
+        if (index < free_.size()) {
+            auto lock = Lock{lock_};
+            auto& list = free_.at(index);
+
+            if (false == list.empty()) {
+                space = std::move(list.back());
+                list.pop_back();
+                idle_ -= space.size();
+            }
+        }
+
+        if (space.empty()) {
+            space.resize(
+                (index < free_.size()) ? class_bytes(index) : bytes);
+        }
+
+        return std::make_unique<Buffer>(
+            shared_from_this(), std::move(space), bytes);
+    }
+
+    ~BufferPool() = default;
+
+private:
+    static constexpr std::size_t classes_{17};
+
+    static_assert((minimum_ << (classes_ - 1)) == maximum_);
+
+    const std::size_t limit_;
+    mutable std::mutex lock_;
+    std::array<std::vector<Space>, classes_> free_;
+    std::size_t idle_;
+
+    static constexpr auto class_bytes(const std::size_t index) noexcept
+        -> std::size_t
+    {
+        return minimum_ << index;
+    }
+    // Returns classes_ if the request is larger than every size class
+    static constexpr auto size_class(const std::size_t bytes) noexcept
+        -> std::size_t
+    {
+        auto index = std::size_t{0};
+
+        while ((index < classes_) && (class_bytes(index) < bytes)) { ++index; }
+
+        return index;
+    }
+
+    auto recycle(Space&& space) noexcept -> void
+    {
+        const auto bytes = space.size();
+        const auto index = size_class(bytes);
+
+        if ((index >= free_.size()) || (class_bytes(index) != bytes)) {
+            return;
+        }
+
+        auto lock = Lock{lock_};
+
+        if ((idle_ + bytes) > limit_) { return; }
+
+        free_.at(index).emplace_back(std::move(space));
+        idle_ += bytes;
+    }
+
+    BufferPool(const std::size_t limit) noexcept
+        : limit_(limit)
+        , lock_()
+        , free_()
+        , idle_(0)
+    {
+    }
+    BufferPool() = delete;
+    BufferPool(const BufferPool&) = delete;
+    BufferPool(BufferPool&&) = delete;
+    auto operator=(const BufferPool&) -> BufferPool& = delete;
+    auto operator=(BufferPool&&) -> BufferPool& = delete;
+};
+}  // namespace opentxs::blockchain
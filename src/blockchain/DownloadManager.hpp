@@ -7,13 +7,16 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <vector>
 
+#include "blockchain/DownloadScheduler.hpp"
 #include "blockchain/DownloadTask.hpp"
 #include "opentxs/Types.hpp"
 #include "opentxs/blockchain/Blockchain.hpp"
@@ -56,8 +59,21 @@ public:
         dm_known_ = position;
         buffer_.clear();
         next_ = 0;
+        dm_batches_.clear();
         downcast().update_tip(position, dm_previous_.get());
     }
+    /// Discards the measurements of a disconnected peer
+    ///
+    /// Batches still held by the peer are not measured when they finish.
+    auto RemovePeer(const int peer) noexcept -> void
+    {
+        auto lock = Lock{dm_lock_};
+        scheduler_.Remove(peer);
+
+        for (auto& [id, allocation] : dm_batches_) {
+            if (peer == allocation.peer_) { allocation.removed_ = true; }
+        }
+    }
     auto Start() noexcept { enabled_ = true; }
 
 protected:
@@ -74,7 +90,12 @@ protected:
     // WARNING Call known() and update_position() from the same thread.
     auto known() const noexcept { return dm_known_; }
 
-    auto allocate_batch(ExtraData extra = {}) noexcept -> BatchType
+    // If peer is specified the batch is sized according to the measured
+    // throughput of that peer. Once every item has been allocated, items
+    // held by slower peers which are overdue are allocated again.
+    auto allocate_batch(
+        ExtraData extra = {},
+        std::optional<int> peer = std::nullopt) noexcept -> BatchType
     {
         auto lock = Lock{dm_lock_};
 
@@ -90,15 +111,28 @@ protected:
         const auto size = [&] {
             const auto unallocated = this->unallocated(lock);
             const auto batch = downcast().batch_size(unallocated);
+            const auto limit = std::min<std::size_t>(unallocated, batch);
+
+            if (peer.has_value()) {
+
+                return scheduler_.Size(peer.value(), limit);
+            }
 
-            return std::min<std::size_t>(unallocated, batch);
+            return limit;
         }();
 
         LogTrace(DOWNLOAD_MANAGER)(__FUNCTION__)(": ")(size)(" ")(log_)(
             " items to download")
             .Flush();
 
-        if (0 == size) { return {}; }
+        if (0 == size) {
+            if (peer.has_value()) {
+
+                return end_game(lock, std::move(extra), peer.value());
+            }
+
+            return {};
+        }
 
         auto output = BatchType{
             ++last_batch_,
@@ -132,11 +166,16 @@ protected:
                 return output;
             }(),
             [=](const auto& batch) { finish_downloading(batch); },
-            std::move(extra)};
+            ExtraData{extra}};
 
         if (const auto allocated = output.data_.size(); 0 == allocated) {
             --last_batch_;
 
+            if (peer.has_value()) {
+
+                return end_game(lock, std::move(extra), peer.value());
+            }
+
             return {};
         } else {
             next_ += allocated;
@@ -144,6 +183,11 @@ protected:
 
         OT_ASSERT(next_ <= buffer_.size());
 
+        if (peer.has_value()) {
+            dm_batches_.try_emplace(
+                output.id_, peer.value(), output.data_, std::nullopt);
+        }
+
         return output;
     }
     auto run_if_enabled() noexcept -> void
@@ -264,6 +308,8 @@ protected:
         , buffer_()
         , next_(0)
         , enabled_(false)
+        , scheduler_()
+        , dm_batches_()
     {
     }
 
@@ -284,6 +330,43 @@ private:
     using TaskPtr = std::shared_ptr<TaskType>;
     using Buffer = std::deque<TaskPtr>;
     using BatchID = typename BatchType::ID;
+    using TaskSet = std::set<const TaskType*>;
+
+    // Batch allocated to a specific peer
+    struct Allocation {
+        const int peer_;
+        const DownloadedData tasks_;
+        const Time started_;
+        // Batch from which the tasks of this batch were reallocated
+        const std::optional<BatchID> origin_;
+        // Batch to which some tasks of this batch were reallocated
+        std::optional<BatchID> reissued_;
+        // Tasks currently owned by the reissued batch
+        TaskSet transferred_;
+        // Set once the peer has disconnected
+        bool removed_;
+
+        Allocation(
+            const int peer,
+            DownloadedData tasks,
+            std::optional<BatchID> origin) noexcept
+            : peer_(peer)
+            , tasks_(std::move(tasks))
+            , started_(Clock::now())
+            , origin_(std::move(origin))
+            , reissued_(std::nullopt)
+            , transferred_()
+            , removed_(false)
+        {
+        }
+    };
+
+    // A batch is overdue once it has taken this many times longer than
+    // expected for its peer
+    static constexpr double straggler_factor_{2.0};
+    // Seconds after which a batch held by a peer with no measurements is
+    // overdue
+    static constexpr double straggler_timeout_{20.0};
 
     const std::string log_;
     const std::size_t max_queue_;
@@ -295,6 +378,8 @@ private:
     Buffer buffer_;
     std::size_t next_;
     std::atomic_bool enabled_;
+    Scheduler scheduler_;
+    std::map<BatchID, Allocation> dm_batches_;
 
     // Functions to implement in child class:
     //
@@ -332,9 +417,122 @@ private:
     {
         return static_cast<CRTP&>(*this);
     }
+    // Allocates items from an overdue batch to a peer which is expected to
+    // be faster. Whichever peer delivers an item first completes it. The
+    // reallocated items are owned by the new batch until it finishes.
+    auto end_game(const Lock&, ExtraData&& extra, const int peer) noexcept
+        -> BatchType
+    {
+        using Duration = Scheduler::Duration;
+        const auto now = Clock::now();
+
+        for (auto& [id, allocation] : dm_batches_) {
+            if ((peer == allocation.peer_) || allocation.origin_.has_value() ||
+                allocation.reissued_.has_value()) {
+                continue;
+            }
+
+            if (false == scheduler_.Preferred(peer, allocation.peer_)) {
+                continue;
+            }
+
+            const auto limit = [&] {
+                const auto expected = scheduler_.Expected(
+                    allocation.peer_, allocation.tasks_.size());
+
+                if (expected.has_value()) {
+
+                    return expected.value() * straggler_factor_;
+                }
+
+                return Duration{straggler_timeout_};
+            }();
+
+            if (std::chrono::duration_cast<Duration>(
+                    now - allocation.started_) < limit) {
+                continue;
+            }
+
+            auto pending = DownloadedData{};
+
+            for (const auto& task : allocation.tasks_) {
+                if (State::Downloading == task->state_.load()) {
+                    pending.emplace_back(task);
+                }
+            }
+
+            if (0 == pending.size()) { continue; }
+
+            pending.resize(std::min(
+                pending.size(), scheduler_.Size(peer, pending.size())));
+            LogVerbose(DOWNLOAD_MANAGER)(__FUNCTION__)(": reallocating ")(
+                pending.size())(" ")(log_)(" items from peer ")(
+                allocation.peer_)(" to peer ")(peer)
+                .Flush();
+            auto output = BatchType{
+                ++last_batch_,
+                std::move(pending),
+                [=](const auto& batch) { finish_downloading(batch); },
+                std::move(extra)};
+            allocation.reissued_ = output.id_;
+
+            for (const auto& task : output.data_) {
+                allocation.transferred_.emplace(task.get());
+            }
+
+            dm_batches_.try_emplace(output.id_, peer, output.data_, id);
+
+            return output;
+        }
+
+        return {};
+    }
     auto finish_downloading(const BatchType& batch) noexcept -> void
     {
         auto lock = Lock{dm_lock_};
+        // Tasks in this batch which are owned by a different batch
+        auto foreign = TaskSet{};
+
+        if (auto it = dm_batches_.find(batch.id_); dm_batches_.end() != it) {
+            auto& allocation = it->second;
+            const auto downloaded = batch.downloaded_.load();
+            const auto raced = allocation.origin_.has_value() ||
+                               allocation.reissued_.has_value();
+
+            // A peer which delivered nothing because it lost the race for
+            // its items to another peer is not penalized
+            const auto measure = (false == allocation.removed_) &&
+                                 ((0 < downloaded) || (false == raced));
+
+            if (measure) {
+                scheduler_.Record(
+                    allocation.peer_,
+                    downloaded,
+                    batch.Latency(),
+                    batch.Duration());
+            }
+
+            if (allocation.reissued_.has_value() &&
+                (0 < dm_batches_.count(allocation.reissued_.value()))) {
+                foreign = std::move(allocation.transferred_);
+            } else if (allocation.origin_.has_value()) {
+                auto origin = dm_batches_.find(allocation.origin_.value());
+
+                if (dm_batches_.end() != origin) {
+                    // Undelivered tasks return to the batch they were taken
+                    // from, which is still downloading them
+                    for (const auto& task : allocation.tasks_) {
+                        foreign.emplace(task.get());
+                    }
+
+                    origin->second.reissued_ = std::nullopt;
+                    origin->second.transferred_.clear();
+                }
+            }
+
+            dm_batches_.erase(it);
+        }
+
         // Make sure all tasks in batch actually got downloaded
         const auto& data = batch.data_;
 
@@ -362,6 +560,8 @@ private:
 
             if (bufferTask.get() != batchTask.get()) { break; }
 
+            if (0 < foreign.count(batchTask.get())) { continue; }
+
             auto& task = *batchTask;
             auto& state = task.state_;
             auto expect = State::Downloaded;
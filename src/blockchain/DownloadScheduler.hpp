@@ -0,0 +1,150 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <optional>
+
+#include "opentxs/Types.hpp"
+
+namespace opentxs::blockchain::download
+{
+/// Tracks the throughput and latency of each peer from completed batches
+///
+/// Batches are sized so that each peer spends roughly the same amount of
+/// time on every allocation regardless of how fast it is. Peers which have
+/// not completed a batch yet receive a small probe allocation.
+///
+/// Not thread safe. The owning download::Manager serializes access.
+class Scheduler
+{
+public:
+    using Duration = std::chrono::duration<double>;
+
+    /// Returns the time the peer is expected to need for a batch
+    auto Expected(const int peer, const std::size_t items) const noexcept
+        -> std::optional<Duration>
+    {
+        const auto it = peers_.find(peer);
+
+        if (peers_.end() == it) { return std::nullopt; }
+
+        const auto& [rate, latency] = it->second;
+
+        if (0.0 >= rate) { return Duration{failed_timeout_}; }
+
+        return Duration{latency + (static_cast<double>(items) / rate)};
+    }
+    /// Returns false if both peers have been measured and the candidate is
+    /// not faster than the current owner of a batch
+    auto Preferred(const int candidate, const int owner) const noexcept -> bool
+    {
+        const auto lhs = peers_.find(candidate);
+        const auto rhs = peers_.find(owner);
+
+        if ((peers_.end() == lhs) || (peers_.end() == rhs)) { return true; }
+
+        return lhs->second.rate_ > rhs->second.rate_;
+    }
+    /// Returns the number of items to allocate to the peer
+    ///
+    /// The result never exceeds limit.
+    auto Size(const int peer, const std::size_t limit) const noexcept
+        -> std::size_t
+    {
+        if (0 == limit) { return 0; }
+
+        const auto it = peers_.find(peer);
+
+        if (peers_.end() == it) {
+
+            return std::max<std::size_t>(limit / probe_divisor_, 1);
+        }
+
+        const auto& [rate, latency] = it->second;
+        // Batches must be long enough for the round trip to be amortized
+        const auto duration = std::max(target_, latency * latency_factor_);
+        const auto items = rate * (duration - latency);
+
+        if (static_cast<double>(limit) <= items) { return limit; }
+
+        return std::max<std::size_t>(static_cast<std::size_t>(items), 1);
+    }
+
+    /// Discards the measurements of a disconnected peer
+    auto Remove(const int peer) noexcept -> void { peers_.erase(peer); }
+    /// Adds a measurement from a completed or abandoned batch
+    ///
+    /// latency is the time until the first item arrived and elapsed is the
+    /// time until the last item arrived.
+    auto Record(
+        const int peer,
+        const std::size_t items,
+        const Clock::duration latency,
+        const Clock::duration elapsed) noexcept -> void
+    {
+        const auto first =
+            std::chrono::duration_cast<Duration>(latency).count();
+        const auto total = std::max(
+            std::chrono::duration_cast<Duration>(elapsed).count(),
+            first + minimum_);
+        auto [it, added] = peers_.try_emplace(peer);
+        auto& [rate, average] = it->second;
+
+        if (0 == items) {
+            // A peer which delivered nothing keeps only a fraction of its
+            // previous rating
+            rate *= failure_penalty_;
+
+            return;
+        }
+
+        const auto sample = static_cast<double>(items) / (total - first);
+
+        if (added) {
+            rate = sample;
+            average = first;
+        } else {
+            rate = (alpha_ * sample) + ((1.0 - alpha_) * rate);
+            average = (alpha_ * first) + ((1.0 - alpha_) * average);
+        }
+    }
+
+    Scheduler() noexcept
+        : peers_()
+    {
+    }
+
+    ~Scheduler() = default;
+
+private:
+    struct Stats {
+        // Items per second after the first item has arrived
+        double rate_{};
+        // Seconds until the first item arrives
+        double latency_{};
+    };
+
+    // Weight of the most recent measurement
+    static constexpr double alpha_{0.25};
+    static constexpr double failure_penalty_{0.5};
+    static constexpr double latency_factor_{4.0};
+    static constexpr double minimum_{0.001};
+    static constexpr double target_{10.0};
+    static constexpr double failed_timeout_{60.0};
+    static constexpr std::size_t probe_divisor_{10};
+
+    std::map<int, Stats> peers_;
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler(Scheduler&&) = delete;
+    auto operator=(const Scheduler&) -> Scheduler& = delete;
+    auto operator=(Scheduler&&) -> Scheduler& = delete;
+};
+}  // namespace opentxs::blockchain::download
@@ -225,6 +225,8 @@ public:
 
     operator bool() const noexcept { return 0 < data_.size(); }
 
+    /// Time between the creation of the batch and the last download
+    auto Duration() const noexcept { return last_activity_ - started_; }
     auto Elapsed() const noexcept { return Clock::now() - last_activity_; }
     auto isDownloaded() const noexcept -> bool
     {
@@ -232,6 +234,8 @@ public:
 
         return (0 < size) && (downloaded_.load() == size);
     }
+    /// Time between the creation of the batch and the first download
+    auto Latency() const noexcept { return first_activity_ - started_; }
 
     auto Download(
         const Position& item,
@@ -239,9 +243,10 @@ public:
         std::optional<ExtraData> check = std::nullopt) -> bool
     {
         if (data_.at(index_.at(item))->download(std::move(data), check)) {
-            ++downloaded_;
             last_activity_ = Clock::now();
 
+            if (0 == downloaded_++) { first_activity_ = last_activity_; }
+
             return true;
         }
 
@@ -277,6 +282,7 @@ public:
         , cb_(cb)
         , index_(index(data_))
         , started_(Clock::now())
+        , first_activity_(started_)
         , last_activity_(started_)
     {
     }
@@ -288,6 +294,7 @@ public:
         , cb_(rhs.cb_)
         , index_(std::move(const_cast<Index&>(rhs.index_)))
         , started_(rhs.started_)
+        , first_activity_(rhs.first_activity_)
         , last_activity_(rhs.last_activity_)
     {
         rhs.cb_ = {};
@@ -310,6 +317,7 @@ public:
             std::swap(
                 const_cast<Index&>(index_), const_cast<Index&>(rhs.index_));
             std::swap(started_, rhs.started_);
+            std::swap(first_activity_, rhs.first_activity_);
             std::swap(last_activity_, rhs.last_activity_);
         }
 
@@ -324,6 +332,7 @@ private:
     Callback cb_;
     const Index index_;
     Time started_;
+    Time first_activity_;
     Time last_activity_;
 
     static auto index(const Vector& in) noexcept -> Index
@@ -7,16 +7,13 @@
 #include "1_Internal.hpp"      // IWYU pragma: associated
 #include "blockchain/GCS.hpp"  // IWYU pragma: associated
 
-#include <boost/core/enable_if.hpp>
-#include <boost/cstdint.hpp>
 #include <boost/endian/buffers.hpp>
-#include <boost/multiprecision/cpp_int.hpp>
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <limits>
-#include <map>
 #include <memory>
 #include <optional>
 #include <stdexcept>
@@ -24,27 +21,24 @@
 #include <utility>
 #include <vector>
 
+#include "blockchain/SipHash.hpp"
 #include "blockchain/bitcoin/CompactSize.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/api/Core.hpp"
 #include "opentxs/api/Factory.hpp"
-#include "opentxs/api/crypto/Crypto.hpp"
-#include "opentxs/api/crypto/Hash.hpp"
 #include "opentxs/blockchain/Blockchain.hpp"
 #include "opentxs/blockchain/FilterType.hpp"
 #include "opentxs/blockchain/block/Block.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/LogSource.hpp"
-#include "opentxs/protobuf/Enums.pb.h"
 #include "opentxs/protobuf/GCS.pb.h"
 #include "util/Container.hpp"
 
-//#define OT_METHOD "opentxs::blockchain::implementation::GCS::"
+#define OT_METHOD "opentxs::blockchain::implementation::GCS::"
 
 namespace be = boost::endian;
-namespace mp = boost::multiprecision;
 
 namespace opentxs
 {
@@ -137,6 +131,26 @@ auto GCS(
     }
 }
 
+auto GCSView(
+    const api::Core& api,
+    const blockchain::filter::Type type,
+    const ReadView key,
+    const ReadView encoded) noexcept -> std::unique_ptr<blockchain::client::GCS>
+{
+    try {
+        const auto params = blockchain::internal::GetFilterParams(type);
+        const auto [elements, bytes] =
+            blockchain::internal::DecodeSerializedCfilter(encoded);
+
+        return std::make_unique<ReturnType>(
+            api, params.first, params.second, elements, key, bytes, false);
+    } catch (const std::exception& e) {
+        LogOutput("opentxs::factory::")(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return nullptr;
+    }
+}
+
 auto GCS(
     const api::Core& api,
     const blockchain::filter::Type type,
@@ -175,31 +189,127 @@ auto GCS(
 
 namespace opentxs::gcs
 {
-using BitReader = blockchain::internal::BitReader;
 using BitWriter = blockchain::internal::BitWriter;
 
-auto golomb_decode(const std::uint8_t P, BitReader& stream) noexcept(false)
-    -> std::uint64_t;
-auto golomb_encode(
-    const std::uint8_t P,
-    const std::uint64_t value,
-    BitWriter& stream) noexcept -> void;
-auto siphash(
-    const api::Core& api,
-    const ReadView key,
-    const ReadView item) noexcept(false) -> std::uint64_t;
-
-auto golomb_decode(const std::uint8_t P, BitReader& stream) noexcept(false)
-    -> std::uint64_t
+// Reads a golomb-rice coded bit stream in place, 64 bits at a time. Reading
+// past the end of the stream produces zero bits and sets the overrun flag.
+class Decoder
 {
-    auto quotient = std::uint64_t{0};
+public:
+    auto Overrun() const noexcept -> bool { return overrun_; }
 
-    while (1 == stream.read(1)) { quotient++; }
+    auto Next() noexcept -> std::uint64_t
+    {
+        auto quotient = std::uint64_t{0};
 
-    auto remainder = stream.read(P);
+        while (true) {
+            refill();
+            const auto ones = leading_ones();
 
-    return std::uint64_t{(quotient << P) + remainder};
-}
+            if (ones < bits_) {
+                quotient += ones;
+                consume(ones + 1u);
+
+                break;
+            } else if (0u == bits_) {
+                overrun_ = true;
+
+                break;
+            }
+
+            quotient += bits_;
+            consume(bits_);
+        }
+
+        refill();
+
+        if (bits_ < p_) { overrun_ = true; }
+
+        const auto remainder =
+            (0u == p_) ? std::uint64_t{0} : (buffer_ >> (64u - p_));
+        consume(std::min<std::size_t>(p_, bits_));
+
+        return (quotient << p_) + remainder;
+    }
+
+    Decoder(const std::uint8_t P, const ReadView encoded) noexcept
+        : p_(P)
+        , data_(reinterpret_cast<const std::uint8_t*>(encoded.data()))
+        , remaining_(encoded.size())
+        , buffer_(0)
+        , bits_(0)
+        , overrun_(false)
+    {
+        OT_ASSERT(64u > P);
+    }
+
+private:
+    const std::uint8_t p_;
+    const std::uint8_t* data_;
+    std::size_t remaining_;
+    // Unread bits are left-aligned. Bits past bits_ are either zero or a copy
+    // of the upcoming stream contents.
+    std::uint64_t buffer_;
+    std::size_t bits_;
+    bool overrun_;
+
+    auto consume(const std::size_t bits) noexcept -> void
+    {
+        buffer_ = (64u > bits) ? (buffer_ << bits) : std::uint64_t{0};
+        bits_ -= bits;
+    }
+    auto leading_ones() const noexcept -> std::size_t
+    {
+        const auto inverted = ~buffer_;
+
+        if (0u == inverted) { return 64u; }
+
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_clzll(inverted));
+#else
+        auto output = std::size_t{0};
+
+        for (auto mask = std::uint64_t{1} << 63u; 0u == (inverted & mask);
+             mask >>= 1u) {
+            ++output;
+        }
+
+        return output;
+#endif
+    }
+    auto refill() noexcept -> void
+    {
+        if (56u < bits_) { return; }
+
+        if (8u <= remaining_) {
+            auto word = be::big_uint64_buf_t{};
+            std::memcpy(static_cast<void*>(&word), data_, sizeof(word));
+            buffer_ |= word.value() >> bits_;
+            const auto bytes = (64u - bits_) / 8u;
+            data_ += bytes;
+            remaining_ -= bytes;
+            bits_ += 8u * bytes;
+        } else {
+            while ((56u >= bits_) && (0u < remaining_)) {
+                buffer_ |= std::uint64_t{*data_} << (56u - bits_);
+                ++data_;
+                --remaining_;
+                bits_ += 8u;
+            }
+        }
+    }
+
+    Decoder() = delete;
+    Decoder(const Decoder&) = delete;
+    Decoder(Decoder&&) = delete;
+    auto operator=(const Decoder&) -> Decoder& = delete;
+    auto operator=(Decoder&&) -> Decoder& = delete;
+};
+
+auto golomb_encode(
+    const std::uint8_t P,
+    const std::uint64_t value,
+    BitWriter& stream) noexcept -> void;
 
 auto golomb_encode(
     const std::uint8_t P,
@@ -218,25 +328,50 @@ auto golomb_encode(
     stream.write(P, remainder);
 }
 
+constexpr auto value_of(const std::uint64_t in) noexcept -> std::uint64_t
+{
+    return in;
+}
+
+constexpr auto value_of(
+    const std::pair<std::uint64_t, std::size_t>& in) noexcept -> std::uint64_t
+{
+    return in.first;
+}
+
 auto GolombDecode(
     const std::uint32_t N,
     const std::uint8_t P,
-    const Space& encoded) noexcept(false) -> std::vector<std::uint64_t>
+    const ReadView encoded) noexcept(false) -> std::vector<std::uint64_t>
 {
     auto output = std::vector<std::uint64_t>{};
-    auto stream = BitReader(encoded);
+    output.reserve(N);
+    auto stream = Decoder{P, encoded};
     auto last = std::uint64_t{0};
 
     for (auto i = std::size_t{0}; i < N; ++i) {
-        auto delta = golomb_decode(P, stream);
-        auto value = last + delta;
-        output.emplace_back(value);
-        last = value;
+        last += stream.Next();
+
+        if (stream.Overrun()) {
+            throw std::runtime_error(
+                "Filter truncated after " + std::to_string(i) + " of " +
+                std::to_string(N) + " elements");
+        }
+
+        output.emplace_back(last);
     }
 
     return output;
 }
 
+auto GolombDecode(
+    const std::uint32_t N,
+    const std::uint8_t P,
+    const Space& encoded) noexcept(false) -> std::vector<std::uint64_t>
+{
+    return GolombDecode(N, P, reader(encoded));
+}
+
 auto GolombEncode(
     const std::uint8_t P,
     const std::vector<std::uint64_t>& hashedSet) noexcept(false) -> Space
@@ -259,54 +394,25 @@ auto GolombEncode(
     return output;
 }
 
-auto siphash(
-    const api::Core& api,
-    const ReadView key,
-    const ReadView item) noexcept(false) -> std::uint64_t
-{
-    if (16 != key.size()) { throw std::runtime_error("Invalid key"); }
-
-    auto output = std::uint64_t{};
-    auto writer = [&output](const auto size) -> WritableView {
-        if (sizeof(output) != size) { throw std::out_of_range("wrong size"); }
-
-        return {&output, sizeof(output)};
-    };
-
-    if (false == api.Crypto().Hash().HMAC(
-                     proto::HASHTYPE_SIPHASH24, key, item, writer)) {
-        throw std::runtime_error("siphash failed");
-    }
-
-    return output;
-}
-
 auto HashToRange(
-    const api::Core& api,
+    const api::Core&,
     const ReadView key,
     const std::uint64_t range,
     const ReadView item) noexcept(false) -> std::uint64_t
 {
-    return ((mp::uint128_t{siphash(api, key, item)} * mp::uint128_t{range}) >>
-            64u)
-        .convert_to<std::uint64_t>();
+    return FastRange(SipHash{key}(item), range);
 }
 
 auto HashedSetConstruct(
-    const api::Core& api,
+    const api::Core&,
     const ReadView key,
     const std::uint32_t N,
     const std::uint32_t M,
     const std::vector<ReadView> items) noexcept(false)
     -> std::vector<std::uint64_t>
 {
-    auto output = std::vector<std::uint64_t>{};
     const auto range = std::uint64_t{N} * std::uint64_t{M};
-    std::transform(
-        std::begin(items),
-        std::end(items),
-        std::back_inserter(output),
-        [&](const auto& item) { return HashToRange(api, key, range, item); });
+    auto output = SipHash{key}.HashToRange(items, range);
     std::sort(output.begin(), output.end());
 
     return output;
@@ -322,19 +428,32 @@ GCS::GCS(
     const std::uint32_t filterElementCount,
     const ReadView key,
     const ReadView encoded) noexcept(false)
+    : GCS(api, bits, fpRate, filterElementCount, key, encoded, true)
+{
+}
+
+GCS::GCS(
+    const api::Core& api,
+    const std::uint8_t bits,
+    const std::uint32_t fpRate,
+    const std::uint32_t filterElementCount,
+    const ReadView key,
+    const ReadView encoded,
+    const bool copy) noexcept(false)
     : version_(1)
     , api_(api)
     , bits_(bits)
     , false_positive_rate_(fpRate)
     , count_(filterElementCount)
     , elements_()
-    , compressed_(api_.Factory().Data(encoded))
-    , key_(api_.Factory().Data(key))
+    , buffer_(copy ? space(encoded) : Space{})
+    , compressed_(copy ? reader(buffer_) : encoded)
+    , key_(make_key(key))
+    , siphash_(key)
+    , uses_(0)
+    , decode_()
+    , decoded_()
 {
-    if (16u != key_->size()) {
-        throw std::runtime_error(
-            "Invalid key size: " + std::to_string(key_->size()));
-    }
 }
 
 GCS::GCS(
@@ -354,9 +473,13 @@ GCS::GCS(
           static_cast<std::uint32_t>(elements.size()),
           false_positive_rate_,
           elements))
-    , compressed_(
-          api_.Factory().Data(reader(gcs::GolombEncode(bits_, *elements_))))
-    , key_(api_.Factory().Data(key))
+    , buffer_(gcs::GolombEncode(bits_, *elements_))
+    , compressed_(reader(buffer_))
+    , key_(make_key(key))
+    , siphash_(key)
+    , uses_(0)
+    , decode_()
+    , decoded_()
 {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wtautological-type-limit-compare"
@@ -366,43 +489,39 @@ GCS::GCS(
             "Too many elements: " + std::to_string(elements.size()));
     }
 #pragma GCC diagnostic pop
-
-    if (16u != key_->size()) {
-        throw std::runtime_error(
-            "Invalid key size: " + std::to_string(key_->size()));
-    }
 }
 
-auto GCS::Compressed() const noexcept -> Space
-{
-    return {
-        reinterpret_cast<const std::byte*>(compressed_->data()),
-        reinterpret_cast<const std::byte*>(compressed_->data()) +
-            compressed_->size()};
-}
+auto GCS::Compressed() const noexcept -> Space { return space(compressed_); }
 
-auto GCS::decompress() const noexcept -> const Elements&
+auto GCS::elements() const noexcept -> const Elements*
 {
-    if (false == elements_.has_value()) {
-        auto& set = const_cast<std::optional<Elements>&>(elements_);
-        set = gcs::GolombDecode(
-            count_,
-            bits_,
-            Space{
-                reinterpret_cast<const std::byte*>(compressed_->data()),
-                reinterpret_cast<const std::byte*>(compressed_->data()) +
-                    compressed_->size()});
-        std::sort(set.value().begin(), set.value().end());
-    }
+    if (elements_.has_value()) { return &elements_.value(); }
+
+    // A filter which is only matched once is cheaper to stream. Objects which
+    // are reused, for example from the FilterOracle cache, decode their
+    // elements once and keep them.
+    if (0u == uses_++) { return nullptr; }
+
+    std::call_once(decode_, [&] {
+        try {
+            decoded_ = gcs::GolombDecode(count_, bits_, compressed_);
+        } catch (const std::exception& e) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+        }
+    });
+
+    // A filter which can not be decoded is streamed, which fails at the same
+    // point
+    if (false == decoded_.has_value()) { return nullptr; }
 
-    return elements_.value();
+    return &decoded_.value();
 }
 
 auto GCS::Encode() const noexcept -> OTData
 {
     const auto bytes = bitcoin::CompactSize(count_).Encode();
     auto output = Data::Factory(bytes.data(), bytes.size());
-    output->Concatenate(compressed_->data(), compressed_->size());
+    output->Concatenate(compressed_.data(), compressed_.size());
 
     return output;
 }
@@ -427,14 +546,10 @@ auto GCS::hashed_set_construct(const std::vector<Space>& elements)
 auto GCS::hashed_set_construct(const std::vector<ReadView>& elements)
     const noexcept -> std::vector<std::uint64_t>
 {
-    return gcs::HashedSetConstruct(
-        api_, key_->Bytes(), count_, false_positive_rate_, elements);
-}
+    auto output = siphash_.HashToRange(elements, range());
+    std::sort(output.begin(), output.end());
 
-auto GCS::hash_to_range(const ReadView in) const noexcept -> std::uint64_t
-{
-    return gcs::HashToRange(
-        api_, key_->Bytes(), count_ * false_positive_rate_, in);
+    return output;
 }
 
 auto GCS::Header(const ReadView previous) const noexcept -> OTData
@@ -442,45 +557,108 @@ auto GCS::Header(const ReadView previous) const noexcept -> OTData
     return internal::FilterToHeader(api_, Encode()->Bytes(), previous);
 }
 
+template <typename Hashes, typename Visitor>
+auto GCS::intersect(const Hashes& targets, Visitor visit) const noexcept
+    -> bool
+{
+    auto target = std::begin(targets);
+    const auto end = std::end(targets);
+    const auto match = [&](const std::uint64_t value) -> bool {
+        while ((end != target) && (gcs::value_of(*target) < value)) {
+            ++target;
+        }
+
+        while ((end != target) && (gcs::value_of(*target) == value)) {
+            if (false == visit(*target)) { return false; }
+
+            ++target;
+        }
+
+        return end != target;
+    };
+
+    if (end == target) { return true; }
+
+    if (const auto* set = elements(); nullptr != set) {
+        for (const auto& value : *set) {
+            if (false == match(value)) { return true; }
+        }
+    } else {
+        // Filter elements are stored in ascending order so the sorted targets
+        // can be merged against the delta stream without decoding the entire
+        // filter first
+        auto stream = gcs::Decoder{bits_, compressed_};
+        auto value = std::uint64_t{0};
+
+        for (auto i = std::uint32_t{0}; i < count_; ++i) {
+            value += stream.Next();
+
+            if (stream.Overrun()) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(": Filter truncated after ")(
+                    i)(" of ")(count_)(" elements")
+                    .Flush();
+
+                return false;
+            }
+
+            if (false == match(value)) { return true; }
+        }
+    }
+
+    return true;
+}
+
+auto GCS::make_key(const ReadView in) noexcept(false) -> Key
+{
+    auto output = Key{};
+
+    if (output.size() != in.size()) {
+        throw std::runtime_error(
+            "Invalid key size: " + std::to_string(in.size()));
+    }
+
+    std::memcpy(output.data(), in.data(), output.size());
+
+    return output;
+}
+
 auto GCS::Match(const Targets& targets) const noexcept -> Matches
 {
     auto output = Matches{};
-    auto hashed = std::vector<std::uint64_t>{};
-    auto matches = std::vector<std::uint64_t>{};
-    auto map = std::map<std::uint64_t, Targets::const_iterator>{};
-    const auto& set = decompress();
-
-    for (auto i = targets.cbegin(); i != targets.cend(); ++i) {
-        const auto& hash = hashed.emplace_back(hash_to_range(*i));
-        map.emplace(hash, i);
+    const auto hashes = siphash_.HashToRange(targets, range());
+    auto hashed = std::vector<std::pair<std::uint64_t, std::size_t>>{};
+    hashed.reserve(hashes.size());
+
+    for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+        hashed.emplace_back(hashes[i], i);
     }
 
     std::sort(std::begin(hashed), std::end(hashed));
-    std::set_intersection(
-        std::begin(hashed),
-        std::end(hashed),
-        std::begin(set),
-        std::end(set),
-        std::back_inserter(matches));
-    std::transform(
-        std::begin(matches),
-        std::end(matches),
-        std::back_inserter(output),
-        [&](const auto& in) { return map.at(in); });
+    const auto valid = intersect(hashed, [&](const auto& item) {
+        output.emplace_back(std::next(targets.cbegin(), item.second));
+
+        return true;
+    });
+
+    if (false == valid) { return {}; }
 
     return output;
 }
 
+auto GCS::range() const noexcept -> std::uint64_t
+{
+    return std::uint64_t{count_} * std::uint64_t{false_positive_rate_};
+}
+
 auto GCS::Serialize() const noexcept -> proto::GCS
 {
     auto output = proto::GCS{};
     output.set_version(version_);
     output.set_bits(bits_);
     output.set_fprate(false_positive_rate_);
-    output.set_key(key_->data(), key_->size());
+    output.set_key(key_.data(), key_.size());
     output.set_count(count_);
-    output.set_filter(
-        static_cast<const char*>(compressed_->data()), compressed_->size());
+    output.set_filter(compressed_.data(), compressed_.size());
 
     return output;
 }
@@ -507,16 +685,14 @@ auto GCS::Test(const std::vector<Space>& targets) const noexcept -> bool
 
 auto GCS::test(const std::vector<std::uint64_t>& targets) const noexcept -> bool
 {
-    const auto& set = decompress();
-    auto matches = std::vector<std::uint64_t>{};
-    std::set_intersection(
-        std::begin(targets),
-        std::end(targets),
-        std::begin(set),
-        std::end(set),
-        std::back_inserter(matches));
+    auto output{false};
+    const auto valid = intersect(targets, [&](const auto&) {
+        output = true;
+
+        return false;
+    });
 
-    return 0 < matches.size();
+    return valid && output;
 }
 
 auto GCS::transform(const std::vector<OTData>& in) noexcept
@@ -8,10 +8,15 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <mutex>
 #include <optional>
 #include <vector>
 
+#include "blockchain/SipHash.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 #include "opentxs/Bytes.hpp"
 #include "opentxs/Proto.hpp"
@@ -52,6 +57,16 @@ public:
         const ReadView key,
         const ReadView encoded)
     noexcept(false);
+    // If copy is false the filter refers to encoded directly, which must
+    // remain valid for the lifetime of this object
+    GCS(const api::Core& api,
+        const std::uint8_t bits,
+        const std::uint32_t fpRate,
+        const std::uint32_t filterElementCount,
+        const ReadView key,
+        const ReadView encoded,
+        const bool copy)
+    noexcept(false);
     GCS(const api::Core& api,
         const std::uint8_t bits,
         const std::uint32_t fpRate,
@@ -63,6 +78,7 @@ public:
 
 private:
     using Elements = std::vector<std::uint64_t>;
+    using Key = std::array<std::byte, 16>;
 
     const VersionNumber version_;
     const api::Core& api_;
@@ -70,24 +86,34 @@ private:
     const std::uint32_t false_positive_rate_;
     const std::uint32_t count_;
     const std::optional<Elements> elements_;
-    const OTData compressed_;
-    const OTData key_;
+    const Space buffer_;
+    const ReadView compressed_;
+    const Key key_;
+    const gcs::SipHash siphash_;
+    mutable std::atomic<std::uint32_t> uses_;
+    mutable std::once_flag decode_;
+    mutable std::optional<Elements> decoded_;
 
+    static auto make_key(const ReadView in) noexcept(false) -> Key;
     static auto transform(const std::vector<OTData>& in) noexcept
         -> std::vector<ReadView>;
     static auto transform(const std::vector<Space>& in) noexcept
         -> std::vector<ReadView>;
 
-    auto decompress() const noexcept -> const Elements&;
     auto hashed_set_construct(const std::vector<OTData>& elements)
         const noexcept -> std::vector<std::uint64_t>;
     auto hashed_set_construct(const std::vector<Space>& elements) const noexcept
         -> std::vector<std::uint64_t>;
     auto hashed_set_construct(const std::vector<ReadView>& elements)
         const noexcept -> std::vector<std::uint64_t>;
+    auto elements() const noexcept -> const Elements*;
+    template <typename Hashes, typename Visitor>
+    // Returns false if the filter ends before count_ elements have been read
+    auto intersect(const Hashes& sortedTargets, Visitor visit) const noexcept
+        -> bool;
+    auto range() const noexcept -> std::uint64_t;
     auto test(const std::vector<std::uint64_t>& targetHashes) const noexcept
         -> bool;
-    auto hash_to_range(const ReadView in) const noexcept -> std::uint64_t;
 
     GCS() = delete;
     GCS(const GCS&) = delete;
@@ -0,0 +1,714 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"           // IWYU pragma: associated
+#include "1_Internal.hpp"         // IWYU pragma: associated
+#include "blockchain/Merkle.hpp"  // IWYU pragma: associated
+
+#include <boost/endian/conversion.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "internal/api/Api.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                               \
+    (defined(__x86_64__) || defined(__i386__))
+#define OT_MERKLE_X86 1
+#else
+#define OT_MERKLE_X86 0
+#endif
+
+#if OT_MERKLE_X86
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define OT_MERKLE_INLINE inline __attribute__((always_inline))
+
+#if !defined(__clang__)
+// The vector kernels are always inlined into functions compiled for the
+// matching instruction set so the vector calling convention never applies
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+#else
+#define OT_MERKLE_INLINE inline
+#endif
+
+namespace be = boost::endian;
+
+namespace opentxs::blockchain
+{
+namespace
+{
+using Words = std::array<std::uint32_t, 64>;
+
+constexpr auto k_ = Words{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+constexpr auto iv_ = std::array<std::uint32_t, 8>{
+    0x6a09e667,
+    0xbb67ae85,
+    0x3c6ef372,
+    0xa54ff53a,
+    0x510e527f,
+    0x9b05688c,
+    0x1f83d9ab,
+    0x5be0cd19};
+// Words 8 through 15 of the block hashed by the second round of SHA256D,
+// which contains a 32 byte digest followed by padding
+constexpr auto digest_padding_ = std::array<std::uint32_t, 8>{
+    0x80000000, 0, 0, 0, 0, 0, 0, 256};
+
+constexpr auto rotr(const std::uint32_t x, const unsigned int n) noexcept
+    -> std::uint32_t
+{
+    return (x >> n) | (x << (32u - n));
+}
+
+// The second block of a 64 byte message consists entirely of padding
+constexpr auto padding_block_ = std::array<std::uint32_t, 16>{
+    0x80000000, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 512};
+
+// The message schedule of the padding block is the same for every preimage so
+// it is expanded, and the round constants added to it, in advance
+constexpr auto padding_schedule() noexcept -> Words
+{
+    auto w = Words{};
+
+    for (auto i = std::size_t{0}; i < padding_block_.size(); ++i) {
+        w[i] = padding_block_[i];
+    }
+
+    for (auto i = std::size_t{16}; i < w.size(); ++i) {
+        const auto s0 =
+            rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3u);
+        const auto s1 =
+            rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10u);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    for (auto i = std::size_t{0}; i < w.size(); ++i) { w[i] += k_[i]; }
+
+    return w;
+}
+
+constexpr auto padding_wk_ = padding_schedule();
+
+OT_MERKLE_INLINE auto load(const std::byte* in) noexcept -> std::uint32_t
+{
+    auto out = std::uint32_t{};
+    std::memcpy(&out, in, sizeof(out));
+
+    return be::big_to_native(out);
+}
+
+OT_MERKLE_INLINE auto store(const std::uint32_t in, std::byte* out) noexcept
+    -> void
+{
+    const auto value = be::native_to_big(in);
+    std::memcpy(out, &value, sizeof(value));
+}
+
+// Word may be std::uint32_t or a gcc/clang vector of std::uint32_t, in which
+// case every operation below is applied to each lane independently
+template <typename Word>
+OT_MERKLE_INLINE auto rotate(const Word& x, const unsigned int n) noexcept
+    -> Word
+{
+    return (x >> n) | (x << (32u - n));
+}
+
+template <typename Word>
+OT_MERKLE_INLINE auto round(
+    const Word& a,
+    const Word& b,
+    const Word& c,
+    Word& d,
+    const Word& e,
+    const Word& f,
+    const Word& g,
+    Word& h,
+    const Word& wk) noexcept -> void
+{
+    const auto t1 = h + (rotate(e, 6) ^ rotate(e, 11) ^ rotate(e, 25)) +
+                    (g ^ (e & (f ^ g))) + wk;
+    const auto t2 = (rotate(a, 2) ^ rotate(a, 13) ^ rotate(a, 22)) +
+                    ((a & b) | (c & (a | b)));
+    d += t1;
+    h = t1 + t2;
+}
+
+// Applies 64 rounds using a message schedule to which the round constants
+// have already been added
+template <typename Word, typename Schedule>
+OT_MERKLE_INLINE auto rounds(Word* state, const Schedule& wk) noexcept -> void
+{
+    auto a = state[0];
+    auto b = state[1];
+    auto c = state[2];
+    auto d = state[3];
+    auto e = state[4];
+    auto f = state[5];
+    auto g = state[6];
+    auto h = state[7];
+
+    for (auto i = std::size_t{0}; i < 64u; i += 8u) {
+        round(a, b, c, d, e, f, g, h, Word{} + wk[i + 0u]);
+        round(h, a, b, c, d, e, f, g, Word{} + wk[i + 1u]);
+        round(g, h, a, b, c, d, e, f, Word{} + wk[i + 2u]);
+        round(f, g, h, a, b, c, d, e, Word{} + wk[i + 3u]);
+        round(e, f, g, h, a, b, c, d, Word{} + wk[i + 4u]);
+        round(d, e, f, g, h, a, b, c, Word{} + wk[i + 5u]);
+        round(c, d, e, f, g, h, a, b, Word{} + wk[i + 6u]);
+        round(b, c, d, e, f, g, h, a, Word{} + wk[i + 7u]);
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+template <typename Word>
+OT_MERKLE_INLINE auto compress(Word* state, const Word* block) noexcept -> void
+{
+    Word w[64];
+
+    for (auto i = std::size_t{0}; i < 16u; ++i) { w[i] = block[i]; }
+
+    for (auto i = std::size_t{16}; i < 64u; ++i) {
+        const auto s0 = rotate(w[i - 15], 7) ^ rotate(w[i - 15], 18) ^
+                        (w[i - 15] >> 3u);
+        const auto s1 = rotate(w[i - 2], 17) ^ rotate(w[i - 2], 19) ^
+                        (w[i - 2] >> 10u);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    for (auto i = std::size_t{0}; i < 64u; ++i) { w[i] += k_[i]; }
+
+    rounds(state, w);
+}
+
+// SHA256D of a 64 byte preimage
+template <typename Word>
+OT_MERKLE_INLINE auto double_sha(Word* block, Word* state) noexcept -> void
+{
+    for (auto i = std::size_t{0}; i < 8u; ++i) { state[i] = Word{} + iv_[i]; }
+
+    compress(state, block);
+    rounds(state, padding_wk_);
+
+    for (auto i = std::size_t{0}; i < 8u; ++i) {
+        block[i] = state[i];
+        block[8u + i] = Word{} + digest_padding_[i];
+        state[i] = Word{} + iv_[i];
+    }
+
+    compress(state, block);
+}
+
+OT_MERKLE_INLINE auto hash_scalar(const std::byte* in, std::byte* out) noexcept
+    -> void
+{
+    std::uint32_t block[16];
+    std::uint32_t state[8];
+
+    for (auto i = std::size_t{0}; i < 16u; ++i) {
+        block[i] = load(in + (4u * i));
+    }
+
+    double_sha(block, state);
+
+    for (auto i = std::size_t{0}; i < 8u; ++i) {
+        store(state[i], out + (4u * i));
+    }
+}
+
+#if OT_MERKLE_X86
+template <std::size_t Lanes>
+struct Vector {
+    typedef std::uint32_t Type
+        __attribute__((vector_size(Lanes * sizeof(std::uint32_t))));
+};
+
+// Hash Lanes consecutive preimages
+template <std::size_t Lanes>
+OT_MERKLE_INLINE auto hash_lanes(const std::byte* in, std::byte* out) noexcept
+    -> void
+{
+    using Word = typename Vector<Lanes>::Type;
+
+    Word block[16];
+    Word state[8];
+
+    for (auto i = std::size_t{0}; i < 16u; ++i) {
+        for (auto l = std::size_t{0}; l < Lanes; ++l) {
+            block[i][l] = load(in + (64u * l) + (4u * i));
+        }
+    }
+
+    double_sha(block, state);
+
+    for (auto i = std::size_t{0}; i < 8u; ++i) {
+        for (auto l = std::size_t{0}; l < Lanes; ++l) {
+            store(state[i][l], out + (32u * l) + (4u * i));
+        }
+    }
+}
+
+#define OT_MERKLE_SHA __attribute__((target("sha,sse4.1")))
+
+OT_MERKLE_SHA inline auto load_sha(const std::uint32_t* in) noexcept -> __m128i
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+}
+
+// Converts ABCD and EFGH into the ABEF and CDGH layout used by sha256rnds2
+OT_MERKLE_SHA inline auto to_sha(const __m128i* in, __m128i* out) noexcept
+    -> void
+{
+    const auto cdab = _mm_shuffle_epi32(in[0], 0xb1);
+    const auto hgfe = _mm_shuffle_epi32(in[1], 0x1b);
+    out[0] = _mm_alignr_epi8(cdab, hgfe, 8);
+    out[1] = _mm_blend_epi16(hgfe, cdab, 0xf0);
+}
+
+// Converts ABEF and CDGH back into ABCD and EFGH
+OT_MERKLE_SHA inline auto from_sha(const __m128i* in, __m128i* out) noexcept
+    -> void
+{
+    const auto feba = _mm_shuffle_epi32(in[0], 0x1b);
+    const auto dchg = _mm_shuffle_epi32(in[1], 0xb1);
+    out[0] = _mm_blend_epi16(feba, dchg, 0xf0);
+    out[1] = _mm_alignr_epi8(dchg, feba, 8);
+}
+
+// The message is overwritten by its expanded schedule
+OT_MERKLE_SHA inline auto compress_sha(__m128i* state, __m128i* m) noexcept
+    -> void
+{
+    const auto abef = state[0];
+    const auto cdgh = state[1];
+
+    for (auto g = std::size_t{0}; g < 16u; ++g) {
+        const auto& current = m[g % 4u];
+        auto wk = _mm_add_epi32(current, load_sha(&k_[4u * g]));
+        state[1] = _mm_sha256rnds2_epu32(state[1], state[0], wk);
+
+        if ((3u <= g) && (15u > g)) {
+            auto& next = m[(g + 1u) % 4u];
+            next = _mm_add_epi32(
+                next, _mm_alignr_epi8(current, m[(g + 3u) % 4u], 4));
+            next = _mm_sha256msg2_epu32(next, current);
+        }
+
+        wk = _mm_shuffle_epi32(wk, 0x0e);
+        state[0] = _mm_sha256rnds2_epu32(state[0], state[1], wk);
+
+        if ((1u <= g) && (13u > g)) {
+            auto& previous = m[(g + 3u) % 4u];
+            previous = _mm_sha256msg1_epu32(previous, current);
+        }
+    }
+
+    state[0] = _mm_add_epi32(state[0], abef);
+    state[1] = _mm_add_epi32(state[1], cdgh);
+}
+
+OT_MERKLE_SHA auto hash_sha(const std::byte* in, std::byte* out) noexcept
+    -> void
+{
+    const auto swap =
+        _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    const __m128i iv[2] = {load_sha(&iv_[0]), load_sha(&iv_[4])};
+    __m128i initial[2];
+    __m128i state[2];
+    __m128i digest[2];
+    __m128i m[4];
+    to_sha(iv, initial);
+    state[0] = initial[0];
+    state[1] = initial[1];
+
+    for (auto i = std::size_t{0}; i < 4u; ++i) {
+        m[i] = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + (16u * i))),
+            swap);
+    }
+
+    compress_sha(state, m);
+
+    for (auto i = std::size_t{0}; i < 4u; ++i) {
+        m[i] = load_sha(&padding_block_[4u * i]);
+    }
+
+    compress_sha(state, m);
+    from_sha(state, digest);
+    m[0] = digest[0];
+    m[1] = digest[1];
+    m[2] = load_sha(&digest_padding_[0]);
+    m[3] = load_sha(&digest_padding_[4]);
+    state[0] = initial[0];
+    state[1] = initial[1];
+    compress_sha(state, m);
+    from_sha(state, digest);
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(digest[0], swap));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(out + 16u),
+        _mm_shuffle_epi8(digest[1], swap));
+}
+#endif  // OT_MERKLE_X86
+
+// Hash count consecutive 64 byte preimages, Lanes at a time. Leftovers which
+// do not fill a group are hashed by the scalar kernel.
+template <std::size_t Lanes>
+OT_MERKLE_INLINE auto hash_batch(
+    const std::byte* in,
+    const std::size_t count,
+    std::byte* out) noexcept -> void
+{
+    auto i = std::size_t{0};
+
+#if OT_MERKLE_X86
+    if constexpr (1u < Lanes) {
+        for (; (i + Lanes) <= count; i += Lanes) {
+            hash_lanes<Lanes>(in + (64u * i), out + (32u * i));
+        }
+    }
+#endif  // OT_MERKLE_X86
+
+    for (; i < count; ++i) { hash_scalar(in + (64u * i), out + (32u * i)); }
+}
+
+#if OT_MERKLE_X86
+__attribute__((target("avx512f"), flatten)) auto hash_batch_16(
+    const std::byte* in,
+    const std::size_t count,
+    std::byte* out) noexcept -> void
+{
+    hash_batch<16>(in, count, out);
+}
+
+__attribute__((target("avx2"), flatten)) auto hash_batch_8(
+    const std::byte* in,
+    const std::size_t count,
+    std::byte* out) noexcept -> void
+{
+    hash_batch<8>(in, count, out);
+}
+
+OT_MERKLE_SHA auto hash_batch_sha(
+    const std::byte* in,
+    const std::size_t count,
+    std::byte* out) noexcept -> void
+{
+    for (auto i = std::size_t{0}; i < count; ++i) {
+        hash_sha(in + (64u * i), out + (32u * i));
+    }
+}
+
+auto cpu_has_sha() noexcept -> bool
+{
+    auto a = 0u;
+    auto b = 0u;
+    auto c = 0u;
+    auto d = 0u;
+
+    if (0 == __get_cpuid(1, &a, &b, &c, &d)) { return false; }
+
+    constexpr auto ssse3 = 1u << 9u;
+    constexpr auto sse41 = 1u << 19u;
+
+    if ((ssse3 != (c & ssse3)) || (sse41 != (c & sse41))) { return false; }
+
+    if (0 == __get_cpuid_count(7, 0, &a, &b, &c, &d)) { return false; }
+
+    constexpr auto sha = 1u << 29u;
+
+    return sha == (b & sha);
+}
+#endif  // OT_MERKLE_X86
+
+// Hashes count consecutive 64 byte preimages
+auto hash_preimages(
+    const std::byte* in,
+    const std::size_t count,
+    std::byte* out,
+    const Merkle::Kernel kernel) noexcept -> void
+{
+    using Kernel = Merkle::Kernel;
+
+    switch (kernel) {
+#if OT_MERKLE_X86
+        case Kernel::SHA: {
+            hash_batch_sha(in, count, out);
+        } break;
+        case Kernel::Lanes16: {
+            hash_batch_16(in, count, out);
+        } break;
+        case Kernel::Lanes8: {
+            hash_batch_8(in, count, out);
+        } break;
+#endif  // OT_MERKLE_X86
+        case Kernel::Scalar:
+        default: {
+            hash_batch<1>(in, count, out);
+        }
+    }
+}
+
+// Rows are only divided between thread pool workers when each worker will
+// receive at least this many hashes, which is several times the cost of
+// queueing a job even on the fastest kernel
+constexpr auto min_hashes_per_thread_ = std::size_t{2048};
+
+auto hash_row(
+    const api::Core* api,
+    const Merkle::Digest* in,
+    const std::size_t count,
+    Merkle::Digest* out,
+    const Merkle::Kernel kernel) noexcept -> void
+{
+    static_assert(sizeof(Merkle::Digest) == 32u);
+
+    // Pairs of adjacent digests are contiguous 64 byte preimages
+    const auto* preimages = reinterpret_cast<const std::byte*>(in);
+    auto* hashes = reinterpret_cast<std::byte*>(out);
+    const auto pairs = count / 2u;
+
+    if (nullptr == api) {
+        hash_preimages(preimages, pairs, hashes, kernel);
+    } else {
+        api::internal::ThreadPool::Parallel(
+            *api,
+            pairs,
+            min_hashes_per_thread_,
+            [&](const auto first, const auto last) {
+                hash_preimages(
+                    preimages + (64u * first),
+                    last - first,
+                    hashes + (32u * first),
+                    kernel);
+            });
+    }
+
+    if (1u == (count % 2u)) {
+        const auto& last = in[count - 1u];
+        const auto preimage = std::array<Merkle::Digest, 2>{last, last};
+        hash_preimages(
+            reinterpret_cast<const std::byte*>(preimage.data()),
+            1u,
+            out[pairs].data(),
+            kernel);
+    }
+}
+
+auto root(const api::Core* api, std::vector<Merkle::Digest>&& leaves) noexcept
+    -> Merkle::Digest
+{
+    if (0u == leaves.size()) { return Merkle::Digest{}; }
+
+    const auto kernel = Merkle::ActiveKernel();
+    auto other = std::vector<Merkle::Digest>((leaves.size() + 1u) / 2u);
+    auto* src = &leaves;
+    auto* dst = &other;
+    auto count = leaves.size();
+
+    while (1u < count) {
+        hash_row(api, src->data(), count, dst->data(), kernel);
+        count = (count + 1u) / 2u;
+        std::swap(src, dst);
+    }
+
+    return src->front();
+}
+}  // namespace
+
+auto Merkle::ActiveKernel() noexcept -> Kernel
+{
+    static const auto kernel = [] {
+#if OT_MERKLE_X86
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx512f")) { return Kernel::Lanes16; }
+
+        if (cpu_has_sha()) { return Kernel::SHA; }
+
+        if (__builtin_cpu_supports("avx2")) { return Kernel::Lanes8; }
+#endif  // OT_MERKLE_X86
+
+        return Kernel::Scalar;
+    }();
+
+    return kernel;
+}
+
+auto Merkle::HashRow(
+    const Digest* in,
+    const std::size_t count,
+    Digest* out,
+    const Kernel kernel) noexcept -> void
+{
+    hash_row(nullptr, in, count, out, kernel);
+}
+
+auto Merkle::HashRow(
+    const api::Core& api,
+    const Digest* in,
+    const std::size_t count,
+    Digest* out,
+    const Kernel kernel) noexcept -> void
+{
+    hash_row(&api, in, count, out, kernel);
+}
+
+auto Merkle::Pair(const Digest& lhs, const Digest& rhs) noexcept -> Digest
+{
+    auto preimage = std::array<Digest, 2>{lhs, rhs};
+    auto output = Digest{};
+    hash_preimages(
+        reinterpret_cast<const std::byte*>(preimage.data()),
+        1u,
+        output.data(),
+        ActiveKernel());
+
+    return output;
+}
+
+auto Merkle::PartialRoot(
+    const std::size_t transactions,
+    const std::vector<Digest>& hashes,
+    const std::vector<std::byte>& flags,
+    std::vector<Digest>& matches) noexcept(false) -> Digest
+{
+    if (0u == transactions) { throw std::runtime_error("Empty tree"); }
+
+    if (hashes.size() > transactions) {
+        throw std::runtime_error("More hashes than transactions");
+    }
+
+    if ((8u * flags.size()) < hashes.size()) {
+        throw std::runtime_error("Not enough flag bits");
+    }
+
+    const auto width = [&](const std::size_t height) {
+        return (transactions + (std::size_t{1} << height) - 1u) >> height;
+    };
+    auto height = std::size_t{0};
+
+    while (1u < width(height)) { ++height; }
+
+    auto bits = std::size_t{0};
+    auto used = std::size_t{0};
+    const auto flag = [&]() -> bool {
+        if (bits >= (8u * flags.size())) {
+            throw std::runtime_error("Flag bits exhausted");
+        }
+
+        const auto byte = std::to_integer<unsigned int>(flags[bits / 8u]);
+        const auto bit = (byte >> (bits % 8u)) & 0x01u;
+        ++bits;
+
+        return 1u == bit;
+    };
+    const auto traverse = [&](const auto& self,
+                              const std::size_t level,
+                              const std::size_t position) -> Digest {
+        const auto parentOfMatch = flag();
+
+        if ((0u == level) || (false == parentOfMatch)) {
+            if (used >= hashes.size()) {
+                throw std::runtime_error("Hashes exhausted");
+            }
+
+            const auto& hash = hashes[used++];
+
+            if ((0u == level) && parentOfMatch) { matches.emplace_back(hash); }
+
+            return hash;
+        }
+
+        const auto left = self(self, level - 1u, 2u * position);
+
+        if (((2u * position) + 1u) < width(level - 1u)) {
+            const auto right = self(self, level - 1u, (2u * position) + 1u);
+
+            // CVE-2012-2459
+            if (left == right) {
+                throw std::runtime_error("Duplicate branch hashes");
+            }
+
+            return Pair(left, right);
+        }
+
+        return Pair(left, left);
+    };
+    const auto output = traverse(traverse, height, 0u);
+
+    if (((bits + 7u) / 8u) != flags.size()) {
+        throw std::runtime_error("Unused flag bytes");
+    }
+
+    if (used != hashes.size()) { throw std::runtime_error("Unused hashes"); }
+
+    return output;
+}
+
+auto Merkle::Root(std::vector<Digest>&& leaves) noexcept -> Digest
+{
+    return root(nullptr, std::move(leaves));
+}
+
+auto Merkle::Root(
+    const api::Core& api,
+    std::vector<Digest>&& leaves) noexcept -> Digest
+{
+    return root(&api, std::move(leaves));
+}
+
+auto Merkle::Supported(const Kernel kernel) noexcept -> bool
+{
+    switch (kernel) {
+        case Kernel::Scalar: {
+
+            return true;
+        }
+#if OT_MERKLE_X86
+        case Kernel::SHA: {
+
+            return cpu_has_sha();
+        }
+        case Kernel::Lanes16: {
+            __builtin_cpu_init();
+
+            return __builtin_cpu_supports("avx512f");
+        }
+        case Kernel::Lanes8: {
+            __builtin_cpu_init();
+
+            return __builtin_cpu_supports("avx2");
+        }
+#endif  // OT_MERKLE_X86
+        default: {
+
+            return false;
+        }
+    }
+}
+}  // namespace opentxs::blockchain
@@ -0,0 +1,82 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include "opentxs/Version.hpp"  // IWYU pragma: associated
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "opentxs/Types.hpp"
+
+namespace opentxs
+{
+namespace api
+{
+class Core;
+}  // namespace api
+}  // namespace opentxs
+
+namespace opentxs::blockchain
+{
+// Native SHA256D merkle tree engine
+//
+// Each row of the tree is hashed as a batch of independent 64 byte preimages.
+// Batches use the SHA extensions when the cpu provides them, otherwise eight
+// or sixteen preimages are hashed at once in AVX2 or AVX-512 lanes. When an api
+// is supplied, rows large enough to amortize the cost of queueing jobs are
+// divided between thread pool workers.
+class OPENTXS_EXPORT Merkle
+{
+public:
+    using Digest = std::array<std::byte, 32>;
+
+    enum class Kernel : std::uint8_t {
+        Scalar = 0,
+        SHA = 1,
+        Lanes8 = 8,
+        Lanes16 = 16,
+    };
+
+    static auto ActiveKernel() noexcept -> Kernel;
+    /// Hashes each pair of adjacent digests. The last digest of a row with an
+    /// odd number of digests is paired with itself.
+    ///
+    /// out must have room for (count + 1) / 2 digests.
+    static auto HashRow(
+        const Digest* in,
+        const std::size_t count,
+        Digest* out,
+        const Kernel kernel = ActiveKernel()) noexcept -> void;
+    static auto HashRow(
+        const api::Core& api,
+        const Digest* in,
+        const std::size_t count,
+        Digest* out,
+        const Kernel kernel = ActiveKernel()) noexcept -> void;
+    static auto Pair(const Digest& lhs, const Digest& rhs) noexcept -> Digest;
+    /// Calculates the root of a BIP-37 partial merkle tree and appends the
+    /// transactions flagged as matches to the matches argument
+    ///
+    /// Throws std::runtime_error if the tree is malformed
+    static auto PartialRoot(
+        const std::size_t transactions,
+        const std::vector<Digest>& hashes,
+        const std::vector<std::byte>& flags,
+        std::vector<Digest>& matches) noexcept(false) -> Digest;
+    /// An empty tree has an all zero root
+    static auto Root(std::vector<Digest>&& leaves) noexcept -> Digest;
+    static auto Root(
+        const api::Core& api,
+        std::vector<Digest>&& leaves) noexcept -> Digest;
+    static auto Supported(const Kernel kernel) noexcept -> bool;
+
+private:
+    Merkle() = delete;
+};
+}  // namespace opentxs::blockchain
@@ -7,10 +7,8 @@
 #include "1_Internal.hpp"              // IWYU pragma: associated
 #include "blockchain/NumericHash.hpp"  // IWYU pragma: associated
 
-#include <boost/endian/buffers.hpp>
 #include <algorithm>
 #include <cstdint>
-#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -26,8 +24,6 @@
 
 #define OT_METHOD "opentxs::blockchain::implementation::NumericHash::"
 
-namespace be = boost::endian;
-
 namespace opentxs::factory
 {
 using ReturnType = blockchain::implementation::NumericHash;
@@ -35,48 +31,24 @@ using ReturnType = blockchain::implementation::NumericHash;
 auto NumericHashNBits(const std::uint32_t input) noexcept
     -> std::unique_ptr<blockchain::NumericHash>
 {
-    using ArgumentType = ReturnType::Type;
-    using MantissaType = mp::checked_cpp_int;
-
-    const auto mantissa = std::uint32_t{input & 0x007fffff};
-    const auto exponent = static_cast<std::uint8_t>((input & 0xff000000) >> 24);
-    auto target = ArgumentType{};
-
-    try {
-        if (exponent > 3) {
-            target = MantissaType{mantissa} << (8 * (exponent - 3));
-        } else {
-            target = MantissaType{mantissa} << (8 * (3 - exponent));
-        }
-    } catch (...) {
-        LogOutput("opentxs::factory::")(__FUNCTION__)(
-            ": Failed to calculate target")
-            .Flush();
-
-        return std::make_unique<ReturnType>();
-    }
-
-    return std::make_unique<ReturnType>(target);
+    return std::make_unique<ReturnType>(ReturnType::Type::FromCompact(input));
 }
 
 auto NumericHash(const blockchain::block::Hash& hash) noexcept
     -> std::unique_ptr<blockchain::NumericHash>
 {
-    ReturnType::Type value{};
-
     if (hash.empty()) { return std::make_unique<ReturnType>(); }
 
     try {
         // Interpret hash as little endian
-        mp::import_bits(value, hash.begin(), hash.end(), 8, false);
+        return std::make_unique<ReturnType>(
+            ReturnType::Type::FromLittleEndian(hash.Bytes()));
     } catch (...) {
         LogOutput("opentxs::factory::")(__FUNCTION__)(": Failed to decode hash")
             .Flush();
 
         return std::make_unique<ReturnType>();
     }
-
-    return std::make_unique<ReturnType>(value);
 }
 }  // namespace opentxs::factory
 
@@ -178,19 +150,16 @@ auto NumericHash::operator<=(const blockchain::NumericHash& rhs) const noexcept
 auto NumericHash::asHex(const std::size_t minimumBytes) const noexcept
     -> std::string
 {
-    std::vector<unsigned char> bytes;
-
-    try {
-        // Export as big endian
-        mp::export_bits(data_, std::back_inserter(bytes), 8, true);
-    } catch (...) {
-        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to encode number").Flush();
+    // Export as big endian
+    const auto bytes = data_.BigEndian();
+    const auto first = std::find_if(
+        bytes.begin(), bytes.end(), [](const auto byte) { return 0 != byte; });
+    auto output = std::vector<unsigned char>{first, bytes.end()};
 
-        return {};
-    }
+    if (output.empty()) { output.emplace_back(0x0); }
 
-    while (minimumBytes > bytes.size()) { bytes.insert(bytes.begin(), 0x0); }
+    while (minimumBytes > output.size()) { output.insert(output.begin(), 0x0); }
 
-    return opentxs::Data::Factory(bytes.data(), bytes.size())->asHex();
+    return opentxs::Data::Factory(output.data(), output.size())->asHex();
 }
 }  // namespace opentxs::blockchain::implementation
@@ -8,20 +8,18 @@
 
 #pragma once
 
-#include <boost/multiprecision/cpp_int.hpp>
 #include <iosfwd>
 #include <string>
 
+#include "blockchain/UInt256.hpp"
 #include "opentxs/blockchain/NumericHash.hpp"
 
-namespace mp = boost::multiprecision;
-
 namespace opentxs::blockchain::implementation
 {
 class NumericHash final : public blockchain::NumericHash
 {
 public:
-    using Type = mp::checked_cpp_int;
+    using Type = UInt256;
 
     auto operator==(const blockchain::NumericHash& rhs) const noexcept
         -> bool final;
@@ -34,7 +32,11 @@ public:
 
     auto asHex(const std::size_t minimumBytes) const noexcept
         -> std::string final;
-    auto Decimal() const noexcept -> std::string final { return data_.str(); }
+    auto Decimal() const noexcept -> std::string final
+    {
+        return data_.Decimal();
+    }
+    auto Value() const noexcept -> const Type& { return data_; }
 
     NumericHash(const Type& data) noexcept;
     NumericHash() noexcept;
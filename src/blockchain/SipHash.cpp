@@ -0,0 +1,316 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"            // IWYU pragma: associated
+#include "1_Internal.hpp"          // IWYU pragma: associated
+#include "blockchain/SipHash.hpp"  // IWYU pragma: associated
+
+#include <boost/endian/conversion.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                               \
+    (defined(__x86_64__) || defined(__i386__))
+#define OT_SIPHASH_X86 1
+#else
+#define OT_SIPHASH_X86 0
+#endif
+
+#if OT_SIPHASH_X86
+#define OT_SIPHASH_INLINE inline __attribute__((always_inline))
+#else
+#define OT_SIPHASH_INLINE inline
+#endif
+
+namespace be = boost::endian;
+
+namespace opentxs::gcs
+{
+namespace
+{
+constexpr auto c0_ = std::uint64_t{0x736f6d6570736575};
+constexpr auto c1_ = std::uint64_t{0x646f72616e646f6d};
+constexpr auto c2_ = std::uint64_t{0x6c7967656e657261};
+constexpr auto c3_ = std::uint64_t{0x7465646279746573};
+
+OT_SIPHASH_INLINE auto load(const char* in) noexcept -> std::uint64_t
+{
+    auto out = std::uint64_t{};
+    std::memcpy(&out, in, sizeof(out));
+
+    return be::little_to_native(out);
+}
+
+// Number of 64 bit compression rounds required for an item, including the
+// final length-tagged block
+OT_SIPHASH_INLINE auto blocks(const ReadView item) noexcept -> std::size_t
+{
+    return (item.size() / 8u) + 1u;
+}
+
+OT_SIPHASH_INLINE auto word(const ReadView item, const std::size_t block)
+    -> std::uint64_t
+{
+    const auto full = item.size() / 8u;
+
+    if (block < full) { return load(item.data() + (8u * block)); }
+
+    auto out = std::uint64_t{item.size()} << 56u;
+    const auto* tail = reinterpret_cast<const std::uint8_t*>(item.data()) +
+                       (8u * full);
+
+    for (auto i = std::size_t{0}; i < (item.size() % 8u); ++i) {
+        out |= std::uint64_t{tail[i]} << (8u * i);
+    }
+
+    return out;
+}
+
+// Word may be std::uint64_t or a gcc/clang vector of std::uint64_t, in which
+// case every operation below is applied to each lane independently
+template <typename Word>
+OT_SIPHASH_INLINE auto sipround(Word& v0, Word& v1, Word& v2, Word& v3) noexcept
+    -> void
+{
+    v0 += v1;
+    v1 = (v1 << 13) | (v1 >> 51);
+    v1 ^= v0;
+    v0 = (v0 << 32) | (v0 >> 32);
+    v2 += v3;
+    v3 = (v3 << 16) | (v3 >> 48);
+    v3 ^= v2;
+    v0 += v3;
+    v3 = (v3 << 21) | (v3 >> 43);
+    v3 ^= v0;
+    v2 += v1;
+    v1 = (v1 << 17) | (v1 >> 47);
+    v1 ^= v2;
+    v2 = (v2 << 32) | (v2 >> 32);
+}
+
+OT_SIPHASH_INLINE auto hash_scalar(
+    const std::uint64_t k0,
+    const std::uint64_t k1,
+    const ReadView item) noexcept -> std::uint64_t
+{
+    auto v0 = std::uint64_t{k0 ^ c0_};
+    auto v1 = std::uint64_t{k1 ^ c1_};
+    auto v2 = std::uint64_t{k0 ^ c2_};
+    auto v3 = std::uint64_t{k1 ^ c3_};
+    const auto count = blocks(item);
+
+    for (auto b = std::size_t{0}; b < count; ++b) {
+        const auto m = word(item, b);
+        v3 ^= m;
+        sipround(v0, v1, v2, v3);
+        sipround(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    v2 ^= 0xff;
+    sipround(v0, v1, v2, v3);
+    sipround(v0, v1, v2, v3);
+    sipround(v0, v1, v2, v3);
+    sipround(v0, v1, v2, v3);
+
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+#if OT_SIPHASH_X86
+template <std::size_t Lanes>
+struct Vector {
+    typedef std::uint64_t Type
+        __attribute__((vector_size(Lanes * sizeof(std::uint64_t))));
+};
+
+// Hash Lanes items which all require the same number of blocks
+template <std::size_t Lanes>
+OT_SIPHASH_INLINE auto hash_lanes(
+    const std::uint64_t k0,
+    const std::uint64_t k1,
+    const ReadView* items,
+    const std::size_t count,
+    std::uint64_t* out) noexcept -> void
+{
+    using Word = typename Vector<Lanes>::Type;
+
+    auto v0 = Word{} + (k0 ^ c0_);
+    auto v1 = Word{} + (k1 ^ c1_);
+    auto v2 = Word{} + (k0 ^ c2_);
+    auto v3 = Word{} + (k1 ^ c3_);
+    auto m = Word{};
+
+    for (auto b = std::size_t{0}; b < count; ++b) {
+        for (auto l = std::size_t{0}; l < Lanes; ++l) {
+            m[l] = word(items[l], b);
+        }
+
+        v3 ^= m;
+        sipround(v0, v1, v2, v3);
+        sipround(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    v2 ^= 0xff;
+    sipround(v0, v1, v2, v3);
+    sipround(v0, v1, v2, v3);
+    sipround(v0, v1, v2, v3);
+    sipround(v0, v1, v2, v3);
+    v0 ^= v1 ^ v2 ^ v3;
+
+    for (auto l = std::size_t{0}; l < Lanes; ++l) { out[l] = v0[l]; }
+}
+#endif  // OT_SIPHASH_X86
+
+// Items are visited in order of block count so that each group of Lanes
+// items can share one pass through the vector kernel. Leftovers which do not
+// fill a group are hashed by the scalar kernel.
+template <std::size_t Lanes>
+OT_SIPHASH_INLINE auto hash_batch(
+    const std::uint64_t k0,
+    const std::uint64_t k1,
+    const std::vector<ReadView>& items,
+    std::uint64_t* out) noexcept -> void
+{
+#if OT_SIPHASH_X86
+    if constexpr (1u < Lanes) {
+        auto index = std::vector<std::size_t>(items.size());
+        std::iota(index.begin(), index.end(), std::size_t{0});
+        std::sort(index.begin(), index.end(), [&](auto lhs, auto rhs) {
+            return blocks(items[lhs]) < blocks(items[rhs]);
+        });
+        auto group = std::array<ReadView, Lanes>{};
+        auto hashes = std::array<std::uint64_t, Lanes>{};
+        auto i = std::size_t{0};
+
+        while (i < index.size()) {
+            const auto count = blocks(items[index[i]]);
+            auto end = i;
+
+            while ((end < index.size()) &&
+                   (count == blocks(items[index[end]]))) {
+                ++end;
+            }
+
+            for (; (i + Lanes) <= end; i += Lanes) {
+                for (auto l = std::size_t{0}; l < Lanes; ++l) {
+                    group[l] = items[index[i + l]];
+                }
+
+                hash_lanes<Lanes>(k0, k1, group.data(), count, hashes.data());
+
+                for (auto l = std::size_t{0}; l < Lanes; ++l) {
+                    out[index[i + l]] = hashes[l];
+                }
+            }
+
+            for (; i < end; ++i) {
+                out[index[i]] = hash_scalar(k0, k1, items[index[i]]);
+            }
+        }
+
+        return;
+    }
+#endif  // OT_SIPHASH_X86
+
+    for (auto i = std::size_t{0}; i < items.size(); ++i) {
+        out[i] = hash_scalar(k0, k1, items[i]);
+    }
+}
+
+#if OT_SIPHASH_X86
+__attribute__((target("avx512f"), flatten)) auto hash_batch_8(
+    const std::uint64_t k0,
+    const std::uint64_t k1,
+    const std::vector<ReadView>& items,
+    std::uint64_t* out) noexcept -> void
+{
+    hash_batch<8>(k0, k1, items, out);
+}
+
+__attribute__((target("avx2"), flatten)) auto hash_batch_4(
+    const std::uint64_t k0,
+    const std::uint64_t k1,
+    const std::vector<ReadView>& items,
+    std::uint64_t* out) noexcept -> void
+{
+    hash_batch<4>(k0, k1, items, out);
+}
+#endif  // OT_SIPHASH_X86
+}  // namespace
+
+SipHash::SipHash(const ReadView key) noexcept(false)
+    : k0_()
+    , k1_()
+{
+    if (16u != key.size()) {
+        throw std::runtime_error(
+            "Invalid key size: " + std::to_string(key.size()));
+    }
+
+    k0_ = load(key.data());
+    k1_ = load(key.data() + 8u);
+}
+
+auto SipHash::ActiveKernel() noexcept -> Kernel
+{
+    static const auto kernel = [] {
+#if OT_SIPHASH_X86
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx512f")) { return Kernel::Lanes8; }
+
+        if (__builtin_cpu_supports("avx2")) { return Kernel::Lanes4; }
+#endif  // OT_SIPHASH_X86
+
+        return Kernel::Scalar;
+    }();
+
+    return kernel;
+}
+
+auto SipHash::operator()(const ReadView item) const noexcept -> std::uint64_t
+{
+    return hash_scalar(k0_, k1_, item);
+}
+
+auto SipHash::Hash(const std::vector<ReadView>& items) const noexcept
+    -> std::vector<std::uint64_t>
+{
+    auto output = std::vector<std::uint64_t>(items.size());
+
+    switch (ActiveKernel()) {
+#if OT_SIPHASH_X86
+        case Kernel::Lanes8: {
+            hash_batch_8(k0_, k1_, items, output.data());
+        } break;
+        case Kernel::Lanes4: {
+            hash_batch_4(k0_, k1_, items, output.data());
+        } break;
+#endif  // OT_SIPHASH_X86
+        case Kernel::Scalar:
+        default: {
+            hash_batch<1>(k0_, k1_, items, output.data());
+        }
+    }
+
+    return output;
+}
+
+auto SipHash::HashToRange(
+    const std::vector<ReadView>& items,
+    const std::uint64_t range) const noexcept -> std::vector<std::uint64_t>
+{
+    auto output = Hash(items);
+
+    for (auto& hash : output) { hash = FastRange(hash, range); }
+
+    return output;
+}
+}  // namespace opentxs::gcs
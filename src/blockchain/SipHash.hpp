@@ -0,0 +1,84 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// IWYU pragma: private
+// IWYU pragma: friend ".*src/blockchain/SipHash.cpp"
+// IWYU pragma: friend ".*src/blockchain/GCS.cpp"
+// IWYU pragma: friend ".*src/blockchain/p2p/bitcoin/CompactBlock.cpp"
+// IWYU pragma: friend ".*tests/blockchain/Test_CompactBlock.cpp"
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "opentxs/Bytes.hpp"
+
+namespace opentxs::gcs
+{
+// Native SipHash-2-4 engine used for BIP-158 filter hashing and BIP-152 short
+// transaction ids
+//
+// The key is expanded once so that an entire target set can be hashed without
+// dispatching through api::crypto::Hash for every element. Batches are hashed
+// four or eight elements at a time when the cpu supports AVX2 or AVX-512.
+class SipHash
+{
+public:
+    enum class Kernel : std::uint8_t {
+        Scalar = 0,
+        Lanes4 = 4,
+        Lanes8 = 8,
+    };
+
+    static auto ActiveKernel() noexcept -> Kernel;
+
+    auto operator()(const ReadView item) const noexcept -> std::uint64_t;
+
+    auto Hash(const std::vector<ReadView>& items) const noexcept
+        -> std::vector<std::uint64_t>;
+    auto HashToRange(const std::vector<ReadView>& items, std::uint64_t range)
+        const noexcept -> std::vector<std::uint64_t>;
+
+    SipHash(const ReadView key) noexcept(false);
+    SipHash(const SipHash&) noexcept = default;
+
+    ~SipHash() = default;
+
+private:
+    std::uint64_t k0_;
+    std::uint64_t k1_;
+
+    SipHash() = delete;
+    SipHash(SipHash&&) = delete;
+    auto operator=(const SipHash&) -> SipHash& = delete;
+    auto operator=(SipHash&&) -> SipHash& = delete;
+};
+
+// Maps a 64 bit hash uniformly onto [0, range) per BIP-158
+inline auto FastRange(const std::uint64_t hash, const std::uint64_t range)
+    -> std::uint64_t
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ using Wide = unsigned __int128;
+
+    return static_cast<std::uint64_t>((Wide{hash} * Wide{range}) >> 64u);
+#else
+    const auto aLo = hash & 0xffffffffu;
+    const auto aHi = hash >> 32u;
+    const auto bLo = range & 0xffffffffu;
+    const auto bHi = range >> 32u;
+    const auto lolo = aLo * bLo;
+    const auto hilo = aHi * bLo;
+    const auto lohi = aLo * bHi;
+    const auto hihi = aHi * bHi;
+    const auto cross =
+        (lolo >> 32u) + (hilo & 0xffffffffu) + (lohi & 0xffffffffu);
+
+    return hihi + (hilo >> 32u) + (lohi >> 32u) + (cross >> 32u);
+#endif
+}
+}  // namespace opentxs::gcs
@@ -0,0 +1,353 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "opentxs/Bytes.hpp"
+
+namespace opentxs::blockchain
+{
+// Fixed width unsigned 256 bit integer for targets, hashes and work
+//
+// Values are stored in four little endian 64 bit limbs so that none of the
+// operations used while validating headers allocate. Comparison and addition
+// do not branch on the values being operated on.
+class UInt256
+{
+public:
+    using Bytes = std::array<std::uint8_t, 32>;
+
+    /// Decodes a compact (nBits) target
+    ///
+    /// The sign bit is ignored. Targets which do not fit in 256 bits are
+    /// saturated to Max().
+    static constexpr auto FromCompact(const std::uint32_t nBits) noexcept
+        -> UInt256
+    {
+        const auto size = std::uint32_t{nBits >> 24};
+        auto word = std::uint64_t{nBits & 0x007fffff};
+
+        if (3 >= size) {
+            word >>= 8u * (3u - size);
+
+            return UInt256{word};
+        }
+
+        const auto overflow =
+            (0 != word) && ((34 < size) || ((0xff < word) && (33 < size)) ||
+                            ((0xffff < word) && (32 < size)));
+
+        if (overflow) { return Max(); }
+
+        return UInt256{word} << (8u * (size - 3u));
+    }
+    /// Throws std::out_of_range if the value does not fit in 256 bits
+    static auto FromBigEndian(const ReadView bytes) noexcept(false) -> UInt256
+    {
+        auto output = UInt256{};
+        const auto* it = reinterpret_cast<const std::uint8_t*>(bytes.data());
+
+        for (auto i = bytes.size(); 0 < i; --i, ++it) {
+            const auto byte = i - 1u;
+
+            if (byte >= 32u) {
+                if (0 != *it) { throw std::out_of_range("Value too large"); }
+
+                continue;
+            }
+
+            output.limbs_[byte / 8u] |= std::uint64_t{*it}
+                                        << (8u * (byte % 8u));
+        }
+
+        return output;
+    }
+    /// Throws std::out_of_range if the value does not fit in 256 bits
+    static auto FromLittleEndian(const ReadView bytes) noexcept(false)
+        -> UInt256
+    {
+        auto output = UInt256{};
+        const auto* it = reinterpret_cast<const std::uint8_t*>(bytes.data());
+
+        for (auto byte = std::size_t{0}; byte < bytes.size(); ++byte, ++it) {
+            if (byte >= 32u) {
+                if (0 != *it) { throw std::out_of_range("Value too large"); }
+
+                continue;
+            }
+
+            output.limbs_[byte / 8u] |= std::uint64_t{*it}
+                                        << (8u * (byte % 8u));
+        }
+
+        return output;
+    }
+    static constexpr auto Max() noexcept -> UInt256
+    {
+        auto output = UInt256{};
+
+        for (auto& limb : output.limbs_) { limb = ~std::uint64_t{0}; }
+
+        return output;
+    }
+
+    constexpr auto operator==(const UInt256& rhs) const noexcept -> bool
+    {
+        auto diff = std::uint64_t{0};
+
+        for (auto i = std::size_t{0}; i < limbs_.size(); ++i) {
+            diff |= limbs_[i] ^ rhs.limbs_[i];
+        }
+
+        return 0 == diff;
+    }
+    constexpr auto operator!=(const UInt256& rhs) const noexcept -> bool
+    {
+        return false == (*this == rhs);
+    }
+    constexpr auto operator<(const UInt256& rhs) const noexcept -> bool
+    {
+        // lhs < rhs if and only if lhs - rhs borrows out of the top limb
+        auto borrow = std::uint64_t{0};
+
+        for (auto i = std::size_t{0}; i < limbs_.size(); ++i) {
+            const auto& l = limbs_[i];
+            const auto& r = rhs.limbs_[i];
+            const auto diff = l - r;
+            borrow = static_cast<std::uint64_t>(l < r) |
+                     static_cast<std::uint64_t>(diff < borrow);
+        }
+
+        return 0 != borrow;
+    }
+    constexpr auto operator<=(const UInt256& rhs) const noexcept -> bool
+    {
+        return false == (rhs < *this);
+    }
+    constexpr auto operator>(const UInt256& rhs) const noexcept -> bool
+    {
+        return rhs < *this;
+    }
+    constexpr auto operator>=(const UInt256& rhs) const noexcept -> bool
+    {
+        return false == (*this < rhs);
+    }
+    /// Saturates to Max() instead of wrapping
+    constexpr auto operator+(const UInt256& rhs) const noexcept -> UInt256
+    {
+        auto output = UInt256{};
+        auto carry = std::uint64_t{0};
+
+        for (auto i = std::size_t{0}; i < limbs_.size(); ++i) {
+            const auto sum = limbs_[i] + rhs.limbs_[i];
+            const auto out = sum + carry;
+            carry = static_cast<std::uint64_t>(sum < limbs_[i]) |
+                    static_cast<std::uint64_t>(out < sum);
+            output.limbs_[i] = out;
+        }
+
+        const auto mask = std::uint64_t{0} - carry;
+
+        for (auto& limb : output.limbs_) { limb |= mask; }
+
+        return output;
+    }
+    constexpr auto operator-(const UInt256& rhs) const noexcept -> UInt256
+    {
+        auto output = UInt256{};
+        auto borrow = std::uint64_t{0};
+
+        for (auto i = std::size_t{0}; i < limbs_.size(); ++i) {
+            const auto& l = limbs_[i];
+            const auto diff = l - rhs.limbs_[i];
+            output.limbs_[i] = diff - borrow;
+            borrow = static_cast<std::uint64_t>(l < rhs.limbs_[i]) |
+                     static_cast<std::uint64_t>(diff < borrow);
+        }
+
+        return output;
+    }
+    /// Division by zero returns Max()
+    constexpr auto operator/(const UInt256& rhs) const noexcept -> UInt256
+    {
+        if (rhs.IsZero()) { return Max(); }
+
+        if (*this < rhs) { return UInt256{}; }
+
+        // Only the bits of the quotient which can be set are visited
+        const auto shift = Bits() - rhs.Bits();
+        auto remainder = *this;
+        auto divisor = rhs << shift;
+        auto output = UInt256{};
+
+        for (auto bit = shift + 1u; 0u < bit; --bit) {
+            if (divisor <= remainder) {
+                remainder = remainder - divisor;
+                output.set_bit(bit - 1u);
+            }
+
+            divisor = divisor >> 1u;
+        }
+
+        return output;
+    }
+    constexpr auto operator<<(const unsigned int bits) const noexcept
+        -> UInt256
+    {
+        auto output = UInt256{};
+
+        if (256u <= bits) { return output; }
+
+        const auto limbs = bits / 64u;
+        const auto offset = bits % 64u;
+
+        for (auto i = limbs; i < limbs_.size(); ++i) {
+            output.limbs_[i] = limbs_[i - limbs] << offset;
+
+            if ((0u < offset) && (i > limbs)) {
+                output.limbs_[i] |= limbs_[i - limbs - 1u] >> (64u - offset);
+            }
+        }
+
+        return output;
+    }
+    constexpr auto operator>>(const unsigned int bits) const noexcept
+        -> UInt256
+    {
+        auto output = UInt256{};
+
+        if (256u <= bits) { return output; }
+
+        const auto limbs = bits / 64u;
+        const auto offset = bits % 64u;
+
+        for (auto i = std::size_t{0}; (i + limbs) < limbs_.size(); ++i) {
+            output.limbs_[i] = limbs_[i + limbs] >> offset;
+
+            if ((0u < offset) && ((i + limbs + 1u) < limbs_.size())) {
+                output.limbs_[i] |= limbs_[i + limbs + 1u] << (64u - offset);
+            }
+        }
+
+        return output;
+    }
+
+    /// Serializes the value as 32 big endian bytes
+    constexpr auto BigEndian() const noexcept -> Bytes
+    {
+        auto output = Bytes{};
+
+        for (auto byte = std::size_t{0}; byte < output.size(); ++byte) {
+            output[output.size() - 1u - byte] = static_cast<std::uint8_t>(
+                limbs_[byte / 8u] >> (8u * (byte % 8u)));
+        }
+
+        return output;
+    }
+    /// Returns the number of significant bits
+    constexpr auto Bits() const noexcept -> unsigned int
+    {
+        for (auto i = limbs_.size(); 0u < i; --i) {
+            auto limb = limbs_[i - 1u];
+
+            if (0 == limb) { continue; }
+
+            auto output = static_cast<unsigned int>(64u * (i - 1u) + 1u);
+
+            for (auto step = 32u; 0u < step; step /= 2u) {
+                if (0 != (limb >> step)) {
+                    output += step;
+                    limb >>= step;
+                }
+            }
+
+            return output;
+        }
+
+        return 0;
+    }
+    auto Decimal() const noexcept -> std::string
+    {
+        constexpr auto chunk = std::uint32_t{1000000000};
+        constexpr auto chunkDigits = std::size_t{9};
+        auto words = words32();
+        auto output = std::string{};
+
+        do {
+            // Long division of the 32 bit words by 10^9
+            auto remainder = std::uint64_t{0};
+
+            for (auto i = words.size(); 0u < i; --i) {
+                auto& word = words[i - 1u];
+                const auto value = (remainder << 32u) | word;
+                word = static_cast<std::uint32_t>(value / chunk);
+                remainder = value % chunk;
+            }
+
+            const auto empty = std::all_of(
+                words.begin(), words.end(), [](auto w) { return 0 == w; });
+
+            for (auto i = std::size_t{0}; i < chunkDigits; ++i) {
+                if (empty && (0 == remainder) && (false == output.empty())) {
+                    break;
+                }
+
+                output.push_back(static_cast<char>('0' + (remainder % 10u)));
+                remainder /= 10u;
+            }
+
+            if (empty) { break; }
+        } while (true);
+
+        std::reverse(output.begin(), output.end());
+
+        return output;
+    }
+    constexpr auto IsZero() const noexcept -> bool
+    {
+        return *this == UInt256{};
+    }
+
+    constexpr UInt256(const std::uint64_t value) noexcept
+        : limbs_{value, 0, 0, 0}
+    {
+    }
+    constexpr UInt256() noexcept
+        : UInt256(0)
+    {
+    }
+    constexpr UInt256(const UInt256&) noexcept = default;
+
+    constexpr auto operator=(const UInt256&) noexcept -> UInt256& = default;
+
+    ~UInt256() = default;
+
+private:
+    std::array<std::uint64_t, 4> limbs_;
+
+    constexpr auto set_bit(const unsigned int bit) noexcept -> void
+    {
+        limbs_[bit / 64u] |= std::uint64_t{1} << (bit % 64u);
+    }
+    constexpr auto words32() const noexcept -> std::array<std::uint32_t, 8>
+    {
+        auto output = std::array<std::uint32_t, 8>{};
+
+        for (auto i = std::size_t{0}; i < output.size(); ++i) {
+            output[i] =
+                static_cast<std::uint32_t>(limbs_[i / 2u] >> (32u * (i % 2u)));
+        }
+
+        return output;
+    }
+};
+}  // namespace opentxs::blockchain
@@ -7,12 +7,12 @@
 #include "1_Internal.hpp"       // IWYU pragma: associated
 #include "blockchain/Work.hpp"  // IWYU pragma: associated
 
-#include <boost/exception/exception.hpp>
-#include <iterator>
+#include <algorithm>
+#include <cstdint>
 #include <memory>
-#include <utility>
 #include <vector>
 
+#include "blockchain/NumericHash.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/blockchain/BlockchainType.hpp"
@@ -26,56 +26,69 @@
 
 namespace opentxs::factory
 {
+namespace
+{
+auto difficulty(
+    const blockchain::Type chain,
+    const blockchain::UInt256& target) noexcept -> blockchain::UInt256
+{
+    using ValueType = blockchain::UInt256;
+
+    const auto max = ValueType::FromCompact(
+        static_cast<std::uint32_t>(blockchain::NumericHash::MaxTarget(chain)));
+
+    if (target > max) { return ValueType{1}; }
+
+    return max / target;
+}
+}  // namespace
+
 auto Work(const std::string& hex) -> blockchain::Work*
 {
     using ReturnType = blockchain::implementation::Work;
-    using ValueType = ReturnType::Type;
 
     const auto bytes = Data::Factory(hex, Data::Mode::Hex);
 
     if (bytes->empty()) { return new ReturnType(); }
 
-    ValueType value{};
-    mp::cpp_int i;
-
     try {
         // Interpret bytes as big endian
-        mp::import_bits(i, bytes->begin(), bytes->end(), 8, true);
-        value = ValueType{i};
+        return new ReturnType(ReturnType::Type::FromBigEndian(bytes->Bytes()));
     } catch (...) {
         LogOutput("opentxs::factory::")(__FUNCTION__)(": Failed to decode work")
             .Flush();
 
         return new ReturnType();
     }
-
-    return new ReturnType(std::move(value));
 }
 
 auto Work(const blockchain::Type chain, const blockchain::NumericHash& input)
     -> blockchain::Work*
 {
     using ReturnType = blockchain::implementation::Work;
-    using TargetType = mp::checked_cpp_int;
-    using ValueType = ReturnType::Type;
+    using InputType = blockchain::implementation::NumericHash;
 
-    auto value = ValueType{};
+    const auto& target = dynamic_cast<const InputType&>(input).Value();
 
-    try {
-        const auto maxTarget = factory::NumericHashNBits(
-            blockchain::NumericHash::MaxTarget(chain));
+    if (target.IsZero()) {
+        LogOutput("opentxs::factory::")(__FUNCTION__)(
+            ": Failed to calculate difficulty")
+            .Flush();
 
-        OT_ASSERT(maxTarget);
+        return new ReturnType();
+    }
 
-        const auto max = TargetType{maxTarget->Decimal()};
-        const auto incoming = TargetType{input.Decimal()};
+    return new ReturnType(difficulty(chain, target));
+}
 
-        if (incoming > max) {
-            value = ValueType{1};
-        } else {
-            value = ValueType{max} / ValueType{incoming};
-        }
-    } catch (...) {
+auto Work(const blockchain::Type chain, const std::uint32_t nBits)
+    -> blockchain::Work*
+{
+    using ReturnType = blockchain::implementation::Work;
+
+    const auto target = ReturnType::Type::FromCompact(nBits);
+
+    if (target.IsZero()) {
         LogOutput("opentxs::factory::")(__FUNCTION__)(
             ": Failed to calculate difficulty")
             .Flush();
@@ -83,7 +96,7 @@ auto Work(const blockchain::Type chain, const blockchain::NumericHash& input)
         return new ReturnType();
     }
 
-    return new ReturnType(std::move(value));
+    return new ReturnType(difficulty(chain, target));
 }
 }  // namespace opentxs::factory
 
@@ -128,9 +141,9 @@ auto operator+(const OTWork& lhs, const blockchain::Work& rhs) noexcept
 
 namespace opentxs::blockchain::implementation
 {
-Work::Work(Type&& data) noexcept
+Work::Work(const Type& data) noexcept
     : blockchain::Work()
-    , data_(std::move(data))
+    , data_(data)
 {
 }
 
@@ -140,7 +153,7 @@ Work::Work() noexcept
 }
 
 Work::Work(const Work& rhs) noexcept
-    : Work(Type{rhs.data_})
+    : Work(rhs.data_)
 {
 }
 
@@ -195,17 +208,14 @@ auto Work::operator+(const blockchain::Work& rhs) const noexcept -> OTWork
 
 auto Work::asHex() const noexcept -> std::string
 {
-    std::vector<unsigned char> bytes;
-
-    try {
-        // Export as big endian
-        mp::export_bits(mp::cpp_int(data_), std::back_inserter(bytes), 8, true);
-    } catch (...) {
-        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to encode number").Flush();
+    // Export as big endian
+    const auto bytes = data_.BigEndian();
+    const auto first = std::find_if(
+        bytes.begin(), bytes.end(), [](const auto byte) { return 0 != byte; });
+    auto output = std::vector<unsigned char>{first, bytes.end()};
 
-        return {};
-    }
+    if (output.empty()) { output.emplace_back(0x0); }
 
-    return opentxs::Data::Factory(bytes.data(), bytes.size())->asHex();
+    return opentxs::Data::Factory(output.data(), output.size())->asHex();
 }
 }  // namespace opentxs::blockchain::implementation
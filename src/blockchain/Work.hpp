@@ -8,10 +8,9 @@
 
 #pragma once
 
-#include <boost/multiprecision/cpp_bin_float.hpp>
-#include <boost/multiprecision/cpp_int.hpp>
 #include <string>
 
+#include "blockchain/UInt256.hpp"
 #include "opentxs/blockchain/Work.hpp"
 
 namespace opentxs
@@ -19,14 +18,12 @@ namespace opentxs
 class Factory;
 }  // namespace opentxs
 
-namespace mp = boost::multiprecision;
-
 namespace opentxs::blockchain::implementation
 {
 class Work final : public blockchain::Work
 {
 public:
-    using Type = mp::cpp_bin_float_double;
+    using Type = UInt256;
 
     auto operator==(const blockchain::Work& rhs) const noexcept -> bool final;
     auto operator!=(const blockchain::Work& rhs) const noexcept -> bool final;
@@ -37,9 +34,12 @@ public:
     auto operator+(const blockchain::Work& rhs) const noexcept -> OTWork final;
 
     auto asHex() const noexcept -> std::string final;
-    auto Decimal() const noexcept -> std::string final { return data_.str(); }
+    auto Decimal() const noexcept -> std::string final
+    {
+        return data_.Decimal();
+    }
 
-    Work(Type&& data) noexcept;
+    Work(const Type& data) noexcept;
     Work() noexcept;
     Work(const Work& rhs) noexcept;
 
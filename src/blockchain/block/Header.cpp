@@ -194,7 +194,7 @@ auto Header::LocalState() const noexcept -> Header::Status { return status_; }
 auto Header::minimum_work(const blockchain::Type chain) -> OTWork
 {
     const auto maxTarget =
-        OTNumericHash{factory::NumericHashNBits(NumericHash::MaxTarget(chain))};
+        static_cast<std::uint32_t>(NumericHash::MaxTarget(chain));
 
     return OTWork{factory::Work(chain, maxTarget)};
 }
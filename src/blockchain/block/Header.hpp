@@ -91,7 +91,8 @@ protected:
     Header(const Header& rhs) noexcept;
 
 private:
-    static const VersionNumber local_data_version_{1};
+    // Version 2 stores work as an integer difficulty
+    static const VersionNumber local_data_version_{2};
 
     const VersionNumber version_;
     const OTWork work_;
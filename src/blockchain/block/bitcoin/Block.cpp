@@ -25,6 +25,7 @@
 #include <type_traits>
 #include <vector>
 
+#include "blockchain/Merkle.hpp"
 #include "blockchain/block/Block.hpp"
 #include "blockchain/block/bitcoin/BlockParser.hpp"
 #include "internal/blockchain/block/Block.hpp"
@@ -371,94 +372,28 @@ auto Block::at(const ReadView txid) const noexcept -> const value_type&
     }
 }
 
-template <typename HashType>
-auto Block::calculate_merkle_hash(
-    const api::Core& api,
-    const Type chain,
-    const HashType& lhs,
-    const HashType& rhs,
-    AllocateOutput out) -> bool
-{
-    auto preimage = std::array<std::byte, 64>{};
-    constexpr auto chunk = preimage.size() / 2u;
-
-    if (chunk != lhs.size()) {
-        throw std::runtime_error("Invalid lhs hash size");
-    }
-    if (chunk != rhs.size()) {
-        throw std::runtime_error("Invalid rhs hash size");
-    }
-
-    auto it = preimage.data();
-    std::memcpy(it, lhs.data(), chunk);
-    std::advance(it, chunk);
-    std::memcpy(it, rhs.data(), chunk);
-
-    return MerkleHash(
-        api,
-        chain,
-        {reinterpret_cast<const char*>(preimage.data()), preimage.size()},
-        out);
-}
-
-template <typename InputContainer, typename OutputContainer>
-auto Block::calculate_merkle_row(
-    const api::Core& api,
-    const Type chain,
-    const InputContainer& in,
-    OutputContainer& out) -> bool
-{
-    out.clear();
-    const auto count{in.size()};
-
-    for (auto i = std::size_t{0}; i < count; i += 2u) {
-        const auto offset = std::size_t{(1u == (count - i)) ? 0u : 1u};
-        auto& next = out.emplace_back();
-        const auto hashed = calculate_merkle_hash(
-            api,
-            chain,
-            in.at(i),
-            in.at(i + offset),
-            preallocated(next.size(), next.data()));
-
-        if (false == hashed) { return false; }
-    }
-
-    return true;
-}
-
 auto Block::calculate_merkle_value(
     const api::Core& api,
-    const Type chain,
+    [[maybe_unused]] const Type chain,
     const TxidIndex& txids) -> block::pHash
 {
-    using Hash = std::array<std::byte, 32>;
+    // Every supported chain uses SHA256D for the transaction merkle tree
+    auto leaves = std::vector<Merkle::Digest>(txids.size());
 
-    if (0 == txids.size()) {
-        constexpr auto blank = Hash{};
+    for (auto i = std::size_t{0}; i < txids.size(); ++i) {
+        const auto& txid = txids[i];
+        auto& leaf = leaves[i];
 
-        return api.Factory().Data(ReadView{
-            reinterpret_cast<const char*>(blank.data()), blank.size()});
-    }
-
-    if (1 == txids.size()) { return api.Factory().Data(txids.at(0)); }
-
-    auto a = std::vector<Hash>{};
-    auto b = std::vector<Hash>{};
-    a.reserve(txids.size());
-    b.reserve(txids.size());
-    auto counter{0};
-    calculate_merkle_row(api, chain, txids, a);
+        if (leaf.size() != txid.size()) {
+            throw std::runtime_error("Invalid txid size");
+        }
 
-    if (1u == a.size()) { return api.Factory().Data(reader(a.at(0))); }
+        std::memcpy(leaf.data(), txid.data(), leaf.size());
+    }
 
-    while (true) {
-        const auto& src = (1 == (++counter % 2)) ? a : b;
-        auto& dst = (0 == (counter % 2)) ? a : b;
-        calculate_merkle_row(api, chain, src, dst);
+    const auto root = Merkle::Root(api, std::move(leaves));
 
-        if (1u == dst.size()) { return api.Factory().Data(reader(dst.at(0))); }
-    }
+    return api.Factory().Data(reader(root));
 }
 
 auto Block::calculate_size() const noexcept -> CalculatedSize
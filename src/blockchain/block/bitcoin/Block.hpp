@@ -66,19 +66,6 @@ public:
 
     static const std::size_t header_bytes_;
 
-    template <typename HashType>
-    static auto calculate_merkle_hash(
-        const api::Core& api,
-        const Type chain,
-        const HashType& lhs,
-        const HashType& rhs,
-        AllocateOutput out) -> bool;
-    template <typename InputContainer, typename OutputContainer>
-    static auto calculate_merkle_row(
-        const api::Core& api,
-        const Type chain,
-        const InputContainer& in,
-        OutputContainer& out) -> bool;
     static auto calculate_merkle_value(
         const api::Core& api,
         const Type chain,
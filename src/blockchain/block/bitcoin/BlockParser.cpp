@@ -56,15 +56,47 @@ auto parse_header(
     return pHeader;
 }
 
-auto parse_transactions(
+auto index_transactions(
     const api::Core& api,
-    const api::client::Blockchain& blockchain,
     const blockchain::Type chain,
     const ReadView in,
     const blockchain::block::bitcoin::Header& header,
+    ByteIterator& it,
+    std::size_t& expectedSize) -> IndexedTransactions
+{
+    auto sizeData = ReturnType::CalculatedSize{in.size(), bb::CompactSize{}};
+    const auto transactionCount =
+        parse_transaction_count(in, sizeData, it, expectedSize);
+    auto output = IndexedTransactions{};
+    auto& [index, offsets] = output;
+    index.reserve(transactionCount);
+    offsets.reserve(transactionCount);
+    const auto* const start = reinterpret_cast<ByteIterator>(in.data());
+
+    while (index.size() < transactionCount) {
+        const auto data = bb::EncodedTransaction::Deserialize(
+            api,
+            chain,
+            ReadView{
+                reinterpret_cast<const char*>(it), in.size() - expectedSize});
+        const auto txBytes = data.size();
+        offsets.emplace_back(
+            static_cast<std::size_t>(std::distance(start, it)), txBytes);
+        index.emplace_back(data.txid_);
+        std::advance(it, txBytes);
+        expectedSize += txBytes;
+    }
+
+    validate_merkle(api, chain, header, index);
+
+    return output;
+}
+
+auto parse_transaction_count(
+    const ReadView in,
     ReturnType::CalculatedSize& sizeData,
     ByteIterator& it,
-    std::size_t& expectedSize) -> ParsedTransactions
+    std::size_t& expectedSize) -> std::size_t
 {
     expectedSize += 1;
 
@@ -79,10 +111,25 @@ auto parse_transactions(
         throw std::runtime_error("Failed to decode transaction count");
     }
 
-    const auto transactionCount = txCount.Value();
+    const auto transactionCount = static_cast<std::size_t>(txCount.Value());
 
     if (0 == transactionCount) { throw std::runtime_error("Empty block"); }
 
+    return transactionCount;
+}
+
+auto parse_transactions(
+    const api::Core& api,
+    const api::client::Blockchain& blockchain,
+    const blockchain::Type chain,
+    const ReadView in,
+    const blockchain::block::bitcoin::Header& header,
+    ReturnType::CalculatedSize& sizeData,
+    ByteIterator& it,
+    std::size_t& expectedSize) -> ParsedTransactions
+{
+    const auto transactionCount =
+        parse_transaction_count(in, sizeData, it, expectedSize);
     auto counter = int{-1};
     auto output = ParsedTransactions{};
     auto& [index, transactions] = output;
@@ -108,12 +155,21 @@ auto parse_transactions(
                 std::move(data)));
     }
 
+    validate_merkle(api, chain, header, index);
+
+    return output;
+}
+
+auto validate_merkle(
+    const api::Core& api,
+    const blockchain::Type chain,
+    const blockchain::block::bitcoin::Header& header,
+    const ReturnType::TxidIndex& index) -> void
+{
     const auto merkle = ReturnType::calculate_merkle_value(api, chain, index);
 
     if (header.MerkleRoot() != merkle) {
         throw std::runtime_error("Invalid merkle hash");
     }
-
-    return output;
 }
 }  // namespace opentxs::factory
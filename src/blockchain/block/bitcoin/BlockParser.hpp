@@ -87,6 +87,22 @@ using ReturnType = blockchain::block::bitcoin::implementation::Block;
 using ByteIterator = const std::byte*;
 using ParsedTransactions =
     std::pair<ReturnType::TxidIndex, ReturnType::TransactionMap>;
+/// position and size of each transaction within the serialized block
+using TransactionOffsets = std::vector<std::pair<std::size_t, std::size_t>>;
+using IndexedTransactions =
+    std::pair<ReturnType::TxidIndex, TransactionOffsets>;
+/// type and contents of each PacketCrypt proof in a PKT block
+using PktProofs = std::vector<std::pair<std::byte, Space>>;
+
+/// Locates every transaction and calculates its txid without instantiating
+/// any Transaction objects. The merkle root is verified.
+auto index_transactions(
+    const api::Core& api,
+    const blockchain::Type chain,
+    const ReadView in,
+    const blockchain::block::bitcoin::Header& header,
+    ByteIterator& it,
+    std::size_t& expectedSize) -> IndexedTransactions;
 
 auto parse_header(
     const api::Core& api,
@@ -107,6 +123,17 @@ auto parse_pkt_block(
     const blockchain::Type chain,
     const ReadView in) noexcept(false)
     -> std::shared_ptr<blockchain::block::bitcoin::Block>;
+/// Reads the proofs which follow the header of a PKT block, through the
+/// terminal proof
+auto parse_pkt_proofs(
+    const ReadView in,
+    ByteIterator& it,
+    std::size_t& expectedSize) noexcept(false) -> PktProofs;
+auto parse_transaction_count(
+    const ReadView in,
+    ReturnType::CalculatedSize& sizeData,
+    ByteIterator& it,
+    std::size_t& expectedSize) -> std::size_t;
 auto parse_transactions(
     const api::Core& api,
     const api::client::Blockchain& blockchain,
@@ -116,4 +143,9 @@ auto parse_transactions(
     ReturnType::CalculatedSize& sizeData,
     ByteIterator& it,
     std::size_t& expectedSize) -> ParsedTransactions;
+auto validate_merkle(
+    const api::Core& api,
+    const blockchain::Type chain,
+    const blockchain::block::bitcoin::Header& header,
+    const ReturnType::TxidIndex& index) -> void;
 }  // namespace opentxs::factory
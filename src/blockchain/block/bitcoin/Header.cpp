@@ -8,6 +8,7 @@
 #include "blockchain/block/bitcoin/Header.hpp"  // IWYU pragma: associated
 
 #include <boost/endian/buffers.hpp>
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <ctime>
@@ -16,6 +17,7 @@
 #include <string_view>
 #include <utility>
 
+#include "blockchain/UInt256.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 #include "internal/blockchain/block/Block.hpp"
 #include "internal/blockchain/block/bitcoin/Bitcoin.hpp"
@@ -185,6 +187,21 @@ auto BitcoinBlockHeader(
     }
 }
 
+auto BitcoinBlockHeader(
+    const api::Core& api,
+    const blockchain::Type chain,
+    const blockchain::block::bitcoin::internal::HeaderRecord& record) noexcept
+    -> std::unique_ptr<blockchain::block::bitcoin::internal::Header>
+{
+    try {
+        return std::make_unique<ReturnType>(api, chain, record);
+    } catch (const std::exception& e) {
+        LogOutput("opentxs::factory::")(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return {};
+    }
+}
+
 auto BitcoinBlockHeader(
     const api::Core& api,
     const blockchain::Type chain,
@@ -207,6 +224,33 @@ auto BitcoinBlockHeader(
 
 namespace opentxs::blockchain::block::bitcoin::implementation
 {
+namespace
+{
+using RecordHash = std::array<char, 32>;
+
+auto read_work(const RecordHash& in) noexcept -> OTWork
+{
+    return OTWork{
+        factory::Work(Data::Factory(in.data(), in.size())->asHex())};
+}
+
+auto write_hash(const ReadView in, RecordHash& out) noexcept -> void
+{
+    std::memcpy(out.data(), in.data(), std::min(in.size(), out.size()));
+}
+
+auto write_work(const blockchain::Work& in, RecordHash& out) noexcept -> void
+{
+    // Work is stored as a right aligned big endian value
+    const auto bytes = Data::Factory(in.asHex(), Data::Mode::Hex);
+    const auto size = std::min(bytes->size(), out.size());
+    std::memcpy(
+        out.data() + (out.size() - size),
+        static_cast<const char*>(bytes->data()) + (bytes->size() - size),
+        size);
+}
+}  // namespace
+
 const VersionNumber Header::local_data_version_{1};
 const VersionNumber Header::subversion_default_{1};
 
@@ -338,7 +382,11 @@ Header::Header(const api::Core& api, const SerializedType& serialized) noexcept(
           serialized.local().height(),
           static_cast<Status>(serialized.local().status()),
           static_cast<Status>(serialized.local().inherit_status()),
-          OTWork{factory::Work(serialized.local().work())},
+          (1 < serialized.local().version())
+              ? OTWork{factory::Work(serialized.local().work())}
+              : calculate_work(
+                    static_cast<blockchain::Type>(serialized.type()),
+                    serialized.bitcoin().nbits()),
           OTWork{factory::Work(serialized.local().inherit_work())},
           serialized.bitcoin().version(),
           serialized.bitcoin().block_version(),
@@ -352,6 +400,42 @@ Header::Header(const api::Core& api, const SerializedType& serialized) noexcept(
 {
 }
 
+Header::Header(
+    const api::Core& api,
+    const blockchain::Type chain,
+    const internal::HeaderRecord& record) noexcept(false)
+    : Header(api, chain, record, preimage(record))
+{
+}
+
+Header::Header(
+    const api::Core& api,
+    const blockchain::Type chain,
+    const internal::HeaderRecord& record,
+    const BitcoinFormat& raw) noexcept(false)
+    : Header(
+          api,
+          default_version_,
+          chain,
+          api.Factory().Data(record.Hash()),
+          api.Factory().Data(ReadView{record.pow_.data(), record.pow_.size()}),
+          api.Factory().Data(
+              ReadView{raw.previous_.data(), raw.previous_.size()}),
+          record.height_.value(),
+          static_cast<Status>(record.status_.value()),
+          static_cast<Status>(record.inherit_status_.value()),
+          read_work(record.work_),
+          read_work(record.inherit_work_),
+          record.subversion_.value(),
+          raw.version_.value(),
+          api.Factory().Data(ReadView{raw.merkle_.data(), raw.merkle_.size()}),
+          Clock::from_time_t(std::time_t(raw.time_.value())),
+          raw.nbits_.value(),
+          raw.nonce_.value(),
+          true)
+{
+}
+
 Header::Header(const Header& rhs) noexcept
     : bitcoin::Header()
     , ot_super(rhs)
@@ -488,14 +572,20 @@ auto Header::calculate_work(
     const blockchain::Type chain,
     const std::uint32_t nbits) -> OTWork
 {
-    const auto hash = OTNumericHash{factory::NumericHashNBits(nbits)};
-
-    return OTWork{factory::Work(chain, hash)};
+    return OTWork{factory::Work(chain, nbits)};
 }
 
 auto Header::check_pow() const noexcept -> bool
 {
-    return NumericHash() < Target();
+    try {
+        // Interpret hash as little endian
+        const auto pow = UInt256::FromLittleEndian(pow_->Bytes());
+
+        return pow < UInt256::FromCompact(nbits_);
+    } catch (...) {
+
+        return false;
+    }
 }
 
 auto Header::Encode() const noexcept -> OTData
@@ -542,6 +632,32 @@ auto Header::preimage(const SerializedType& in) -> BitcoinFormat
         in.bitcoin().nonce()};
 }
 
+auto Header::preimage(const internal::HeaderRecord& in) -> BitcoinFormat
+{
+    static_assert(sizeof(BitcoinFormat) == sizeof(in.header_));
+
+    auto output = BitcoinFormat{};
+    std::memcpy(static_cast<void*>(&output), in.header_.data(), sizeof(output));
+
+    return output;
+}
+
+auto Header::Record() const noexcept -> internal::HeaderRecord
+{
+    auto output = internal::HeaderRecord{};
+    Serialize(preallocated(output.header_.size(), output.header_.data()));
+    write_hash(hash_->Bytes(), output.hash_);
+    write_hash(pow_->Bytes(), output.pow_);
+    write_work(IncrementalWork(), output.work_);
+    write_work(ParentWork(), output.inherit_work_);
+    output.height_ = Height();
+    output.subversion_ = subversion_;
+    output.status_ = static_cast<std::uint32_t>(LocalState());
+    output.inherit_status_ = static_cast<std::uint32_t>(InheritedState());
+
+    return output;
+}
+
 auto Header::Serialize() const noexcept -> Header::SerializedType
 {
     auto output = ot_super::Serialize();
@@ -98,6 +98,7 @@ public:
     }
     auto Nonce() const noexcept -> std::uint32_t final { return nonce_; }
     auto nBits() const noexcept -> std::uint32_t final { return nbits_; }
+    auto Record() const noexcept -> internal::HeaderRecord final;
     auto Serialize() const noexcept -> SerializedType final;
     auto Serialize(const AllocateOutput destination) const noexcept
         -> bool final;
@@ -129,6 +130,10 @@ public:
         const block::Height height) noexcept(false);
     Header(const api::Core& api, const SerializedType& serialized) noexcept(
         false);
+    Header(
+        const api::Core& api,
+        const blockchain::Type chain,
+        const internal::HeaderRecord& record) noexcept(false);
     Header(const Header& rhs) noexcept;
 
     ~Header() final = default;
@@ -153,6 +158,7 @@ private:
         const blockchain::Type chain,
         const std::uint32_t nbits) -> OTWork;
     static auto preimage(const SerializedType& in) -> BitcoinFormat;
+    static auto preimage(const internal::HeaderRecord& in) -> BitcoinFormat;
 
     auto check_pow() const noexcept -> bool;
 
@@ -177,6 +183,11 @@ private:
         const std::uint32_t nbits,
         const std::uint32_t nonce,
         const bool validate) noexcept(false);
+    Header(
+        const api::Core& api,
+        const blockchain::Type chain,
+        const internal::HeaderRecord& record,
+        const BitcoinFormat& raw) noexcept(false);
     Header() = delete;
     Header(Header&&) = delete;
     auto operator=(const Header&) -> Header& = delete;
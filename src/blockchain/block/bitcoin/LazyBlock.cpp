@@ -0,0 +1,409 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"                            // IWYU pragma: associated
+#include "1_Internal.hpp"                          // IWYU pragma: associated
+#include "blockchain/block/bitcoin/LazyBlock.hpp"  // IWYU pragma: associated
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "blockchain/block/bitcoin/BlockParser.hpp"
+#include "internal/blockchain/bitcoin/Bitcoin.hpp"
+#include "internal/blockchain/block/bitcoin/Bitcoin.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/api/Core.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/blockchain/block/bitcoin/Header.hpp"
+#include "opentxs/blockchain/block/bitcoin/Transaction.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/LogSource.hpp"
+#include "util/Container.hpp"
+
+#define OT_METHOD                                                              \
+    "opentxs::blockchain::block::bitcoin::implementation::LazyBlock::"
+
+namespace opentxs::factory
+{
+auto BitcoinBlockView(
+    const api::Core& api,
+    const api::client::Blockchain& blockchain,
+    const blockchain::Type chain,
+    const ReadView in) noexcept
+    -> std::shared_ptr<blockchain::block::bitcoin::Block>
+{
+    try {
+        switch (chain) {
+            case blockchain::Type::Bitcoin:
+            case blockchain::Type::Bitcoin_testnet3:
+            case blockchain::Type::BitcoinCash:
+            case blockchain::Type::BitcoinCash_testnet3:
+            case blockchain::Type::Litecoin:
+            case blockchain::Type::Litecoin_testnet4:
+            case blockchain::Type::PKT:
+            case blockchain::Type::PKT_testnet:
+            case blockchain::Type::UnitTest: {
+                using Block = blockchain::block::bitcoin::implementation::
+                    LazyBlock;
+
+                auto it = ByteIterator{};
+                auto expectedSize = std::size_t{};
+                auto pHeader = parse_header(api, chain, in, it, expectedSize);
+
+                OT_ASSERT(pHeader);
+
+                // The serialized form of the view is the input bytes, so the
+                // proofs of a PKT block only need to be skipped
+                if ((blockchain::Type::PKT == chain) ||
+                    (blockchain::Type::PKT_testnet == chain)) {
+                    parse_pkt_proofs(in, it, expectedSize);
+                }
+
+                auto [index, offsets] = index_transactions(
+                    api, chain, in, *pHeader, it, expectedSize);
+
+                return std::make_shared<Block>(
+                    api,
+                    blockchain,
+                    chain,
+                    std::move(pHeader),
+                    in,
+                    std::move(index),
+                    std::move(offsets));
+            }
+            case blockchain::Type::Unknown:
+            case blockchain::Type::Ethereum_frontier:
+            case blockchain::Type::Ethereum_ropsten:
+            default: {
+                LogOutput(OT_METHOD)(__FUNCTION__)(": Unsupported type (")(
+                    static_cast<std::uint32_t>(chain))(")")
+                    .Flush();
+
+                return {};
+            }
+        }
+    } catch (const std::exception& e) {
+        LogOutput("opentxs::factory::")(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return {};
+    }
+}
+}  // namespace opentxs::factory
+
+namespace opentxs::blockchain::block::bitcoin::implementation
+{
+namespace
+{
+// Every element a transaction can match (data pushes, witness items, output
+// scripts and spent outpoints) appears verbatim in the serialized
+// transaction, so a transaction whose bytes contain none of the patterns can
+// not produce a match and does not need to be instantiated.
+class Screen
+{
+public:
+    /// Returns false only if the transaction can not match any pattern
+    auto operator()(const ReadView tx) const noexcept -> bool
+    {
+        if (everything_) { return true; }
+
+        if (prefix_ > tx.size()) { return false; }
+
+        const auto* const data = reinterpret_cast<const std::byte*>(tx.data());
+        const auto last = tx.size() - prefix_;
+
+        for (auto i = std::size_t{0}; i <= last; ++i) {
+            const auto word = load(data + i);
+
+            if (false == filter_.test(bucket(word))) { continue; }
+
+            const auto candidates = patterns_.find(word);
+
+            if (patterns_.end() == candidates) { continue; }
+
+            for (const auto& pattern : candidates->second) {
+                if (pattern.size() > (tx.size() - i)) { continue; }
+
+                if (0 == std::memcmp(data + i, pattern.data(), pattern.size())) {
+
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    Screen(
+        const block::Block::Patterns& txos,
+        const block::Block::Patterns& elements) noexcept
+        : everything_(false)
+        , filter_()
+        , patterns_()
+    {
+        for (const auto* set : {&txos, &elements}) {
+            for (const auto& [id, pattern] : *set) { add(reader(pattern)); }
+        }
+    }
+
+private:
+    static constexpr auto prefix_ = sizeof(std::uint64_t);
+    static constexpr auto buckets_ = std::size_t{1} << 16u;
+
+    bool everything_;
+    std::bitset<buckets_> filter_;
+    std::unordered_map<std::uint64_t, std::vector<ReadView>> patterns_;
+
+    static auto bucket(const std::uint64_t word) noexcept -> std::size_t
+    {
+        return static_cast<std::size_t>((word * 0x9e3779b97f4a7c15) >> 48u);
+    }
+    static auto load(const void* in) noexcept -> std::uint64_t
+    {
+        auto out = std::uint64_t{};
+        std::memcpy(&out, in, sizeof(out));
+
+        return out;
+    }
+
+    auto add(const ReadView pattern) noexcept -> void
+    {
+        if (prefix_ > pattern.size()) {
+            // Patterns this short are not worth screening for
+            everything_ = true;
+
+            return;
+        }
+
+        const auto word = load(pattern.data());
+        filter_.set(bucket(word));
+        patterns_[word].emplace_back(pattern);
+    }
+};
+}  // namespace
+
+const LazyBlock::value_type LazyBlock::null_tx_{};
+
+LazyBlock::LazyBlock(
+    const api::Core& api,
+    const api::client::Blockchain& blockchain,
+    const blockchain::Type chain,
+    std::unique_ptr<const internal::Header> header,
+    const ReadView bytes,
+    TxidIndex&& index,
+    Offsets&& offsets) noexcept(false)
+    : block::implementation::Block(api, *header)
+    , blockchain_(blockchain)
+    , chain_(chain)
+    , header_p_(std::move(header))
+    , header_(*header_p_)
+    , bytes_(bytes)
+    , index_(std::move(index))
+    , offsets_(std::move(offsets))
+    , lookup_([&] {
+        auto output = std::map<ReadView, std::size_t>{};
+
+        for (auto i = std::size_t{0}; i < index_.size(); ++i) {
+            output.emplace(reader(index_.at(i)), i);
+        }
+
+        return output;
+    }())
+    , lock_()
+    , transactions_(index_.size())
+{
+    if (index_.size() != offsets_.size()) {
+        throw std::runtime_error("Invalid transaction index");
+    }
+
+    if (false == bool(header_p_)) {
+        throw std::runtime_error("Invalid header");
+    }
+
+    for (const auto& [position, size] : offsets_) {
+        if ((position + size) > bytes_.size()) {
+            throw std::runtime_error("Invalid transaction offset");
+        }
+    }
+}
+
+auto LazyBlock::at(const std::size_t index) const noexcept -> const value_type&
+{
+    try {
+        if (index_.size() <= index) {
+            throw std::out_of_range("invalid index " + std::to_string(index));
+        }
+
+        auto lock = Lock{lock_};
+        auto& output = transactions_.at(index);
+
+        if (false == bool(output)) { output = instantiate(index); }
+
+        return output;
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return null_tx_;
+    }
+}
+
+auto LazyBlock::at(const ReadView txid) const noexcept -> const value_type&
+{
+    if (auto i = lookup_.find(txid); lookup_.end() != i) {
+
+        return at(i->second);
+    }
+
+    LogOutput(OT_METHOD)(__FUNCTION__)(": transaction ")(
+        api_.Factory().Data(txid)->asHex())(" not found in block ")(
+        header_.Hash().asHex())
+        .Flush();
+
+    return null_tx_;
+}
+
+auto LazyBlock::ExtractElements(const FilterType style) const noexcept
+    -> std::vector<Space>
+{
+    auto output = std::vector<Space>{};
+    LogTrace(OT_METHOD)(__FUNCTION__)(": processing ")(index_.size())(
+        " transactions")
+        .Flush();
+
+    try {
+        for (auto i = std::size_t{0}; i < index_.size(); ++i) {
+            auto temp = get(i)->ExtractElements(style);
+            output.insert(
+                output.end(),
+                std::make_move_iterator(temp.begin()),
+                std::make_move_iterator(temp.end()));
+        }
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return {};
+    }
+
+    LogTrace(OT_METHOD)(__FUNCTION__)(": extracted ")(output.size())(
+        " elements")
+        .Flush();
+    std::sort(output.begin(), output.end());
+
+    return output;
+}
+
+auto LazyBlock::FindMatches(
+    const api::client::Blockchain& blockchain,
+    const FilterType style,
+    const Patterns& outpoints,
+    const Patterns& patterns) const noexcept -> Matches
+{
+    if (0 == (outpoints.size() + patterns.size())) { return {}; }
+
+    LogTrace(OT_METHOD)(__FUNCTION__)(": Verifying ")(
+        patterns.size() + outpoints.size())(" potential matches in ")(
+        index_.size())(" transactions")
+        .Flush();
+    auto output = Matches{};
+    const auto parsed = ParsedPatterns{patterns};
+    const auto screen = Screen{outpoints, patterns};
+    auto instantiated = std::size_t{0};
+
+    for (auto i = std::size_t{0}; i < index_.size(); ++i) {
+        if (false == screen(transaction_bytes(i))) { continue; }
+
+        ++instantiated;
+        const auto& pTx = at(i);
+
+        if (false == bool(pTx)) { continue; }
+
+        auto temp = pTx->FindMatches(blockchain, style, outpoints, parsed);
+        output.insert(
+            output.end(),
+            std::make_move_iterator(temp.begin()),
+            std::make_move_iterator(temp.end()));
+    }
+
+    LogTrace(OT_METHOD)(__FUNCTION__)(": ")(instantiated)(" of ")(
+        index_.size())(" transactions contain candidate patterns")
+        .Flush();
+    dedup(output);
+
+    return output;
+}
+
+auto LazyBlock::get(const std::size_t index) const noexcept(false)
+    -> value_type
+{
+    {
+        auto lock = Lock{lock_};
+        const auto& existing = transactions_.at(index);
+
+        if (existing) { return existing; }
+    }
+
+    return instantiate(index);
+}
+
+auto LazyBlock::instantiate(const std::size_t index) const noexcept(false)
+    -> value_type
+{
+    auto output = value_type{factory::BitcoinTransaction(
+        api_,
+        blockchain_,
+        chain_,
+        (0 == index),
+        header_.Timestamp(),
+        bb::EncodedTransaction::Deserialize(
+            api_, chain_, transaction_bytes(index)))};
+
+    if (false == bool(output)) {
+        throw std::runtime_error(
+            "Failed to instantiate transaction " + std::to_string(index));
+    }
+
+    return output;
+}
+
+auto LazyBlock::Serialize(AllocateOutput bytes) const noexcept -> bool
+{
+    if (false == bool(bytes)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid output allocator")
+            .Flush();
+
+        return false;
+    }
+
+    const auto size = bytes_.size();
+    auto out = bytes(size);
+
+    if (false == out.valid(size)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to allocate output")
+            .Flush();
+
+        return false;
+    }
+
+    std::memcpy(out.data(), bytes_.data(), size);
+
+    return true;
+}
+
+auto LazyBlock::transaction_bytes(const std::size_t index) const
+    noexcept(false) -> ReadView
+{
+    const auto& [position, size] = offsets_.at(index);
+
+    return {std::next(bytes_.data(), position), size};
+}
+
+LazyBlock::~LazyBlock() = default;
+}  // namespace opentxs::blockchain::block::bitcoin::implementation
@@ -0,0 +1,136 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "1_Internal.hpp"
+#include "blockchain/block/Block.hpp"
+#include "blockchain/block/bitcoin/Block.hpp"
+#include "internal/blockchain/block/Block.hpp"
+#include "opentxs/Bytes.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/blockchain/BlockchainType.hpp"
+#include "opentxs/blockchain/Types.hpp"
+#include "opentxs/blockchain/block/Block.hpp"
+#include "opentxs/blockchain/block/bitcoin/Block.hpp"
+
+namespace opentxs
+{
+namespace api
+{
+namespace client
+{
+class Blockchain;
+}  // namespace client
+
+class Core;
+}  // namespace api
+
+namespace blockchain
+{
+namespace block
+{
+namespace bitcoin
+{
+namespace internal
+{
+struct Header;
+}  // namespace internal
+}  // namespace bitcoin
+}  // namespace block
+}  // namespace blockchain
+}  // namespace opentxs
+
+namespace opentxs::blockchain::block::bitcoin::implementation
+{
+/// Bitcoin block backed by its serialized form
+///
+/// Constructing the block locates every transaction and verifies the merkle
+/// root, but Transaction objects are only instantiated when a caller accesses
+/// them. FindMatches skips any transaction whose serialized bytes do not
+/// contain at least one of the requested patterns.
+///
+/// The block does not own the serialized bytes. They must remain valid for
+/// the lifetime of the block.
+class LazyBlock final : public bitcoin::Block,
+                        public block::implementation::Block
+{
+public:
+    using TxidIndex = implementation::Block::TxidIndex;
+    /// position and size of each transaction within the serialized block
+    using Offsets = std::vector<std::pair<std::size_t, std::size_t>>;
+
+    auto at(const std::size_t index) const noexcept -> const value_type& final;
+    auto at(const ReadView txid) const noexcept -> const value_type& final;
+    auto begin() const noexcept -> const_iterator final { return cbegin(); }
+    auto CalculateSize() const noexcept -> std::size_t final
+    {
+        return bytes_.size();
+    }
+    auto cbegin() const noexcept -> const_iterator final
+    {
+        return const_iterator(this, 0);
+    }
+    auto cend() const noexcept -> const_iterator final
+    {
+        return const_iterator(this, index_.size());
+    }
+    auto end() const noexcept -> const_iterator final { return cend(); }
+    auto ExtractElements(const FilterType style) const noexcept
+        -> std::vector<Space> final;
+    auto FindMatches(
+        const api::client::Blockchain& blockchain,
+        const FilterType type,
+        const Patterns& outpoints,
+        const Patterns& scripts) const noexcept -> Matches final;
+    auto Serialize(AllocateOutput bytes) const noexcept -> bool final;
+    auto size() const noexcept -> std::size_t final { return index_.size(); }
+
+    LazyBlock(
+        const api::Core& api,
+        const api::client::Blockchain& blockchain,
+        const blockchain::Type chain,
+        std::unique_ptr<const internal::Header> header,
+        const ReadView bytes,
+        TxidIndex&& index,
+        Offsets&& offsets) noexcept(false);
+
+    ~LazyBlock() final;
+
+private:
+    static const value_type null_tx_;
+
+    const api::client::Blockchain& blockchain_;
+    const blockchain::Type chain_;
+    const std::unique_ptr<const internal::Header> header_p_;
+    const internal::Header& header_;
+    const ReadView bytes_;
+    const TxidIndex index_;
+    const Offsets offsets_;
+    const std::map<ReadView, std::size_t> lookup_;
+    mutable std::mutex lock_;
+    mutable std::vector<value_type> transactions_;
+
+    auto get(const std::size_t index) const noexcept(false) -> value_type;
+    auto instantiate(const std::size_t index) const noexcept(false)
+        -> value_type;
+    auto transaction_bytes(const std::size_t index) const noexcept(false)
+        -> ReadView;
+
+    LazyBlock() = delete;
+    LazyBlock(const LazyBlock&) = delete;
+    LazyBlock(LazyBlock&&) = delete;
+    auto operator=(const LazyBlock&) -> LazyBlock& = delete;
+    auto operator=(LazyBlock&&) -> LazyBlock& = delete;
+};
+}  // namespace opentxs::blockchain::block::bitcoin::implementation
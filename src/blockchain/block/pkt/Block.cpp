@@ -45,7 +45,29 @@ auto parse_pkt_block(
 
     const auto& header = *pHeader;
     const auto proofStart{it};
-    auto proofs = ReturnType::Proofs{};
+    auto proofs = parse_pkt_proofs(in, it, expectedSize);
+    const auto proofEnd{it};
+    auto sizeData = ReturnType::CalculatedSize{in.size(), bb::CompactSize{}};
+    auto [index, transactions] = parse_transactions(
+        api, blockchain, chain, in, header, sizeData, it, expectedSize);
+
+    return std::make_shared<ReturnType>(
+        api,
+        chain,
+        std::move(pHeader),
+        std::move(proofs),
+        std::move(index),
+        std::move(transactions),
+        static_cast<std::size_t>(std::distance(proofStart, proofEnd)),
+        std::move(sizeData));
+}
+
+auto parse_pkt_proofs(
+    const ReadView in,
+    ByteIterator& it,
+    std::size_t& expectedSize) noexcept(false) -> PktProofs
+{
+    auto proofs = PktProofs{};
 
     while (true) {
         expectedSize += 1;
@@ -86,20 +108,7 @@ auto parse_pkt_block(
         if (type == terminalType) { break; }
     }
 
-    const auto proofEnd{it};
-    auto sizeData = ReturnType::CalculatedSize{in.size(), bb::CompactSize{}};
-    auto [index, transactions] = parse_transactions(
-        api, blockchain, chain, in, header, sizeData, it, expectedSize);
-
-    return std::make_shared<ReturnType>(
-        api,
-        chain,
-        std::move(pHeader),
-        std::move(proofs),
-        std::move(index),
-        std::move(transactions),
-        static_cast<std::size_t>(std::distance(proofStart, proofEnd)),
-        std::move(sizeData));
+    return proofs;
 }
 }  // namespace opentxs::factory
 
@@ -31,6 +31,7 @@ namespace opentxs::factory
 {
 auto BlockOracle(
     const api::Core& api,
+    const blockchain::client::internal::Config& config,
     const blockchain::client::internal::Network& network,
     const blockchain::client::internal::HeaderOracle& header,
     const blockchain::client::internal::BlockDatabase& db,
@@ -41,7 +42,7 @@ auto BlockOracle(
     using ReturnType = blockchain::client::implementation::BlockOracle;
 
     return std::make_unique<ReturnType>(
-        api, network, header, db, chain, shutdown);
+        api, config, network, header, db, chain, shutdown);
 }
 }  // namespace opentxs::factory
 
@@ -49,6 +50,7 @@ namespace opentxs::blockchain::client::implementation
 {
 BlockOracle::BlockOracle(
     const api::Core& api,
+    const internal::Config& config,
     const internal::Network& network,
     const internal::HeaderOracle& header,
     const internal::BlockDatabase& db,
@@ -58,7 +60,7 @@ BlockOracle::BlockOracle(
     , network_(network)
     , db_(db)
     , lock_()
-    , cache_(api, network, db, chain)
+    , cache_(api, network, db, chain, config.block_cache_bytes_)
     , block_downloader_([&]() -> std::unique_ptr<BlockDownloader> {
         using Policy = api::client::blockchain::BlockStorage;
 
@@ -71,13 +73,13 @@ BlockOracle::BlockOracle(
     init_executor({shutdown});
 }
 
-auto BlockOracle::GetBlockJob() const noexcept -> BlockJob
+auto BlockOracle::GetBlockJob(const int peer) const noexcept -> BlockJob
 {
     auto lock = Lock{lock_};
 
     if (block_downloader_) {
 
-        return block_downloader_->NextBatch();
+        return block_downloader_->NextBatch(peer);
     } else {
 
         return {};
@@ -156,6 +158,13 @@ auto BlockOracle::pipeline(const zmq::Message& in) noexcept -> void
     }
 }
 
+auto BlockOracle::RemovePeer(const int peer) const noexcept -> void
+{
+    auto lock = Lock{lock_};
+
+    if (block_downloader_) { block_downloader_->RemovePeer(peer); }
+}
+
 auto BlockOracle::shutdown(std::promise<void>& promise) noexcept -> void
 {
     {
@@ -178,7 +187,12 @@ auto BlockOracle::state_machine() noexcept -> bool
 {
     if (false == running_.get()) { return false; }
 
-    return cache_.StateMachine();
+    auto repeat = cache_.StateMachine();
+    // Pruning runs in small batches on this thread so that it never delays
+    // the block downloader
+    repeat |= db_.BlockPrune();
+
+    return repeat;
 }
 
 auto BlockOracle::SubmitBlock(const ReadView in) const noexcept -> void
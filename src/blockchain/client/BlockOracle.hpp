@@ -5,9 +5,9 @@
 
 #pragma once
 
-#include <boost/container/flat_map.hpp>
+#include <atomic>
 #include <chrono>
-#include <deque>
+#include <cstddef>
 #include <functional>
 #include <future>
 #include <iosfwd>
@@ -28,6 +28,7 @@
 #include "opentxs/blockchain/client/BlockOracle.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/util/WorkType.hpp"
+#include "util/LRU.hpp"
 #include "util/Work.hpp"
 
 namespace opentxs
@@ -68,12 +69,18 @@ public:
         statemachine = OT_ZMQ_STATE_MACHINE_SIGNAL,
     };
 
-    auto GetBlockJob() const noexcept -> BlockJob final;
+    auto GetBlockJob(const int peer) const noexcept -> BlockJob final;
     auto Heartbeat() const noexcept -> void final;
     auto LoadBitcoin(const block::Hash& block) const noexcept
         -> BitcoinBlockFuture final;
     auto LoadBitcoin(const BlockHashes& hashes) const noexcept
         -> BitcoinBlockFutures final;
+    auto LoadRaw(const block::Hash& block) const noexcept
+        -> api::client::blockchain::BlockReader final
+    {
+        return db_.BlockLoadRaw(block);
+    }
+    auto RemovePeer(const int peer) const noexcept -> void final;
     auto SubmitBlock(const ReadView in) const noexcept -> void final;
     auto Tip() const noexcept -> block::Position final
     {
@@ -88,6 +95,7 @@ public:
 
     BlockOracle(
         const api::Core& api,
+        const internal::Config& config,
         const internal::Network& network,
         const internal::HeaderOracle& header,
         const internal::BlockDatabase& db,
@@ -118,32 +126,16 @@ private:
             const api::Core& api_,
             const internal::Network& network,
             const internal::BlockDatabase& db,
-            const blockchain::Type chain) noexcept;
+            const blockchain::Type chain,
+            const std::size_t bytes) noexcept;
         ~Cache() { Shutdown(); }
 
     private:
-        static const std::size_t cache_limit_;
-        static const std::chrono::seconds download_timeout_;
-
-        struct Mem {
-            auto find(const ReadView& id) const noexcept -> BitcoinBlockFuture;
-
-            auto clear() noexcept -> void;
-            auto push(block::pHash&& id, BitcoinBlockFuture&& future) noexcept
-                -> void;
+        // Completed blocks are stored as ready futures so a cache hit can be
+        // returned without allocating a new promise
+        using Mem = LRU<block::pHash, BitcoinBlockFuture>;
 
-            Mem(const std::size_t limit) noexcept;
-
-        private:
-            using Completed =
-                std::deque<std::pair<block::pHash, BitcoinBlockFuture>>;
-            using Index = boost::container::
-                flat_map<ReadView, Completed::const_reverse_iterator>;
-
-            const std::size_t limit_;
-            Completed queue_;
-            Index index_;
-        };
+        static const std::chrono::seconds download_timeout_;
 
         const api::Core& api_;
         const internal::Network& network_;
@@ -152,9 +144,15 @@ private:
         mutable std::mutex lock_;
         mutable Pending pending_;
         mutable Mem mem_;
-        bool running_;
+        std::atomic<bool> running_;
 
+        static auto ready(BitcoinBlock_p block) noexcept -> BitcoinBlockFuture;
+
+        auto cache(const block::Hash& id, const BitcoinBlock_p& block)
+            const noexcept -> BitcoinBlockFuture;
         auto download(const block::Hash& block) const noexcept -> bool;
+        auto load(const block::Hash& block) const noexcept
+            -> BitcoinBlockFuture;
     };
 
     const internal::Network& network_;
@@ -14,6 +14,8 @@
 #include <sstream>
 #include <thread>
 
+#include "blockchain/BufferPool.hpp"
+#include "internal/network/Factory.hpp"
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/api/Core.hpp"
 #include "opentxs/api/Endpoints.hpp"
@@ -31,12 +33,10 @@ namespace opentxs::blockchain::client::internal
 {
 IO::IO(const api::Core& api) noexcept
     : api_(api)
-    , lock_()
     , cb_(zmq::ListenCallback::Factory([this](auto& in) { callback(in); }))
     , socket_(
           api.ZeroMQ().RouterSocket(cb_, zmq::socket::Socket::Direction::Bind))
-    , next_buffer_(-1)
-    , buffers_()
+    , buffers_(BufferPool::Factory())
     , context_()
     , work_(std::make_unique<boost::asio::io_context::work>(context_))
     , thread_pool_()
@@ -82,12 +82,6 @@ auto IO::callback(zmq::Message& in) noexcept -> void
     }
 }
 
-auto IO::clear_buffer(const int id) const noexcept -> void
-{
-    Lock lock(lock_);
-    buffers_.erase(id);
-}
-
 auto IO::Connect(
     const Space& id,
     const tcp::endpoint& endpoint,
@@ -103,16 +97,6 @@ auto IO::Connect(
     });
 }
 
-auto IO::get_buffer(const std::size_t bytes) const noexcept
-    -> std::pair<int, WritableView>
-{
-    Lock lock(lock_);
-    auto id = ++next_buffer_;
-    auto& buffer = buffers_[id];
-
-    return {id, writer(buffer)(bytes)};
-}
-
 auto IO::Receive(
     const Space& id,
     const OTZMQWorkType type,
@@ -121,24 +105,34 @@ auto IO::Receive(
 {
     OT_ASSERT(0 < id.size());
 
-    auto space = get_buffer(bytes);
-    auto asioBuffer =
-        boost::asio::buffer(space.second.data(), space.second.size());
+    using Buffer = std::shared_ptr<BufferPool::Buffer>;
+    auto buffer = Buffer{buffers_->Get(bytes)};
+    auto asioBuffer = boost::asio::buffer(buffer->data(), buffer->size());
     boost::asio::async_read(
         socket,
         asioBuffer,
-        [this, id, type, space{std::move(space)}](const auto& e, auto size) {
+        [this, id, type, buffer](const auto& e, auto size) {
             auto work = api_.ZeroMQ().TaggedReply(
                 reader(id), e ? OT_ZMQ_DISCONNECT_SIGNAL : type);
 
             if (e) {
                 LogVerbose("asio receive error: ")(e.message()).Flush();
             } else {
-                work->AddFrame(space.second);
+                // The frame keeps the buffer alive until the peer has
+                // processed the message
+                auto* hint = new Buffer{buffer};
+                constexpr auto cleanup = [](void*, void* hint) {
+                    delete static_cast<Buffer*>(hint);
+                };
+                work->AddFrame();
+                work->Replace(
+                    work->size() - 1,
+                    OTZMQFrame{factory::ZMQFrame(
+                                   buffer->data(), size, cleanup, hint)
+                                   .release()});
             }
 
             socket_->Send(work);
-            clear_buffer(space.first);
         });
 }
 
@@ -172,7 +166,22 @@ auto Config::print() const noexcept -> std::string
            << '\n';
     output << "  * use sync server: " << print_bool(use_sync_server_) << '\n';
     output << "  * disable wallet: " << print_bool(disable_wallet_) << '\n';
+    output << "  * disable compact blocks: "
+           << print_bool(disable_compact_blocks_) << '\n';
+    output << "  * compact blocks high bandwidth: "
+           << print_bool(compact_blocks_high_bandwidth_) << '\n';
+    output << "  * disable segmented headers: "
+           << print_bool(disable_segmented_headers_) << '\n';
     output << "  * sync endpoint: " << sync_endpoint_ << '\n';
+    output << "  * peer target bytes: " << peer_target_bytes_ << '\n';
+    output << "  * block cache bytes: " << block_cache_bytes_ << '\n';
+    output << "  * block prune blocks: " << block_prune_blocks_ << '\n';
+    output << "  * block prune bytes: " << block_prune_bytes_ << '\n';
+    output << "  * filter cache bytes: " << filter_cache_bytes_ << '\n';
+    output << "  * mempool bytes: " << mempool_bytes_ << '\n';
+    output << "  * mempool expiry hours: " << mempool_expiry_hours_ << '\n';
+    output << "  * scan parallelism: " << scan_parallelism_ << '\n';
+    output << "  * block prefetch: " << block_prefetch_ << '\n';
 
     return output.str();
 }
@@ -9,9 +9,12 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <future>
 #include <iterator>
+#include <memory>
 #include <stdexcept>
 #include <tuple>
 #include <type_traits>
@@ -211,6 +214,7 @@ FilterOracle::FilterOracle(
     }())
     , last_sync_progress_()
     , outstanding_jobs_()
+    , cache_(config.filter_cache_bytes_)
     , running_(true)
 {
     OT_ASSERT(cb_);
@@ -219,6 +223,20 @@ FilterOracle::FilterOracle(
     compare_tips_to_checkpoint();
 }
 
+auto FilterOracle::cache_filter(
+    const CacheKey& key,
+    const std::shared_ptr<const GCS>& filter) const noexcept -> void
+{
+    if (false == bool(filter)) { return; }
+
+    const auto count = std::size_t{filter->ElementCount()};
+    // decoded set retained after reuse plus roughly 20 bits per element for
+    // the compressed filter
+    const auto bytes =
+        (count * (sizeof(std::uint64_t) + 3u)) + key.second->size();
+    cache_.Insert(key, filter, bytes);
+}
+
 auto FilterOracle::compare_header_to_checkpoint(
     const block::Position& block,
     const filter::Header& receivedHeader) noexcept -> block::Position
@@ -319,26 +337,26 @@ auto FilterOracle::compare_tips_to_header_chain() noexcept -> bool
     return true;
 }
 
-auto FilterOracle::GetFilterJob() const noexcept -> CfilterJob
+auto FilterOracle::GetFilterJob(const int peer) const noexcept -> CfilterJob
 {
     auto lock = rLock{lock_};
 
     if (filter_downloader_) {
 
-        return filter_downloader_->NextBatch();
+        return filter_downloader_->NextBatch(peer);
     } else {
 
         return {};
     }
 }
 
-auto FilterOracle::GetHeaderJob() const noexcept -> CfheaderJob
+auto FilterOracle::GetHeaderJob(const int peer) const noexcept -> CfheaderJob
 {
     auto lock = rLock{lock_};
 
     if (header_downloader_) {
 
-        return header_downloader_->NextBatch();
+        return header_downloader_->NextBatch(peer);
     } else {
 
         return {};
@@ -358,14 +376,21 @@ auto FilterOracle::Heartbeat() const noexcept -> void
     if ((Clock::now() - last_sync_progress_) > limit) {
         new_tip(lock, default_type_, database_.FilterTip(default_type_));
     }
+
+    const auto stats = cache_.Stats();
+    LogTrace(OT_METHOD)(__FUNCTION__)(": ")(DisplayString(chain_))(
+        " filter cache: ")(stats.items_)(" filters, ")(stats.bytes_)(" of ")(
+        stats.capacity_)(" bytes, ")(stats.hits_)(" hits, ")(stats.misses_)(
+        " misses, ")(stats.evictions_)(" evictions")
+        .Flush();
 }
 
 auto FilterOracle::LoadFilterOrResetTip(
     const filter::Type type,
     const block::Position& position) const noexcept
-    -> std::unique_ptr<const GCS>
+    -> std::shared_ptr<const GCS>
 {
-    auto output = LoadFilter(type, position.second);
+    auto output = LoadFilterShared(type, position.second);
 
     if (output) { return output; }
 
@@ -383,6 +408,60 @@ auto FilterOracle::LoadFilterOrResetTip(
     return {};
 }
 
+auto FilterOracle::LoadFilterShared(
+    const filter::Type type,
+    const block::Hash& block) const noexcept -> std::shared_ptr<const GCS>
+{
+    const auto key = CacheKey{type, block};
+
+    if (auto cached = cache_.Find(key); cached.has_value()) {
+
+        return cached.value();
+    }
+
+    auto output =
+        std::shared_ptr<const GCS>{database_.LoadFilter(type, block.Bytes())};
+    cache_filter(key, output);
+
+    return output;
+}
+
+auto FilterOracle::LoadFilters(
+    const filter::Type type,
+    const std::vector<block::pHash>& blocks) const noexcept
+    -> std::vector<std::shared_ptr<const GCS>>
+{
+    auto output = std::vector<std::shared_ptr<const GCS>>(blocks.size());
+    auto missing = std::vector<block::pHash>{};
+    auto index = std::vector<std::size_t>{};
+
+    for (auto i = std::size_t{0}; i < blocks.size(); ++i) {
+        const auto& block = blocks.at(i);
+
+        if (auto cached = cache_.Find(CacheKey{type, block});
+            cached.has_value()) {
+            output.at(i) = std::move(cached.value());
+        } else {
+            missing.emplace_back(block);
+            index.emplace_back(i);
+        }
+    }
+
+    if (0 == missing.size()) { return output; }
+
+    auto loaded = database_.LoadFilters(type, missing);
+
+    OT_ASSERT(loaded.size() == missing.size());
+
+    for (auto i = std::size_t{0}; i < loaded.size(); ++i) {
+        auto& filter = output.at(index.at(i));
+        filter = std::move(loaded.at(i));
+        cache_filter(CacheKey{type, missing.at(i)}, filter);
+    }
+
+    return output;
+}
+
 auto FilterOracle::new_tip(
     const rLock&,
     const filter::Type type,
@@ -729,6 +808,15 @@ auto FilterOracle::process_block(
         elements);
 }
 
+auto FilterOracle::RemovePeer(const int peer) const noexcept -> void
+{
+    auto lock = rLock{lock_};
+
+    if (filter_downloader_) { filter_downloader_->RemovePeer(peer); }
+
+    if (header_downloader_) { header_downloader_->RemovePeer(peer); }
+}
+
 auto FilterOracle::reset_tips_to(
     const filter::Type type,
     const block::Position& position,
@@ -39,6 +39,7 @@
 #include "opentxs/network/zeromq/socket/Push.hpp"
 #include "opentxs/util/WorkType.hpp"
 #include "util/JobCounter.hpp"
+#include "util/LRU.hpp"
 #include "util/Work.hpp"
 
 namespace opentxs
@@ -118,8 +119,8 @@ public:
     {
         return database_.FilterTip(type);
     }
-    auto GetFilterJob() const noexcept -> CfilterJob final;
-    auto GetHeaderJob() const noexcept -> CfheaderJob final;
+    auto GetFilterJob(const int peer) const noexcept -> CfilterJob final;
+    auto GetHeaderJob(const int peer) const noexcept -> CfheaderJob final;
     auto Heartbeat() const noexcept -> void final;
     auto LoadFilter(const filter::Type type, const block::Hash& block)
         const noexcept -> std::unique_ptr<const GCS> final
@@ -131,16 +132,30 @@ public:
     {
         return database_.LoadFilterHeader(type, block.Bytes());
     }
+    auto LoadFilterHeaders(
+        const filter::Type type,
+        const std::vector<block::pHash>& blocks) const noexcept
+        -> std::vector<Header> final
+    {
+        return database_.LoadFilterHeaders(type, blocks);
+    }
     auto LoadFilterOrResetTip(
         const filter::Type type,
         const block::Position& position) const noexcept
-        -> std::unique_ptr<const GCS> final;
+        -> std::shared_ptr<const GCS> final;
+    auto LoadFilterShared(const filter::Type type, const block::Hash& block)
+        const noexcept -> std::shared_ptr<const GCS> final;
+    auto LoadFilters(
+        const filter::Type type,
+        const std::vector<block::pHash>& blocks) const noexcept
+        -> std::vector<std::shared_ptr<const GCS>> final;
     auto ProcessBlock(const block::bitcoin::Block& block) const noexcept
         -> bool final;
     auto ProcessBlock(BlockIndexerData& data) const noexcept -> void;
     auto ProcessSyncData(const ParsedSyncData& data) const noexcept
         -> void final;
     auto ProcessSyncData(SyncClientFilterData& data) const noexcept -> void;
+    auto RemovePeer(const int peer) const noexcept -> void final;
     auto Tip(const filter::Type type) const noexcept -> block::Position final
     {
         return database_.FilterTip(type);
@@ -171,6 +186,8 @@ private:
     using ChainMap = std::map<block::Height, FilterHeaderMap>;
     using CheckpointMap = std::map<blockchain::Type, ChainMap>;
     using OutstandingMap = std::map<int, std::atomic_int>;
+    using CacheKey = std::pair<filter::Type, block::pHash>;
+    using FilterCache = LRU<CacheKey, std::shared_ptr<const GCS>>;
 
     static const CheckpointMap filter_checkpoints_;
 
@@ -189,8 +206,12 @@ private:
     mutable std::unique_ptr<BlockIndexer> block_indexer_;
     mutable Time last_sync_progress_;
     mutable JobCounter outstanding_jobs_;
+    mutable FilterCache cache_;
     std::atomic_bool running_;
 
+    auto cache_filter(
+        const CacheKey& key,
+        const std::shared_ptr<const GCS>& filter) const noexcept -> void;
     auto new_tip(
         const rLock&,
         const filter::Type type,
@@ -13,8 +13,10 @@
 #include <iosfwd>
 #include <iterator>
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <type_traits>
 
 #include "blockchain/client/UpdateTransaction.hpp"
@@ -23,7 +25,6 @@
 #include "internal/blockchain/block/bitcoin/Bitcoin.hpp"
 #include "internal/blockchain/client/Factory.hpp"
 #include "internal/core/Core.hpp"
-#include "opentxs/Proto.tpp"
 #include "opentxs/api/Core.hpp"
 #include "opentxs/api/Factory.hpp"
 #include "opentxs/blockchain/FilterType.hpp"
@@ -34,11 +35,6 @@
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/LogSource.hpp"
-#include "opentxs/network/zeromq/Frame.hpp"
-#include "opentxs/network/zeromq/FrameIterator.hpp"
-#include "opentxs/network/zeromq/FrameSection.hpp"
-#include "opentxs/network/zeromq/Message.hpp"
-#include "opentxs/protobuf/BlockchainP2PSync.pb.h"
 
 #define OT_METHOD "opentxs::blockchain::client::implementation::HeaderOracle::"
 
@@ -98,11 +94,102 @@ HeaderOracle::HeaderOracle(
     , database_(database)
     , chain_(type)
     , lock_()
+    , best_(load_index())
 {
-    Lock lock(lock_);
-    const auto best = best_chain(lock);
+    OT_ASSERT(0 <= best_->Tip().first);
+}
+
+HeaderOracle::BestHashIndex::BestHashIndex() noexcept
+    : chunks_()
+    , size_(0)
+{
+}
+
+HeaderOracle::BestHashIndex::BestHashIndex(const BestHashIndex& rhs) noexcept
+    : chunks_(rhs.chunks_)
+    , size_(rhs.size_)
+{
+}
+
+auto HeaderOracle::BestHashIndex::at(const block::Height height) const noexcept
+    -> const block::Hash*
+{
+    if ((0 > height) || (static_cast<std::size_t>(height) >= size_)) {
+
+        return nullptr;
+    }
+
+    const auto i = static_cast<std::size_t>(height);
+
+    return &(chunks_.at(i / chunk_size_)->at(i % chunk_size_).get());
+}
+
+auto HeaderOracle::BestHashIndex::Pop(const block::Height height) noexcept
+    -> void
+{
+    const auto keep =
+        static_cast<std::size_t>(std::max<block::Height>(height + 1, 0));
+
+    if (keep >= size_) { return; }
+
+    size_ = keep;
+    chunks_.resize((keep + chunk_size_ - 1u) / chunk_size_);
+
+    if (const auto partial = keep % chunk_size_; 0u < partial) {
+        auto& chunk = writable(chunks_.size() - 1u);
+        chunk.erase(std::next(chunk.begin(), partial), chunk.end());
+    }
+}
+
+auto HeaderOracle::BestHashIndex::Push(const block::Position& position) noexcept
+    -> bool
+{
+    const auto& [height, hash] = position;
+
+    if ((0 > height) || (static_cast<std::size_t>(height) > size_)) {
+
+        return false;
+    }
 
-    OT_ASSERT(0 <= best.first);
+    const auto i = static_cast<std::size_t>(height);
+    const auto chunk = i / chunk_size_;
+
+    if (i < size_) {
+        writable(chunk).at(i % chunk_size_) = hash;
+
+        return true;
+    }
+
+    if (chunk == chunks_.size()) {
+        chunks_.emplace_back(std::make_shared<Chunk>());
+        chunks_.back()->reserve(chunk_size_);
+    }
+
+    writable(chunk).emplace_back(hash);
+    ++size_;
+
+    return true;
+}
+
+auto HeaderOracle::BestHashIndex::Tip() const noexcept -> block::Position
+{
+    if (0u == size_) { return {-1, Data::Factory()}; }
+
+    const auto height = static_cast<block::Height>(size_ - 1u);
+
+    return {height, *at(height)};
+}
+
+auto HeaderOracle::BestHashIndex::writable(const std::size_t chunk) noexcept
+    -> Chunk&
+{
+    auto& pChunk = chunks_.at(chunk);
+
+    // Chunks shared with a published index must not be modified. A chunk with
+    // no other owner can not be reached by any reader.
+    if (1 < pChunk.use_count()) { pChunk = std::make_shared<Chunk>(*pChunk); }
+
+    return *pChunk;
 }
 
 auto HeaderOracle::Ancestors(
@@ -110,16 +197,16 @@ auto HeaderOracle::Ancestors(
     const block::Position& target,
     const std::size_t limit) const noexcept(false) -> Positions
 {
-    Lock lock(lock_);
+    const auto pIndex = best_index();
+    const auto& index = *pIndex;
     const auto check =
         std::max<block::Height>(std::min(start.first, target.first), 0);
-    const auto fast = is_in_best_chain(lock, target.second).first &&
-                      is_in_best_chain(lock, start.second).first &&
+    const auto fast = is_in_best_chain(index, target.second).first &&
+                      is_in_best_chain(index, start.second).first &&
                       (start.first < target.first);
 
     if (fast) {
-        auto output = best_chain(lock, start, limit);
-        lock.unlock();
+        auto output = best_chain(index, start, limit);
 
         while ((1 < output.size()) && (output.back().first > target.first)) {
             output.pop_back();
@@ -203,7 +290,7 @@ auto HeaderOracle::AddCheckpoint(
 
     if (apply_checkpoint(lock, position, update)) {
 
-        return database_.ApplyUpdate(update);
+        return apply_update(lock, update);
     } else {
 
         return false;
@@ -224,23 +311,34 @@ auto HeaderOracle::AddHeaders(
 {
     if (0 == headers.size()) { return false; }
 
-    Lock lock(lock_);
-    auto update = UpdateTransaction{api_, database_};
-
-    for (auto& header : headers) {
+    for (const auto& header : headers) {
         if (false == bool(header)) {
             LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid header").Flush();
 
             return false;
         }
+    }
 
-        if (false == add_header(lock, update, std::move(header))) {
+    // Batches received from more than one peer usually overlap. Headers which
+    // are already stored are skipped without holding lock_.
+    const auto first =
+        std::find_if(headers.begin(), headers.end(), [&](const auto& header) {
+            return false == database_.HeaderExists(header->Hash());
+        });
+
+    if (headers.end() == first) { return true; }
+
+    Lock lock(lock_);
+    auto update = UpdateTransaction{api_, database_};
+
+    for (auto header = first; header != headers.end(); ++header) {
+        if (false == add_header(lock, update, std::move(*header))) {
 
             return false;
         }
     }
 
-    return database_.ApplyUpdate(update);
+    return apply_update(lock, update);
 }
 
 auto HeaderOracle::add_header(
@@ -350,39 +448,55 @@ auto HeaderOracle::apply_checkpoint(
     }
 }
 
-auto HeaderOracle::best_chain(const Lock& lock) const noexcept
-    -> block::Position
+auto HeaderOracle::apply_update(
+    const Lock& lock,
+    const UpdateTransaction& update) noexcept -> bool
 {
-    return database_.CurrentBest()->Position();
+    if (false == database_.ApplyUpdate(update)) { return false; }
+
+    auto index = std::make_shared<BestHashIndex>(*best_index());
+
+    if (update.HaveReorg()) { index->Pop(update.ReorgParent().first); }
+
+    for (const auto& [height, hash] : update.BestChain()) {
+        if (false == index->Push({height, hash})) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Best chain index does not match database")
+                .Flush();
+            index = load_index();
+
+            break;
+        }
+    }
+
+    std::atomic_store(&best_, Index{std::move(index)});
+
+    return true;
 }
 
 auto HeaderOracle::BestChain() const noexcept -> block::Position
 {
-    Lock lock(lock_);
-
-    return best_chain(lock);
+    return best_index()->Tip();
 }
 
 auto HeaderOracle::BestChain(
     const block::Position& tip,
     const std::size_t limit) const noexcept(false) -> Positions
 {
-    Lock lock(lock_);
-
-    return best_chain(lock, tip, limit);
+    return best_chain(*best_index(), tip, limit);
 }
 
 auto HeaderOracle::best_chain(
-    const Lock& lock,
+    const BestHashIndex& index,
     const block::Position& tip,
     const std::size_t limit) const noexcept -> Positions
 {
-    const auto [youngest, best] = common_parent(lock, tip);
+    const auto [youngest, best] = common_parent(index, tip);
     static const auto blank = api_.Factory().Data();
     auto height{youngest.first};
     auto output = Positions{};
 
-    for (auto& hash : best_hashes(lock, height, blank, 0)) {
+    for (auto& hash : best_hashes(index, height, blank, 0)) {
         output.emplace_back(height++, std::move(hash));
 
         if ((0u < limit) && (output.size() == limit)) { break; }
@@ -394,13 +508,14 @@ auto HeaderOracle::best_chain(
 auto HeaderOracle::BestHash(const block::Height height) const noexcept
     -> block::pHash
 {
-    Lock lock(lock_);
+    const auto pIndex = best_index();
 
-    try {
-        return database_.BestBlock(height);
-    } catch (...) {
-        return make_blank<block::pHash>::value(api_);
+    if (const auto* hash = pIndex->at(height); nullptr != hash) {
+
+        return *hash;
     }
+
+    return make_blank<block::pHash>::value(api_);
 }
 
 auto HeaderOracle::BestHashes(
@@ -409,9 +524,7 @@ auto HeaderOracle::BestHashes(
 {
     static const auto blank = api_.Factory().Data();
 
-    Lock lock(lock_);
-
-    return best_hashes(lock, start, blank, limit);
+    return best_hashes(*best_index(), start, blank, limit);
 }
 
 auto HeaderOracle::BestHashes(
@@ -419,9 +532,7 @@ auto HeaderOracle::BestHashes(
     const block::Hash& stop,
     const std::size_t limit) const noexcept -> Hashes
 {
-    Lock lock(lock_);
-
-    return best_hashes(lock, start, stop, limit);
+    return best_hashes(*best_index(), start, stop, limit);
 }
 
 auto HeaderOracle::BestHashes(
@@ -429,11 +540,12 @@ auto HeaderOracle::BestHashes(
     const block::Hash& stop,
     const std::size_t limit) const noexcept -> Hashes
 {
-    Lock lock(lock_);
+    const auto pIndex = best_index();
+    const auto& index = *pIndex;
     auto start = std::size_t{0};
 
     for (const auto& hash : previous) {
-        const auto [best, height] = is_in_best_chain(lock, hash);
+        const auto [best, height] = is_in_best_chain(index, hash);
 
         if (best) {
             start = height;
@@ -441,11 +553,11 @@ auto HeaderOracle::BestHashes(
         }
     }
 
-    return best_hashes(lock, start, stop, limit);
+    return best_hashes(index, start, stop, limit);
 }
 
 auto HeaderOracle::best_hashes(
-    const Lock& lock,
+    const BestHashIndex& index,
     const block::Height start,
     const block::Hash& stop,
     const std::size_t limit) const noexcept -> Hashes
@@ -458,32 +570,32 @@ auto HeaderOracle::best_hashes(
         static_cast<block::Height>(1)};
 
     while (limitIsZero || (current <= last)) {
-        try {
-            auto hash = database_.BestBlock(current++);
+        const auto* hash = index.at(current++);
 
-            // TODO this check shouldn't be necessary but BestBlock doesn't
-            // throw the exception documented in its declaration.
-            if (hash->empty()) { break; }
+        if (nullptr == hash) { break; }
 
-            const auto stopHere = stop.empty() ? false : (stop == hash);
-            output.emplace_back(std::move(hash));
+        const auto stopHere = stop.empty() ? false : (stop == *hash);
+        output.emplace_back(*hash);
 
-            if (stopHere) { break; }
-        } catch (...) {
-            break;
-        }
+        if (stopHere) { break; }
     }
 
     return output;
 }
 
+auto HeaderOracle::best_index() const noexcept -> Index
+{
+    return std::atomic_load(&best_);
+}
+
 auto HeaderOracle::CalculateReorg(const block::Position tip) const
     noexcept(false) -> Positions
 {
     auto output = Positions{};
-    Lock lock(lock_);
+    const auto pIndex = best_index();
+    const auto& index = *pIndex;
 
-    if (is_in_best_chain(lock, tip)) { return output; }
+    if (is_in_best_chain(index, tip)) { return output; }
 
     output.emplace_back(tip);
 
@@ -508,7 +620,7 @@ auto HeaderOracle::CalculateReorg(const block::Position tip) const
 
         auto parent = block::Position{height - 1, header.ParentHash()};
 
-        if (is_in_best_chain(lock, parent)) { break; }
+        if (is_in_best_chain(index, parent)) { break; }
 
         output.emplace_back(std::move(parent));
     }
@@ -603,19 +715,17 @@ auto HeaderOracle::choose_candidate(
 auto HeaderOracle::CommonParent(const block::Position& position) const noexcept
     -> std::pair<block::Position, block::Position>
 {
-    Lock lock(lock_);
-
-    return common_parent(lock, position);
+    return common_parent(*best_index(), position);
 }
 
 auto HeaderOracle::common_parent(
-    const Lock& lock,
+    const BestHashIndex& index,
     const block::Position& position) const noexcept
     -> std::pair<block::Position, block::Position>
 {
     const auto& database = database_;
     std::pair<block::Position, block::Position> output{
-        {0, GenesisBlockHash(chain_)}, best_chain(lock)};
+        {0, GenesisBlockHash(chain_)}, index.Tip()};
     auto& [parent, best] = output;
     auto test{position};
     auto pHeader = database.TryLoadHeader(test.second);
@@ -623,7 +733,7 @@ auto HeaderOracle::common_parent(
     if (false == bool(pHeader)) { return output; }
 
     while (0 < test.first) {
-        if (is_in_best_chain(lock, test.second).first) {
+        if (is_in_best_chain(index, test.second).first) {
             parent = test;
 
             return output;
@@ -708,7 +818,7 @@ auto HeaderOracle::DeleteCheckpoint() noexcept -> bool
 
     if (apply_checkpoint(lock, position, update)) {
 
-        return database_.ApplyUpdate(update);
+        return apply_update(lock, update);
     } else {
 
         return false;
@@ -820,17 +930,13 @@ auto HeaderOracle::initialize_candidate(
 
 auto HeaderOracle::IsInBestChain(const block::Hash& hash) const noexcept -> bool
 {
-    Lock lock(lock_);
-
-    return is_in_best_chain(lock, hash).first;
+    return is_in_best_chain(*best_index(), hash).first;
 }
 
 auto HeaderOracle::IsInBestChain(const block::Position& position) const noexcept
     -> bool
 {
-    Lock lock(lock_);
-
-    return is_in_best_chain(lock, position.first, position.second);
+    return is_in_best_chain(*best_index(), position);
 }
 
 auto HeaderOracle::is_disconnected(
@@ -853,8 +959,9 @@ auto HeaderOracle::is_disconnected(
     }
 }
 
-auto HeaderOracle::is_in_best_chain(const Lock& lock, const block::Hash& hash)
-    const noexcept -> std::pair<bool, block::Height>
+auto HeaderOracle::is_in_best_chain(
+    const BestHashIndex& index,
+    const block::Hash& hash) const noexcept -> std::pair<bool, block::Height>
 {
     const auto pHeader = database_.TryLoadHeader(hash);
 
@@ -862,28 +969,38 @@ auto HeaderOracle::is_in_best_chain(const Lock& lock, const block::Hash& hash)
 
     const auto& header = *pHeader;
 
-    return {is_in_best_chain(lock, header.Height(), hash), header.Height()};
+    return {is_in_best_chain(index, header.Position()), header.Height()};
 }
 
 auto HeaderOracle::is_in_best_chain(
-    const Lock& lock,
+    const BestHashIndex& index,
     const block::Position& position) const noexcept -> bool
 {
-    return is_in_best_chain(lock, position.first, position.second);
+    const auto* best = index.at(position.first);
+
+    return (nullptr != best) && (position.second.get() == *best);
 }
 
-auto HeaderOracle::is_in_best_chain(
-    const Lock& lock,
-    const block::Height height,
-    const block::Hash& hash) const noexcept -> bool
+auto HeaderOracle::load_index() const noexcept
+    -> std::shared_ptr<BestHashIndex>
 {
-    try {
-        return hash == database_.BestBlock(height);
+    auto output = std::make_shared<BestHashIndex>();
+    const auto tip = database_.CurrentBest()->Height();
+    auto hashes = database_.BestChain();
 
-    } catch (...) {
+    for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+        const auto height = static_cast<block::Height>(i);
 
-        return false;
+        if (height > tip) { break; }
+
+        auto& hash = hashes.at(i);
+
+        if (hash->empty()) { break; }
+
+        output->Push({height, std::move(hash)});
     }
+
+    return output;
 }
 
 auto HeaderOracle::LoadBitcoinHeader(const block::Hash& hash) const noexcept
@@ -899,38 +1016,32 @@ auto HeaderOracle::LoadHeader(const block::Hash& hash) const noexcept
 }
 
 auto HeaderOracle::ProcessSyncData(
-    const network::zeromq::Message& work,
+    SyncHeaders& headers,
     ParsedSyncData& out) noexcept -> bool
 {
-    auto& [prior, vector] = out;
-    const auto b = work.Body();
+    auto& [prior, packets] = out;
 
-    if (3 > b.size()) { return false; }
+    if (headers.empty() || (headers.size() != packets.size())) {
+        return false;
+    }
 
-    vector.clear();
-    vector.reserve(b.size() - 1u);
     Lock lock(lock_);
     auto update = UpdateTransaction{api_, database_};
     auto previous = [&] {
-        const auto& first = b.at(2);
-        const auto data = proto::Factory<proto::BlockchainP2PSync>(first);
-        const auto height = static_cast<block::Height>(data.height());
+        const auto height = std::get<1>(packets.front());
 
         if (0 >= height) {
 
             return block::BlankHash();
         } else {
-            const auto prior = height - 1;
-            out.first = database_.BestBlock(prior);
+            prior = BestHash(height - 1);
 
-            return out.first;
+            return prior;
         }
     }();
 
-    for (auto i{std::next(b.begin(), 2)}; i != b.end(); std::advance(i, 1)) {
-        const auto sync = proto::Factory<proto::BlockchainP2PSync>(*i);
-        auto pHeader = factory::BitcoinBlockHeader(
-            api_, static_cast<Type>(sync.chain()), sync.header());
+    for (auto i = std::size_t{0}; i < headers.size(); ++i) {
+        auto& pHeader = headers.at(i);
 
         if (false == bool(pHeader)) {
             LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid header").Flush();
@@ -938,40 +1049,30 @@ auto HeaderOracle::ProcessSyncData(
             return false;
         }
 
-        {
-            const auto& header = *pHeader;
+        const auto& hash = std::get<0>(packets.at(i));
 
-            if (header.ParentHash() != previous) {
-                LogOutput(OT_METHOD)(__FUNCTION__)(": Non-contiguous headers")
-                    .Flush();
+        if (pHeader->ParentHash() != previous) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Non-contiguous headers")
+                .Flush();
 
-                return false;
-            }
+            return false;
+        }
 
-            const auto& [hash, height, type, count, filter] =
-                vector.emplace_back(
-                    header.Hash(),
-                    static_cast<block::Height>(sync.height()),
-                    static_cast<filter::Type>(sync.filter_type()),
-                    sync.filter_element_count(),
-                    api_.Factory().Data(sync.filter(), StringStyle::Raw));
-            previous = hash;
+        previous = hash;
 
-            if (is_in_best_chain(lock, hash).first) { continue; }
-        }
+        if (is_in_best_chain(*best_index(), hash).first) { continue; }
 
         if (false == add_header(lock, update, std::move(pHeader))) {
             LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to process header")
                 .Flush();
-            vector.pop_back();
 
             return false;
         }
     }
 
-    database_.ApplyUpdate(update);
+    apply_update(lock, update);
 
-    return 0 < vector.size();
+    return true;
 }
 
 auto HeaderOracle::stage_candidate(
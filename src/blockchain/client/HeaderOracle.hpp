@@ -6,6 +6,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <deque>
 #include <iosfwd>
 #include <map>
@@ -51,14 +52,6 @@ class UpdateTransaction;
 }  // namespace client
 }  // namespace blockchain
 
-namespace network
-{
-namespace zeromq
-{
-class Message;
-}  // namespace zeromq
-}  // namespace network
-
 class Factory;
 }  // namespace opentxs
 
@@ -67,6 +60,43 @@ namespace opentxs::blockchain::client::implementation
 class HeaderOracle final : virtual public internal::HeaderOracle
 {
 public:
+    // Best chain block hashes indexed by height
+    //
+    // Published indices are never modified. Updates are made to a copy which
+    // then replaces the published index, so readers do not need lock_. Hashes
+    // are stored in fixed size chunks which are shared between copies, so
+    // extending the chain only copies the last chunk.
+    class BestHashIndex
+    {
+    public:
+        /// Returns nullptr if height is not in the best chain
+        auto at(const block::Height height) const noexcept
+            -> const block::Hash*;
+        auto Tip() const noexcept -> block::Position;
+
+        /// Removes every hash above height
+        auto Pop(const block::Height height) noexcept -> void;
+        /// Returns false if position is not contiguous with the index
+        auto Push(const block::Position& position) noexcept -> bool;
+
+        BestHashIndex() noexcept;
+        BestHashIndex(const BestHashIndex&) noexcept;
+
+    private:
+        using Chunk = std::vector<block::pHash>;
+
+        static constexpr std::size_t chunk_size_{2048};
+
+        std::vector<std::shared_ptr<Chunk>> chunks_;
+        std::size_t size_;
+
+        auto writable(const std::size_t chunk) noexcept -> Chunk&;
+
+        BestHashIndex(BestHashIndex&&) = delete;
+        auto operator=(const BestHashIndex&) -> BestHashIndex& = delete;
+        auto operator=(BestHashIndex&&) -> BestHashIndex& = delete;
+    };
+
     auto Ancestors(
         const block::Position& start,
         const block::Position& target,
@@ -114,9 +144,8 @@ public:
         -> bool final;
     auto DeleteCheckpoint() noexcept -> bool final;
     auto Init() noexcept -> void final;
-    auto ProcessSyncData(
-        const network::zeromq::Message& work,
-        ParsedSyncData& out) noexcept -> bool final;
+    auto ProcessSyncData(SyncHeaders& headers, ParsedSyncData& out) noexcept
+        -> bool final;
 
     HeaderOracle(
         const api::Core& api,
@@ -132,36 +161,39 @@ private:
     };
 
     using Candidates = std::vector<Candidate>;
+    using Index = std::shared_ptr<const BestHashIndex>;
 
     const api::Core& api_;
     const internal::HeaderDatabase& database_;
     const blockchain::Type chain_;
     mutable std::mutex lock_;
+    // Only access with std::atomic_load and std::atomic_store
+    Index best_;
 
     static auto evaluate_candidate(
         const block::Header& current,
         const block::Header& candidate) noexcept -> bool;
 
-    auto best_chain(const Lock& lock) const noexcept -> block::Position;
     auto best_chain(
-        const Lock& lock,
+        const BestHashIndex& index,
         const block::Position& tip,
         const std::size_t limit) const noexcept -> Positions;
     auto best_hashes(
-        const Lock& lock,
+        const BestHashIndex& index,
         const block::Height start,
         const block::Hash& stop,
         const std::size_t limit) const noexcept -> Hashes;
-    auto common_parent(const Lock& lock, const block::Position& position)
-        const noexcept -> std::pair<block::Position, block::Position>;
-    auto is_in_best_chain(const Lock& lock, const block::Hash& hash)
+    auto best_index() const noexcept -> Index;
+    auto common_parent(
+        const BestHashIndex& index,
+        const block::Position& position) const noexcept
+        -> std::pair<block::Position, block::Position>;
+    auto is_in_best_chain(const BestHashIndex& index, const block::Hash& hash)
         const noexcept -> std::pair<bool, block::Height>;
-    auto is_in_best_chain(const Lock& lock, const block::Position& position)
-        const noexcept -> bool;
     auto is_in_best_chain(
-        const Lock& lock,
-        const block::Height height,
-        const block::Hash& hash) const noexcept -> bool;
+        const BestHashIndex& index,
+        const block::Position& position) const noexcept -> bool;
+    auto load_index() const noexcept -> std::shared_ptr<BestHashIndex>;
 
     auto add_header(
         const Lock& lock,
@@ -171,6 +203,9 @@ private:
         const Lock& lock,
         const block::Height height,
         UpdateTransaction& update) noexcept -> bool;
+    auto apply_update(
+        const Lock& lock,
+        const UpdateTransaction& update) noexcept -> bool;
     auto choose_candidate(
         const block::Header& current,
         const Candidates& candidates,
@@ -0,0 +1,352 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"                          // IWYU pragma: associated
+#include "1_Internal.hpp"                        // IWYU pragma: associated
+#include "blockchain/client/HeaderSegments.hpp"  // IWYU pragma: associated
+
+#include <iterator>
+#include <map>
+#include <tuple>
+#include <utility>
+
+#include "internal/blockchain/client/Factory.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/LogSource.hpp"
+
+#define OT_METHOD                                                              \
+    "opentxs::blockchain::client::implementation::HeaderSegments::"
+
+namespace opentxs::factory
+{
+auto BlockchainHeaderSegments(
+    const blockchain::client::internal::Config& config,
+    blockchain::client::internal::HeaderOracle& header) noexcept
+    -> std::unique_ptr<blockchain::client::internal::HeaderSegments>
+{
+    using ReturnType = blockchain::client::implementation::HeaderSegments;
+
+    return std::make_unique<ReturnType>(config, header);
+}
+}  // namespace opentxs::factory
+
+namespace opentxs::blockchain::client::implementation
+{
+HeaderSegments::Segment::Segment(
+    block::Position start,
+    std::optional<block::Position> stop) noexcept
+    : start_(start)
+    , stop_(std::move(stop))
+    , progress_(std::move(start))
+    , headers_()
+    , peer_()
+    , updated_()
+    , complete_(false)
+{
+}
+
+HeaderSegments::HeaderSegments(
+    const internal::Config& config,
+    internal::HeaderOracle& header,
+    const std::chrono::milliseconds timeout) noexcept
+    : enabled_(false == config.disable_segmented_headers_)
+    , timeout_(timeout)
+    , header_(header)
+    , lock_()
+    , flush_lock_()
+    , planned_(false)
+    , segments_()
+{
+}
+
+auto HeaderSegments::Assign(const int peer) const noexcept
+    -> std::optional<Request>
+{
+    auto lock = Lock{lock_};
+    plan(lock);
+    const auto now = Clock::now();
+
+    if (auto it = find(lock, peer); segments_.end() != it) {
+        it->updated_ = now;
+
+        return request(*it);
+    }
+
+    if (buffered(lock) >= buffer_limit_) { return std::nullopt; }
+
+    for (auto& segment : segments_) {
+        if (segment.complete_) { continue; }
+
+        const auto stalled =
+            segment.peer_.has_value() && ((now - segment.updated_) > timeout_);
+
+        if (segment.peer_.has_value() && (false == stalled)) { continue; }
+
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": Assigning segment starting at ")(
+            segment.start_.first)(" to peer ")(peer)
+            .Flush();
+        segment.peer_ = peer;
+        segment.updated_ = now;
+
+        return request(segment);
+    }
+
+    return std::nullopt;
+}
+
+auto HeaderSegments::buffered(const Lock&) const noexcept -> std::size_t
+{
+    auto output = std::size_t{0};
+
+    for (const auto& segment : segments_) {
+        output += segment.headers_.size();
+    }
+
+    return output;
+}
+
+auto HeaderSegments::find(const Lock&, const int peer) const noexcept
+    -> std::list<Segment>::iterator
+{
+    auto it = segments_.begin();
+
+    for (; segments_.end() != it; ++it) {
+        if (it->peer_.has_value() && (peer == it->peer_.value())) { break; }
+    }
+
+    return it;
+}
+
+auto HeaderSegments::Flush() const noexcept -> void
+{
+    // Segments are only erased here, so the segment being added remains valid
+    // while lock_ is released
+    auto flush = Lock{flush_lock_};
+
+    while (true) {
+        auto ready = std::vector<std::unique_ptr<block::Header>>{};
+        auto adding = std::optional<std::list<Segment>::iterator>{};
+
+        {
+            auto lock = Lock{lock_};
+            const auto tip = header_.BestChain().first;
+            auto it = segments_.begin();
+
+            while (segments_.end() != it) {
+                auto& segment = *it;
+                const auto obsolete =
+                    (segment.complete_ && (tip >= segment.progress_.first)) ||
+                    (segment.stop_.has_value() &&
+                     (tip >= segment.stop_->first));
+
+                if (obsolete) {
+                    it = segments_.erase(it);
+
+                    continue;
+                }
+
+                const auto connected =
+                    segment.complete_ &&
+                    (header_.BestHash(segment.start_.first) ==
+                     segment.start_.second);
+
+                if (connected) {
+                    ready = std::move(segment.headers_);
+                    adding = it;
+
+                    break;
+                }
+
+                ++it;
+            }
+        }
+
+        if (false == adding.has_value()) { return; }
+
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": Adding ")(ready.size())(
+            " headers from completed segment")
+            .Flush();
+        const auto added = header_.AddHeaders(ready);
+        auto lock = Lock{lock_};
+        auto& segment = *adding.value();
+
+        if (false == added) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Header oracle rejected segment starting at ")(
+                segment.start_.first)
+                .Flush();
+            // Download the segment again, possibly from a different peer
+            reset(lock, segment);
+
+            return;
+        }
+
+        segments_.erase(adding.value());
+    }
+}
+
+auto HeaderSegments::plan(const Lock&) const noexcept -> void
+{
+    if (planned_) { return; }
+
+    planned_ = true;
+
+    if (false == enabled_) { return; }
+
+    const auto tip = header_.BestChain().first;
+    auto boundaries = std::map<block::Height, block::pHash>{};
+
+    {
+        const auto [height, hash, parent, filter] =
+            header_.GetDefaultCheckpoint();
+
+        if (height > tip) { boundaries.try_emplace(height, hash); }
+    }
+
+    {
+        const auto [height, hash] = header_.GetCheckpoint();
+
+        if (height > tip) { boundaries.insert_or_assign(height, hash); }
+    }
+
+    for (auto i = boundaries.begin(); boundaries.end() != i; ++i) {
+        const auto next = std::next(i);
+
+        if (boundaries.end() == next) {
+            segments_.emplace_back(*i, std::nullopt);
+        } else {
+            segments_.emplace_back(*i, *next);
+        }
+    }
+
+    LogVerbose(OT_METHOD)(__FUNCTION__)(": Planned ")(segments_.size())(
+        " segments above height ")(tip)
+        .Flush();
+}
+
+auto HeaderSegments::Receive(
+    const int peer,
+    std::vector<std::unique_ptr<block::Header>>&& headers) const noexcept
+    -> void
+{
+    auto complete{false};
+
+    {
+        auto lock = Lock{lock_};
+        auto it = find(lock, peer);
+
+        if (segments_.end() == it) {
+            LogVerbose(OT_METHOD)(__FUNCTION__)(
+                ": No segment is assigned to peer ")(peer)
+                .Flush();
+
+            return;
+        }
+
+        auto& segment = *it;
+        segment.updated_ = Clock::now();
+
+        if (headers.empty()) {
+            // The peer has no headers beyond the current progress
+            segment.complete_ = (false == segment.stop_.has_value());
+            segment.peer_.reset();
+            complete = segment.complete_;
+        } else if (
+            headers.front()->ParentHash() != segment.progress_.second) {
+            LogVerbose(OT_METHOD)(__FUNCTION__)(
+                ": Headers do not connect to segment starting at ")(
+                segment.start_.first)
+                .Flush();
+
+            return;
+        } else {
+            const auto received = headers.size();
+            auto height = segment.progress_.first;
+
+            for (auto& header : headers) {
+                ++height;
+
+                if (segment.stop_.has_value()) {
+                    const auto& [stopHeight, stopHash] = segment.stop_.value();
+
+                    if ((height == stopHeight) &&
+                        (header->Hash() != stopHash)) {
+                        LogOutput(OT_METHOD)(__FUNCTION__)(": Peer ")(peer)(
+                            " provided headers which do not match the "
+                            "checkpoint at height ")(stopHeight)
+                            .Flush();
+                        reset(lock, segment);
+
+                        return;
+                    }
+                }
+
+                segment.progress_ = {height, header->Hash()};
+                segment.headers_.emplace_back(std::move(header));
+
+                if (segment.stop_.has_value() &&
+                    (height == segment.stop_->first)) {
+                    segment.complete_ = true;
+
+                    break;
+                }
+            }
+
+            if (segment.stop_.has_value()) {
+                // A short batch means the peer does not have the rest of the
+                // segment
+                if (segment.complete_ || (received < batch_size_)) {
+                    segment.peer_.reset();
+                }
+            } else if (received < batch_size_) {
+                segment.complete_ = true;
+                segment.peer_.reset();
+            } else if (segment.headers_.size() >= segment_limit_) {
+                // Split the segment so the headers received so far can be
+                // added as soon as they connect. The same peer continues with
+                // the remainder.
+                segment.stop_ = segment.progress_;
+                segment.complete_ = true;
+                auto& next = *segments_.emplace(
+                    std::next(it), segment.progress_, std::nullopt);
+                next.peer_ = segment.peer_;
+                next.updated_ = segment.updated_;
+                segment.peer_.reset();
+            }
+
+            complete = segment.complete_;
+        }
+    }
+
+    if (complete) { Flush(); }
+}
+
+auto HeaderSegments::Release(const int peer) const noexcept -> void
+{
+    auto lock = Lock{lock_};
+
+    if (auto it = find(lock, peer); segments_.end() != it) {
+        it->peer_.reset();
+    }
+}
+
+auto HeaderSegments::request(const Segment& segment) noexcept -> Request
+{
+    return Request{
+        segment.progress_.second,
+        segment.stop_.has_value() ? segment.stop_->second : Data::Factory()};
+}
+
+auto HeaderSegments::reset(const Lock&, Segment& segment) const noexcept
+    -> void
+{
+    segment.progress_ = segment.start_;
+    segment.headers_.clear();
+    segment.peer_.reset();
+    segment.complete_ = false;
+}
+}  // namespace opentxs::blockchain::client::implementation
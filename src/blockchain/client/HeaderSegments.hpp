@@ -0,0 +1,96 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "internal/blockchain/client/Client.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/blockchain/block/Header.hpp"
+
+namespace opentxs::blockchain::client::implementation
+{
+/// Splits the best chain above the local tip at known checkpoints
+///
+/// The headers between the local tip and the first checkpoint are downloaded
+/// by the normal header sync. Every later segment is assigned to a single
+/// peer at a time and is reassigned if that peer stops responding. Complete
+/// segments are buffered until the header oracle reaches their first block.
+class HeaderSegments final : public internal::HeaderSegments
+{
+public:
+    auto Assign(const int peer) const noexcept -> std::optional<Request> final;
+    auto Flush() const noexcept -> void final;
+    auto Receive(
+        const int peer,
+        std::vector<std::unique_ptr<block::Header>>&& headers) const noexcept
+        -> void final;
+    auto Release(const int peer) const noexcept -> void final;
+
+    HeaderSegments(
+        const internal::Config& config,
+        internal::HeaderOracle& header,
+        const std::chrono::milliseconds timeout = default_timeout_) noexcept;
+
+    ~HeaderSegments() final = default;
+
+private:
+    struct Segment {
+        const block::Position start_;
+        // Unset if the segment follows the last checkpoint
+        std::optional<block::Position> stop_;
+        block::Position progress_;
+        std::vector<std::unique_ptr<block::Header>> headers_;
+        std::optional<int> peer_;
+        Time updated_;
+        bool complete_;
+
+        Segment(
+            block::Position start,
+            std::optional<block::Position> stop) noexcept;
+    };
+
+    // Maximum number of headers in a getheaders reply
+    static constexpr std::size_t batch_size_{2000};
+    // A segment which follows the last checkpoint is split once it holds
+    // this many headers
+    static constexpr std::size_t segment_limit_{50000};
+    // No segments are assigned while this many headers are buffered
+    static constexpr std::size_t buffer_limit_{250000};
+    static constexpr auto default_timeout_ = std::chrono::seconds{30};
+
+    const bool enabled_;
+    // Segments are reassigned if the peer does not respond for this long
+    const std::chrono::milliseconds timeout_;
+    internal::HeaderOracle& header_;
+    mutable std::mutex lock_;
+    // Serializes Flush
+    mutable std::mutex flush_lock_;
+    mutable bool planned_;
+    mutable std::list<Segment> segments_;
+
+    static auto request(const Segment& segment) noexcept -> Request;
+
+    auto buffered(const Lock& lock) const noexcept -> std::size_t;
+    auto find(const Lock& lock, const int peer) const noexcept
+        -> std::list<Segment>::iterator;
+    auto plan(const Lock& lock) const noexcept -> void;
+    auto reset(const Lock& lock, Segment& segment) const noexcept -> void;
+
+    HeaderSegments() = delete;
+    HeaderSegments(const HeaderSegments&) = delete;
+    HeaderSegments(HeaderSegments&&) = delete;
+    auto operator=(const HeaderSegments&) -> HeaderSegments& = delete;
+    auto operator=(HeaderSegments&&) -> HeaderSegments& = delete;
+};
+}  // namespace opentxs::blockchain::client::implementation
@@ -0,0 +1,263 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"                   // IWYU pragma: associated
+#include "1_Internal.hpp"                 // IWYU pragma: associated
+#include "blockchain/client/Mempool.hpp"  // IWYU pragma: associated
+
+#include <memory>
+#include <utility>
+
+#include "internal/blockchain/client/Factory.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/blockchain/block/bitcoin/Block.hpp"
+#include "opentxs/blockchain/block/bitcoin/Input.hpp"
+#include "opentxs/blockchain/block/bitcoin/Inputs.hpp"
+#include "opentxs/blockchain/block/bitcoin/Transaction.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/LogSource.hpp"
+
+#define OT_METHOD "opentxs::blockchain::client::implementation::Mempool::"
+
+namespace opentxs::factory
+{
+auto BlockchainMempool(
+    const blockchain::client::internal::Config& config,
+    const blockchain::client::internal::Wallet& wallet) noexcept
+    -> std::unique_ptr<blockchain::client::internal::Mempool>
+{
+    using ReturnType = blockchain::client::implementation::Mempool;
+
+    return std::make_unique<ReturnType>(config, wallet);
+}
+}  // namespace opentxs::factory
+
+namespace opentxs::blockchain::client::implementation
+{
+Mempool::Mempool(
+    const internal::Config& config,
+    const internal::Wallet& wallet) noexcept
+    : wallet_(wallet)
+    , max_bytes_(config.mempool_bytes_)
+    , expiry_(config.mempool_expiry_hours_)
+    , lock_()
+    , transactions_()
+    , received_()
+    , spent_()
+    , requested_()
+    , bytes_(0)
+{
+}
+
+auto Mempool::Dump() const noexcept -> std::vector<block::pTxid>
+{
+    auto lock = Lock{lock_};
+    expire(lock, Clock::now());
+    auto output = std::vector<block::pTxid>{};
+    output.reserve(transactions_.size());
+
+    for (const auto& [txid, entry] : transactions_) {
+        output.emplace_back(entry.tx_->ID());
+    }
+
+    return output;
+}
+
+auto Mempool::evict(const Lock& lock, std::vector<block::pTxid>& removed)
+    const noexcept -> void
+{
+    OT_ASSERT(false == received_.empty());
+
+    auto it = transactions_.find(received_.front());
+
+    OT_ASSERT(transactions_.end() != it);
+
+    removed.emplace_back(remove(lock, it));
+}
+
+auto Mempool::expire(const Lock& lock, const Time now) const noexcept -> void
+{
+    auto removed = std::vector<block::pTxid>{};
+
+    while (false == received_.empty()) {
+        const auto& entry = transactions_.at(received_.front());
+
+        if ((now - entry.received_) < expiry_) { break; }
+
+        evict(lock, removed);
+    }
+
+    if (0 < removed.size()) { wallet_.ExpireMempool(std::move(removed)); }
+
+    for (auto i = requested_.begin(); i != requested_.end();) {
+        if ((now - i->second) < request_timeout_) {
+            ++i;
+        } else {
+            i = requested_.erase(i);
+        }
+    }
+}
+
+auto Mempool::Prune(const block::bitcoin::Block& mined) const noexcept -> void
+{
+    auto lock = Lock{lock_};
+    auto confirmed = std::size_t{0};
+    auto conflicts = std::vector<block::pTxid>{};
+
+    for (const auto& pTx : mined) {
+        OT_ASSERT(pTx);
+
+        const auto& tx = *pTx;
+        const auto key = space(tx.ID().Bytes());
+        requested_.erase(key);
+
+        if (auto it = transactions_.find(key); transactions_.end() != it) {
+            remove(lock, it);
+            ++confirmed;
+
+            continue;
+        }
+
+        for (const auto& input : tx.Inputs()) {
+            const auto spent = spent_.find(input.PreviousOutput());
+
+            if (spent_.end() == spent) { continue; }
+
+            auto it = transactions_.find(spent->second);
+
+            OT_ASSERT(transactions_.end() != it);
+
+            conflicts.emplace_back(remove(lock, it));
+        }
+    }
+
+    if ((0 < confirmed) || (0 < conflicts.size())) {
+        LogTrace(OT_METHOD)(__FUNCTION__)(": removed ")(confirmed)(
+            " confirmed and ")(conflicts.size())(
+            " conflicting transactions for block ")(mined.ID().asHex())
+            .Flush();
+    }
+
+    if (0 < conflicts.size()) { wallet_.ExpireMempool(std::move(conflicts)); }
+}
+
+auto Mempool::Query(const ReadView txid) const noexcept -> Transaction
+{
+    auto lock = Lock{lock_};
+    expire(lock, Clock::now());
+
+    if (auto it = transactions_.find(space(txid)); transactions_.end() != it) {
+
+        return it->second.tx_;
+    }
+
+    return {};
+}
+
+auto Mempool::remove(const Lock&, std::map<Space, Entry>::iterator it)
+    const noexcept -> block::pTxid
+{
+    auto& entry = it->second;
+    auto output = block::pTxid{entry.tx_->ID()};
+
+    for (const auto& input : entry.tx_->Inputs()) {
+        spent_.erase(input.PreviousOutput());
+    }
+
+    bytes_ -= entry.bytes_;
+    received_.erase(entry.position_);
+    transactions_.erase(it);
+
+    return output;
+}
+
+auto Mempool::Request(std::vector<block::pTxid>&& txids) const noexcept
+    -> std::vector<block::pTxid>
+{
+    if (0 == max_bytes_) { return {}; }
+
+    const auto now = Clock::now();
+    auto lock = Lock{lock_};
+    expire(lock, now);
+    auto output = std::vector<block::pTxid>{};
+
+    for (auto& txid : txids) {
+        auto key = space(txid->Bytes());
+
+        if (0 < transactions_.count(key)) { continue; }
+
+        if (requested_.try_emplace(std::move(key), now).second) {
+            output.emplace_back(std::move(txid));
+        }
+    }
+
+    return output;
+}
+
+auto Mempool::Snapshot() const noexcept -> Transactions
+{
+    auto lock = Lock{lock_};
+    expire(lock, Clock::now());
+    auto output = Transactions{};
+    output.reserve(transactions_.size());
+
+    for (const auto& [txid, entry] : transactions_) {
+        output.emplace_back(entry.tx_);
+    }
+
+    return output;
+}
+
+auto Mempool::Submit(Transaction tx) const noexcept -> bool
+{
+    if (false == bool(tx)) { return false; }
+
+    const auto bytes = tx->CalculateSize();
+
+    if (bytes > max_bytes_) { return false; }
+
+    const auto now = Clock::now();
+    auto lock = Lock{lock_};
+    expire(lock, now);
+    auto key = space(tx->ID().Bytes());
+    requested_.erase(key);
+
+    if (0 < transactions_.count(key)) { return false; }
+
+    for (const auto& input : tx->Inputs()) {
+        if (0 < spent_.count(input.PreviousOutput())) {
+            LogTrace(OT_METHOD)(__FUNCTION__)(": transaction ")(
+                tx->ID().asHex())(" conflicts with a transaction in mempool")
+                .Flush();
+
+            return false;
+        }
+    }
+
+    for (const auto& input : tx->Inputs()) {
+        spent_.emplace(input.PreviousOutput(), key);
+    }
+
+    auto position = received_.emplace(received_.end(), key);
+    transactions_.try_emplace(std::move(key), Entry{tx, bytes, now, position});
+    bytes_ += bytes;
+    auto removed = std::vector<block::pTxid>{};
+
+    while (bytes_ > max_bytes_) { evict(lock, removed); }
+
+    LogTrace(OT_METHOD)(__FUNCTION__)(": added transaction ")(tx->ID().asHex())(
+        ". ")(transactions_.size())(" transactions totalling ")(bytes_)(
+        " bytes in mempool")
+        .Flush();
+    // The wallet is notified while the lock is held so that it sees additions
+    // and removals of the same transaction in the order they happened
+    wallet_.ProcessMempool(std::move(tx));
+
+    if (0 < removed.size()) { wallet_.ExpireMempool(std::move(removed)); }
+
+    return true;
+}
+}  // namespace opentxs::blockchain::client::implementation
@@ -0,0 +1,87 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "internal/blockchain/client/Client.hpp"
+#include "opentxs/Bytes.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/blockchain/block/bitcoin/Input.hpp"
+
+namespace opentxs::blockchain::client::implementation
+{
+/// In-memory pool of unconfirmed transactions
+///
+/// Transactions are evicted in the order they were received once the pool
+/// holds more than the configured number of bytes, or once they are older
+/// than the configured expiry. A transaction which spends an outpoint already
+/// spent by another transaction in the pool is rejected. Every newly accepted
+/// transaction is passed to the wallet, and the wallet is told about every
+/// transaction which leaves the pool without being mined.
+class Mempool final : public internal::Mempool
+{
+public:
+    auto Dump() const noexcept -> std::vector<block::pTxid> final;
+    auto Prune(const block::bitcoin::Block& block) const noexcept
+        -> void final;
+    auto Query(const ReadView txid) const noexcept -> Transaction final;
+    auto Request(std::vector<block::pTxid>&& txids) const noexcept
+        -> std::vector<block::pTxid> final;
+    auto Snapshot() const noexcept -> Transactions final;
+    auto Submit(Transaction tx) const noexcept -> bool final;
+
+    Mempool(
+        const internal::Config& config,
+        const internal::Wallet& wallet) noexcept;
+
+    ~Mempool() final = default;
+
+private:
+    using Order = std::list<Space>;
+
+    struct Entry {
+        Transaction tx_;
+        std::size_t bytes_;
+        Time received_;
+        Order::iterator position_;
+    };
+
+    // Announcements of a transaction by other peers are ignored for this long
+    // after it has been requested
+    static constexpr auto request_timeout_ = std::chrono::seconds{30};
+
+    const internal::Wallet& wallet_;
+    const std::size_t max_bytes_;
+    const std::chrono::hours expiry_;
+    mutable std::mutex lock_;
+    mutable std::map<Space, Entry> transactions_;
+    // txids in the order they were received
+    mutable Order received_;
+    // outpoints spent by transactions in the pool
+    mutable std::map<block::bitcoin::Outpoint, Space> spent_;
+    mutable std::map<Space, Time> requested_;
+    mutable std::size_t bytes_;
+
+    auto evict(const Lock& lock, std::vector<block::pTxid>& removed)
+        const noexcept -> void;
+    auto expire(const Lock& lock, const Time now) const noexcept -> void;
+    auto remove(const Lock& lock, std::map<Space, Entry>::iterator it)
+        const noexcept -> block::pTxid;
+
+    Mempool() = delete;
+    Mempool(const Mempool&) = delete;
+    Mempool(Mempool&&) = delete;
+    auto operator=(const Mempool&) -> Mempool& = delete;
+    auto operator=(Mempool&&) -> Mempool& = delete;
+};
+}  // namespace opentxs::blockchain::client::implementation
@@ -18,8 +18,10 @@
 #include <utility>
 #include <vector>
 
+#include "blockchain/client/network/SyncPipeline.hpp"
 #include "blockchain/client/network/SyncServer.hpp"
 #include "internal/blockchain/Params.hpp"
+#include "internal/blockchain/block/bitcoin/Bitcoin.hpp"
 #include "internal/blockchain/client/Factory.hpp"
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/Proto.tpp"
@@ -33,6 +35,7 @@
 #include "opentxs/api/client/blockchain/Subchain.hpp"
 #include "opentxs/blockchain/block/Header.hpp"
 #include "opentxs/blockchain/block/bitcoin/Block.hpp"
+#include "opentxs/blockchain/block/bitcoin/Transaction.hpp"
 #include "opentxs/blockchain/client/BlockOracle.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Identifier.hpp"
@@ -53,6 +56,7 @@
 #include "opentxs/protobuf/BlockchainTransactionProposedOutput.pb.h"
 #include "opentxs/protobuf/HDPath.pb.h"
 #include "opentxs/protobuf/PaymentCode.pb.h"
+#include "util/Blank.hpp"
 
 #define OT_METHOD "opentxs::blockchain::client::implementation::Network::"
 
@@ -61,6 +65,9 @@ namespace opentxs::blockchain::client::implementation
 constexpr auto proposal_version_ = VersionNumber{1};
 constexpr auto notification_version_ = VersionNumber{1};
 constexpr auto output_version_ = VersionNumber{1};
+// Header batches are only divided between thread pool workers when each
+// worker will receive at least this many headers
+constexpr auto min_headers_per_thread_ = std::size_t{250};
 
 struct NullWallet final : public internal::Wallet {
     const api::Core& api_;
@@ -73,6 +80,15 @@ struct NullWallet final : public internal::Wallet {
 
         return promise.get_future();
     }
+    auto ExpireMempool(std::vector<block::pTxid>&&) const noexcept
+        -> void final
+    {
+    }
+    auto ProcessMempool(internal::Mempool::Transaction) const noexcept
+        -> void final
+    {
+    }
+
     auto Init() noexcept -> void final {}
     auto Shutdown() noexcept -> std::shared_future<void> final
     {
@@ -107,12 +123,14 @@ Network::Network(
           api,
           blockchain,
           *this,
+          config,
           blockchain.BlockchainDB(),
           type))
     , config_(config)
     , header_p_(factory::HeaderOracle(api, *database_p_, type))
     , block_p_(factory::BlockOracle(
           api,
+          config_,
           *this,
           *header_p_,
           *database_p_,
@@ -155,6 +173,8 @@ Network::Network(
                 shutdown_sender_.endpoint_);
         }
     }())
+    , mempool_p_(factory::BlockchainMempool(config_, *wallet_p_))
+    , segments_p_(factory::BlockchainHeaderSegments(config_, *header_p_))
     , blockchain_(blockchain)
     , chain_(type)
     , database_(*database_p_)
@@ -163,6 +183,8 @@ Network::Network(
     , peer_(*peer_p_)
     , block_(*block_p_)
     , wallet_(*wallet_p_)
+    , mempool_(*mempool_p_)
+    , segments_(*segments_p_)
     , parent_(blockchain)
     , sync_endpoint_(syncEndpoint)
     , sync_server_([&] {
@@ -181,6 +203,13 @@ Network::Network(
             return std::unique_ptr<SyncServer>{};
         }
     }())
+    , sync_pipeline_([&] {
+        if (config_.use_sync_server_) {
+            return std::make_unique<SyncPipeline>(*this);
+        } else {
+            return std::unique_ptr<SyncPipeline>{};
+        }
+    }())
     , local_chain_height_(0)
     , remote_chain_height_(
           params::Data::Chains().at(chain_).checkpoint_.height_)
@@ -197,6 +226,8 @@ Network::Network(
     OT_ASSERT(peer_p_);
     OT_ASSERT(block_p_);
     OT_ASSERT(wallet_p_);
+    OT_ASSERT(mempool_p_);
+    OT_ASSERT(segments_p_);
 
     database_.SetDefaultFilterType(filters_.DefaultType());
     header_.Init();
@@ -279,6 +310,10 @@ auto Network::BroadcastTransaction(
 {
     if (false == running_.get()) { return false; }
 
+    // Peers which request the transaction after receiving it are served from
+    // the mempool
+    mempool_.Submit(tx.clone());
+
     return peer_.BroadcastTransaction(tx);
 }
 
@@ -339,6 +374,55 @@ auto Network::init() noexcept -> void
     trigger();
 }
 
+auto Network::instantiate_headers(const std::vector<ReadView>& payloads)
+    const noexcept -> std::vector<std::unique_ptr<block::Header>>
+{
+    return InstantiateHeaders(api_, payloads, [this](const auto payload) {
+        return instantiate_header(payload);
+    });
+}
+
+auto Network::InstantiateHeaders(
+    const api::Core& api,
+    const std::vector<ReadView>& payloads,
+    const HeaderFactory& factory) noexcept
+    -> std::vector<std::unique_ptr<block::Header>>
+{
+    // Hashing and proof of work checks happen when headers are instantiated,
+    // so a batch is validated in parallel before the header oracle is locked
+    auto output = std::vector<std::unique_ptr<block::Header>>(payloads.size());
+    api::internal::ThreadPool::Parallel(
+        api,
+        payloads.size(),
+        min_headers_per_thread_,
+        [&](const auto first, const auto last) {
+            for (auto i = first; i < last; ++i) {
+                output.at(i) = factory(payloads.at(i));
+            }
+        });
+    const block::Header* previous{nullptr};
+
+    for (const auto& header : output) {
+        if (false == bool(header)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid header").Flush();
+
+            return {};
+        }
+
+        if ((nullptr != previous) &&
+            (header->ParentHash() != previous->Hash())) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Headers are not contiguous")
+                .Flush();
+
+            return {};
+        }
+
+        previous = header.get();
+    }
+
+    return output;
+}
+
 auto Network::is_synchronized_blocks() const noexcept -> bool
 {
     return block_.Tip().first >= this->target();
@@ -397,6 +481,10 @@ auto Network::pipeline(zmq::Message& in) noexcept -> void
         case Task::SubmitBlock: {
             process_block(in);
         } break;
+        case Task::SubmitHeaderSegment: {
+            process_header_segment(in);
+            do_work();
+        } break;
         case Task::SubmitBlockHeader: {
             process_header(in);
             [[fallthrough]];
@@ -410,6 +498,9 @@ auto Network::pipeline(zmq::Message& in) noexcept -> void
         case Task::SyncData: {
             process_sync_data(in);
         } break;
+        case Task::SyncRequest: {
+            blockchain_.RequestSyncData(chain_);
+        } break;
         case Task::Heartbeat: {
             block_.Heartbeat();
             filters_.Heartbeat();
@@ -511,20 +602,74 @@ auto Network::process_header(network::zeromq::Message& in) noexcept -> void
     OT_ASSERT(pPromise);
 
     auto& promise = *pPromise;
-    auto headers = std::vector<std::unique_ptr<block::Header>>{};
+    auto headers = instantiate_headers(input);
+
+    if (false == headers.empty()) {
+        header_.AddHeaders(headers);
+        segments_.Flush();
+    }
+
+    promise.set_value();
+}
+
+auto Network::process_header_segment(network::zeromq::Message& in) noexcept
+    -> void
+{
+    if (false == running_.get()) { return; }
+
+    using Promise = std::promise<void>;
+    auto pPromise = std::unique_ptr<Promise>{};
+    auto peer{-1};
+    auto input = std::vector<ReadView>{};
+
+    {
+        auto counter{-1};
+        const auto body = in.Body();
+
+        if (3 > body.size()) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid message").Flush();
+
+            return;
+        }
 
-    for (const auto& header : input) {
-        headers.emplace_back(instantiate_header(header));
+        for (const auto& frame : body) {
+            switch (++counter) {
+                case 0: {
+                    break;
+                }
+                case 1: {
+                    pPromise.reset(
+                        reinterpret_cast<Promise*>(frame.as<std::uintptr_t>()));
+                } break;
+                case 2: {
+                    peer = frame.as<int>();
+                } break;
+                default: {
+                    input.emplace_back(frame.Bytes());
+                }
+            }
+        }
     }
 
-    if (false == headers.empty()) { header_.AddHeaders(headers); }
+    OT_ASSERT(pPromise);
+
+    auto& promise = *pPromise;
+    auto headers = instantiate_headers(input);
+
+    if (headers.empty() && (false == input.empty())) {
+        // Headers which fail validation are discarded along with the rest of
+        // the batch and the segment is requested again
+        segments_.Release(peer);
+    } else {
+        segments_.Receive(peer, std::move(headers));
+    }
 
     promise.set_value();
 }
 
 auto Network::process_sync_data(network::zeromq::Message& in) noexcept -> void
 {
-    auto parsed = ParsedSyncData{api_.Factory().Data(), {}};
+    if (false == bool(sync_pipeline_)) { return; }
 
     {
         const auto hello =
@@ -549,12 +694,7 @@ auto Network::process_sync_data(network::zeromq::Message& in) noexcept -> void
         }
     }
 
-    if (false == header_.ProcessSyncData(in, parsed)) { return; }
-
-    LogVerbose(OT_METHOD)(__FUNCTION__)(": Accepted ")(parsed.second.size())(
-        " of ")(in.Body().size() - 2)(" headers")
-        .Flush();
-    filters_.ProcessSyncData(parsed);
+    sync_pipeline_->Push(in);
 }
 
 auto Network::RequestBlock(const block::Hash& block) const noexcept -> bool
@@ -759,6 +899,14 @@ auto Network::shutdown(std::promise<void>& promise) noexcept -> void
     }
 }
 
+auto Network::Shutdown() noexcept -> std::shared_future<void>
+{
+    // The worker thread may be waiting for space in the sync pipeline
+    if (sync_pipeline_) { sync_pipeline_->Shutdown(); }
+
+    return stop_worker();
+}
+
 auto Network::shutdown_endpoint() noexcept -> std::string
 {
     return std::string{"inproc://"} + Identifier::Random()->str();
@@ -915,6 +1063,13 @@ auto Network::Submit(network::zeromq::Message& work) const noexcept -> void
     pipeline_->Push(work);
 }
 
+auto Network::SyncPosition() const noexcept -> block::Position
+{
+    if (sync_pipeline_) { return sync_pipeline_->Position(); }
+
+    return make_blank<block::Position>::value(api_);
+}
+
 auto Network::target() const noexcept -> block::Height
 {
     return std::max(local_chain_height_.load(), remote_chain_height_.load());
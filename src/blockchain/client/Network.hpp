@@ -6,6 +6,7 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
 #include <future>
 #include <iosfwd>
 #include <memory>
@@ -100,8 +101,12 @@ class Network : virtual public internal::Network,
                 public Worker<Network, api::Core>
 {
 public:
+    class SyncPipeline;
     class SyncServer;
 
+    using HeaderFactory =
+        std::function<std::unique_ptr<block::Header>(const ReadView)>;
+
     enum class Work : OTZMQWorkType {
         shutdown = value(WorkType::Shutdown),
         heartbeat = OT_ZMQ_HEARTBEAT_SIGNAL,
@@ -109,6 +114,16 @@ public:
         statemachine = OT_ZMQ_STATE_MACHINE_SIGNAL,
     };
 
+    /// Instantiates a batch of headers on the thread pool
+    ///
+    /// Returns an empty vector if any header is invalid or if the headers do
+    /// not form a contiguous sequence.
+    static auto InstantiateHeaders(
+        const api::Core& api,
+        const std::vector<ReadView>& payloads,
+        const HeaderFactory& factory) noexcept
+        -> std::vector<std::unique_ptr<block::Header>>;
+
     auto AddBlock(const std::shared_ptr<const block::bitcoin::Block> block)
         const noexcept -> bool final;
     auto AddPeer(const p2p::Address& address) const noexcept -> bool final;
@@ -139,6 +154,10 @@ public:
     {
         return database_.GetBalance(owner);
     }
+    auto GetConfig() const noexcept -> const internal::Config& final
+    {
+        return config_;
+    }
     auto GetConfirmations(const std::string& txid) const noexcept
         -> ChainHeight final;
     auto GetHeight() const noexcept -> ChainHeight final
@@ -152,6 +171,11 @@ public:
     {
         return header_;
     }
+    auto HeaderSegments() const noexcept
+        -> const internal::HeaderSegments& final
+    {
+        return segments_;
+    }
     auto Heartbeat() const noexcept -> void final
     {
         pipeline_->Push(MakeWork(Task::Heartbeat));
@@ -163,6 +187,10 @@ public:
     auto JobReady(const internal::PeerManager::Task type) const noexcept
         -> void final;
     auto Listen(const p2p::Address& address) const noexcept -> bool final;
+    auto Mempool() const noexcept -> const internal::Mempool& final
+    {
+        return mempool_;
+    }
     auto Reorg() const noexcept -> const network::zeromq::socket::Publish& final
     {
         return parent_.Reorg();
@@ -186,6 +214,7 @@ public:
         const Amount amount,
         const std::string& memo) const noexcept -> PendingOutgoing final;
     auto Submit(network::zeromq::Message& work) const noexcept -> void final;
+    auto SyncPosition() const noexcept -> block::Position final;
     auto UpdateHeight(const block::Height height) const noexcept -> void final;
     auto UpdateLocalHeight(const block::Position position) const noexcept
         -> void final;
@@ -200,10 +229,7 @@ public:
     {
         return header_;
     }
-    auto Shutdown() noexcept -> std::shared_future<void> final
-    {
-        return stop_worker();
-    }
+    auto Shutdown() noexcept -> std::shared_future<void> final;
 
     ~Network() override;
 
@@ -216,6 +242,8 @@ private:
     std::unique_ptr<internal::FilterOracle> filter_p_;
     std::unique_ptr<internal::PeerManager> peer_p_;
     std::unique_ptr<internal::Wallet> wallet_p_;
+    std::unique_ptr<internal::Mempool> mempool_p_;
+    std::unique_ptr<internal::HeaderSegments> segments_p_;
 
 protected:
     const api::client::internal::Blockchain& blockchain_;
@@ -226,6 +254,8 @@ protected:
     internal::PeerManager& peer_;
     internal::BlockOracle& block_;
     internal::Wallet& wallet_;
+    internal::Mempool& mempool_;
+    internal::HeaderSegments& segments_;
 
     // NOTE call init in every final constructor body
     auto init() noexcept -> void;
@@ -252,6 +282,7 @@ private:
     const api::client::internal::Blockchain& parent_;
     const std::string sync_endpoint_;
     std::unique_ptr<SyncServer> sync_server_;
+    std::unique_ptr<SyncPipeline> sync_pipeline_;
     mutable std::atomic<block::Height> local_chain_height_;
     mutable std::atomic<block::Height> remote_chain_height_;
     OTFlag waiting_for_headers_;
@@ -265,6 +296,8 @@ private:
 
     virtual auto instantiate_header(const ReadView payload) const noexcept
         -> std::unique_ptr<block::Header> = 0;
+    auto instantiate_headers(const std::vector<ReadView>& payloads)
+        const noexcept -> std::vector<std::unique_ptr<block::Header>>;
     auto is_synchronized_blocks() const noexcept -> bool;
     auto is_synchronized_filters() const noexcept -> bool;
     auto is_synchronized_headers() const noexcept -> bool;
@@ -275,6 +308,7 @@ private:
     auto process_block(zmq::Message& in) noexcept -> void;
     auto process_filter_update(zmq::Message& in) noexcept -> void;
     auto process_header(zmq::Message& in) noexcept -> void;
+    auto process_header_segment(zmq::Message& in) noexcept -> void;
     auto process_sync_data(zmq::Message& in) noexcept -> void;
     auto shutdown(std::promise<void>& promise) noexcept -> void;
     auto state_machine() noexcept -> bool;
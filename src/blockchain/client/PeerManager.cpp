@@ -9,7 +9,9 @@
 
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <string_view>
 
 #include "core/Worker.hpp"
@@ -87,6 +89,8 @@ PeerManager::PeerManager(
     , Worker(api, std::chrono::milliseconds(100))
     , database_(database)
     , io_context_(io)
+    , compact_lock_()
+    , compact_high_bandwidth_()
     , jobs_(api)
     , peers_(
           api,
@@ -110,6 +114,21 @@ PeerManager::PeerManager(
     init_executor({shutdown});
 }
 
+auto PeerManager::AcquireCompactHighBandwidth(const int id) const noexcept
+    -> bool
+{
+    Lock lock(compact_lock_);
+    auto& peers = compact_high_bandwidth_;
+
+    if (0 < peers.count(id)) { return true; }
+
+    if (max_compact_high_bandwidth_ <= peers.size()) { return false; }
+
+    peers.emplace(id);
+
+    return true;
+}
+
 auto PeerManager::AddIncomingPeer(const int id, std::uintptr_t endpoint)
     const noexcept -> void
 {
@@ -383,6 +402,13 @@ auto PeerManager::RequestHeaders() const noexcept -> bool
     return true;
 }
 
+auto PeerManager::ReleaseCompactHighBandwidth(const int id) const noexcept
+    -> void
+{
+    Lock lock(compact_lock_);
+    compact_high_bandwidth_.erase(id);
+}
+
 auto PeerManager::shutdown(std::promise<void>& promise) noexcept -> void
 {
     init_.get();
@@ -14,6 +14,7 @@
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -166,6 +167,7 @@ public:
         std::atomic<std::size_t> count_;
         Addresses connected_;
         std::unique_ptr<IncomingConnectionManager> incoming_zmq_;
+        Time last_eviction_;
 
         static auto get_preferred_services(
             const internal::Config& config) noexcept -> std::set<p2p::Service>;
@@ -186,6 +188,7 @@ public:
 
         auto add_peer(Endpoint endpoint) noexcept -> int;
         auto add_peer(const int id, Endpoint endpoint) noexcept -> int;
+        auto evict_slow_peer() noexcept -> void;
         auto peer_factory(Endpoint endpoint, const int id) noexcept
             -> std::unique_ptr<p2p::internal::Peer>;
     };
@@ -199,6 +202,8 @@ public:
         Shutdown = value(WorkType::Shutdown),
     };
 
+    auto AcquireCompactHighBandwidth(const int id) const noexcept
+        -> bool final;
     auto AddIncomingPeer(const int id, std::uintptr_t endpoint) const noexcept
         -> void final;
     auto AddPeer(const p2p::Address& address) const noexcept -> bool final;
@@ -222,6 +227,7 @@ public:
     auto Heartbeat() const noexcept -> void final
     {
         jobs_.Dispatch(Task::Heartbeat);
+        trigger();
     }
     auto JobReady(const Task type) const noexcept -> void final;
     auto Listen(const p2p::Address& address) const noexcept -> bool final;
@@ -229,6 +235,8 @@ public:
     auto RequestBlocks(const std::vector<ReadView>& hashes) const noexcept
         -> bool final;
     auto RequestHeaders() const noexcept -> bool final;
+    auto ReleaseCompactHighBandwidth(const int id) const noexcept
+        -> void final;
     auto Shutdown() noexcept -> std::shared_future<void> final
     {
         return stop_worker();
@@ -290,8 +298,13 @@ private:
         Jobs() = delete;
     };
 
+    // BIP-152 recommends at most three high bandwidth peers
+    static constexpr auto max_compact_high_bandwidth_{std::size_t{3}};
+
     const internal::PeerDatabase& database_;
     const internal::IO& io_context_;
+    mutable std::mutex compact_lock_;
+    mutable std::set<int> compact_high_bandwidth_;
     mutable Jobs jobs_;
     mutable Peers peers_;
     std::promise<void> init_promise_;
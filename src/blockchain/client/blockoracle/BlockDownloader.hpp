@@ -35,7 +35,7 @@ using BlockWorker = Worker<BlockOracle::BlockDownloader, api::Core>;
 class BlockOracle::BlockDownloader : public BlockDM, public BlockWorker
 {
 public:
-    auto NextBatch() noexcept { return allocate_batch(0); }
+    auto NextBatch(const int peer) noexcept { return allocate_batch(0, peer); }
 
     BlockDownloader(
         const api::Core& api,
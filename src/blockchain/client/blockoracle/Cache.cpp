@@ -11,6 +11,7 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "internal/blockchain/client/Client.hpp"
@@ -29,31 +30,63 @@
 
 namespace opentxs::blockchain::client::implementation
 {
-const std::size_t BlockOracle::Cache::cache_limit_{16};
 const std::chrono::seconds BlockOracle::Cache::download_timeout_{15};
 
 BlockOracle::Cache::Cache(
     const api::Core& api,
     const internal::Network& network,
     const internal::BlockDatabase& db,
-    const blockchain::Type chain) noexcept
+    const blockchain::Type chain,
+    const std::size_t bytes) noexcept
     : api_(api)
     , network_(network)
     , db_(db)
     , chain_(chain)
     , lock_()
     , pending_()
-    , mem_(cache_limit_)
+    , mem_(bytes)
     , running_(true)
 {
 }
 
+auto BlockOracle::Cache::cache(
+    const block::Hash& id,
+    const BitcoinBlock_p& block) const noexcept -> BitcoinBlockFuture
+{
+    auto output = ready(block);
+    mem_.Insert(block::pHash{id}, output, block->CalculateSize());
+
+    return output;
+}
+
 auto BlockOracle::Cache::download(const block::Hash& block) const noexcept
     -> bool
 {
     return network_.RequestBlock(block);
 }
 
+auto BlockOracle::Cache::load(const block::Hash& block) const noexcept
+    -> BitcoinBlockFuture
+{
+    auto pBlock = db_.BlockLoadBitcoin(block);
+
+    if (false == bool(pBlock)) { return {}; }
+
+    // TODO this should be checked in the block factory function
+    OT_ASSERT(pBlock->ID() == block);
+
+    return cache(block, pBlock);
+}
+
+auto BlockOracle::Cache::ready(BitcoinBlock_p block) noexcept
+    -> BitcoinBlockFuture
+{
+    auto promise = Promise{};
+    promise.set_value(std::move(block));
+
+    return promise.get_future();
+}
+
 auto BlockOracle::Cache::ReceiveBlock(const zmq::Frame& in) const noexcept
     -> void
 {
@@ -68,14 +101,21 @@ auto BlockOracle::Cache::ReceiveBlock(BitcoinBlock_p in) const noexcept -> void
         return;
     }
 
-    Lock lock{lock_};
     auto& block = *in;
 
     if (api::client::blockchain::BlockStorage::None != db_.BlockPolicy()) {
         db_.BlockStore(block);
     }
 
+    network_.Mempool().Prune(block);
+
     const auto& id = block.ID();
+    // The block must be visible in mem_ before lock_ is acquired so that a
+    // concurrent Request() which missed the cache and is waiting for lock_
+    // finds it instead of requesting another download
+    cache(id, in);
+    LogVerbose(OT_METHOD)(__FUNCTION__)(": Cached block ")(id.asHex()).Flush();
+    Lock lock{lock_};
     auto pending = pending_.find(id);
 
     if (pending_.end() == pending) {
@@ -88,8 +128,6 @@ auto BlockOracle::Cache::ReceiveBlock(BitcoinBlock_p in) const noexcept -> void
 
     auto& [time, promise, future, queued] = pending->second;
     promise.set_value(std::move(in));
-    LogVerbose(OT_METHOD)(__FUNCTION__)(": Cached block ")(id.asHex()).Flush();
-    mem_.push(std::move(id), std::move(future));
     pending_.erase(pending);
 }
 
@@ -106,82 +144,86 @@ auto BlockOracle::Cache::Request(const block::Hash& block) const noexcept
 auto BlockOracle::Cache::Request(const BlockHashes& hashes) const noexcept
     -> BitcoinBlockFutures
 {
-    auto output = BitcoinBlockFutures{};
-    output.reserve(hashes.size());
-    auto download = std::map<block::pHash, BitcoinBlockFutures::iterator>{};
-    Lock lock{lock_};
+    auto output = BitcoinBlockFutures(hashes.size());
+    const auto cancel = [&](const auto& indices) {
+        for (const auto i : indices) { output.at(i) = ready(nullptr); }
+    };
+    auto missing = std::vector<std::size_t>{};
+
+    for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+        if (auto cached = mem_.Find(hashes.at(i)); cached.has_value()) {
+            output.at(i) = std::move(cached.value());
+        } else {
+            missing.emplace_back(i);
+        }
+    }
+
+    if (0 == missing.size()) { return output; }
 
     if (false == running_) {
-        std::for_each(hashes.begin(), hashes.end(), [&](const auto&) {
-            auto promise = Promise{};
-            promise.set_value(nullptr);
-            output.emplace_back(promise.get_future());
-        });
+        cancel(missing);
 
         return output;
     }
 
-    for (const auto& block : hashes) {
-        auto found{false};
+    auto download = std::vector<std::size_t>{};
 
-        if (auto future = mem_.find(block->Bytes()); future.valid()) {
-            output.emplace_back(std::move(future));
-            found = true;
+    for (const auto i : missing) {
+        if (auto loaded = load(hashes.at(i)); loaded.valid()) {
+            output.at(i) = std::move(loaded);
+        } else {
+            download.emplace_back(i);
         }
+    }
 
-        if (found) { continue; }
+    if (0 == download.size()) { return output; }
 
-        {
-            auto it = pending_.find(block);
+    Lock lock{lock_};
 
-            if (pending_.end() != it) {
-                const auto& [time, promise, future, queued] = it->second;
-                output.emplace_back(future);
-                found = true;
-            }
-        }
+    if (false == running_) {
+        cancel(download);
+
+        return output;
+    }
+
+    auto requested = std::vector<Pending::iterator>{};
 
-        if (found) { continue; }
+    for (const auto i : download) {
+        const auto& block = hashes.at(i);
 
-        if (auto pBlock = db_.BlockLoadBitcoin(block); bool(pBlock)) {
-            // TODO this should be checked in the block factory function
-            OT_ASSERT(pBlock->ID() == block);
+        // Check again in case the block arrived since the first lookup
+        if (auto cached = mem_.Find(block); cached.has_value()) {
+            output.at(i) = std::move(cached.value());
 
-            auto promise = Promise{};
-            promise.set_value(std::move(pBlock));
-            mem_.push(OTData{block}, promise.get_future());
-            output.emplace_back(mem_.find(block->Bytes()));
-            found = true;
+            continue;
         }
 
-        if (found) { continue; }
+        if (auto it = pending_.find(block); pending_.end() != it) {
+            const auto& [time, promise, future, queued] = it->second;
+            output.at(i) = future;
 
-        output.emplace_back();
-        auto it = output.begin();
-        std::advance(it, output.size() - 1);
-        download.emplace(block, it);
-    }
+            continue;
+        }
 
-    OT_ASSERT(output.size() == hashes.size());
+        auto it = pending_.try_emplace(block).first;
+        auto& [time, promise, future, queued] = it->second;
+        time = Clock::now();
+        future = promise.get_future();
+        output.at(i) = future;
+        requested.emplace_back(it);
+    }
 
-    if (0 < download.size()) {
+    if (0 < requested.size()) {
         auto blockList = std::vector<ReadView>{};
         std::transform(
-            std::begin(download),
-            std::end(download),
+            std::begin(requested),
+            std::end(requested),
             std::back_inserter(blockList),
-            [](const auto& in) -> auto {
-                const auto& [key, value] = in;
-
-                return key->Bytes();
-            });
+            [](const auto& in) -> auto { return in->first->Bytes(); });
         const auto messageSent = network_.RequestBlocks(blockList);
 
-        for (auto& [hash, futureOut] : download) {
-            auto& [time, promise, future, queued] = pending_[hash];
-            time = Clock::now();
-            future = promise.get_future();
-            *futureOut = future;
+        for (auto& it : requested) {
+            auto& [time, promise, future, queued] = it->second;
             queued = messageSent;
         }
     }
@@ -195,7 +237,7 @@ auto BlockOracle::Cache::Shutdown() noexcept -> void
 
     if (running_) {
         running_ = false;
-        mem_.clear();
+        mem_.Clear();
 
         for (auto& [hash, item] : pending_) {
             auto& [time, promise, future, queued] = item;
@@ -208,6 +250,12 @@ auto BlockOracle::Cache::Shutdown() noexcept -> void
 
 auto BlockOracle::Cache::StateMachine() const noexcept -> bool
 {
+    const auto stats = mem_.Stats();
+    LogTrace(OT_METHOD)(__FUNCTION__)(": ")(DisplayString(chain_))(
+        " block cache: ")(stats.items_)(" blocks, ")(stats.bytes_)(" of ")(
+        stats.capacity_)(" bytes, ")(stats.hits_)(" hits, ")(stats.misses_)(
+        " misses, ")(stats.evictions_)(" evictions")
+        .Flush();
     Lock lock{lock_};
 
     if (false == running_) { return false; }
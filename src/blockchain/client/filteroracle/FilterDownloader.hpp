@@ -32,7 +32,10 @@ using FilterWorker = Worker<FilterOracle::FilterDownloader, api::Core>;
 class FilterOracle::FilterDownloader : public FilterDM, public FilterWorker
 {
 public:
-    auto NextBatch() noexcept { return allocate_batch(type_); }
+    auto NextBatch(const int peer) noexcept
+    {
+        return allocate_batch(type_, peer);
+    }
     auto UpdatePosition(const Position& pos) -> void
     {
         try {
@@ -37,7 +37,10 @@ public:
     using Callback =
         std::function<Position(const Position&, const filter::Header&)>;
 
-    auto NextBatch() noexcept { return allocate_batch(type_); }
+    auto NextBatch(const int peer) noexcept
+    {
+        return allocate_batch(type_, peer);
+    }
 
     HeaderDownloader(
         const api::Core& api,
@@ -0,0 +1,255 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"    // IWYU pragma: associated
+#include "1_Internal.hpp"  // IWYU pragma: associated
+#include "blockchain/client/network/SyncPipeline.hpp"  // IWYU pragma: associated
+
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+#include "internal/blockchain/block/Block.hpp"
+#include "internal/blockchain/block/bitcoin/Bitcoin.hpp"
+#include "opentxs/Proto.tpp"
+#include "opentxs/api/Core.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/blockchain/FilterType.hpp"
+#include "opentxs/blockchain/block/Header.hpp"
+#include "opentxs/blockchain/block/bitcoin/Header.hpp"  // IWYU pragma: keep
+#include "opentxs/blockchain/client/FilterOracle.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/LogSource.hpp"
+#include "opentxs/network/zeromq/Frame.hpp"
+#include "opentxs/network/zeromq/FrameIterator.hpp"
+#include "opentxs/network/zeromq/FrameSection.hpp"
+#include "opentxs/network/zeromq/Pipeline.hpp"
+#include "opentxs/protobuf/BlockchainP2PSync.pb.h"
+#include "util/Blank.hpp"
+
+#define OT_METHOD                                                              \
+    "opentxs::blockchain::client::implementation::Network::SyncPipeline::"
+
+namespace opentxs::blockchain::client::implementation
+{
+Network::SyncPipeline::SyncPipeline(Network& parent) noexcept
+    : parent_(parent)
+    , lock_()
+    , position_(make_blank<block::Position>::value(parent_.api_))
+    , stalled_(false)
+    , incoming_(queue_limit_)
+    , decoded_(queue_limit_)
+    , connected_(queue_limit_)
+    , decode_(&SyncPipeline::decode_thread, this)
+    , connect_(&SyncPipeline::connect_thread, this)
+    , store_(&SyncPipeline::store_thread, this)
+{
+}
+
+auto Network::SyncPipeline::connect_thread() noexcept -> void
+{
+    auto& header = parent_.header_;
+
+    while (auto item = decoded_.Pop()) {
+        auto& [headers, parsed] = item.value();
+
+        if (false == header.ProcessSyncData(headers, parsed)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to connect ")(
+                DisplayString(parent_.chain_))(" headers from sync data")
+                .Flush();
+            // Nothing further will arrive unless the range is requested again
+            reset();
+
+            continue;
+        }
+
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": Connected ")(
+            parsed.second.size())(" ")(DisplayString(parent_.chain_))(
+            " headers from sync data")
+            .Flush();
+        const auto position = [&] {
+            const auto& [hash, height, type, count, filter] =
+                parsed.second.back();
+
+            return block::Position{height, hash};
+        }();
+
+        if (false == connected_.Push(std::move(parsed))) { return; }
+
+        {
+            auto lock = Lock{lock_};
+
+            if (stalled_) { continue; }
+
+            if (position.first > position_.first) { position_ = position; }
+        }
+
+        // Ask for the next range while the filters for this one are stored
+        parent_.pipeline_->Push(parent_.MakeWork(Task::SyncRequest));
+    }
+}
+
+auto Network::SyncPipeline::decode(const zmq::Message& in) const noexcept
+    -> std::optional<Decoded>
+{
+    const auto& api = parent_.api_;
+    const auto chain = parent_.chain_;
+    const auto body = in.Body();
+
+    if (3 > body.size()) { return std::nullopt; }
+
+    auto output = std::make_optional<Decoded>(
+        SyncHeaders{}, ParsedSyncData{api.Factory().Data(), {}});
+    auto& [headers, parsed] = output.value();
+    auto& packets = parsed.second;
+    headers.reserve(body.size() - 2u);
+    packets.reserve(body.size() - 2u);
+
+    for (auto i{std::next(body.begin(), 2)}; i != body.end();
+         std::advance(i, 1)) {
+        const auto sync = proto::Factory<proto::BlockchainP2PSync>(*i);
+        auto pHeader = factory::BitcoinBlockHeader(api, chain, sync.header());
+
+        if (false == bool(pHeader)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid header").Flush();
+
+            return std::nullopt;
+        }
+
+        packets.emplace_back(
+            pHeader->Hash(),
+            static_cast<block::Height>(sync.height()),
+            static_cast<filter::Type>(sync.filter_type()),
+            sync.filter_element_count(),
+            api.Factory().Data(sync.filter(), StringStyle::Raw));
+        headers.emplace_back(std::move(pHeader));
+    }
+
+    return output;
+}
+
+auto Network::SyncPipeline::decode_thread() noexcept -> void
+{
+    while (auto item = incoming_.Pop()) {
+        auto decoded = decode(item.value());
+
+        if (false == decoded.has_value()) { continue; }
+
+        if (false == decoded_.Push(std::move(decoded.value()))) { return; }
+    }
+}
+
+auto Network::SyncPipeline::Position() const noexcept -> block::Position
+{
+    auto lock = Lock{lock_};
+
+    return position_;
+}
+
+auto Network::SyncPipeline::Prepare(
+    const block::Position& tip,
+    ParsedSyncData& data) noexcept -> Status
+{
+    auto& [prior, packets] = data;
+
+    // The same range may be received more than once when an earlier request
+    // is answered after the pipeline has moved ahead
+    auto it = packets.begin();
+
+    while ((packets.end() != it) && (std::get<1>(*it) <= tip.first)) {
+        std::advance(it, 1);
+    }
+
+    if (packets.end() == it) { return Status::Duplicate; }
+
+    if (packets.begin() != it) {
+        prior = std::get<0>(*std::prev(it));
+        packets.erase(packets.begin(), it);
+    }
+
+    const auto first = std::get<1>(packets.front());
+
+    if ((first != (tip.first + 1)) || ((0 < first) && (prior != tip.second))) {
+        return Status::Gap;
+    }
+
+    return Status::Connects;
+}
+
+auto Network::SyncPipeline::Push(const zmq::Message& in) noexcept -> void
+{
+    incoming_.Push(OTZMQMessage{in});
+}
+
+auto Network::SyncPipeline::reset() noexcept -> void
+{
+    auto lock = Lock{lock_};
+    position_ = make_blank<block::Position>::value(parent_.api_);
+
+    if (stalled_) { return; }
+
+    stalled_ = true;
+    lock.unlock();
+    // Request the range which follows the filter tip
+    parent_.pipeline_->Push(parent_.MakeWork(Task::SyncRequest));
+}
+
+auto Network::SyncPipeline::resume() noexcept -> void
+{
+    auto lock = Lock{lock_};
+    stalled_ = false;
+}
+
+auto Network::SyncPipeline::Shutdown() noexcept -> void
+{
+    incoming_.Close();
+    decoded_.Close();
+    connected_.Close();
+
+    if (decode_.joinable()) { decode_.join(); }
+
+    if (connect_.joinable()) { connect_.join(); }
+
+    if (store_.joinable()) { store_.join(); }
+}
+
+auto Network::SyncPipeline::store(ParsedSyncData& data) noexcept -> void
+{
+    auto& filters = parent_.filters_;
+    const auto type = std::get<2>(data.second.front());
+    const auto tip = filters.FilterTip(type);
+    const auto status = Prepare(tip, data);
+
+    if (Status::Duplicate == status) { return; }
+
+    if (Status::Gap == status) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(
+            DisplayString(parent_.chain_))(" sync data at height ")(
+            std::get<1>(data.second.front()))(
+            " does not connect to filter tip ")(tip.first)
+            .Flush();
+        reset();
+
+        return;
+    }
+
+    const auto last = std::get<1>(data.second.back());
+    filters.ProcessSyncData(data);
+
+    if (filters.FilterTip(type).first < last) {
+        reset();
+    } else {
+        resume();
+    }
+}
+
+auto Network::SyncPipeline::store_thread() noexcept -> void
+{
+    while (auto item = connected_.Pop()) { store(item.value()); }
+}
+
+Network::SyncPipeline::~SyncPipeline() { Shutdown(); }
+}  // namespace opentxs::blockchain::client::implementation
@@ -0,0 +1,100 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "blockchain/client/Network.hpp"
+#include "internal/blockchain/client/Client.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "util/BoundedQueue.hpp"
+
+namespace opentxs::blockchain::client::implementation
+{
+/// Applies data received from a sync server in three overlapping stages
+///
+/// Packets are decoded into headers, the headers are connected to the header
+/// oracle, and finally the filters are verified and stored. Each stage runs on
+/// its own thread and the stages are connected by bounded queues, so a slow
+/// stage eventually blocks the network thread and leaves further replies
+/// waiting in zmq.
+///
+/// The next range is requested from the sync server as soon as a batch of
+/// headers has been connected rather than after its filters are stored.
+class Network::SyncPipeline
+{
+public:
+    enum class Status : std::uint8_t {
+        Duplicate = 0,
+        Gap = 1,
+        Connects = 2,
+    };
+
+    /// Removes the packets which are at or below the filter tip
+    ///
+    /// Returns Duplicate if no packets remain to be stored and Gap if the
+    /// remaining packets do not connect to the filter tip.
+    static auto Prepare(
+        const block::Position& tip,
+        ParsedSyncData& data) noexcept -> Status;
+
+    /// Position of the most recent batch which has been connected to the
+    /// header chain, or a blank position if no batch is in progress
+    auto Position() const noexcept -> block::Position;
+
+    /// Blocks while the decode stage is full
+    auto Push(const zmq::Message& in) noexcept -> void;
+    auto Shutdown() noexcept -> void;
+
+    SyncPipeline(Network& parent) noexcept;
+
+    ~SyncPipeline();
+
+private:
+    using Decoded = std::pair<SyncHeaders, ParsedSyncData>;
+
+    // Batches allowed to wait between two consecutive stages
+    static constexpr std::size_t queue_limit_{2};
+
+    Network& parent_;
+    mutable std::mutex lock_;
+    block::Position position_;
+    // Set when the store stage rejects a batch. Batches which were already in
+    // flight must not advance position_ past the failure, so nothing is
+    // requested from the pipeline until a batch is stored at the filter tip.
+    bool stalled_;
+    BoundedQueue<OTZMQMessage> incoming_;
+    BoundedQueue<Decoded> decoded_;
+    BoundedQueue<ParsedSyncData> connected_;
+    std::thread decode_;
+    std::thread connect_;
+    std::thread store_;
+
+    auto decode(const zmq::Message& in) const noexcept
+        -> std::optional<Decoded>;
+
+    auto connect_thread() noexcept -> void;
+    auto decode_thread() noexcept -> void;
+    auto reset() noexcept -> void;
+    auto resume() noexcept -> void;
+    auto store(ParsedSyncData& data) noexcept -> void;
+    auto store_thread() noexcept -> void;
+
+    SyncPipeline() = delete;
+    SyncPipeline(const SyncPipeline&) = delete;
+    SyncPipeline(SyncPipeline&&) = delete;
+    auto operator=(const SyncPipeline&) -> SyncPipeline& = delete;
+    auto operator=(SyncPipeline&&) -> SyncPipeline& = delete;
+};
+}  // namespace opentxs::blockchain::client::implementation
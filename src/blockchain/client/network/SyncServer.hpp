@@ -11,10 +11,13 @@
 
 #include <zmq.h>
 #include <atomic>
+#include <cstddef>
 #include <functional>
 #include <limits>
 #include <mutex>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include "blockchain/DownloadManager.hpp"
 #include "internal/blockchain/Blockchain.hpp"
@@ -44,7 +47,7 @@
 namespace opentxs::blockchain::client::implementation
 {
 using SyncDM = download::
-    Manager<Network::SyncServer, std::unique_ptr<const GCS>, int, filter::Type>;
+    Manager<Network::SyncServer, std::shared_ptr<const GCS>, int, filter::Type>;
 using SyncWorker = Worker<Network::SyncServer, api::Core>;
 
 class Network::SyncServer : public SyncDM, public SyncWorker
@@ -177,9 +180,19 @@ private:
     auto download() noexcept -> void
     {
         auto work = NextBatch();
+        auto blocks = std::vector<block::pHash>{};
+        blocks.reserve(work.data_.size());
 
         for (const auto& task : work.data_) {
-            task->download(filter_.LoadFilter(type_, task->position_.second));
+            blocks.emplace_back(task->position_.second);
+        }
+
+        auto filters = filter_.LoadFilters(type_, blocks);
+
+        OT_ASSERT(filters.size() == work.data_.size());
+
+        for (auto i = std::size_t{0}; i < filters.size(); ++i) {
+            work.data_.at(i)->download(std::move(filters.at(i)));
         }
     }
     auto pipeline(const zmq::Message& in) noexcept -> void
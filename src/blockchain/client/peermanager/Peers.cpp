@@ -16,7 +16,9 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <optional>
 #include <random>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -84,6 +86,7 @@ PeerManager::Peers::Peers(
     , count_()
     , connected_()
     , incoming_zmq_()
+    , last_eviction_(Clock::now())
 {
     const auto& data = params::Data::Chains().at(chain_);
     database_.AddOrUpdate(Endpoint{factory::BlockchainAddress(
@@ -214,6 +217,55 @@ auto PeerManager::Peers::Disconnect(const int id) noexcept -> void
     peers_.erase(it);
     --count_;
     connected_.erase(address);
+    // Peer ids are never reused
+    block_.RemovePeer(id);
+    filter_.RemovePeer(id);
+}
+
+auto PeerManager::Peers::evict_slow_peer() noexcept -> void
+{
+    constexpr auto interval = std::chrono::minutes(2);
+    const auto target = config_.peer_target_bytes_;
+
+    if (0 == target) { return; }
+
+    const auto now = Clock::now();
+
+    if ((now - last_eviction_) < interval) { return; }
+
+    if (minimum_peers_.load() > peers_.size()) { return; }
+
+    const auto defaultPeer = [&] {
+        auto endpoint = get_default_peer();
+
+        return endpoint ? OTIdentifier{endpoint->ID()}
+                        : api_.Factory().Identifier();
+    }();
+    auto rates = p2p::internal::PeerRates{};
+    auto exempt = std::set<int>{};
+
+    for (const auto& [id, peer] : peers_) {
+        const auto rate = peer->Throughput();
+
+        if (false == rate.has_value()) { continue; }
+
+        rates.emplace(id, rate.value());
+
+        if (defaultPeer == peer->AddressID()) { exempt.emplace(id); }
+    }
+
+    const auto slowest = p2p::internal::SlowPeer(rates, exempt, target);
+
+    if (false == slowest.has_value()) { return; }
+
+    last_eviction_ = now;
+    const auto id = slowest.value();
+    LogVerbose(OT_METHOD)(__FUNCTION__)(
+        ": Combined download rate is below target of ")(target)(
+        " bytes/s. Replacing peer ")(id)(" which delivered ")(rates.at(id))(
+        " bytes/s")
+        .Flush();
+    Disconnect(id);
 }
 
 auto PeerManager::Peers::get_default_peer() const noexcept -> Endpoint
@@ -485,6 +537,7 @@ auto PeerManager::Peers::Run() noexcept -> bool
     if ((false == running_) || invalid_peer_) { return false; }
 
     const auto target = minimum_peers_.load();
+    evict_slow_peer();
 
     if (target > peers_.size()) {
         LogVerbose(OT_METHOD)(__FUNCTION__)(": Fewer peers (")(peers_.size())(
@@ -32,6 +32,23 @@ namespace opentxs::blockchain::client::wallet
 using Subchain = internal::WalletDatabase::Subchain;
 
 struct Account::Imp {
+    auto mempool(const internal::Mempool::Transactions& transactions) noexcept
+        -> void
+    {
+        auto ticket = gatekeeper_.get();
+
+        if (ticket) { return; }
+
+        for (const auto& account : ref_.GetHD()) {
+            get(account, Subchain::Internal, internal_).mempool(transactions);
+            get(account, Subchain::External, external_).mempool(transactions);
+        }
+
+        for (const auto& account : ref_.GetPaymentCode()) {
+            get(account, Subchain::Outgoing, outgoing_).mempool(transactions);
+            get(account, Subchain::Incoming, incoming_).mempool(transactions);
+        }
+    }
     auto reorg(const block::Position& parent) noexcept -> bool
     {
         auto ticket = gatekeeper_.get();
@@ -111,6 +128,7 @@ struct Account::Imp {
         const zmq::socket::Push& threadPool,
         const filter::Type filter,
         Outstanding&& jobs,
+        ScanCoordinator& scanner,
         const SimpleCallback& taskFinished) noexcept
         : api_(api)
         , blockchain_(blockchain)
@@ -125,6 +143,7 @@ struct Account::Imp {
         , outgoing_()
         , incoming_()
         , jobs_(std::move(jobs))
+        , scanner_(scanner)
         , gatekeeper_()
     {
         for (const auto& account : ref_.GetHD()) {
@@ -155,6 +174,7 @@ private:
     Map outgoing_;
     Map incoming_;
     Outstanding jobs_;
+    ScanCoordinator& scanner_;
     Gatekeeper gatekeeper_;
 
     auto get(
@@ -182,6 +202,7 @@ private:
             account,
             task_finished_,
             jobs_,
+            scanner_,
             thread_pool_,
             filter_type_,
             subchain);
@@ -201,6 +222,7 @@ Account::Account(
     const zmq::socket::Push& threadPool,
     const filter::Type filter,
     Outstanding&& jobs,
+    ScanCoordinator& scanner,
     const SimpleCallback& taskFinished) noexcept
     : imp_(std::make_unique<Imp>(
           api,
@@ -211,6 +233,7 @@ Account::Account(
           threadPool,
           filter,
           std::move(jobs),
+          scanner,
           taskFinished))
 {
     OT_ASSERT(imp_);
@@ -222,6 +245,12 @@ Account::Account(Account&& rhs) noexcept
     OT_ASSERT(imp_);
 }
 
+auto Account::mempool(
+    const internal::Mempool::Transactions& transactions) noexcept -> void
+{
+    imp_->mempool(transactions);
+}
+
 auto Account::reorg(const block::Position& parent) noexcept -> bool
 {
     return imp_->reorg(parent);
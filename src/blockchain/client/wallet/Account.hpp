@@ -45,6 +45,7 @@ struct WalletDatabase;
 
 namespace wallet
 {
+class ScanCoordinator;
 class SubchainStateData;
 }  // namespace wallet
 }  // namespace client
@@ -71,6 +72,8 @@ class Account
 public:
     using BalanceTree = api::client::blockchain::internal::BalanceTree;
 
+    auto mempool(const internal::Mempool::Transactions& transactions) noexcept
+        -> void;
     auto reorg(const block::Position& parent) noexcept -> bool;
     auto shutdown() noexcept -> void;
     auto state_machine() noexcept -> bool;
@@ -84,6 +87,7 @@ public:
         const network::zeromq::socket::Push& threadPool,
         const filter::Type filter,
         Outstanding&& jobs,
+        ScanCoordinator& scanner,
         const SimpleCallback& taskFinished) noexcept;
     Account(Account&&) noexcept;
 
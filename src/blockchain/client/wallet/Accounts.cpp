@@ -13,6 +13,7 @@
 
 #include "blockchain/client/wallet/Account.hpp"
 #include "blockchain/client/wallet/NotificationStateData.hpp"
+#include "blockchain/client/wallet/ScanCoordinator.hpp"
 #include "blockchain/client/wallet/SubchainStateData.hpp"
 #include "internal/api/client/Client.hpp"
 #include "internal/blockchain/client/Client.hpp"
@@ -53,6 +54,7 @@ struct Accounts::Imp {
             thread_pool_,
             filter_type_,
             job_counter_.Allocate(),
+            scanner_,
             task_finished_);
 
         if (added) {
@@ -74,6 +76,15 @@ struct Accounts::Imp {
 
         return Add(id);
     }
+    auto Mempool(const internal::Mempool::Transactions& transactions) noexcept
+        -> void
+    {
+        auto ticket = gatekeeper_.get();
+
+        if (ticket) { return; }
+
+        for (auto& [nym, account] : map_) { account.mempool(transactions); }
+    }
     auto Reorg(const block::Position& parent) noexcept -> bool
     {
         auto ticket = gatekeeper_.get();
@@ -130,6 +141,7 @@ struct Accounts::Imp {
         , chain_(chain)
         , filter_type_(network_.FilterOracleInternal().DefaultType())
         , job_counter_()
+        , scanner_(network_, db_, filter_type_)
         , map_()
         , pc_counter_(job_counter_.Allocate())
         , payment_codes_()
@@ -153,6 +165,7 @@ private:
     const Type chain_;
     const filter::Type filter_type_;
     JobCounter job_counter_;
+    ScanCoordinator scanner_;
     AccountMap map_;
     Outstanding pc_counter_;
     PCMap payment_codes_;
@@ -182,6 +195,7 @@ private:
             db_,
             task_finished_,
             pc_counter_,
+            scanner_,
             thread_pool_,
             filter_type_,
             chain_,
@@ -219,6 +233,12 @@ auto Accounts::Add(const zmq::Frame& message) noexcept -> bool
     return imp_->Add(message);
 }
 
+auto Accounts::Mempool(
+    const internal::Mempool::Transactions& transactions) noexcept -> void
+{
+    imp_->Mempool(transactions);
+}
+
 auto Accounts::Reorg(const block::Position& parent) noexcept -> bool
 {
     return imp_->Reorg(parent);
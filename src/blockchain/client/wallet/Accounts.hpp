@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "internal/blockchain/client/Client.hpp"
 #include "opentxs/Types.hpp"
 #include "opentxs/blockchain/Blockchain.hpp"
 #include "opentxs/blockchain/BlockchainType.hpp"
@@ -68,6 +69,8 @@ class Accounts
 public:
     auto Add(const identifier::Nym& nym) noexcept -> bool;
     auto Add(const network::zeromq::Frame& message) noexcept -> bool;
+    auto Mempool(const internal::Mempool::Transactions& transactions) noexcept
+        -> void;
     auto Reorg(const block::Position& parent) noexcept -> bool;
 
     auto shutdown() noexcept -> void;
@@ -17,6 +17,7 @@
 #include <utility>
 #include <vector>
 
+#include "blockchain/client/wallet/ScanCoordinator.hpp"
 #include "internal/blockchain/client/Client.hpp"
 #include "opentxs/Bytes.hpp"
 #include "opentxs/Pimpl.hpp"
@@ -53,6 +54,7 @@ DeterministicStateData::DeterministicStateData(
     const api::client::blockchain::Deterministic& node,
     const SimpleCallback& taskFinished,
     Outstanding& jobCounter,
+    ScanCoordinator& scanner,
     const zmq::socket::Push& threadPool,
     const filter::Type filter,
     const Subchain subchain) noexcept
@@ -64,6 +66,7 @@ DeterministicStateData::DeterministicStateData(
           OTIdentifier{node.ID()},
           taskFinished,
           jobCounter,
+          scanner,
           threadPool,
           filter,
           subchain)
@@ -105,21 +108,127 @@ auto DeterministicStateData::handle_confirmed_matches(
     const block::Position& position,
     const block::Block::Matches& confirmed) noexcept -> void
 {
-    auto transactions = std::map<
-        block::pTxid,
-        std::pair<
-            std::vector<Bip32Index>,
-            const block::bitcoin::Transaction*>>{};
+    const auto transactions = [&] {
+        auto all = Candidates{};
+        all.reserve(block.size());
 
-    for (const auto& match : confirmed) {
+        for (const auto& transaction : block) {
+            OT_ASSERT(transaction);
+
+            all.emplace_back(transaction.get());
+        }
+
+        return select(confirmed, all);
+    }();
+
+    for (const auto& [txid, data] : transactions) {
+        auto& [outputs, pTX] = data;
+
+        OT_ASSERT(nullptr != pTX);
+
+        auto updated = db_.AddConfirmedTransaction(
+            network_.Chain(),
+            id_,
+            subchain_,
+            filter_type_,
+            position,
+            outputs,
+            *pTX);
+
+        OT_ASSERT(updated);  // TODO handle database errors
+    }
+}
+
+auto DeterministicStateData::handle_mempool_matches(
+    const block::Block::Matches& matches,
+    const internal::Mempool::Transactions& mempool) noexcept -> void
+{
+    const auto transactions = [&] {
+        auto all = Candidates{};
+        all.reserve(mempool.size());
+
+        for (const auto& transaction : mempool) {
+            OT_ASSERT(transaction);
+
+            all.emplace_back(transaction.get());
+        }
+
+        return select(matches, all);
+    }();
+
+    for (const auto& [txid, data] : transactions) {
+        auto& [outputs, pTX] = data;
+
+        OT_ASSERT(nullptr != pTX);
+
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(
+            " unconfirmed transaction ")(txid->asHex())
+            .Flush();
+        const auto updated = db_.AddMempoolTransaction(
+            network_.Chain(), id_, subchain_, filter_type_, outputs, *pTX);
+
+        if (false == updated) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": ")(id_)(
+                " failed to record unconfirmed transaction ")(txid->asHex())
+                .Flush();
+
+            return;
+        }
+    }
+}
+
+auto DeterministicStateData::index() noexcept -> void
+{
+    const auto first =
+        last_indexed_.has_value() ? last_indexed_.value() + 1u : Bip32Index{0u};
+    const auto last = node_.LastGenerated(subchain_).value_or(0u);
+    auto elements = WalletDatabase::ElementMap{};
+
+    if (last > first) {
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(
+            " indexing elements from ")(first)(" to ")(last)
+            .Flush();
+    } else {
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(
+            " subchain is fully indexed to item ")(last)
+            .Flush();
+    }
+
+    for (auto i{first}; i <= last; ++i) {
+        const auto& element = node_.BalanceElement(subchain_, i);
+        index_element(filter_type_, element, i, elements);
+    }
+
+    db_.SubchainAddElements(id_, subchain_, filter_type_, elements);
+
+    if (0 < elements.size()) { scanner_.Invalidate(); }
+}
+
+auto DeterministicStateData::select(
+    const block::Block::Matches& matches,
+    const Candidates& all) const noexcept -> Selected
+{
+    auto transactions = Selected{};
+    const auto lookup = [&] {
+        auto output = std::map<ReadView, const block::bitcoin::Transaction*>{};
+
+        for (const auto* transaction : all) {
+            output.emplace(transaction->ID().Bytes(), transaction);
+        }
+
+        return output;
+    }();
+
+    for (const auto& match : matches) {
         const auto& [txid, elementID] = match;
         const auto& [index, subchainID] = elementID;
         const auto& [subchain, accountID] = subchainID;
         const auto& element = node_.BalanceElement(subchain, index);
-        const auto& pTransaction = block.at(txid->Bytes());
+        const auto it = lookup.find(txid->Bytes());
 
-        OT_ASSERT(pTransaction);
+        OT_ASSERT(lookup.end() != it);
 
+        const auto* pTransaction = it->second;
         auto& arg = transactions[txid];
         auto& [outputs, pTX] = arg;
         auto postcondition = ScopeGuard{[&] {
@@ -145,7 +254,7 @@ auto DeterministicStateData::handle_confirmed_matches(
                     if (key.PublicKey() == script.Pubkey().value()) {
                         outputs.emplace_back(i);
 
-                        if (nullptr == pTX) { pTX = pTransaction.get(); }
+                        if (nullptr == pTX) { pTX = pTransaction; }
                     }
 
                     // TODO mark key as used
@@ -158,7 +267,7 @@ auto DeterministicStateData::handle_confirmed_matches(
                     if (hash->Bytes() == script.PubkeyHash().value()) {
                         outputs.emplace_back(i);
 
-                        if (nullptr == pTX) { pTX = pTransaction.get(); }
+                        if (nullptr == pTX) { pTX = pTransaction; }
                     }
 
                     // TODO mark key as used
@@ -185,7 +294,7 @@ auto DeterministicStateData::handle_confirmed_matches(
                     if (key.PublicKey() == script.MultisigPubkey(0).value()) {
                         outputs.emplace_back(i);
 
-                        if (nullptr == pTX) { pTX = pTransaction.get(); }
+                        if (nullptr == pTX) { pTX = pTransaction; }
                     }
 
                     // TODO mark key as used
@@ -205,58 +314,16 @@ auto DeterministicStateData::handle_confirmed_matches(
         unspent.insert(utxo.first);
     }
 
-    for (const auto& transaction : block) {
-        OT_ASSERT(transaction);
-
+    for (const auto* transaction : all) {
         for (const auto& input : transaction->Inputs()) {
             if (0 < unspent.count(input.PreviousOutput())) {
                 auto& pTx = transactions[transaction->ID()].second;
 
-                if (nullptr == pTx) { pTx = transaction.get(); }
+                if (nullptr == pTx) { pTx = transaction; }
             }
         }
     }
 
-    for (const auto& [txid, data] : transactions) {
-        auto& [outputs, pTX] = data;
-
-        OT_ASSERT(nullptr != pTX);
-
-        auto updated = db_.AddConfirmedTransaction(
-            network_.Chain(),
-            id_,
-            subchain_,
-            filter_type_,
-            position,
-            outputs,
-            *pTX);
-
-        OT_ASSERT(updated);  // TODO handle database errors
-    }
-}
-
-auto DeterministicStateData::index() noexcept -> void
-{
-    const auto first =
-        last_indexed_.has_value() ? last_indexed_.value() + 1u : Bip32Index{0u};
-    const auto last = node_.LastGenerated(subchain_).value_or(0u);
-    auto elements = WalletDatabase::ElementMap{};
-
-    if (last > first) {
-        LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(
-            " indexing elements from ")(first)(" to ")(last)
-            .Flush();
-    } else {
-        LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(
-            " subchain is fully indexed to item ")(last)
-            .Flush();
-    }
-
-    for (auto i{first}; i <= last; ++i) {
-        const auto& element = node_.BalanceElement(subchain_, i);
-        index_element(filter_type_, element, i, elements);
-    }
-
-    db_.SubchainAddElements(id_, subchain_, filter_type_, elements);
+    return transactions;
 }
 }  // namespace opentxs::blockchain::client::wallet
@@ -10,6 +10,7 @@
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <utility>
 #include <vector>
 
 #include "blockchain/client/wallet/SubchainStateData.hpp"
@@ -51,6 +52,7 @@ namespace block
 namespace bitcoin
 {
 class Block;
+class Transaction;
 }  // namespace bitcoin
 }  // namespace block
 namespace client
@@ -59,6 +61,11 @@ namespace internal
 {
 struct Network;
 }  // namespace internal
+
+namespace wallet
+{
+class ScanCoordinator;
+}  // namespace wallet
 }  // namespace client
 }  // namespace blockchain
 
@@ -93,6 +100,7 @@ public:
         const api::client::blockchain::Deterministic& node,
         const SimpleCallback& taskFinished,
         Outstanding& jobCounter,
+        ScanCoordinator& scanner,
         const zmq::socket::Push& threadPool,
         const filter::Type filter,
         const Subchain subchain) noexcept;
@@ -100,11 +108,26 @@ public:
     ~DeterministicStateData() final = default;
 
 private:
+    using Candidates = std::vector<const block::bitcoin::Transaction*>;
+    // txid, (indices of owned outputs, transaction)
+    using Selected = std::map<
+        block::pTxid,
+        std::pair<
+            std::vector<Bip32Index>,
+            const block::bitcoin::Transaction*>>;
+
+    auto select(const block::Block::Matches& matches, const Candidates& all)
+        const noexcept -> Selected;
+
     auto check_index() noexcept -> bool final;
     auto handle_confirmed_matches(
         const block::bitcoin::Block& block,
         const block::Position& position,
         const block::Block::Matches& confirmed) noexcept -> void final;
+    auto handle_mempool_matches(
+        const block::Block::Matches& matches,
+        const internal::Mempool::Transactions& transactions) noexcept
+        -> void final;
 
     DeterministicStateData() = delete;
     DeterministicStateData(const DeterministicStateData&) = delete;
@@ -17,6 +17,7 @@
 #include <utility>
 #include <vector>
 
+#include "blockchain/client/wallet/ScanCoordinator.hpp"
 #include "internal/blockchain/client/Client.hpp"
 #include "opentxs/Bytes.hpp"
 #include "opentxs/Pimpl.hpp"
@@ -51,6 +52,7 @@ NotificationStateData::NotificationStateData(
     const WalletDatabase& db,
     const SimpleCallback& taskFinished,
     Outstanding& jobCounter,
+    ScanCoordinator& scanner,
     const zmq::socket::Push& threadPool,
     const filter::Type filter,
     const Type chain,
@@ -65,6 +67,7 @@ NotificationStateData::NotificationStateData(
           calculate_id(api, chain, code),
           taskFinished,
           jobCounter,
+          scanner,
           threadPool,
           filter,
           Subchain::Notification)
@@ -136,6 +139,7 @@ auto NotificationStateData::index() noexcept -> void
     }
 
     db_.SubchainAddElements(id_, subchain_, filter_type_, elements);
+    scanner_.Invalidate();
     LogTrace(OT_METHOD)(__FUNCTION__)(": Payment code ")(code_->asBase58())(
         " indexed")
         .Flush();
@@ -65,6 +65,11 @@ namespace internal
 {
 struct Network;
 }  // namespace internal
+
+namespace wallet
+{
+class ScanCoordinator;
+}  // namespace wallet
 }  // namespace client
 }  // namespace blockchain
 
@@ -102,6 +107,7 @@ public:
         const WalletDatabase& db,
         const SimpleCallback& taskFinished,
         Outstanding& jobCounter,
+        ScanCoordinator& scanner,
         const zmq::socket::Push& threadPool,
         const filter::Type filter,
         const Type chain,
@@ -121,6 +127,12 @@ private:
         const block::bitcoin::Block& block,
         const block::Position& position,
         const block::Block::Matches& confirmed) noexcept -> void final;
+    auto handle_mempool_matches(
+        const block::Block::Matches&,
+        const internal::Mempool::Transactions&) noexcept -> void final
+    {
+        // Notification transactions are processed once they are confirmed
+    }
 
     NotificationStateData() = delete;
     NotificationStateData(const NotificationStateData&) = delete;
@@ -0,0 +1,212 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"    // IWYU pragma: associated
+#include "1_Internal.hpp"  // IWYU pragma: associated
+#include "blockchain/client/wallet/ScanCoordinator.hpp"  // IWYU pragma: associated
+
+#include <iterator>
+#include <utility>
+
+#include "blockchain/client/wallet/SubchainJobs.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/blockchain/block/bitcoin/Input.hpp"  // IWYU pragma: keep
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/LogSource.hpp"
+#include "opentxs/protobuf/BlockchainTransactionOutput.pb.h"  // IWYU pragma: keep
+
+#define OT_METHOD "opentxs::blockchain::client::wallet::ScanCoordinator::"
+
+namespace opentxs::blockchain::client::wallet
+{
+ScanCoordinator::Targets::Targets(
+    Patterns&& patterns,
+    std::vector<internal::WalletDatabase::UTXO>&& utxos,
+    Owners&& owners,
+    const filter::Type type) noexcept
+    : patterns_(std::move(patterns))
+    , utxos_(std::move(utxos))
+    , owners_(std::move(owners))
+    , targets_(internal::ScanTargets(type, patterns_, utxos_))
+{
+}
+
+ScanCoordinator::ScanCoordinator(
+    const internal::Network& network,
+    const internal::WalletDatabase& db,
+    const filter::Type filter) noexcept
+    : network_(network)
+    , db_(db)
+    , filter_type_(filter)
+    , generation_(0)
+    , lock_()
+    , subchains_()
+    , targets_generation_(0)
+    , targets_()
+    , cache_(cache_capacity_)
+{
+}
+
+auto ScanCoordinator::Attribute(
+    const client::GCS::Targets& targets,
+    const std::size_t patterns,
+    const Owners& owners,
+    const client::GCS::Matches& matches) noexcept -> Pass
+{
+    auto output = Pass{};
+
+    for (const auto& it : matches) {
+        const auto index =
+            static_cast<std::size_t>(std::distance(targets.cbegin(), it));
+
+        if (index < patterns) {
+            const auto owner = owners.upper_bound(index);
+
+            OT_ASSERT(owners.end() != owner);
+
+            output.matches_.emplace(owner->second);
+        } else {
+            output.utxo_ = true;
+        }
+    }
+
+    return output;
+}
+
+auto ScanCoordinator::Check(
+    const SubchainID& subchain,
+    const block::Hash& block) noexcept -> std::optional<bool>
+{
+    auto promise = std::promise<std::shared_ptr<const Pass>>{};
+    auto load = std::optional<std::promise<std::shared_ptr<const Targets>>>{};
+    auto subchains = std::set<SubchainID>{};
+    auto targets = TargetsFuture{};
+    const auto key = block::pHash{block};
+    auto future = [&] {
+        auto lock = Lock{lock_};
+        const auto generation = generation_.load();
+
+        if (auto cached = cache_.Find(key); cached.has_value()) {
+            if (generation == cached.value().generation_) {
+
+                return cached.value().pass_;
+            }
+        }
+
+        if ((false == targets_.valid()) ||
+            (generation != targets_generation_)) {
+            // The database is only read after the lock is released. Other
+            // passes started before the targets are ready wait for them.
+            load.emplace();
+            targets_ = load->get_future().share();
+            targets_generation_ = generation;
+            subchains = subchains_;
+        }
+
+        targets = targets_;
+        auto output = promise.get_future().share();
+        cache_.Insert(key, Entry{generation, output}, 1u);
+
+        return output;
+    }();
+
+    if (targets.valid()) {
+        if (load.has_value()) { load->set_value(load_targets(subchains)); }
+
+        auto pass = run(block, *targets.get());
+
+        if (pass->missing_) { cache_.Erase(key); }
+
+        promise.set_value(std::move(pass));
+    }
+
+    const auto& pass = *future.get();
+
+    if (pass.missing_) { return std::nullopt; }
+
+    return pass.utxo_ || (0 < pass.matches_.count(subchain));
+}
+
+auto ScanCoordinator::Invalidate() noexcept -> void { ++generation_; }
+
+auto ScanCoordinator::load_targets(const std::set<SubchainID>& subchains)
+    const noexcept -> std::shared_ptr<const Targets>
+{
+    auto input = std::vector<std::pair<SubchainID, Patterns>>{};
+    input.reserve(subchains.size());
+
+    for (const auto& id : subchains) {
+        const auto& [subchain, node] = id;
+        input.emplace_back(id, db_.GetPatterns(node, subchain, filter_type_));
+    }
+
+    auto patterns = Patterns{};
+    auto owners = Merge(std::move(input), patterns);
+    auto output = std::make_shared<const Targets>(
+        std::move(patterns),
+        db_.GetUnspentOutputs(),
+        std::move(owners),
+        filter_type_);
+    LogVerbose(OT_METHOD)(__FUNCTION__)(": scanning ")(
+        output->patterns_.size())(" patterns from ")(subchains.size())(
+        " subchains and ")(output->utxos_.size())(" unspent outputs")
+        .Flush();
+
+    return output;
+}
+
+auto ScanCoordinator::Merge(
+    std::vector<std::pair<SubchainID, Patterns>>&& input,
+    Patterns& output) noexcept -> Owners
+{
+    auto owners = Owners{};
+
+    for (auto& [id, patterns] : input) {
+        if (0 == patterns.size()) { continue; }
+
+        std::move(patterns.begin(), patterns.end(), std::back_inserter(output));
+        owners.emplace(output.size(), id);
+    }
+
+    return owners;
+}
+
+auto ScanCoordinator::Register(const SubchainID& subchain) noexcept -> void
+{
+    auto lock = Lock{lock_};
+    subchains_.emplace(subchain);
+    ++generation_;
+}
+
+auto ScanCoordinator::run(const block::Hash& block, const Targets& targets)
+    const noexcept -> std::shared_ptr<const Pass>
+{
+    const auto pFilter =
+        network_.FilterOracleInternal().LoadFilterShared(filter_type_, block);
+
+    if (false == bool(pFilter)) {
+        auto output = std::make_shared<Pass>();
+        output->missing_ = true;
+
+        return output;
+    }
+
+    const auto& filter = *pFilter;
+
+    return std::make_shared<const Pass>(Attribute(
+        targets.targets_,
+        targets.patterns_.size(),
+        targets.owners_,
+        filter.Match(targets.targets_)));
+}
+
+auto ScanCoordinator::Unregister(const SubchainID& subchain) noexcept -> void
+{
+    auto lock = Lock{lock_};
+    subchains_.erase(subchain);
+    ++generation_;
+}
+}  // namespace opentxs::blockchain::client::wallet
@@ -0,0 +1,143 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "internal/blockchain/client/Client.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/blockchain/FilterType.hpp"
+#include "opentxs/blockchain/Types.hpp"
+#include "opentxs/blockchain/client/FilterOracle.hpp"
+#include "util/LRU.hpp"
+
+namespace opentxs
+{
+namespace blockchain
+{
+namespace client
+{
+namespace internal
+{
+struct Network;
+struct WalletDatabase;
+}  // namespace internal
+}  // namespace client
+}  // namespace blockchain
+}  // namespace opentxs
+
+namespace opentxs::blockchain::client::wallet
+{
+/// Matches every filter against the targets of all subchains on a chain at
+/// once
+///
+/// The first subchain to scan a block loads its filter and hashes the union of
+/// every registered subchain's patterns plus the wallet's unspent outputs.
+/// The result is cached by block hash so the remaining subchains scanning the
+/// same block only look up whether any of their own targets matched.
+///
+/// Cached results are tied to a generation number which is advanced whenever
+/// the target set of any subchain may have changed.
+class ScanCoordinator
+{
+public:
+    using SubchainID = internal::WalletDatabase::SubchainID;
+    using Patterns = internal::WalletDatabase::Patterns;
+    // Maps the index one past the last pattern of each subchain to its owner
+    using Owners = std::map<std::size_t, SubchainID>;
+
+    struct Pass {
+        bool missing_{false};
+        bool utxo_{false};
+        std::set<SubchainID> matches_{};
+    };
+
+    /// Returns which subchains own the matching targets
+    ///
+    /// Targets at or after index patterns are unspent outputs.
+    static auto Attribute(
+        const client::GCS::Targets& targets,
+        const std::size_t patterns,
+        const Owners& owners,
+        const client::GCS::Matches& matches) noexcept -> Pass;
+    /// Appends the patterns of every subchain to output
+    ///
+    /// Subchains without patterns do not appear in the returned map.
+    static auto Merge(
+        std::vector<std::pair<SubchainID, Patterns>>&& input,
+        Patterns& output) noexcept -> Owners;
+
+    /// Returns std::nullopt if the filter for the block is not available,
+    /// otherwise whether any target belonging to the subchain matched
+    auto Check(const SubchainID& subchain, const block::Hash& block) noexcept
+        -> std::optional<bool>;
+    auto Invalidate() noexcept -> void;
+    auto Register(const SubchainID& subchain) noexcept -> void;
+    auto Unregister(const SubchainID& subchain) noexcept -> void;
+
+    ScanCoordinator(
+        const internal::Network& network,
+        const internal::WalletDatabase& db,
+        const filter::Type filter) noexcept;
+
+    ~ScanCoordinator() = default;
+
+private:
+    struct Targets {
+        const Patterns patterns_;
+        const std::vector<internal::WalletDatabase::UTXO> utxos_;
+        const Owners owners_;
+        const client::GCS::Targets targets_;
+
+        Targets(
+            Patterns&& patterns,
+            std::vector<internal::WalletDatabase::UTXO>&& utxos,
+            Owners&& owners,
+            const filter::Type type) noexcept;
+    };
+    struct Entry {
+        std::uint64_t generation_;
+        std::shared_future<std::shared_ptr<const Pass>> pass_;
+    };
+    using Cache = LRU<block::pHash, Entry>;
+    using TargetsFuture = std::shared_future<std::shared_ptr<const Targets>>;
+
+    // Number of blocks for which results are retained
+    static constexpr std::size_t cache_capacity_{20000};
+
+    const internal::Network& network_;
+    const internal::WalletDatabase& db_;
+    const filter::Type filter_type_;
+    std::atomic<std::uint64_t> generation_;
+    mutable std::mutex lock_;
+    std::set<SubchainID> subchains_;
+    std::uint64_t targets_generation_;
+    TargetsFuture targets_;
+    Cache cache_;
+
+    auto load_targets(const std::set<SubchainID>& subchains) const noexcept
+        -> std::shared_ptr<const Targets>;
+    auto run(const block::Hash& block, const Targets& targets) const noexcept
+        -> std::shared_ptr<const Pass>;
+
+    ScanCoordinator() = delete;
+    ScanCoordinator(const ScanCoordinator&) = delete;
+    ScanCoordinator(ScanCoordinator&&) = delete;
+    auto operator=(const ScanCoordinator&) -> ScanCoordinator& = delete;
+    auto operator=(ScanCoordinator&&) -> ScanCoordinator& = delete;
+};
+}  // namespace opentxs::blockchain::client::wallet
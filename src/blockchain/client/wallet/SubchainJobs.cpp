@@ -0,0 +1,247 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"    // IWYU pragma: associated
+#include "1_Internal.hpp"  // IWYU pragma: associated
+#include "blockchain/client/wallet/SubchainJobs.hpp"  // IWYU pragma: associated
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <iterator>
+#include <utility>
+
+#include "opentxs/Bytes.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/blockchain/block/bitcoin/Input.hpp"  // IWYU pragma: keep
+#include "opentxs/protobuf/BlockchainTransactionOutput.pb.h"  // IWYU pragma: keep
+
+namespace opentxs::blockchain::client::internal
+{
+ProcessJob::Item::Item(const OutstandingBlocks::iterator block) noexcept
+    : block_(block)
+    , matched_()
+    , promise_()
+    , finished_(promise_.get_future())
+{
+}
+
+ProcessJob::ProcessJob(
+    const std::vector<OutstandingBlocks::iterator>& blocks) noexcept
+    : items_()
+    , next_(0)
+{
+    items_.reserve(blocks.size());
+
+    for (const auto& block : blocks) { items_.emplace_back(block); }
+}
+
+auto ProcessJob::Finish() noexcept -> void
+{
+    // Every block must be claimed before this function is called, so waiting
+    // on a block can only block on a job which is already running
+    for (auto& item : items_) {
+        item.finished_.wait();
+        item.block_->second.matched_ = std::move(item.matched_);
+    }
+}
+
+auto ProcessJob::Next() noexcept -> Item*
+{
+    const auto index = next_.fetch_add(1);
+
+    if (index < items_.size()) { return &items_.at(index); }
+
+    return nullptr;
+}
+
+ScanJob::Range::Range(
+    const block::Height first,
+    const block::Height last) noexcept
+    : first_(first)
+    , last_(last)
+    , highest_()
+    , missing_()
+    , matches_()
+    , promise_()
+    , finished_(promise_.get_future())
+{
+}
+
+ScanJob::ScanJob(
+    std::vector<WalletDatabase::UTXO>&& utxos,
+    const block::Height first,
+    const block::Height last,
+    const std::size_t jobs) noexcept
+    : utxos_(std::move(utxos))
+    , ranges_()
+    , stop_(last)
+    , next_(0)
+{
+    if (last < first) { return; }
+
+    static constexpr auto minimum = block::Height{100};
+    const auto count = last - first + 1;
+    const auto divisions =
+        static_cast<block::Height>((1u < jobs) ? (jobs * 4u) : 1u);
+    const auto size = std::max(minimum, (count + divisions - 1) / divisions);
+    ranges_.reserve(static_cast<std::size_t>((count + size - 1) / size));
+
+    for (auto i{first}; i <= last; i += size) {
+        ranges_.emplace_back(i, std::min(i + size - 1, last));
+    }
+}
+
+auto ScanJob::Merge(std::vector<block::pHash>& output) noexcept -> Result
+{
+    auto result = Result{};
+
+    // Every range must be claimed before the merge starts, so waiting on a
+    // range can only block on a job which is already running
+    for (auto& range : ranges_) {
+        range.finished_.wait();
+        std::move(
+            std::begin(range.matches_),
+            std::end(range.matches_),
+            std::back_inserter(output));
+        range.matches_.clear();
+
+        if (range.highest_.has_value()) {
+            result.highest_ = std::move(range.highest_);
+        }
+
+        if (range.missing_.has_value()) {
+            result.missing_ = std::move(range.missing_);
+
+            break;
+        }
+    }
+
+    return result;
+}
+
+auto ScanJob::Next() noexcept -> Range*
+{
+    const auto index = next_.fetch_add(1);
+
+    if (index < ranges_.size()) { return &ranges_.at(index); }
+
+    return nullptr;
+}
+
+auto ScanJob::Stop(const block::Height height) noexcept -> void
+{
+    auto current = stop_.load();
+
+    while ((height < current) &&
+           (false == stop_.compare_exchange_weak(current, height))) {
+    }
+}
+
+auto PrefetchBlocks(
+    const std::size_t limit,
+    const OutstandingBlocks& outstanding,
+    std::vector<block::pHash>& requests) noexcept -> BlockOracle::BlockHashes
+{
+    const auto window = (limit > outstanding.size())
+                            ? (limit - outstanding.size())
+                            : std::size_t{0};
+    auto output = BlockOracle::BlockHashes{};
+    auto next = requests.begin();
+
+    for (; (requests.end() != next) && (output.size() < window); ++next) {
+        const auto& hash = *next;
+
+        if (0 < outstanding.count(hash)) { continue; }
+
+        if (output.end() != std::find(output.begin(), output.end(), hash)) {
+            continue;
+        }
+
+        output.emplace_back(hash);
+    }
+
+    requests.erase(requests.begin(), next);
+
+    return output;
+}
+
+auto ReadyBlocks(const ProcessQueue& queue) noexcept
+    -> std::vector<OutstandingBlocks::iterator>
+{
+    auto output = std::vector<OutstandingBlocks::iterator>{};
+
+    for (const auto& it : queue) {
+        const auto& [future, matched] = it->second;
+
+        if (matched) { continue; }
+
+        if (std::future_status::ready ==
+            future.wait_for(std::chrono::milliseconds(0))) {
+            output.emplace_back(it);
+        }
+    }
+
+    return output;
+}
+
+auto ScanTargets(
+    const filter::Type type,
+    const WalletDatabase::Patterns& keys,
+    const std::vector<WalletDatabase::UTXO>& unspent) noexcept
+    -> client::GCS::Targets
+{
+    auto output = client::GCS::Targets{};
+    output.reserve(keys.size() + unspent.size());
+    std::transform(
+        std::begin(keys),
+        std::end(keys),
+        std::back_inserter(output),
+        [](const auto& in) { return reader(in.second); });
+
+    switch (type) {
+        case filter::Type::Basic_BIP158: {
+            std::transform(
+                std::begin(unspent),
+                std::end(unspent),
+                std::back_inserter(output),
+                [](const auto& in) {
+                    return ReadView{
+                        in.second.script().data(), in.second.script().size()};
+                });
+        } break;
+        case filter::Type::Basic_BCHVariant:
+        case filter::Type::Extended_opentxs:
+        default: {
+            std::transform(
+                std::begin(unspent),
+                std::end(unspent),
+                std::back_inserter(output),
+                [](const auto& in) { return in.first.Bytes(); });
+        }
+    }
+
+    return output;
+}
+
+auto TakeMatchedBlocks(ProcessQueue& queue) noexcept
+    -> std::vector<OutstandingBlocks::iterator>
+{
+    auto output = std::vector<OutstandingBlocks::iterator>{};
+
+    // Blocks which were matched ahead of an earlier block which is still
+    // downloading remain queued until every earlier block is committed
+    while (false == queue.empty()) {
+        auto it = queue.front();
+
+        if (false == bool(it->second.matched_)) { break; }
+
+        output.emplace_back(it);
+        queue.pop_front();
+    }
+
+    return output;
+}
+}  // namespace opentxs::blockchain::client::internal
@@ -0,0 +1,164 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "internal/blockchain/client/Client.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/blockchain/FilterType.hpp"
+#include "opentxs/blockchain/Types.hpp"
+#include "opentxs/blockchain/block/Block.hpp"
+#include "opentxs/blockchain/block/Header.hpp"
+#include "opentxs/blockchain/client/BlockOracle.hpp"
+#include "opentxs/blockchain/client/FilterOracle.hpp"
+#include "opentxs/core/Data.hpp"
+
+// Work which a wallet subchain divides between thread pool jobs. None of
+// these types depend on SubchainStateData, so they can be tested without a
+// network.
+namespace opentxs::blockchain::client::internal
+{
+// Result of matching a downloaded block against a subchain's untested
+// patterns. A null block_ indicates the download failed.
+struct MatchedBlock {
+    BlockOracle::BitcoinBlock_p block_{};
+    std::unique_ptr<block::Header> header_{};
+    WalletDatabase::MatchingIndices tested_{};
+    std::size_t potential_{};
+    block::Block::Matches confirmed_{};
+    std::chrono::milliseconds elapsed_{};
+};
+
+struct PendingBlock {
+    BlockOracle::BitcoinBlockFuture future_;
+    // Set once the block has been matched and is waiting to be committed
+    std::shared_ptr<const MatchedBlock> matched_;
+};
+
+using OutstandingBlocks = std::map<block::pHash, PendingBlock>;
+using ProcessQueue = std::deque<OutstandingBlocks::iterator>;
+
+// Shared state for one call to SubchainStateData::process(). Blocks which
+// have finished downloading are claimed in queue order by the process job
+// itself and by any helper jobs it was able to queue. Matched blocks are only
+// ever committed by the original process job, in queue order, after every
+// block has been matched.
+struct ProcessJob {
+    struct Item {
+        const OutstandingBlocks::iterator block_;
+        std::shared_ptr<const MatchedBlock> matched_;
+        std::promise<void> promise_;
+        std::future<void> finished_;
+
+        Item(const OutstandingBlocks::iterator block) noexcept;
+        Item(Item&&) = default;
+    };
+
+    std::vector<Item> items_;
+
+    /// Waits for every block to be matched and attaches the results to the
+    /// pending blocks
+    auto Finish() noexcept -> void;
+    /// Returns nullptr once every block has been claimed
+    auto Next() noexcept -> Item*;
+
+    ProcessJob(const std::vector<OutstandingBlocks::iterator>& blocks) noexcept;
+
+private:
+    std::atomic<std::size_t> next_;
+
+    ProcessJob() = delete;
+    ProcessJob(const ProcessJob&) = delete;
+    ProcessJob(ProcessJob&&) = delete;
+    auto operator=(const ProcessJob&) -> ProcessJob& = delete;
+    auto operator=(ProcessJob&&) -> ProcessJob& = delete;
+};
+
+// Shared state for one call to SubchainStateData::scan(). The height range is
+// divided into contiguous sub-ranges which are claimed in order by the scan
+// job itself and by any helper jobs it was able to queue. Results are only
+// ever merged by the original scan job, in height order, after every
+// sub-range has finished.
+struct ScanJob {
+    struct Range {
+        block::Height first_;
+        block::Height last_;
+        std::optional<block::Position> highest_;
+        std::optional<block::Position> missing_;
+        std::vector<block::pHash> matches_;
+        std::promise<void> promise_;
+        std::future<void> finished_;
+
+        Range(const block::Height first, const block::Height last) noexcept;
+        Range(Range&&) = default;
+    };
+
+    struct Result {
+        // Highest height tested before the first missing filter
+        std::optional<block::Position> highest_{};
+        // Lowest height at which a filter was missing
+        std::optional<block::Position> missing_{};
+    };
+
+    const std::vector<WalletDatabase::UTXO> utxos_;
+    std::vector<Range> ranges_;
+    // Lowest height at which a filter was found to be missing. No height
+    // above this one can contribute to the result.
+    std::atomic<block::Height> stop_;
+
+    /// Waits for every range to finish and appends the matching blocks to
+    /// the output in height order, stopping at the first missing filter
+    auto Merge(std::vector<block::pHash>& output) noexcept -> Result;
+    /// Returns nullptr once every range has been claimed
+    auto Next() noexcept -> Range*;
+    auto Stop(const block::Height height) noexcept -> void;
+
+    ScanJob(
+        std::vector<WalletDatabase::UTXO>&& utxos,
+        const block::Height first,
+        const block::Height last,
+        const std::size_t jobs) noexcept;
+
+private:
+    std::atomic<std::size_t> next_;
+
+    ScanJob() = delete;
+    ScanJob(const ScanJob&) = delete;
+    ScanJob(ScanJob&&) = delete;
+    auto operator=(const ScanJob&) -> ScanJob& = delete;
+    auto operator=(ScanJob&&) -> ScanJob& = delete;
+};
+
+/// Removes blocks from the front of the request list until the number of
+/// outstanding blocks reaches the limit and returns the ones which are not
+/// already outstanding
+auto PrefetchBlocks(
+    const std::size_t limit,
+    const OutstandingBlocks& outstanding,
+    std::vector<block::pHash>& requests) noexcept -> BlockOracle::BlockHashes;
+/// Queued blocks which have finished downloading but are not yet matched
+auto ReadyBlocks(const ProcessQueue& queue) noexcept
+    -> std::vector<OutstandingBlocks::iterator>;
+/// Filter targets for the specified patterns and unspent outputs
+auto ScanTargets(
+    const filter::Type type,
+    const WalletDatabase::Patterns& keys,
+    const std::vector<WalletDatabase::UTXO>& unspent) noexcept
+    -> client::GCS::Targets;
+/// Removes and returns the matched blocks at the front of the queue. Blocks
+/// matched behind one which is still pending stay queued.
+auto TakeMatchedBlocks(ProcessQueue& queue) noexcept
+    -> std::vector<OutstandingBlocks::iterator>;
+}  // namespace opentxs::blockchain::client::internal
@@ -12,10 +12,13 @@
 #include <future>
 #include <iterator>
 #include <memory>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
+#include "blockchain/client/wallet/ScanCoordinator.hpp"
 #include "internal/api/Api.hpp"
+#include "internal/blockchain/block/Block.hpp"
 #include "opentxs/Bytes.hpp"
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/api/Core.hpp"
@@ -26,6 +29,7 @@
 #include "opentxs/blockchain/block/bitcoin/Block.hpp"
 #include "opentxs/blockchain/block/bitcoin/Input.hpp"  // IWYU pragma: keep
 #include "opentxs/blockchain/block/bitcoin/Script.hpp"
+#include "opentxs/blockchain/block/bitcoin/Transaction.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/LogSource.hpp"
 #include "opentxs/network/zeromq/Frame.hpp"
@@ -58,13 +62,50 @@ auto Wallet::ProcessThreadPool(const zmq::Message& in) noexcept -> void
     OT_ASSERT(nullptr != pData);
 
     auto& data = *pData;
+    const auto task = body.at(0).as<Task>();
+
+    if ((Task::scan_range == task) || (Task::process_range == task)) {
+        if (3 > body.size()) {
+            LogOutput("opentxs::blockchain::client::internal:Wallet::")(
+                __FUNCTION__)(": Invalid message")
+                .Flush();
+
+            OT_FAIL;
+        }
+
+        const auto address = body.at(2).as<std::uintptr_t>();
+        auto postcondition = ScopeGuard{[&] { --data.job_counter_; }};
+
+        if (Task::scan_range == task) {
+            using Job = ScanJob;
+            auto pJob = std::unique_ptr<std::shared_ptr<Job>>{
+                reinterpret_cast<std::shared_ptr<Job>*>(address)};
+
+            OT_ASSERT(pJob);
+            OT_ASSERT(*pJob);
+
+            data.scan_range(**pJob);
+        } else {
+            using Job = ProcessJob;
+            auto pJob = std::unique_ptr<std::shared_ptr<Job>>{
+                reinterpret_cast<std::shared_ptr<Job>*>(address)};
+
+            OT_ASSERT(pJob);
+            OT_ASSERT(*pJob);
+
+            data.process_range(**pJob);
+        }
+
+        return;
+    }
+
     auto postcondition = ScopeGuard{[&] {
         data.running_.store(false);
         data.task_finished_();
         --data.job_counter_;
     }};
 
-    switch (body.at(0).as<Task>()) {
+    switch (task) {
         case Task::index: {
             data.index();
         } break;
@@ -94,12 +135,14 @@ SubchainStateData::SubchainStateData(
     const OTIdentifier&& id,
     const SimpleCallback& taskFinished,
     Outstanding& jobCounter,
+    ScanCoordinator& scanner,
     const zmq::socket::Push& threadPool,
     const filter::Type filter,
     const Subchain subchain) noexcept
     : id_(std::move(id))
     , subchain_(subchain)
     , job_counter_(jobCounter)
+    , scanner_(scanner)
     , task_finished_(taskFinished)
     , running_(false)
     , reorg_()
@@ -114,9 +157,13 @@ SubchainStateData::SubchainStateData(
     , db_(db)
     , filter_type_(filter)
     , thread_pool_(threadPool)
+    , scan_jobs_(scan_jobs(network))
+    , prefetch_(std::max<std::size_t>(network.GetConfig().block_prefetch_, 1u))
 {
     OT_ASSERT(task_finished_);
     OT_ASSERT(false == id_->empty());
+
+    scanner_.Register(scan_id());
 }
 
 auto SubchainStateData::ReorgQueue::Empty() const noexcept -> bool
@@ -148,22 +195,31 @@ auto SubchainStateData::ReorgQueue::Next() noexcept -> block::Position
 
 auto SubchainStateData::check_blocks() noexcept -> bool
 {
-    for (const auto& hash : blocks_to_request_) {
+    auto hashes = internal::PrefetchBlocks(
+        prefetch_, outstanding_blocks_, blocks_to_request_);
+
+    if (0 == hashes.size()) { return false; }
+
+    for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
         LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(" requesting block ")(
-            hash->asHex())(" queue position: ")(outstanding_blocks_.size())
+            hashes.at(i)->asHex())(" queue position: ")(
+            outstanding_blocks_.size() + i)
             .Flush();
+    }
 
-        if (0 == outstanding_blocks_.count(hash)) {
-            auto [it, added] = outstanding_blocks_.emplace(
-                hash, network_.BlockOracle().LoadBitcoin(hash));
+    auto futures = network_.BlockOracle().LoadBitcoin(hashes);
 
-            OT_ASSERT(added);
+    OT_ASSERT(hashes.size() == futures.size());
 
-            process_block_queue_.push(it);
-        }
-    }
+    for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+        auto [it, added] = outstanding_blocks_.emplace(
+            std::move(hashes.at(i)),
+            internal::PendingBlock{std::move(futures.at(i)), nullptr});
 
-    blocks_to_request_.clear();
+        OT_ASSERT(added);
+
+        process_block_queue_.push_back(it);
+    }
 
     return false;
 }
@@ -172,19 +228,20 @@ auto SubchainStateData::check_process() noexcept -> bool
 {
     if (process_block_queue_.empty()) { return false; }
 
-    const auto& [id, future] = *process_block_queue_.front();
+    const auto haveWork =
+        bool(process_block_queue_.front()->second.matched_) ||
+        (false == internal::ReadyBlocks(process_block_queue_).empty());
 
-    if (std::future_status::ready ==
-        future.wait_for(std::chrono::milliseconds(1))) {
+    if (haveWork) {
         LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(
-            " ready to process block")
+            " ready to process blocks")
             .Flush();
         static constexpr auto job{"process"};
 
         return queue_work(Task::process, job);
     } else {
-        LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(" waiting for block ")(
-            id->asHex())(" to download")
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(" waiting for ")(
+            process_block_queue_.size())(" blocks to download")
             .Flush();
     }
 
@@ -248,44 +305,6 @@ auto SubchainStateData::check_scan() noexcept -> bool
     return false;
 }
 
-auto SubchainStateData::get_targets(
-    const internal::WalletDatabase::Patterns& keys,
-    const std::vector<internal::WalletDatabase::UTXO>& unspent) const noexcept
-    -> client::GCS::Targets
-{
-    auto output = client::GCS::Targets{};
-    output.reserve(keys.size() + unspent.size());
-    std::transform(
-        std::begin(keys),
-        std::end(keys),
-        std::back_inserter(output),
-        [](const auto& in) { return reader(in.second); });
-
-    switch (filter_type_) {
-        case filter::Type::Basic_BIP158: {
-            std::transform(
-                std::begin(unspent),
-                std::end(unspent),
-                std::back_inserter(output),
-                [](const auto& in) {
-                    return ReadView{
-                        in.second.script().data(), in.second.script().size()};
-                });
-        } break;
-        case filter::Type::Basic_BCHVariant:
-        case filter::Type::Extended_opentxs:
-        default: {
-            std::transform(
-                std::begin(unspent),
-                std::end(unspent),
-                std::back_inserter(output),
-                [](const auto& in) { return in.first.Bytes(); });
-        }
-    }
-
-    return output;
-}
-
 auto SubchainStateData::index_element(
     const filter::Type type,
     const api::client::blockchain::BalanceNode::Element& input,
@@ -336,19 +355,11 @@ auto SubchainStateData::index_element(
     }
 }
 
-auto SubchainStateData::process() noexcept -> void
+auto SubchainStateData::commit(
+    const block::Hash& blockHash,
+    const internal::MatchedBlock& matched) noexcept -> void
 {
-    const auto start = Clock::now();
-    const auto& filters = network_.FilterOracleInternal();
-    auto it = process_block_queue_.front();
-    auto postcondition = ScopeGuard{[&] {
-        outstanding_blocks_.erase(it);
-        process_block_queue_.pop();
-    }};
-    const auto& blockHash = it->first.get();
-    const auto pBlock = it->second.get();
-
-    if (false == bool(pBlock)) {
+    if (false == bool(matched.block_)) {
         LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(" invalid block ")(
             blockHash.asHex())
             .Flush();
@@ -358,8 +369,44 @@ auto SubchainStateData::process() noexcept -> void
         return;
     }
 
+    const auto& block = *matched.block_;
+    const auto& header = *matched.header_;
+    const auto& confirmed = matched.confirmed_;
+    handle_confirmed_matches(block, header.Position(), confirmed);
+    const auto [balance, unconfirmed] = db_.GetBalance();
+    LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(" block ")(
+        block.ID().asHex())(" processed in ")(matched.elapsed_.count())(
+        " milliseconds. ")(confirmed.size())(" of ")(matched.potential_)(
+        " potential matches confirmed. Wallet balance is: ")(unconfirmed)(" (")(
+        balance)(" confirmed)")
+        .Flush();
+    db_.SubchainMatchBlock(
+        id_, subchain_, filter_type_, matched.tested_, blockHash.Bytes());
+
+    if (0 < confirmed.size()) {
+        // The wallet's unspent outputs are part of every scan target set
+        scanner_.Invalidate();
+        // Re-scan the last 1000 blocks
+        const auto& oracle = network_.HeaderOracleInternal();
+        const auto height = std::max(header.Height() - 1000, block::Height{0});
+        last_scanned_ = block::Position{height, oracle.BestHash(height)};
+    }
+}
+
+auto SubchainStateData::match(
+    const block::Hash& blockHash,
+    const BlockOracle::BitcoinBlock_p& pBlock) const noexcept
+    -> std::shared_ptr<const internal::MatchedBlock>
+{
+    const auto start = Clock::now();
+    auto output = std::make_shared<internal::MatchedBlock>();
+    output->block_ = pBlock;
+
+    if (false == bool(pBlock)) { return output; }
+
+    const auto& filters = network_.FilterOracleInternal();
     const auto& block = *pBlock;
-    auto tested = WalletDatabase::MatchingIndices{};
+    auto& tested = output->tested_;
     auto patterns = client::GCS::Targets{};
     auto elements = db_.GetUntestedPatterns(
         id_, subchain_, filter_type_, blockHash.Bytes());
@@ -371,7 +418,7 @@ auto SubchainStateData::process() noexcept -> void
             patterns.emplace_back(reader(data));
         });
 
-    const auto pFilter = filters.LoadFilter(filter_type_, blockHash);
+    const auto pFilter = filters.LoadFilterShared(filter_type_, blockHash);
 
     OT_ASSERT(pFilter);
 
@@ -384,32 +431,99 @@ auto SubchainStateData::process() noexcept -> void
         potential.emplace_back(std::move(id), std::move(element));
     }
 
-    const auto confirmed =
+    output->potential_ = potential.size();
+    output->confirmed_ =
         block.FindMatches(blockchain_, filter_type_, {}, potential);
-    const auto& oracle = network_.HeaderOracleInternal();
-    const auto pHeader = oracle.LoadHeader(blockHash);
+    output->header_ = network_.HeaderOracleInternal().LoadHeader(blockHash);
 
-    OT_ASSERT(pHeader);
+    OT_ASSERT(output->header_);
 
-    const auto& header = *pHeader;
-    handle_confirmed_matches(block, header.Position(), confirmed);
-    const auto [balance, unconfirmed] = db_.GetBalance();
-    LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(" block ")(
-        block.ID().asHex())(" processed in ")(
-        std::chrono::duration_cast<std::chrono::milliseconds>(
-            Clock::now() - start)
-            .count())(" milliseconds. ")(confirmed.size())(" of ")(
-        potential.size())(" potential matches confirmed. Wallet balance is: ")(
-        unconfirmed)(" (")(balance)(" confirmed)")
-        .Flush();
-    db_.SubchainMatchBlock(
-        id_, subchain_, filter_type_, tested, blockHash.Bytes());
+    output->elapsed_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+        Clock::now() - start);
 
-    if (0 < confirmed.size()) {
-        // Re-scan the last 1000 blocks
-        const auto height = std::max(header.Height() - 1000, block::Height{0});
-        last_scanned_ = block::Position{height, oracle.BestHash(height)};
+    return output;
+}
+
+auto SubchainStateData::mempool(
+    const internal::Mempool::Transactions& transactions) noexcept -> void
+{
+    const auto patterns = block::Block::ParsedPatterns{
+        db_.GetPatterns(id_, subchain_, filter_type_)};
+    auto matches = block::Block::Matches{};
+
+    for (const auto& pTransaction : transactions) {
+        OT_ASSERT(pTransaction);
+
+        auto temp =
+            pTransaction->FindMatches(blockchain_, filter_type_, {}, patterns);
+        matches.insert(
+            matches.end(),
+            std::make_move_iterator(temp.begin()),
+            std::make_move_iterator(temp.end()));
+    }
+
+    handle_mempool_matches(matches, transactions);
+
+    if (0 < matches.size()) { scanner_.Invalidate(); }
+}
+
+auto SubchainStateData::process() noexcept -> void
+{
+    const auto blocks = internal::ReadyBlocks(process_block_queue_);
+
+    if (0 < blocks.size()) {
+        auto job = std::make_shared<internal::ProcessJob>(blocks);
+        const auto helpers = std::min(scan_jobs_, job->items_.size());
+
+        for (auto i = std::size_t{1}; i < helpers; ++i) {
+            if (false == queue_helper(Task::process_range, job)) { break; }
+        }
+
+        process_range(*job);
+        job->Finish();
+    }
+
+    for (const auto& it : internal::TakeMatchedBlocks(process_block_queue_)) {
+        commit(it->first, *it->second.matched_);
+        outstanding_blocks_.erase(it);
+    }
+}
+
+auto SubchainStateData::process_range(internal::ProcessJob& job) const noexcept
+    -> void
+{
+    for (auto* item = job.Next(); nullptr != item; item = job.Next()) {
+        auto postcondition = ScopeGuard{[&] { item->promise_.set_value(); }};
+        const auto& [hash, pending] = *item->block_;
+        item->matched_ = match(hash, pending.future_.get());
+    }
+}
+
+template <typename Job>
+auto SubchainStateData::queue_helper(
+    const Task task,
+    const std::shared_ptr<Job>& job) noexcept -> bool
+{
+    if (job_counter_.limited()) { return false; }
+
+    using Pool = api::internal::ThreadPool;
+    auto work =
+        Pool::MakeWork(api_.ZeroMQ(), value(Pool::Work::BlockchainWallet));
+    auto pJob = std::make_unique<std::shared_ptr<Job>>(job);
+    work->AddFrame(task);
+    work->AddFrame(reinterpret_cast<std::uintptr_t>(this));
+    work->AddFrame(reinterpret_cast<std::uintptr_t>(pJob.get()));
+    ++job_counter_;
+
+    if (thread_pool_.Send(work)) {
+        pJob.release();
+
+        return true;
     }
+
+    --job_counter_;
+
+    return false;
 }
 
 auto SubchainStateData::queue_work(const Task task, const char* log) noexcept
@@ -454,6 +568,7 @@ auto SubchainStateData::reorg() noexcept -> void
             db_.SubchainLastProcessed(id_, subchain_, filter_type_);
         const auto reorg = network_.HeaderOracleInternal().CalculateReorg(tip);
         db_.ReorgTo(id_, subchain_, filter_type_, reorg);
+        scanner_.Invalidate();
     }
 
     const auto scannedTarget =
@@ -464,11 +579,8 @@ auto SubchainStateData::reorg() noexcept -> void
     if (last_scanned_.has_value()) { last_scanned_ = scannedTarget; }
 
     blocks_to_request_.clear();
+    process_block_queue_.clear();
     outstanding_blocks_.clear();
-
-    while (false == process_block_queue_.empty()) {
-        process_block_queue_.pop();
-    }
 }
 
 auto SubchainStateData::scan() noexcept -> void
@@ -500,54 +612,26 @@ auto SubchainStateData::scan() noexcept -> void
             .Flush();
     }
 
-    const auto elements = db_.GetPatterns(id_, subchain_, filter_type_);
-    const auto utxos = db_.GetUnspentOutputs();
-    auto highestTested =
-        last_scanned_.value_or(make_blank<block::Position>::value(api_));
-    auto atLeastOnce{false};
-
-    for (auto i{startHeight}; i <= stopHeight; ++i) {
-        auto blockHash = headers.BestHash(i);
-        const auto pFilter = filters.LoadFilterOrResetTip(
-            filter_type_, block::Position{i, blockHash});
-
-        if (false == bool(pFilter)) {
-            LogOutput(OT_METHOD)(__FUNCTION__)(": ")(id_)(" filter at height ")(
-                i)(" not found ")
-                .Flush();
+    auto job = std::make_shared<internal::ScanJob>(
+        db_.GetUnspentOutputs(), startHeight, stopHeight, scan_jobs_);
+    const auto helpers = std::min(scan_jobs_, job->ranges_.size());
 
-            break;
-        }
+    for (auto i = std::size_t{1}; i < helpers; ++i) {
+        if (false == queue_helper(Task::scan_range, job)) { break; }
+    }
 
-        atLeastOnce = true;
-        highestTested.first = i;
-        highestTested.second = blockHash;
-        const auto& filter = *pFilter;
-        auto patterns = get_targets(elements, utxos);
-        auto matches = filter.Match(patterns);
-        const auto size{matches.size()};
-
-        if (0 < matches.size()) {
-            LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(" GCS for block ")(
-                blockHash->asHex())(" at height ")(i)(
-                " matches at least one of the ")(patterns.size())(
-                " target elements for ")(id_)
-                .Flush();
-            const auto retest = db_.GetUntestedPatterns(
-                id_, subchain_, filter_type_, blockHash->Bytes());
-            patterns = get_targets(retest, utxos);
-            matches = filter.Match(patterns);
-            LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(" ")(matches.size())(
-                " of ")(size)(" matches are new")
-                .Flush();
+    scan_range(*job);
+    auto [highest, missing] = job->Merge(blocks_to_request_);
 
-            if (0 < matches.size()) {
-                blocks_to_request_.emplace_back(std::move(blockHash));
-            }
-        }
+    if (missing.has_value()) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(id_)(" filter at height ")(
+            missing.value().first)(" not found ")
+            .Flush();
+        filters.LoadFilterOrResetTip(filter_type_, missing.value());
     }
 
-    if (atLeastOnce) {
+    if (highest.has_value()) {
+        const auto& highestTested = highest.value();
         LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(" found ")(
             blocks_to_request_.size())(" potential matches between blocks ")(
             startHeight)(" and ")(highestTested.first)(" in ")(
@@ -555,13 +639,84 @@ auto SubchainStateData::scan() noexcept -> void
                 Clock::now() - start)
                 .count())(" milliseconds")
             .Flush();
-        last_scanned_ = std::move(highestTested);
+        last_scanned_ = std::move(highest);
     } else {
         LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(
             " scan interrupted due to missing filter")
             .Flush();
     }
 }
+
+auto SubchainStateData::scan_jobs(const internal::Network& network) noexcept
+    -> std::size_t
+{
+    const auto configured = network.GetConfig().scan_parallelism_;
+
+    if (0u < configured) { return configured; }
+
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1u);
+}
+
+auto SubchainStateData::scan_id() const noexcept
+    -> internal::WalletDatabase::SubchainID
+{
+    return {subchain_, id_};
+}
+
+auto SubchainStateData::scan_range(internal::ScanJob& job) const noexcept
+    -> void
+{
+    const auto& headers = network_.HeaderOracleInternal();
+    const auto& filters = network_.FilterOracleInternal();
+    const auto key = scan_id();
+
+    for (auto* range = job.Next(); nullptr != range; range = job.Next()) {
+        auto postcondition = ScopeGuard{[&] { range->promise_.set_value(); }};
+
+        for (auto i{range->first_}; i <= range->last_; ++i) {
+            if (i > job.stop_.load()) { break; }
+
+            auto blockHash = headers.BestHash(i);
+            const auto match = scanner_.Check(key, blockHash);
+            const auto pFilter =
+                (match.has_value() && match.value())
+                    ? filters.LoadFilterShared(filter_type_, blockHash)
+                    : std::shared_ptr<const client::GCS>{};
+
+            if ((false == match.has_value()) ||
+                (match.value() && (false == bool(pFilter)))) {
+                range->missing_ = block::Position{i, std::move(blockHash)};
+                job.Stop(i);
+
+                break;
+            }
+
+            range->highest_ = block::Position{i, blockHash};
+
+            if (match.value()) {
+                LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(
+                    " GCS for block ")(blockHash->asHex())(" at height ")(i)(
+                    " matches at least one target element for ")(id_)
+                    .Flush();
+                const auto& filter = *pFilter;
+                const auto retest = db_.GetUntestedPatterns(
+                    id_, subchain_, filter_type_, blockHash->Bytes());
+                const auto patterns =
+                    internal::ScanTargets(filter_type_, retest, job.utxos_);
+                const auto matches = filter.Match(patterns);
+                LogVerbose(OT_METHOD)(__FUNCTION__)(": ")(id_)(" ")(
+                    matches.size())(" of ")(patterns.size())(
+                    " untested targets match")
+                    .Flush();
+
+                if (0 < matches.size()) {
+                    range->matches_.emplace_back(std::move(blockHash));
+                }
+            }
+        }
+    }
+}
+
 auto SubchainStateData::state_machine() noexcept -> bool
 {
     if (running_) {
@@ -583,5 +738,7 @@ auto SubchainStateData::state_machine() noexcept -> bool
 SubchainStateData::~SubchainStateData()
 {
     while (0 < job_counter_) { Sleep(std::chrono::microseconds(100)); }
+
+    scanner_.Unregister(scan_id());
 }
 }  // namespace opentxs::blockchain::client::wallet
@@ -6,12 +6,15 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <queue>
 #include <vector>
 
+#include "blockchain/client/wallet/SubchainJobs.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 #include "internal/blockchain/client/Client.hpp"
 #include "opentxs/Types.hpp"
@@ -73,13 +76,12 @@ class Outstanding;
 
 namespace opentxs::blockchain::client::wallet
 {
+class ScanCoordinator;
+
 class SubchainStateData
 {
 public:
     using Subchain = internal::WalletDatabase::Subchain;
-    using OutstandingMap =
-        std::map<block::pHash, BlockOracle::BitcoinBlockFuture>;
-    using ProcessQueue = std::queue<OutstandingMap::iterator>;
 
     struct ReorgQueue {
         auto Empty() const noexcept -> bool;
@@ -95,20 +97,26 @@ public:
     const OTIdentifier id_;
     const Subchain subchain_;
     Outstanding& job_counter_;
+    ScanCoordinator& scanner_;
     const SimpleCallback& task_finished_;
     std::atomic<bool> running_;
     ReorgQueue reorg_;
     std::optional<Bip32Index> last_indexed_;
     std::optional<block::Position> last_scanned_;
     std::vector<block::pHash> blocks_to_request_;
-    OutstandingMap outstanding_blocks_;
-    ProcessQueue process_block_queue_;
+    internal::OutstandingBlocks outstanding_blocks_;
+    internal::ProcessQueue process_block_queue_;
 
     virtual auto index() noexcept -> void = 0;
     virtual auto process() noexcept -> void;
     virtual auto reorg() noexcept -> void;
     virtual auto scan() noexcept -> void;
 
+    /// Matches unconfirmed transactions against every pattern of the subchain
+    auto mempool(const internal::Mempool::Transactions& transactions) noexcept
+        -> void;
+    auto process_range(internal::ProcessJob& job) const noexcept -> void;
+    auto scan_range(internal::ScanJob& job) const noexcept -> void;
     auto state_machine() noexcept -> bool;
 
     virtual ~SubchainStateData();
@@ -138,27 +146,44 @@ protected:
         const OTIdentifier&& id,
         const SimpleCallback& taskFinished,
         Outstanding& jobCounter,
+        ScanCoordinator& scanner,
         const zmq::socket::Push& threadPool,
         const filter::Type filter,
         const Subchain subchain) noexcept;
 
 private:
     const zmq::socket::Push& thread_pool_;
+    const std::size_t scan_jobs_;
+    const std::size_t prefetch_;
+
+    static auto scan_jobs(const internal::Network& network) noexcept
+        -> std::size_t;
 
-    auto get_targets(
-        const internal::WalletDatabase::Patterns& keys,
-        const std::vector<internal::WalletDatabase::UTXO>& unspent)
-        const noexcept -> client::GCS::Targets;
+    auto match(
+        const block::Hash& blockHash,
+        const BlockOracle::BitcoinBlock_p& pBlock) const noexcept
+        -> std::shared_ptr<const internal::MatchedBlock>;
+    auto scan_id() const noexcept -> internal::WalletDatabase::SubchainID;
 
     auto check_blocks() noexcept -> bool;
     virtual auto check_index() noexcept -> bool = 0;
     auto check_process() noexcept -> bool;
     auto check_reorg() noexcept -> bool;
     auto check_scan() noexcept -> bool;
+    auto commit(
+        const block::Hash& blockHash,
+        const internal::MatchedBlock& matched) noexcept -> void;
+    template <typename Job>
+    auto queue_helper(const Task task, const std::shared_ptr<Job>& job) noexcept
+        -> bool;
     virtual auto handle_confirmed_matches(
         const block::bitcoin::Block& block,
         const block::Position& position,
         const block::Block::Matches& confirmed) noexcept -> void = 0;
+    virtual auto handle_mempool_matches(
+        const block::Block::Matches& matches,
+        const internal::Mempool::Transactions& transactions) noexcept
+        -> void = 0;
 
     SubchainStateData() = delete;
     SubchainStateData(const SubchainStateData&) = delete;
@@ -7,10 +7,13 @@
 #include "1_Internal.hpp"                       // IWYU pragma: associated
 #include "blockchain/client/wallet/Wallet.hpp"  // IWYU pragma: associated
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <future>
 #include <memory>
+#include <mutex>
+#include <utility>
 
 #include "core/Worker.hpp"
 #include "internal/api/client/Client.hpp"
@@ -77,6 +80,9 @@ Wallet::Wallet(
           chain_,
           task_finished_)
     , proposals_(api, blockchain_api_, parent_, db_, chain_)
+    , mempool_lock_()
+    , mempool_()
+    , expired_()
 {
     auto zmq = thread_pool->Start(api_.ThreadPool().Endpoint());
 
@@ -101,6 +107,28 @@ auto Wallet::ConstructTransaction(
     return output;
 }
 
+auto Wallet::ExpireMempool(std::vector<block::pTxid>&& txids) const noexcept
+    -> void
+{
+    if (false == enabled_.load()) { return; }
+
+    {
+        auto lock = Lock{mempool_lock_};
+
+        for (auto& txid : txids) {
+            mempool_.erase(
+                std::remove_if(
+                    mempool_.begin(),
+                    mempool_.end(),
+                    [&](const auto& tx) { return txid == tx->ID(); }),
+                mempool_.end());
+            expired_.emplace_back(std::move(txid));
+        }
+    }
+
+    trigger();
+}
+
 auto Wallet::Init() noexcept -> void
 {
     enabled_ = true;
@@ -152,6 +180,28 @@ auto Wallet::pipeline(const zmq::Message& in) noexcept -> void
     }
 }
 
+auto Wallet::ProcessMempool(internal::Mempool::Transaction tx) const noexcept
+    -> void
+{
+    // Transactions received before the wallet is enabled will be found by
+    // scanning once they confirm
+    if (false == enabled_.load()) { return; }
+
+    {
+        auto lock = Lock{mempool_lock_};
+        const auto& txid = tx->ID();
+        expired_.erase(
+            std::remove_if(
+                expired_.begin(),
+                expired_.end(),
+                [&](const auto& id) { return id == txid; }),
+            expired_.end());
+        mempool_.emplace_back(std::move(tx));
+    }
+
+    trigger();
+}
+
 auto Wallet::process_reorg(const zmq::Message& in) noexcept -> void
 {
     const auto body = in.Body();
@@ -189,6 +239,25 @@ auto Wallet::state_machine() noexcept -> bool
 {
     if (false == running_.get()) { return false; }
 
+    auto mempool = internal::Mempool::Transactions{};
+    auto expired = std::vector<block::pTxid>{};
+
+    {
+        auto lock = Lock{mempool_lock_};
+        mempool.swap(mempool_);
+        expired.swap(expired_);
+    }
+
+    if (0 < mempool.size()) { accounts_.Mempool(mempool); }
+
+    for (const auto& txid : expired) {
+        if (false == db_.RemoveMempoolTransaction(txid)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to remove unconfirmed transaction ")(txid->asHex())
+                .Flush();
+        }
+    }
+
     auto repeat = accounts_.state_machine();
     repeat |= proposals_.Run();
 
@@ -129,6 +129,10 @@ class Wallet final : virtual public internal::Wallet, Worker<Wallet, api::Core>
 public:
     auto ConstructTransaction(const proto::BlockchainTransactionProposal& tx)
         const noexcept -> std::future<block::pTxid> final;
+    auto ExpireMempool(std::vector<block::pTxid>&& txids) const noexcept
+        -> void final;
+    auto ProcessMempool(internal::Mempool::Transaction tx) const noexcept
+        -> void final;
 
     auto Init() noexcept -> void final;
     auto Shutdown() noexcept -> std::shared_future<void> final
@@ -322,6 +326,11 @@ private:
     OTZMQPushSocket thread_pool;
     wallet::Accounts accounts_;
     Proposals proposals_;
+    mutable std::mutex mempool_lock_;
+    // Unconfirmed transactions waiting to be matched by the state machine
+    mutable internal::Mempool::Transactions mempool_;
+    // Transactions which left the mempool without being mined
+    mutable std::vector<block::pTxid> expired_;
 
     auto pipeline(const zmq::Message& in) noexcept -> void;
     auto process_reorg(const zmq::Message& in) noexcept -> void;
@@ -7,11 +7,15 @@
 #include "1_Internal.hpp"                  // IWYU pragma: associated
 #include "blockchain/database/Blocks.hpp"  // IWYU pragma: associated
 
+#include <algorithm>
+#include <cstring>
 #include <iosfwd>
 #include <memory>
+#include <vector>
 
 #include "internal/blockchain/Blockchain.hpp"
 #include "internal/blockchain/Params.hpp"
+#include "internal/blockchain/block/bitcoin/Bitcoin.hpp"
 #include "internal/blockchain/client/Client.hpp"
 #include "opentxs/Bytes.hpp"
 #include "opentxs/Pimpl.hpp"
@@ -37,10 +41,13 @@ auto tsv(const Input& in) noexcept -> ReadView
 
 Blocks::Blocks(
     const api::Core& api,
+    const api::client::Blockchain& blockchain,
     const Common& common,
     const opentxs::storage::lmdb::LMDB& lmdb,
+    const client::internal::Config& config,
     const blockchain::Type type) noexcept
     : api_(api)
+    , blockchain_(blockchain)
     , common_(common)
     , lmdb_(lmdb)
     , blank_position_(make_blank<block::Position>::value(api))
@@ -50,12 +57,46 @@ Blocks::Blocks(
 
         return api_.Factory().Data(hex, StringStyle::Hex);
     }())
+    , prune_blocks_(config.block_prune_blocks_)
+    , prune_bytes_(config.block_prune_bytes_)
+    , lock_()
+    , pruned_(load_pruned())
+    , checked_(-1)
+    , target_(pruned_)
 {
     if (blank_position_.first == Tip().first) {
         SetTip(block::Position{0, genesis_});
     }
 }
 
+auto Blocks::best_hash(const block::Height height) const noexcept
+    -> block::pHash
+{
+    auto output = api_.Factory().Data();
+    lmdb_.Load(
+        Table::BlockHeaderBest,
+        tsv(static_cast<std::size_t>(height)),
+        [&](const auto in) -> void { output->Assign(in.data(), in.size()); });
+
+    return output;
+}
+
+auto Blocks::load_pruned() const noexcept -> block::Height
+{
+    auto output = block::Height{-1};
+    auto cb = [&output](const auto in) {
+        if (sizeof(output) != in.size()) { return; }
+
+        std::memcpy(&output, in.data(), in.size());
+    };
+    lmdb_.Load(
+        Table::Config,
+        tsv(static_cast<std::size_t>(Key::PrunedBlockHeight)),
+        cb);
+
+    return output;
+}
+
 auto Blocks::LoadBitcoin(const block::Hash& block) const noexcept
     -> std::shared_ptr<const block::bitcoin::Block>
 {
@@ -81,8 +122,123 @@ auto Blocks::LoadBitcoin(const block::Hash& block) const noexcept
             return {};
         }
 
-        return api_.Factory().BitcoinBlock(chain_, bytes.get());
+        // Block storage is never unmapped while the database exists and a
+        // stored block is only ever rewritten with identical contents, so the
+        // block may continue to refer to the mapped bytes after the reader is
+        // released. The pin prevents pruning from releasing the bytes for as
+        // long as the block exists.
+        struct Pinned {
+            std::shared_ptr<const void> pin_;
+            std::shared_ptr<const block::bitcoin::Block> block_;
+        };
+
+        auto pinned = std::make_shared<Pinned>();
+        pinned->pin_ = common_.BlockPin(block);
+        pinned->block_ = factory::BitcoinBlockView(
+            api_, blockchain_, chain_, bytes.get());
+
+        if (false == bool(pinned->block_)) { return {}; }
+
+        return {pinned, pinned->block_.get()};
+    }
+}
+
+auto Blocks::LoadRaw(const block::Hash& block) const noexcept
+    -> api::client::blockchain::BlockReader
+{
+    auto output = common_.BlockLoad(block);
+
+    if (false == output.valid()) {
+        LogDebug(OT_METHOD)(__FUNCTION__)(": block ")(block.asHex())(
+            " not found.")
+            .Flush();
     }
+
+    return output;
+}
+
+auto Blocks::Prune() const noexcept -> bool
+{
+    if ((0 == prune_blocks_) && (0 == prune_bytes_)) { return false; }
+
+    auto lock = Lock{lock_};
+    const auto tip = Tip();
+
+    if (tip.first != checked_) {
+        target_ = PruneTarget(
+            tip.first,
+            pruned_,
+            prune_blocks_,
+            prune_bytes_,
+            [this](const auto height) {
+                return common_.BlockLoad(best_hash(height)).size();
+            });
+        checked_ = tip.first;
+    }
+
+    if (target_ <= pruned_) { return false; }
+
+    const auto last = std::min(target_, pruned_ + prune_batch_);
+    auto hashes = std::vector<block::pHash>{};
+
+    for (auto height = pruned_ + 1; height <= last; ++height) {
+        hashes.emplace_back(best_hash(height));
+    }
+
+    // Removal stops at a block which is in use. It is retried on a later call.
+    const auto removed = common_.BlockForget(hashes);
+
+    if (0 == removed) { return false; }
+
+    const auto cursor = pruned_ + static_cast<block::Height>(removed);
+    const auto saved = lmdb_.Store(
+        Table::Config,
+        tsv(static_cast<std::size_t>(Key::PrunedBlockHeight)),
+        tsv(cursor));
+
+    if (false == saved.first) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to save pruned height")
+            .Flush();
+
+        return false;
+    }
+
+    pruned_ = cursor;
+    LogVerbose(OT_METHOD)(__FUNCTION__)(": Pruned ")(removed)(
+        " blocks through height ")(pruned_)
+        .Flush();
+
+    return (removed == hashes.size()) && (pruned_ < target_);
+}
+
+auto Blocks::PruneTarget(
+    const block::Height tip,
+    const block::Height pruned,
+    const std::size_t blocks,
+    const std::size_t bytes,
+    const BlockSize& size) noexcept -> block::Height
+{
+    auto output = pruned;
+
+    if (0 < blocks) {
+        output = std::max(output, tip - static_cast<block::Height>(blocks));
+    }
+
+    if (0 < bytes) {
+        auto total = std::size_t{0};
+
+        for (auto height = tip; height > output; --height) {
+            total += size(height);
+
+            // The tip is always retained regardless of its size
+            if ((total > bytes) && (height < tip)) {
+                output = height;
+                break;
+            }
+        }
+    }
+
+    return output;
 }
 
 auto Blocks::SetTip(const block::Position& position) const noexcept -> bool
@@ -7,7 +7,9 @@
 
 #include <boost/container/flat_set.hpp>
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iosfwd>
 #include <map>
 #include <memory>
@@ -71,27 +73,63 @@ class LMDB;
 
 namespace opentxs::blockchain::database
 {
+// Blocks which fall outside of the configured pruning limits are removed from
+// storage in small batches after the block tip advances. A removed block which
+// is needed again is requested from the network.
 class Blocks
 {
 public:
+    using BlockSize = std::function<std::size_t(const block::Height)>;
+
+    // Returns the highest height at or below which blocks fall outside of the
+    // pruning limits, or pruned if no further blocks should be removed. size
+    // is only called for heights above the returned value.
+    static auto PruneTarget(
+        const block::Height tip,
+        const block::Height pruned,
+        const std::size_t blocks,
+        const std::size_t bytes,
+        const BlockSize& size) noexcept -> block::Height;
+
     auto LoadBitcoin(const block::Hash& block) const noexcept
         -> std::shared_ptr<const block::bitcoin::Block>;
+    auto LoadRaw(const block::Hash& block) const noexcept
+        -> api::client::blockchain::BlockReader;
+    // Removes the next batch of blocks which fall outside of the pruning
+    // limits and returns true if more blocks remain to be removed
+    auto Prune() const noexcept -> bool;
     auto SetTip(const block::Position& position) const noexcept -> bool;
     auto Store(const block::Block& block) const noexcept -> bool;
     auto Tip() const noexcept -> block::Position;
 
     Blocks(
         const api::Core& api,
+        const api::client::Blockchain& blockchain,
         const Common& common,
         const opentxs::storage::lmdb::LMDB& lmdb,
+        const client::internal::Config& config,
         const blockchain::Type type) noexcept;
 
 private:
+    static constexpr auto prune_batch_ = block::Height{100};
+
     const api::Core& api_;
+    const api::client::Blockchain& blockchain_;
     const Common& common_;
     const opentxs::storage::lmdb::LMDB& lmdb_;
     const block::Position blank_position_;
     const blockchain::Type chain_;
     const block::pHash genesis_;
+    const std::size_t prune_blocks_;
+    const std::size_t prune_bytes_;
+    mutable std::mutex lock_;
+    // Highest height which has been pruned, persisted after each batch
+    mutable block::Height pruned_;
+    // Tip height for which target_ was calculated
+    mutable block::Height checked_;
+    mutable block::Height target_;
+
+    auto best_hash(const block::Height height) const noexcept -> block::pHash;
+    auto load_pruned() const noexcept -> block::Height;
 };
 }  // namespace opentxs::blockchain::database
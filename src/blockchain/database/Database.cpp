@@ -10,6 +10,7 @@
 #include <memory>
 #include <string>
 
+#include "internal/api/client/Client.hpp"  // IWYU pragma: keep
 #include "internal/blockchain/Blockchain.hpp"
 #include "internal/blockchain/client/Factory.hpp"
 #include "opentxs/core/Log.hpp"
@@ -23,13 +24,15 @@ auto BlockchainDatabase(
     const api::Core& api,
     const api::client::internal::Blockchain& blockchain,
     const blockchain::client::internal::Network& network,
+    const blockchain::client::internal::Config& config,
     const api::client::blockchain::database::implementation::Database& common,
     const blockchain::Type type) noexcept
     -> std::unique_ptr<blockchain::internal::Database>
 {
     using ReturnType = blockchain::implementation::Database;
 
-    return std::make_unique<ReturnType>(api, blockchain, network, common, type);
+    return std::make_unique<ReturnType>(
+        api, blockchain, network, config, common, type);
 }
 }  // namespace opentxs::factory
 
@@ -46,7 +49,7 @@ auto tsv(const Input& in) noexcept -> ReadView
     return {reinterpret_cast<const char*>(&in), sizeof(in)};
 }
 
-const std::size_t Database::db_version_{1};
+const std::size_t Database::db_version_{database::db_version_};
 const opentxs::storage::lmdb::TableNames Database::table_names_{
     {database::Config, "config"},
     {database::BlockHeaderMetadata, "block_header_metadata"},
@@ -56,12 +59,15 @@ const opentxs::storage::lmdb::TableNames Database::table_names_{
     {database::BlockHeaderDisconnected, "disconnected_block_headers"},
     {database::BlockFilterBest, "filter_tips"},
     {database::BlockFilterHeaderBest, "filter_header_tips"},
+    {database::BlockHeaderRecords, "block_header_records"},
+    {database::FreeHeaderRecords, "free_header_records"},
 };
 
 Database::Database(
     const api::Core& api,
     const api::client::internal::Blockchain& blockchain,
     const client::internal::Network& network,
+    const client::internal::Config& config,
     const database::Common& common,
     const blockchain::Type type) noexcept
     : chain_(type)
@@ -80,13 +86,15 @@ Database::Database(
                 {database::BlockHeaderDisconnected, MDB_DUPSORT},
                 {database::BlockFilterBest, MDB_INTEGERKEY},
                 {database::BlockFilterHeaderBest, MDB_INTEGERKEY},
+                {database::BlockHeaderRecords, 0},
+                {database::FreeHeaderRecords, MDB_INTEGERKEY},
             },
             0};
         init_db(lmdb);
 
         return lmdb;
     }())
-    , blocks_(api, common_, lmdb_, type)
+    , blocks_(api, blockchain, common_, lmdb_, config, type)
     , filters_(api, common_, lmdb_, type)
     , headers_(api, network, common_, lmdb_, type)
     , wallet_(api, blockchain, common_, chain_)
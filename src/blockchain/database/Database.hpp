@@ -136,6 +136,24 @@ public:
             outputIndices,
             transaction);
     }
+    auto AddMempoolTransaction(
+        const blockchain::Type chain,
+        const NodeID& balanceNode,
+        const Subchain subchain,
+        const FilterType type,
+        const std::vector<std::uint32_t> outputIndices,
+        const block::bitcoin::Transaction& transaction,
+        const VersionNumber version) const noexcept -> bool final
+    {
+        return wallet_.AddMempoolTransaction(
+            chain,
+            balanceNode,
+            subchain,
+            type,
+            version,
+            outputIndices,
+            transaction);
+    }
     auto AddOutgoingTransaction(
         const blockchain::Type chain,
         const Identifier& proposalID,
@@ -168,6 +186,10 @@ public:
     {
         return headers_.BestBlock(position);
     }
+    auto BestChain() const noexcept -> std::vector<block::pHash> final
+    {
+        return headers_.BestChain();
+    }
     auto BlockExists(const block::Hash& block) const noexcept -> bool final
     {
         return common_.BlockExists(block);
@@ -177,11 +199,17 @@ public:
     {
         return blocks_.LoadBitcoin(block);
     }
+    auto BlockLoadRaw(const block::Hash& block) const noexcept
+        -> api::client::blockchain::BlockReader final
+    {
+        return blocks_.LoadRaw(block);
+    }
     auto BlockPolicy() const noexcept
         -> api::client::blockchain::BlockStorage final
     {
         return common_.BlockPolicy();
     }
+    auto BlockPrune() const noexcept -> bool final { return blocks_.Prune(); }
     auto BlockStore(const block::Block& block) const noexcept -> bool final
     {
         return blocks_.Store(block);
@@ -313,6 +341,20 @@ public:
     {
         return filters_.LoadFilterHeader(type, block);
     }
+    auto LoadFilterHeaders(
+        const filter::Type type,
+        const std::vector<block::pHash>& blocks) const noexcept
+        -> std::vector<Hash> final
+    {
+        return filters_.LoadFilterHeaders(type, blocks);
+    }
+    auto LoadFilters(
+        const filter::Type type,
+        const std::vector<block::pHash>& blocks) const noexcept
+        -> std::vector<std::unique_ptr<const client::GCS>> final
+    {
+        return filters_.LoadFilters(type, blocks);
+    }
     // Throws std::out_of_range if the header does not exist
     auto LoadHeader(const block::Hash& hash) const noexcept(false)
         -> std::unique_ptr<block::Header> final
@@ -334,6 +376,11 @@ public:
     {
         return sync_.Load(height, output);
     }
+    auto LoadStatistics(const Identifier& address) const noexcept
+        -> Statistics final
+    {
+        return common_.LoadPeerStatistics(address);
+    }
     auto LookupContact(const Data& pubkeyHash) const noexcept
         -> std::set<OTIdentifier> final
     {
@@ -348,6 +395,11 @@ public:
     {
         return wallet_.ReleaseChangeKey(proposal, key);
     }
+    auto RemoveMempoolTransaction(const block::Txid& txid) const noexcept
+        -> bool final
+    {
+        return wallet_.RemoveMempoolTransaction(txid);
+    }
     auto ReorgSync(const Height height) const noexcept -> bool final
     {
         return sync_.Reorg(height);
@@ -420,6 +472,12 @@ public:
     {
         return filters_.StoreHeaders(type, previous, std::move(headers));
     }
+    auto StoreStatistics(
+        const Identifier& address,
+        const Statistics& statistics) const noexcept -> bool final
+    {
+        return common_.StorePeerStatistics(address, statistics);
+    }
     auto StoreSync(const block::Position& tip, const Items& items)
         const noexcept -> bool final
     {
@@ -529,6 +587,7 @@ public:
         const api::Core& api,
         const api::client::internal::Blockchain& blockchain,
         const client::internal::Network& network,
+        const client::internal::Config& config,
         const database::Common& common,
         const blockchain::Type type) noexcept;
 
@@ -10,6 +10,7 @@
 #include <boost/container/flat_map.hpp>
 #include <algorithm>
 #include <iosfwd>
+#include <iterator>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -159,6 +160,20 @@ auto Filters::LoadFilterHeader(const filter::Type type, const ReadView block)
     return api_.Factory().Data();
 }
 
+auto Filters::views(const std::vector<block::pHash>& blocks) noexcept
+    -> std::vector<ReadView>
+{
+    auto output = std::vector<ReadView>{};
+    output.reserve(blocks.size());
+    std::transform(
+        blocks.begin(),
+        blocks.end(),
+        std::back_inserter(output),
+        [](const auto& hash) { return hash->Bytes(); });
+
+    return output;
+}
+
 auto Filters::SetHeaderTip(
     const filter::Type type,
     const block::Position& position) const noexcept -> bool
@@ -0,0 +1,266 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"                           // IWYU pragma: associated
+#include "1_Internal.hpp"                         // IWYU pragma: associated
+#include "blockchain/database/HeaderRecords.hpp"  // IWYU pragma: associated
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+#include "internal/blockchain/database/Database.hpp"
+#include "opentxs/Bytes.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Log.hpp"
+#include "opentxs/core/LogSource.hpp"
+
+#define OT_METHOD "opentxs::blockchain::database::HeaderRecords::"
+
+namespace opentxs::blockchain::database
+{
+template <typename Input>
+auto tsv(const Input& in) noexcept -> ReadView
+{
+    return {reinterpret_cast<const char*>(&in), sizeof(in)};
+}
+
+// Records are written in aligned groups which never span two backing files
+constexpr auto records_per_chunk_ = block::Height{4096};
+
+HeaderRecords::HeaderRecords(
+    opentxs::storage::lmdb::LMDB& lmdb,
+    const std::string& path) noexcept(false)
+    : MappedFileStorage(
+          lmdb,
+          path,
+          "hdr",
+          Table::Config,
+          static_cast<std::size_t>(Key::NextHeaderRecord),
+          Table::FreeHeaderRecords)
+    , lock_()
+    , height_(load_height())
+{
+}
+
+auto HeaderRecords::Height() const noexcept -> block::Height
+{
+    auto lock = Lock{lock_};
+
+    return height_;
+}
+
+auto HeaderRecords::index(const block::Height height) noexcept -> IndexData
+{
+    return IndexData{
+        static_cast<std::size_t>(height) * record_bytes_, record_bytes_};
+}
+
+auto HeaderRecords::Invalidate(const block::Height height, MDB_txn* tx) noexcept
+    -> bool
+{
+    auto lock = Lock{lock_};
+
+    if (height >= height_) { return true; }
+
+    if (false == store_height(height, tx)) { return false; }
+
+    height_ = height;
+
+    return true;
+}
+
+auto HeaderRecords::load(const Lock&, const block::Height height)
+    const noexcept -> std::optional<Record>
+{
+    if ((0 > height) || (height > height_)) { return std::nullopt; }
+
+    const auto view = get_read_view(index(height));
+
+    if (record_bytes_ != view.size()) { return std::nullopt; }
+
+    auto output = Record{};
+    std::memcpy(static_cast<void*>(&output), view.data(), view.size());
+
+    return output;
+}
+
+auto HeaderRecords::Load(const block::Height height) const noexcept
+    -> std::optional<Record>
+{
+    auto lock = Lock{lock_};
+
+    return load(lock, height);
+}
+
+auto HeaderRecords::Load(const block::Hash& hash) const noexcept
+    -> std::optional<Record>
+{
+    auto lock = Lock{lock_};
+    auto height = std::size_t{0};
+    const auto indexed = lmdb_.Load(
+        BlockHeaderRecords, hash.Bytes(), [&](const auto in) -> void {
+            std::memcpy(
+                &height, in.data(), std::min(in.size(), sizeof(height)));
+        });
+
+    if (false == indexed) { return std::nullopt; }
+
+    auto output = load(lock, static_cast<block::Height>(height));
+
+    // The index may refer to a record which has since been replaced
+    if (output.has_value() && (output->Hash() != hash.Bytes())) {
+        return std::nullopt;
+    }
+
+    return output;
+}
+
+auto HeaderRecords::load_height() const noexcept -> block::Height
+{
+    auto output = block::Height{-1};
+    lmdb_.Load(
+        Table::Config,
+        tsv(static_cast<std::size_t>(Key::HeaderRecordHeight)),
+        [&](const auto in) -> void {
+            std::memcpy(
+                &output, in.data(), std::min(in.size(), sizeof(output)));
+        });
+
+    return output;
+}
+
+auto HeaderRecords::Store(const std::vector<Record>& records) noexcept -> bool
+{
+    if (records.empty()) { return true; }
+
+    auto lock = Lock{lock_};
+    const auto first = block::Height{records.front().height_.value()};
+
+    if ((height_ + 1) != first) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Expected record at height ")(
+            height_ + 1)(" but received ")(first)
+            .Flush();
+
+        return false;
+    }
+
+    auto tx = lmdb_.TransactionRW();
+    auto pending = Pending{};
+    auto next = std::size_t{0};
+
+    while (next < records.size()) {
+        const auto start = first + static_cast<block::Height>(next);
+        const auto end = std::min(
+            first + static_cast<block::Height>(records.size()),
+            ((start / records_per_chunk_) + 1) * records_per_chunk_);
+        const auto count = static_cast<std::size_t>(end - start);
+        auto position = index(start);
+        position.size_ = count * record_bytes_;
+        auto view = get_write_view(tx, position, position.size_, pending);
+
+        if (false == view.valid(position.size_)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to get write position for height ")(start)
+                .Flush();
+
+            return false;
+        }
+
+        auto* out = static_cast<char*>(view.data());
+
+        for (auto i = std::size_t{0}; i < count; ++i, ++next) {
+            const auto& record = records.at(next);
+            const auto height = start + static_cast<block::Height>(i);
+
+            if (height != record.height_.value()) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Records are not contiguous")
+                    .Flush();
+
+                return false;
+            }
+
+            auto* slot = out + (i * record_bytes_);
+            const auto old = ReadView{slot, record.hash_.size()};
+            const auto empty = std::all_of(
+                old.begin(), old.end(), [](const auto c) { return 0 == c; });
+
+            if ((false == empty) && (old != record.Hash())) {
+                // NOTE failure is not fatal since the stale entry will be
+                // detected when it is read
+                lmdb_.Delete(BlockHeaderRecords, old, tx);
+            }
+
+            std::memcpy(slot, &record, record_bytes_);
+            const auto key = static_cast<std::size_t>(height);
+
+            if (false ==
+                lmdb_.Store(BlockHeaderRecords, record.Hash(), tsv(key), tx)
+                    .first) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Failed to index record at height ")(height)
+                    .Flush();
+
+                return false;
+            }
+        }
+    }
+
+    const auto last = first + static_cast<block::Height>(records.size()) - 1;
+
+    if (false == store_height(last, tx)) { return false; }
+
+    if (false == tx.Finalize(true)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Database update error").Flush();
+
+        return false;
+    }
+
+    apply(pending);
+    height_ = last;
+
+    return true;
+}
+
+auto HeaderRecords::Update(const Record& record) noexcept -> bool
+{
+    auto lock = Lock{lock_};
+    const auto height = block::Height{record.height_.value()};
+    const auto existing = load(lock, height);
+
+    if ((false == existing.has_value()) ||
+        (existing->Hash() != record.Hash())) {
+        return false;
+    }
+
+    auto position = index(height);
+    auto view = get_write_view(position, {}, record_bytes_);
+
+    if (false == view.valid(record_bytes_)) { return false; }
+
+    std::memcpy(view.data(), &record, record_bytes_);
+
+    return true;
+}
+
+auto HeaderRecords::store_height(const block::Height height, MDB_txn* tx)
+    const noexcept -> bool
+{
+    const auto output = lmdb_.Store(
+        Table::Config,
+        tsv(static_cast<std::size_t>(Key::HeaderRecordHeight)),
+        tsv(height),
+        tx);
+
+    if (false == output.first) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to store record height")
+            .Flush();
+    }
+
+    return output.first;
+}
+}  // namespace opentxs::blockchain::database
@@ -0,0 +1,76 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "internal/blockchain/block/Block.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/blockchain/Types.hpp"
+#include "util/LMDB.hpp"
+#include "util/MappedFileStorage.hpp"
+
+namespace opentxs
+{
+namespace storage
+{
+namespace lmdb
+{
+class LMDB;
+}  // namespace lmdb
+}  // namespace storage
+}  // namespace opentxs
+
+namespace opentxs::blockchain::database
+{
+// Stores the best chain as an array of fixed size header records
+//
+// The record for each height is located at a fixed offset in a memory mapped
+// file. An index in LMDB maps the hash of each stored record to its height.
+// Records above Height() are not valid and are never returned.
+class HeaderRecords final : private util::MappedFileStorage
+{
+public:
+    using Record = block::bitcoin::internal::HeaderRecord;
+
+    // Returns the height through which every record is valid
+    auto Height() const noexcept -> block::Height;
+    auto Load(const block::Height height) const noexcept
+        -> std::optional<Record>;
+    auto Load(const block::Hash& hash) const noexcept -> std::optional<Record>;
+
+    // Marks every record above the specified height as invalid. Must be
+    // called before the best chain at those heights is changed.
+    auto Invalidate(const block::Height height, MDB_txn* tx) noexcept -> bool;
+    // The records must be contiguous and start at Height() + 1
+    auto Store(const std::vector<Record>& records) noexcept -> bool;
+    // Replaces the metadata of a valid record with the same hash and height.
+    // Returns false if no such record exists.
+    auto Update(const Record& record) noexcept -> bool;
+
+    HeaderRecords(
+        opentxs::storage::lmdb::LMDB& lmdb,
+        const std::string& path) noexcept(false);
+
+private:
+    static constexpr auto record_bytes_ = sizeof(Record);
+
+    mutable std::mutex lock_;
+    block::Height height_;
+
+    static auto index(const block::Height height) noexcept -> IndexData;
+
+    auto load(const Lock& lock, const block::Height height) const noexcept
+        -> std::optional<Record>;
+    auto load_height() const noexcept -> block::Height;
+    auto store_height(const block::Height height, MDB_txn* tx) const noexcept
+        -> bool;
+};
+}  // namespace opentxs::blockchain::database
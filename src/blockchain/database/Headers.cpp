@@ -10,11 +10,14 @@
 #include <algorithm>
 #include <cstring>
 #include <iterator>
+#include <limits>
+#include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "blockchain/client/UpdateTransaction.hpp"
 #include "core/Worker.hpp"
@@ -53,13 +56,18 @@ Headers::Headers(
     const api::Core& api,
     const client::internal::Network& network,
     const Common& common,
-    const opentxs::storage::lmdb::LMDB& lmdb,
+    opentxs::storage::lmdb::LMDB& lmdb,
     const blockchain::Type type) noexcept
     : api_(api)
     , network_(network)
     , common_(common)
     , lmdb_(lmdb)
+    , chain_(type)
     , lock_()
+    , records_(
+          lmdb,
+          common.AllocateStorageFolder(
+              std::to_string(static_cast<std::uint32_t>(type))))
 {
     import_genesis(type);
 
@@ -70,6 +78,34 @@ Headers::Headers(
         OT_ASSERT(0 <= best.first);
     }
 
+    {
+        auto lock = Lock{lock_};
+
+        // The database version is only updated when the migration succeeds,
+        // so it will be attempted again on the next start
+        if (false == migrate_work(lock)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to recalculate stored work")
+                .Flush();
+
+            OT_FAIL;
+        }
+
+        const auto missing = best(lock).first - records_.Height();
+
+        if (0 < missing) {
+            LogNormal("Building header records for ")(missing)(
+                " best chain headers")
+                .Flush();
+        }
+
+        if (false == update_records(lock, nullptr)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to build header records")
+                .Flush();
+        }
+    }
+
     {
         const auto header = CurrentBest();
 
@@ -189,6 +225,29 @@ auto Headers::ApplyUpdate(const client::UpdateTransaction& update) noexcept
         }
     }
 
+    // Records for heights which are about to change must not be read until
+    // they have been rewritten
+    const auto unchanged = [&] {
+        auto output = std::numeric_limits<block::Height>::max();
+
+        if (update.HaveReorg()) { output = update.ReorgParent().first; }
+
+        if (0 < update.BestChain().size()) {
+            output =
+                std::min(output, update.BestChain().cbegin()->first - 1);
+        }
+
+        return output;
+    }();
+
+    if (false == records_.Invalidate(unchanged, parentTxn)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Failed to invalidate header records")
+            .Flush();
+
+        return false;
+    }
+
     if (update.HaveReorg()) {
         for (auto i = initialHeight; i > update.ReorgParent().first; --i) {
             if (false == pop_best(i, parentTxn)) {
@@ -225,6 +284,22 @@ auto Headers::ApplyUpdate(const client::UpdateTransaction& update) noexcept
     parentTxn.Finalize(true);
     const auto position = best(lock);
 
+    for (const auto& [hash, pair] : update.UpdatedHeaders()) {
+        const auto* header =
+            dynamic_cast<const block::bitcoin::internal::Header*>(
+                pair.first.get());
+
+        if (nullptr != header) { records_.Update(header->Record()); }
+    }
+
+    // NOTE a failure here is not fatal since the missing records will be
+    // written during the next update
+    if (false == update_records(lock, &update.UpdatedHeaders())) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Failed to update header records")
+            .Flush();
+    }
+
     if (update.HaveReorg()) {
         const auto [height, hash] = update.ReorgParent();
         const auto bytes = hash->Bytes();
@@ -253,6 +328,43 @@ auto Headers::ApplyUpdate(const client::UpdateTransaction& update) noexcept
 
 auto Headers::BestBlock(const block::Height position) const noexcept(false)
     -> block::pHash
+{
+    if (const auto record = records_.Load(position); record.has_value()) {
+        const auto hash = record->Hash();
+
+        return Data::Factory(hash.data(), hash.size());
+    }
+
+    return best_hash(position);
+}
+
+auto Headers::BestChain() const noexcept -> std::vector<block::pHash>
+{
+    Lock lock(lock_);
+    auto output = std::vector<block::pHash>{};
+    lmdb_.Read(
+        BlockHeaderBest,
+        [&](const auto key, const auto value) -> bool {
+            auto height = std::size_t{};
+
+            if (sizeof(height) != key.size()) { return false; }
+
+            std::memcpy(&height, key.data(), key.size());
+
+            // Stop at the first gap rather than return a discontinuous chain
+            if (output.size() != height) { return false; }
+
+            output.emplace_back(Data::Factory(value.data(), value.size()));
+
+            return true;
+        },
+        opentxs::storage::lmdb::LMDB::Dir::Forward);
+
+    return output;
+}
+
+auto Headers::best_hash(const block::Height position) const noexcept
+    -> block::pHash
 {
     auto output = Data::Factory();
 
@@ -383,6 +495,8 @@ auto Headers::HaveCheckpoint() const noexcept -> bool
 auto Headers::header_exists(const Lock& lock, const block::Hash& hash)
     const noexcept -> bool
 {
+    if (records_.Load(hash).has_value()) { return true; }
+
     return common_.BlockHeaderExists(hash) &&
            lmdb_.Exists(BlockHeaderMetadata, hash.Bytes());
 }
@@ -466,6 +580,12 @@ auto Headers::IsSibling(const block::Hash& hash) const noexcept -> bool
 auto Headers::load_bitcoin_header(const block::Hash& hash) const
     -> std::unique_ptr<block::bitcoin::Header>
 {
+    if (const auto record = records_.Load(hash); record.has_value()) {
+        auto output = factory::BitcoinBlockHeader(api_, chain_, *record);
+
+        if (output) { return output; }
+    }
+
     auto proto = common_.LoadBlockHeader(hash);
     const auto haveMeta =
         lmdb_.Load(BlockHeaderMetadata, hash.Bytes(), [&](const auto data) {
@@ -488,6 +608,12 @@ auto Headers::load_bitcoin_header(const block::Hash& hash) const
 auto Headers::load_header(const block::Hash& hash) const
     -> std::unique_ptr<block::Header>
 {
+    if (const auto record = records_.Load(hash); record.has_value()) {
+        auto output = factory::BitcoinBlockHeader(api_, chain_, *record);
+
+        if (output) { return output; }
+    }
+
     auto proto = common_.LoadBlockHeader(hash);
     const auto haveMeta =
         lmdb_.Load(BlockHeaderMetadata, hash.Bytes(), [&](const auto data) {
@@ -505,6 +631,144 @@ auto Headers::load_header(const block::Hash& hash) const
     return output;
 }
 
+auto Headers::migrate_work(const Lock& lock) noexcept -> bool
+{
+    auto version = std::size_t{0};
+    lmdb_.Load(
+        Config,
+        tsv(static_cast<std::size_t>(Key::Version)),
+        [&](const auto in) -> void {
+            std::memcpy(
+                &version, in.data(), std::min(in.size(), sizeof(version)));
+        });
+
+    if (db_version_ <= version) { return true; }
+
+    const auto tip = best(lock).first;
+    LogNormal("Recalculating work for ")(tip + 1)(" best chain headers")
+        .Flush();
+
+    try {
+        auto txn = lmdb_.TransactionRW();
+
+        // Records contain the old values and will be rebuilt from the
+        // migrated headers
+        if (false == records_.Invalidate(-1, txn)) {
+            throw std::runtime_error("Failed to invalidate header records");
+        }
+
+        // Headers loaded from older metadata calculate their own work from
+        // nBits. Only the inherited work needs to be recalculated.
+        const auto store = [&](block::Header& header, const auto& parent) {
+            if (false == header.ParentHash().IsNull()) {
+                header.InheritWork(parent);
+            }
+
+            const auto stored = lmdb_.Store(
+                BlockHeaderMetadata,
+                header.Hash().Bytes(),
+                proto::ToString(header.Serialize().local()),
+                txn);
+
+            if (false == stored.first) {
+                throw std::runtime_error("Failed to store header metadata");
+            }
+
+            return header.Work();
+        };
+        // Each side chain is stored as the path from its tip back to the
+        // first header which is not in the best chain
+        auto sideChains = std::map<block::Height, std::vector<block::pHash>>{};
+
+        auto siblings = std::vector<block::pHash>{};
+        lmdb_.Read(
+            BlockHeaderSiblings,
+            [&](const auto, const auto value) -> bool {
+                siblings.emplace_back(
+                    Data::Factory(value.data(), value.size()));
+
+                return true;
+            },
+            opentxs::storage::lmdb::LMDB::Dir::Forward);
+
+        for (const auto& sibling : siblings) {
+            auto path = std::vector<block::pHash>{};
+            auto hash = block::pHash{sibling};
+
+            while (true) {
+                const auto header = load_bitcoin_header(hash);
+                const auto height = header->Height();
+
+                if ((0 > height) || (best_hash(height) == hash.get())) {
+                    if (false == path.empty()) {
+                        auto& chains = sideChains[height];
+                        std::move(
+                            path.rbegin(),
+                            path.rend(),
+                            std::back_inserter(chains));
+                    }
+
+                    break;
+                }
+
+                path.emplace_back(hash);
+                hash = block::pHash{header->ParentHash()};
+            }
+        }
+
+        auto forks = std::map<block::Height, OTWork>{};
+        auto work = OTWork{factory::Work("")};
+
+        for (auto height = block::Height{0}; height <= tip; ++height) {
+            const auto hash = best_hash(height);
+            auto header = load_bitcoin_header(hash);
+            work = store(*header, work.get());
+
+            if (0 < sideChains.count(height)) {
+                forks.emplace(height, work);
+            }
+        }
+
+        for (const auto& [height, hashes] : sideChains) {
+            const auto fork = forks.find(height);
+
+            if (forks.end() == fork) { continue; }
+
+            auto parent = block::pHash{best_hash(height)};
+            auto chain = std::map<block::pHash, OTWork>{};
+            chain.emplace(parent, fork->second);
+
+            for (const auto& hash : hashes) {
+                auto header = load_bitcoin_header(hash);
+                const auto it = chain.find(block::pHash{header->ParentHash()});
+
+                if (chain.end() == it) {
+                    throw std::runtime_error("Side chain parent not found");
+                }
+
+                auto cumulative = store(*header, it->second.get());
+                chain.emplace(hash, std::move(cumulative));
+            }
+        }
+
+        const auto stored = lmdb_.Store(
+            Config,
+            tsv(static_cast<std::size_t>(Key::Version)),
+            tsv(db_version_),
+            txn);
+
+        if (false == stored.first) {
+            throw std::runtime_error("Failed to store database version");
+        }
+
+        return txn.Finalize(true);
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return false;
+    }
+}
+
 auto Headers::pop_best(const std::size_t i, MDB_txn* parent) const noexcept
     -> bool
 {
@@ -546,14 +810,16 @@ auto Headers::recent_hashes(const Lock& lock) const noexcept
     -> std::vector<block::pHash>
 {
     auto output = std::vector<block::pHash>{};
-    lmdb_.Read(
-        BlockHeaderBest,
-        [&](const auto, const auto value) -> bool {
-            output.emplace_back(Data::Factory(value.data(), value.size()));
 
-            return 100 > output.size();
-        },
-        opentxs::storage::lmdb::LMDB::Dir::Backward);
+    for (auto height = best(lock).first;
+         (0 <= height) && (100 > output.size());
+         --height) {
+        auto hash = BestBlock(height);
+
+        if (hash->empty()) { break; }
+
+        output.emplace_back(std::move(hash));
+    }
 
     return output;
 }
@@ -574,6 +840,56 @@ auto Headers::SiblingHashes() const noexcept -> client::Hashes
     return output;
 }
 
+auto Headers::update_records(
+    const Lock& lock,
+    const client::UpdatedHeader* updated) const noexcept -> bool
+{
+    constexpr auto batch = std::size_t{10000};
+    const auto tip = best(lock).first;
+    auto records = std::vector<HeaderRecords::Record>{};
+    auto complete{true};
+
+    for (auto height = records_.Height() + 1; height <= tip; ++height) {
+        const auto hash = best_hash(height);
+        auto loaded = std::unique_ptr<block::Header>{};
+        const auto* header = [&]() -> const block::Header* {
+            if (nullptr != updated) {
+                const auto it = updated->find(hash);
+
+                if (updated->end() != it) { return it->second.first.get(); }
+            }
+
+            try {
+                loaded = load_header(hash);
+            } catch (...) {
+            }
+
+            return loaded.get();
+        }();
+        const auto* bitcoin =
+            dynamic_cast<const block::bitcoin::internal::Header*>(header);
+
+        if (nullptr == bitcoin) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to load header at height ")(height)
+                .Flush();
+            complete = false;
+
+            break;
+        }
+
+        records.emplace_back(bitcoin->Record());
+
+        if (batch <= records.size()) {
+            if (false == records_.Store(records)) { return false; }
+
+            records.clear();
+        }
+    }
+
+    return records_.Store(records) && complete;
+}
+
 auto Headers::TryLoadBitcoinHeader(const block::Hash& hash) const noexcept
     -> std::unique_ptr<block::bitcoin::Header>
 {
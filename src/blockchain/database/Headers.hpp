@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "api/client/blockchain/database/Database.hpp"
+#include "blockchain/database/HeaderRecords.hpp"
 #include "internal/api/client/blockchain/Blockchain.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 #include "internal/blockchain/client/Client.hpp"
@@ -70,6 +71,7 @@ public:
 
     auto BestBlock(const block::Height position) const noexcept(false)
         -> block::pHash;
+    auto BestChain() const noexcept -> std::vector<block::pHash>;
     auto CurrentBest() const noexcept -> std::unique_ptr<block::Header>
     {
         return load_header(best().second);
@@ -103,7 +105,7 @@ public:
         const api::Core& api,
         const client::internal::Network& network,
         const Common& common,
-        const opentxs::storage::lmdb::LMDB& lmdb,
+        opentxs::storage::lmdb::LMDB& lmdb,
         const blockchain::Type type) noexcept;
 
 private:
@@ -111,10 +113,13 @@ private:
     const client::internal::Network& network_;
     const Common& common_;
     const opentxs::storage::lmdb::LMDB& lmdb_;
+    const blockchain::Type chain_;
     mutable std::mutex lock_;
+    mutable HeaderRecords records_;
 
     auto best() const noexcept -> block::Position;
     auto best(const Lock& lock) const noexcept -> block::Position;
+    auto best_hash(const block::Height height) const noexcept -> block::pHash;
     auto checkpoint(const Lock& lock) const noexcept -> block::Position;
     auto header_exists(const Lock& lock, const block::Hash& hash) const noexcept
         -> bool;
@@ -124,6 +129,9 @@ private:
     // Throws std::out_of_range if the header does not exist
     auto load_header(const block::Hash& hash) const noexcept(false)
         -> std::unique_ptr<block::Header>;
+    // Recalculates the work of every connected header stored by an earlier
+    // database version
+    auto migrate_work(const Lock& lock) noexcept -> bool;
     auto pop_best(const std::size_t i, MDB_txn* parent) const noexcept -> bool;
     auto push_best(
         const block::Position next,
@@ -131,5 +139,9 @@ private:
         MDB_txn* parent) const noexcept -> bool;
     auto recent_hashes(const Lock& lock) const noexcept
         -> std::vector<block::pHash>;
+    // Appends records for the best chain above the current record height
+    auto update_records(
+        const Lock& lock,
+        const client::UpdatedHeader* updated) const noexcept -> bool;
 };
 }  // namespace opentxs::blockchain::database
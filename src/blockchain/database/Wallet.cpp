@@ -98,6 +98,7 @@ Wallet::Wallet(
     , finished_proposals_()
     , change_keys_()
     , nym_map_()
+    , mempool_outputs_()
 {
     // TODO persist default_filter_type_ and reindex various tables
     // if the type provided by the filter oracle has changed
@@ -252,6 +253,113 @@ auto Wallet::AddConfirmedTransaction(
         }
     }
 
+    // Outputs recorded while the transaction was unconfirmed are now
+    // confirmed and must survive its removal from the mempool
+    mempool_outputs_.erase(copy.ID());
+
+    if (false == add_transaction(lock, chain, block, copy)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(
+            ": Error adding transaction to database")
+            .Flush();
+
+        return false;
+    }
+
+    print(lock);
+    blockchain_.UpdateBalance(chain_, get_balance(lock));
+
+    for (const auto& [nym, balance] : get_balances(lock)) {
+        blockchain_.UpdateBalance(nym, chain_, balance);
+    }
+
+    return true;
+}
+
+auto Wallet::AddMempoolTransaction(
+    const blockchain::Type chain,
+    const NodeID& balanceNode,
+    const Subchain subchain,
+    const FilterType type,
+    const VersionNumber version,
+    const std::vector<std::uint32_t> outputIndices,
+    const block::bitcoin::Transaction& original) const noexcept -> bool
+{
+    static const auto block = make_blank<block::Position>::value(api_);
+    Lock lock(lock_);
+    auto pCopy = original.clone();
+
+    OT_ASSERT(pCopy);
+
+    auto& copy = *pCopy;
+    auto inputIndex = int{-1};
+
+    // Relayed transactions are not verified so they must not change the state
+    // of outputs they claim to spend. Outputs spent by transactions this
+    // wallet built were already reserved when the proposal was created.
+    for (const auto& input : copy.Inputs()) {
+        const auto& outpoint = input.PreviousOutput();
+        ++inputIndex;
+
+        if (auto out = find_output(lock, outpoint); out.has_value()) {
+            const auto& proto = std::get<2>(out.value()->second);
+
+            if (!copy.AssociatePreviousOutput(blockchain_, inputIndex, proto)) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Error associating previous output to input")
+                    .Flush();
+
+                return false;
+            }
+        }
+    }
+
+    for (const auto index : outputIndices) {
+        const auto outpoint =
+            block::bitcoin::Outpoint{copy.ID().Bytes(), index};
+        const auto& output = copy.Outputs().at(index);
+
+        OT_ASSERT((0 < output.Keys().size()));
+
+        if (false == find_output(lock, outpoint).has_value()) {
+            const auto owners = [&] {
+                auto val = Owners{};
+
+                for (const auto& key : output.Keys()) {
+                    val.emplace(blockchain_.Owner(key));
+                }
+
+                return val;
+            }();
+
+            OT_ASSERT(0 < owners.size());
+
+            if (false == create_state(
+                             lock,
+                             owners,
+                             outpoint,
+                             TxoState::UnconfirmedNew,
+                             block,
+                             output)) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Error created new output state")
+                    .Flush();
+
+                return false;
+            }
+
+            auto& created = mempool_outputs_[copy.ID()];
+            created.emplace_back(outpoint);
+            dedup(created);
+        }
+
+        {
+            auto& vector = output_subchain_[subchain_id(
+                balanceNode, subchain, type, version)];
+            vector.emplace_back(outpoint);
+            dedup(vector);
+        }
+    }
+
     if (false == add_transaction(lock, chain, block, copy)) {
         LogOutput(OT_METHOD)(__FUNCTION__)(
             ": Error adding transaction to database")
@@ -645,6 +753,34 @@ auto Wallet::DeleteProposal(const Identifier& id) const noexcept -> bool
     return true;
 }
 
+auto Wallet::delete_state(
+    const Lock& lock,
+    const block::bitcoin::Outpoint& id) const noexcept -> bool
+{
+    auto itOutput = outputs_.find(id);
+
+    if (outputs_.end() == itOutput) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Outpoint does not exist in db")
+            .Flush();
+
+        return false;
+    }
+
+    const auto& [state, position, data] = itOutput->second;
+    delete_from_vector(output_states_[state], id);
+    delete_from_vector(output_positions_[position], id);
+
+    for (auto& [subchain, vector] : output_subchain_) {
+        delete_from_vector(vector, id);
+    }
+
+    for (auto& [nym, outpoints] : nym_map_) { outpoints.erase(id); }
+
+    outputs_.erase(itOutput);
+
+    return true;
+}
+
 auto Wallet::effective_position(
     const TxoState state,
     const block::Position& position) const noexcept -> const block::Position&
@@ -1000,6 +1136,58 @@ auto Wallet::ReleaseChangeKey(const Identifier& proposal, const KeyID key)
     return true;
 }
 
+auto Wallet::RemoveMempoolTransaction(const block::Txid& txid) const noexcept
+    -> bool
+{
+    static const auto blank = make_blank<block::Position>::value(api_);
+    Lock lock(lock_);
+    auto it = mempool_outputs_.find(txid);
+
+    if (mempool_outputs_.end() == it) { return true; }
+
+    for (const auto& outpoint : it->second) {
+        const auto out = find_output(lock, outpoint);
+
+        if (false == out.has_value()) { continue; }
+
+        // Outputs which have since been confirmed or spent are left alone
+        if (TxoState::UnconfirmedNew != std::get<0>(out.value()->second)) {
+            continue;
+        }
+
+        if (false == delete_state(lock, outpoint)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Error removing unconfirmed output")
+                .Flush();
+
+            return false;
+        }
+    }
+
+    mempool_outputs_.erase(it);
+
+    if (auto blocks = tx_to_block_.find(txid); tx_to_block_.end() != blocks) {
+        const auto& [height, hash] = blank;
+        delete_from_vector(blocks->second, hash);
+        delete_from_vector(block_to_tx_[hash], block::pTxid{txid});
+        delete_from_vector(tx_history_[height], block::pTxid{txid});
+
+        if (blocks->second.empty()) { tx_to_block_.erase(blocks); }
+    }
+
+    LogVerbose(OT_METHOD)(__FUNCTION__)(": Removed unconfirmed transaction ")(
+        txid.asHex())
+        .Flush();
+    print(lock);
+    blockchain_.UpdateBalance(chain_, get_balance(lock));
+
+    for (const auto& [nym, balance] : get_balances(lock)) {
+        blockchain_.UpdateBalance(nym, chain_, balance);
+    }
+
+    return true;
+}
+
 auto Wallet::ReorgTo(
     const NodeID& balanceNode,
     const Subchain subchain,
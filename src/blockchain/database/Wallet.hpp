@@ -110,6 +110,14 @@ public:
         const block::Position& block,
         const std::vector<std::uint32_t> outputIndices,
         const block::bitcoin::Transaction& transaction) const noexcept -> bool;
+    auto AddMempoolTransaction(
+        const blockchain::Type chain,
+        const NodeID& balanceNode,
+        const Subchain subchain,
+        const FilterType type,
+        const VersionNumber version,
+        const std::vector<std::uint32_t> outputIndices,
+        const block::bitcoin::Transaction& transaction) const noexcept -> bool;
     auto AddOutgoingTransaction(
         const blockchain::Type chain,
         const Identifier& proposalID,
@@ -148,6 +156,8 @@ public:
     }
     auto ReleaseChangeKey(const Identifier& proposal, const KeyID key)
         const noexcept -> bool;
+    auto RemoveMempoolTransaction(const block::Txid& txid) const noexcept
+        -> bool;
     auto ReorgTo(
         const NodeID& balanceNode,
         const Subchain subchain,
@@ -263,6 +273,8 @@ private:
     using ChangeKeyMap = std::map<OTIdentifier, std::vector<KeyID>>;
     using NymMap = std::map<OTNymID, std::set<block::bitcoin::Outpoint>>;
     using NymBalances = std::map<OTNymID, Balance>;
+    using MempoolOutputMap =
+        std::map<block::pTxid, std::vector<block::bitcoin::Outpoint>>;
 
     const api::Core& api_;
     const api::client::internal::Blockchain& blockchain_;
@@ -291,6 +303,8 @@ private:
     mutable FinishedProposals finished_proposals_;  // NOTE don't move to lmdb
     mutable ChangeKeyMap change_keys_;
     mutable NymMap nym_map_;
+    // Outputs created by unconfirmed transactions received from peers
+    mutable MempoolOutputMap mempool_outputs_;
 
     static auto owns(
         const identifier::Nym& spender,
@@ -366,6 +380,8 @@ private:
         const TxoState state,
         const block::Position position,
         const block::bitcoin::Output& output) const noexcept -> bool;
+    auto delete_state(const Lock& lock, const block::bitcoin::Outpoint& id)
+        const noexcept -> bool;
     auto find_output(const Lock& lock, const block::bitcoin::Outpoint& id)
         const noexcept -> std::optional<OutputMap::iterator>;
     auto pattern_id(const SubchainID& subchain, const Bip32Index index)
@@ -13,6 +13,7 @@
 
 #include "blockchain/DownloadTask.hpp"
 #include "internal/api/client/Client.hpp"
+#include "internal/network/Factory.hpp"
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/api/Core.hpp"
 #include "opentxs/blockchain/Blockchain.hpp"
@@ -74,6 +75,7 @@ Peer::Peer(
           context))
     , send_promises_()
     , activity_()
+    , performance_(manager_.Database().LoadStatistics(address_.ID()))
     , init_promise_()
     , init_(init_promise_.get_future())
 {
@@ -83,6 +85,7 @@ Peer::Peer(
         LogNormal("Connection to peer ")(address_.Display())(
             " timed out during connect")
             .Flush();
+        performance_.Failure();
         disconnect();
     }
 }
@@ -102,6 +105,7 @@ auto Peer::check_activity() noexcept -> void
         std::chrono::seconds(OT_BLOCKCHAIN_PEER_PING_SECONDS) <= interval;
 
     if (disconnect) {
+        performance_.Timeout();
         this->disconnect();
     } else if (ping) {
         this->ping();
@@ -123,19 +127,28 @@ auto Peer::check_jobs() noexcept -> void
     constexpr auto limit = std::chrono::minutes(1);
 
     if (auto& job = cfheader_job_; job) {
-        if (job.Elapsed() >= limit) { reset_cfheader_job(); }
+        if (job.Elapsed() >= limit) {
+            performance_.Timeout();
+            reset_cfheader_job();
+        }
     } else if (cfilter_probe_) {
         reset_cfheader_job();
     }
 
     if (auto& job = cfilter_job_; job) {
-        if (job.Elapsed() >= limit) { reset_cfilter_job(); }
+        if (job.Elapsed() >= limit) {
+            performance_.Timeout();
+            reset_cfilter_job();
+        }
     } else if (cfilter_probe_) {
         reset_cfilter_job();
     }
 
     if (auto& job = block_job_; job) {
-        if (job.Elapsed() >= limit) { reset_block_job(); }
+        if (job.Elapsed() >= limit) {
+            performance_.Timeout();
+            reset_block_job();
+        }
     } else if (header_probe_) {
         reset_block_job();
     }
@@ -158,6 +171,11 @@ auto Peer::check_handshake() noexcept -> void
             LogVerbose(" * ")(p2p::DisplayService(service)).Flush();
         }
 
+        if (false == address_.Incoming()) {
+            performance_.Handshake(Clock::now() - state.started_);
+        }
+
+        performance_.Connected();
         update_address_activity();
         state.promise_.set_value();
 
@@ -257,6 +275,18 @@ auto Peer::on_pipeline(
     pipeline_->Push(message);
 }
 
+auto Peer::on_receive(const ReadView header, zmq::Frame& body) noexcept
+    -> void
+{
+    auto message = MakeWork(Task::ReceiveMessage);
+    message->AddFrame(header.data(), header.size());
+    message->AddFrame();
+    message->Replace(
+        message->size() - 1,
+        OTZMQFrame{factory::ZMQFrameShared(body).release()});
+    pipeline_->Push(message);
+}
+
 auto Peer::pipeline(zmq::Message& message) noexcept -> void
 {
     if (false == running_.get()) { return; }
@@ -315,6 +345,11 @@ auto Peer::pipeline(zmq::Message& message) noexcept -> void
         } break;
         case Task::ReceiveMessage: {
             activity_.Bump();
+
+            for (const auto& frame : message.Body()) {
+                performance_.Receive(frame.size());
+            }
+
             process_message(message);
         } break;
         case Task::Heartbeat:
@@ -340,6 +375,7 @@ auto Peer::process_state_machine() noexcept -> void
 {
     switch (state_.value_.load()) {
         case State::Run: {
+            performance_.Sample(cfheader_job_ || cfilter_job_ || block_job_);
             check_activity();
             check_jobs();
             check_download_peers();
@@ -349,12 +385,37 @@ auto Peer::process_state_machine() noexcept -> void
     }
 }
 
+auto Peer::queue_send(zmq::Message& work) noexcept -> SendStatus
+{
+    try {
+        if (false == state_.connect_.future_.get()) {
+            LogVerbose(OT_METHOD)(__FUNCTION__)(
+                ": Unable to send to disconnected peer")
+                .Flush();
+
+            return {};
+        }
+    } catch (...) {
+        return {};
+    }
+
+    if (running_.get()) {
+        auto [future, promise] = send_promises_.NewPromise();
+        work.AddFrame(promise);
+        pipeline_->Push(work);
+
+        return std::move(future);
+    } else {
+        return {};
+    }
+}
+
 auto Peer::reset_block_job() noexcept -> void
 {
     auto& job = block_job_;
     job = {};
 
-    if (header_probe_) { job = block_.GetBlockJob(); }
+    if (header_probe_) { job = block_.GetBlockJob(id_); }
 
     if (job) { request_blocks(); }
 }
@@ -364,7 +425,7 @@ auto Peer::reset_cfheader_job() noexcept -> void
     auto& job = cfheader_job_;
     job = {};
 
-    if (cfilter_probe_) { job = filter_.GetHeaderJob(); }
+    if (cfilter_probe_) { job = filter_.GetHeaderJob(id_); }
 
     if (job) { request_cfheaders(); }
 }
@@ -374,36 +435,28 @@ auto Peer::reset_cfilter_job() noexcept -> void
     auto& job = cfilter_job_;
     job = {};
 
-    if (cfilter_probe_) { job = filter_.GetFilterJob(); }
+    if (cfilter_probe_) { job = filter_.GetFilterJob(id_); }
 
     if (job) { request_cfilter(); }
 }
 
 auto Peer::send(OTData in) noexcept -> SendStatus
 {
-    try {
-        if (false == state_.connect_.future_.get()) {
-            LogVerbose(OT_METHOD)(__FUNCTION__)(
-                ": Unable to send to disconnected peer")
-                .Flush();
+    auto work = MakeWork(Task::SendMessage);
+    work->AddFrame(in);
 
-            return {};
-        }
-    } catch (...) {
-        return {};
-    }
+    return queue_send(work);
+}
 
-    if (running_.get()) {
-        auto [future, promise] = send_promises_.NewPromise();
-        auto message = MakeWork(Task::SendMessage);
-        message->AddFrame(in);
-        message->AddFrame(promise);
-        pipeline_->Push(message);
+auto Peer::send(std::unique_ptr<zmq::Frame> in) noexcept -> SendStatus
+{
+    OT_ASSERT(in);
 
-        return std::move(future);
-    } else {
-        return {};
-    }
+    auto work = MakeWork(Task::SendMessage);
+    work->AddFrame();
+    work->Replace(work->size() - 1, OTZMQFrame{in.release()});
+
+    return queue_send(work);
 }
 
 auto Peer::Shutdown() noexcept -> std::shared_future<void>
@@ -427,6 +480,13 @@ auto Peer::shutdown(std::promise<void>& promise) noexcept -> void
             update_address_activity();
         }
 
+        if (false == address_.Incoming()) {
+            manager_.Database().StoreStatistics(
+                address_.ID(), performance_.Current());
+        }
+
+        network_.HeaderSegments().Release(id_);
+        manager_.ReleaseCompactHighBandwidth(id_);
         LogVerbose("Disconnected from ")(address_.Display()).Flush();
 
         try {
@@ -523,6 +583,15 @@ auto Peer::state_machine() noexcept -> bool
     }
 
     if (disconnect) {
+        switch (state_.value_.load()) {
+            case State::Handshake:
+            case State::Verify: {
+                performance_.Failure();
+            } break;
+            default: {
+            }
+        }
+
         LogVerbose(OT_METHOD)(__FUNCTION__)(": Disconnecting ")(
             address_.Display())
             .Flush();
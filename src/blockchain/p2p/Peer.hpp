@@ -17,6 +17,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <set>
 #include <string>
@@ -169,11 +170,22 @@ public:
     {
         return state_.handshake_.future_;
     }
+    auto Statistics() const noexcept -> internal::PeerStatistics final
+    {
+        return performance_.Current();
+    }
+    auto Throughput() const noexcept -> std::optional<std::size_t> final
+    {
+        return performance_.Throughput();
+    }
 
     auto on_connect() noexcept -> void;
     auto on_pipeline(
         const Task type,
         const std::vector<ReadView>& frames) noexcept -> void;
+    // Queues a received message without copying the body
+    auto on_receive(const ReadView header, zmq::Frame& body) noexcept
+        -> void;
     auto Shutdown() noexcept -> std::shared_future<void> final;
 
     ~Peer() override;
@@ -307,6 +319,7 @@ protected:
     {
         return *connection_;
     }
+    auto id() const noexcept -> int { return id_; }
 
     virtual auto broadcast_block(zmq::Message& message) noexcept -> void = 0;
     virtual auto broadcast_transaction(zmq::Message& message) noexcept
@@ -326,6 +339,8 @@ protected:
     auto reset_cfheader_job() noexcept -> void;
     auto reset_cfilter_job() noexcept -> void;
     auto send(OTData message) noexcept -> SendStatus;
+    // Queues an encoded message without copying it
+    auto send(std::unique_ptr<zmq::Frame> message) noexcept -> SendStatus;
     auto update_address_services(
         const std::set<p2p::Service>& services) noexcept -> void;
     auto verifying() noexcept -> bool
@@ -362,6 +377,34 @@ private:
         Time activity_;
     };
 
+    struct Performance {
+        auto Current() const noexcept -> internal::PeerStatistics;
+        auto Throughput() const noexcept -> std::optional<std::size_t>;
+
+        auto Connected() noexcept -> void;
+        auto Failure() noexcept -> void;
+        auto Handshake(const std::chrono::nanoseconds elapsed) noexcept
+            -> void;
+        auto Receive(const std::size_t bytes) noexcept -> void;
+        // Call periodically with busy set while a download job is
+        // outstanding
+        auto Sample(const bool busy) noexcept -> void;
+        auto Timeout() noexcept -> void;
+
+        Performance(const internal::PeerStatistics& stored) noexcept;
+
+    private:
+        mutable std::mutex lock_;
+        internal::PeerStatistics stats_;
+        // Moving average of the throughput during this connection
+        std::optional<double> rate_;
+        std::size_t bytes_;
+        std::optional<Time> window_;
+        Time busy_;
+
+        auto measure(const Lock& lock, const Time now) noexcept -> void;
+    };
+
     struct SendPromises {
         void Break();
         auto NewPromise() -> std::pair<std::future<bool>, int>;
@@ -381,6 +424,7 @@ private:
     std::unique_ptr<ConnectionManager> connection_;
     SendPromises send_promises_;
     Activity activity_;
+    Performance performance_;
     std::promise<void> init_promise_;
     std::shared_future<void> init_;
 
@@ -401,6 +445,7 @@ private:
     auto check_jobs() noexcept -> void;
     auto connect() noexcept -> void;
     auto pipeline(zmq::Message& message) noexcept -> void;
+    auto queue_send(zmq::Message& work) noexcept -> SendStatus;
     virtual auto process_message(const zmq::Message& message) noexcept
         -> void = 0;
     auto process_state_machine() noexcept -> void;
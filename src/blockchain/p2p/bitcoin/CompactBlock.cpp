@@ -0,0 +1,319 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"                             // IWYU pragma: associated
+#include "1_Internal.hpp"                           // IWYU pragma: associated
+#include "blockchain/p2p/bitcoin/CompactBlock.hpp"  // IWYU pragma: associated
+
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "blockchain/Merkle.hpp"
+#include "blockchain/SipHash.hpp"
+#include "blockchain/bitcoin/CompactSize.hpp"
+#include "internal/blockchain/bitcoin/Bitcoin.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/api/Core.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/crypto/Hash.hpp"
+#include "opentxs/blockchain/block/bitcoin/Transaction.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/protobuf/Enums.pb.h"
+
+namespace opentxs::blockchain::p2p::bitcoin
+{
+namespace
+{
+constexpr auto key_bytes_ = std::size_t{16};
+constexpr auto short_id_mask_ = std::uint64_t{0x0000ffffffffffff};
+
+auto read_size(ReadView& in) noexcept(false) -> std::size_t
+{
+    if (in.empty()) { throw std::runtime_error("Missing CompactSize"); }
+
+    auto it = reinterpret_cast<blockchain::bitcoin::ByteIterator>(in.data());
+    auto expected = std::size_t{1};
+    auto output = std::size_t{};
+
+    if (false == blockchain::bitcoin::DecodeCompactSizeFromPayload(
+                     it, expected, in.size(), output)) {
+        throw std::runtime_error("Invalid CompactSize");
+    }
+
+    in.remove_prefix(expected);
+
+    return output;
+}
+}  // namespace
+
+CompactBlock::CompactBlock(
+    const api::Core& api,
+    const blockchain::Type chain,
+    const std::uint64_t version,
+    const ReadView cmpctblock,
+    const Transactions& mempool) noexcept(false)
+    : api_(api)
+    , chain_(chain)
+    , header_(header(cmpctblock))
+    , hash_(hash())
+    , transactions_()
+{
+    auto in = cmpctblock;
+    in.remove_prefix(header_bytes_);
+
+    if (nonce_bytes_ > in.size()) {
+        throw std::runtime_error("Missing nonce");
+    }
+
+    const auto siphash = [&] {
+        auto preimage = space(reader(header_));
+        preimage.insert(
+            preimage.end(),
+            reinterpret_cast<const std::byte*>(in.data()),
+            reinterpret_cast<const std::byte*>(in.data()) + nonce_bytes_);
+        auto digest = Space{};
+
+        if (false == api_.Crypto().Hash().Digest(
+                         proto::HASHTYPE_SHA256,
+                         reader(preimage),
+                         writer(digest))) {
+            throw std::runtime_error("Failed to calculate short id key");
+        }
+
+        // The first two little endian 64 bit words of the digest are the key
+        return gcs::SipHash{ReadView{
+            reinterpret_cast<const char*>(digest.data()), key_bytes_}};
+    }();
+    in.remove_prefix(nonce_bytes_);
+    auto shortIDs = std::vector<std::uint64_t>{};
+    const auto shortCount = read_size(in);
+
+    if (shortCount > (in.size() / short_id_bytes_)) {
+        throw std::runtime_error("Missing short ids");
+    }
+
+    shortIDs.reserve(shortCount);
+
+    for (auto i = std::size_t{0}; i < shortCount; ++i) {
+        auto id = std::uint64_t{0};
+
+        for (auto b = std::size_t{0}; b < short_id_bytes_; ++b) {
+            id |= std::uint64_t{static_cast<std::uint8_t>(in[b])} << (8u * b);
+        }
+
+        shortIDs.emplace_back(id);
+        in.remove_prefix(short_id_bytes_);
+    }
+
+    const auto prefilledCount = read_size(in);
+
+    if (prefilledCount > in.size()) {
+        throw std::runtime_error("Missing prefilled transactions");
+    }
+
+    const auto total = shortCount + prefilledCount;
+    transactions_.resize(total);
+    auto prefilled = std::vector<bool>(total, false);
+
+    for (auto i = std::size_t{0}, next = std::size_t{0}; i < prefilledCount;
+         ++i) {
+        // Indices are differentially encoded
+        const auto index = next + read_size(in);
+
+        if (index >= total) {
+            throw std::runtime_error("Invalid prefilled transaction index");
+        }
+
+        transactions_.at(index) = parse_transaction(in);
+        prefilled.at(index) = true;
+        next = index + 1;
+    }
+
+    if (false == in.empty()) { throw std::runtime_error("Excess bytes"); }
+
+    auto slots = std::map<std::uint64_t, std::size_t>{};
+    auto duplicates = std::set<std::uint64_t>{};
+
+    for (auto i = std::size_t{0}, s = std::size_t{0}; i < total; ++i) {
+        if (prefilled.at(i)) { continue; }
+
+        const auto id = shortIDs.at(s++);
+
+        if (false == slots.try_emplace(id, i).second) {
+            duplicates.emplace(id);
+        }
+    }
+
+    // Transactions which share a short id can not be identified and must be
+    // requested
+    for (const auto id : duplicates) { slots.erase(id); }
+
+    const auto ids = [&] {
+        auto output = std::vector<ReadView>{};
+        output.reserve(mempool.size());
+
+        for (const auto& tx : mempool) {
+            const auto& id = (1 < version) ? tx->WTXID() : tx->ID();
+            output.emplace_back(id.Bytes());
+        }
+
+        return output;
+    }();
+    const auto hashes = siphash.Hash(ids);
+    auto collisions = std::set<std::size_t>{};
+
+    for (auto i = std::size_t{0}; i < mempool.size(); ++i) {
+        const auto it = slots.find(hashes.at(i) & short_id_mask_);
+
+        if (slots.end() == it) { continue; }
+
+        const auto& tx = *mempool.at(i);
+        const auto index = it->second;
+        auto& slot = transactions_.at(index);
+
+        if (false == slot.bytes_.empty()) {
+            collisions.emplace(index);
+
+            continue;
+        }
+
+        if (false == tx.Serialize(writer(slot.bytes_)).has_value()) {
+            slot.bytes_.clear();
+
+            continue;
+        }
+
+        const auto txid = tx.ID().Bytes();
+        slot.txid_ = space(txid);
+    }
+
+    // Request every transaction which matched more than one candidate
+    for (const auto index : collisions) { transactions_.at(index) = Slot{}; }
+}
+
+auto CompactBlock::Fill(const ReadView blocktxn) noexcept(false) -> void
+{
+    auto in = blocktxn;
+
+    if (hash_->size() > in.size()) {
+        throw std::runtime_error("Missing block hash");
+    }
+
+    if (in.substr(0, hash_->size()) != hash_->Bytes()) {
+        throw std::runtime_error("Wrong block hash");
+    }
+
+    in.remove_prefix(hash_->size());
+    const auto missing = Missing();
+
+    if (read_size(in) != missing.size()) {
+        throw std::runtime_error("Wrong number of transactions");
+    }
+
+    auto received = std::vector<Slot>{};
+    received.reserve(missing.size());
+
+    for (auto i = std::size_t{0}; i < missing.size(); ++i) {
+        received.emplace_back(parse_transaction(in));
+    }
+
+    if (false == in.empty()) { throw std::runtime_error("Excess bytes"); }
+
+    for (auto i = std::size_t{0}; i < missing.size(); ++i) {
+        transactions_.at(missing.at(i)) = std::move(received.at(i));
+    }
+}
+
+auto CompactBlock::hash() const noexcept(false) -> block::pHash
+{
+    auto output = api_.Factory().Data();
+    const auto hashed =
+        BlockHash(api_, chain_, reader(header_), output->WriteInto());
+
+    if (false == hashed) {
+        throw std::runtime_error("Failed to calculate block hash");
+    }
+
+    return output;
+}
+
+auto CompactBlock::header(const ReadView cmpctblock) noexcept(false) -> Space
+{
+    if (header_bytes_ > cmpctblock.size()) {
+        throw std::runtime_error("Missing block header");
+    }
+
+    return space(cmpctblock.substr(0, header_bytes_));
+}
+
+auto CompactBlock::Missing() const noexcept -> std::vector<std::size_t>
+{
+    auto output = std::vector<std::size_t>{};
+
+    for (auto i = std::size_t{0}; i < transactions_.size(); ++i) {
+        if (transactions_.at(i).bytes_.empty()) { output.emplace_back(i); }
+    }
+
+    return output;
+}
+
+auto CompactBlock::parse_transaction(ReadView& in) const noexcept(false)
+    -> Slot
+{
+    const auto tx =
+        blockchain::bitcoin::EncodedTransaction::Deserialize(api_, chain_, in);
+    const auto bytes = tx.size();
+    auto output = Slot{tx.txid_, space(in.substr(0, bytes))};
+    in.remove_prefix(bytes);
+
+    return output;
+}
+
+auto CompactBlock::Serialize() const noexcept(false) -> Space
+{
+    auto leaves = std::vector<Merkle::Digest>(transactions_.size());
+
+    for (auto i = std::size_t{0}; i < transactions_.size(); ++i) {
+        const auto& [txid, bytes] = transactions_.at(i);
+        auto& leaf = leaves.at(i);
+
+        if (bytes.empty()) { throw std::runtime_error("Missing transaction"); }
+
+        if (leaf.size() != txid.size()) {
+            throw std::runtime_error("Invalid txid size");
+        }
+
+        std::memcpy(leaf.data(), txid.data(), leaf.size());
+    }
+
+    // The merkle root follows the version and previous block hash fields
+    constexpr auto merkleOffset = std::size_t{36};
+    const auto root = Merkle::Root(api_, std::move(leaves));
+
+    if (0 != std::memcmp(
+                 root.data(), header_.data() + merkleOffset, root.size())) {
+        throw std::runtime_error("Merkle root mismatch");
+    }
+
+    auto output = space(reader(header_));
+    const auto count =
+        blockchain::bitcoin::CompactSize(transactions_.size()).Encode();
+    output.insert(output.end(), count.begin(), count.end());
+
+    for (const auto& slot : transactions_) {
+        output.insert(output.end(), slot.bytes_.begin(), slot.bytes_.end());
+    }
+
+    return output;
+}
+}  // namespace opentxs::blockchain::p2p::bitcoin
@@ -0,0 +1,90 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "internal/blockchain/client/Client.hpp"
+#include "opentxs/Bytes.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/blockchain/BlockchainType.hpp"
+#include "opentxs/blockchain/Types.hpp"
+
+namespace opentxs
+{
+namespace api
+{
+class Core;
+}  // namespace api
+}  // namespace opentxs
+
+namespace opentxs::blockchain::p2p::bitcoin
+{
+/// Reconstructs a block announced with a BIP-152 cmpctblock message
+///
+/// Short transaction ids are matched against the contents of the mempool.
+/// Transactions which can not be matched must be requested with getblocktxn
+/// and passed to Fill before the block can be serialized.
+class CompactBlock
+{
+public:
+    using Transactions = client::internal::Mempool::Transactions;
+
+    auto Hash() const noexcept -> const block::Hash& { return hash_; }
+    /// Returns the indices of the transactions which are still required
+    auto Missing() const noexcept -> std::vector<std::size_t>;
+    /// Returns the serialized block
+    ///
+    /// Throws std::runtime_error if transactions are missing or if the
+    /// reconstructed transactions do not match the merkle root
+    auto Serialize() const noexcept(false) -> Space;
+
+    /// Adds the transactions from a blocktxn payload
+    ///
+    /// Throws std::runtime_error if the payload does not contain exactly the
+    /// missing transactions
+    auto Fill(const ReadView blocktxn) noexcept(false) -> void;
+
+    /// Throws std::runtime_error if the cmpctblock payload is malformed
+    CompactBlock(
+        const api::Core& api,
+        const blockchain::Type chain,
+        const std::uint64_t version,
+        const ReadView cmpctblock,
+        const Transactions& mempool) noexcept(false);
+
+    ~CompactBlock() = default;
+
+private:
+    struct Slot {
+        Space txid_{};
+        Space bytes_{};
+    };
+
+    static constexpr std::size_t header_bytes_{80};
+    static constexpr std::size_t nonce_bytes_{8};
+    static constexpr std::size_t short_id_bytes_{6};
+
+    const api::Core& api_;
+    const blockchain::Type chain_;
+    const Space header_;
+    const block::pHash hash_;
+    std::vector<Slot> transactions_;
+
+    static auto header(const ReadView cmpctblock) noexcept(false) -> Space;
+
+    auto hash() const noexcept(false) -> block::pHash;
+    auto parse_transaction(ReadView& in) const noexcept(false) -> Slot;
+
+    CompactBlock() = delete;
+    CompactBlock(const CompactBlock&) = delete;
+    CompactBlock(CompactBlock&&) = delete;
+    auto operator=(const CompactBlock&) -> CompactBlock& = delete;
+    auto operator=(CompactBlock&&) -> CompactBlock& = delete;
+};
+}  // namespace opentxs::blockchain::p2p::bitcoin
@@ -11,14 +11,17 @@
 #include <array>
 #include <cstdint>
 #include <iterator>
+#include <memory>
 #include <stdexcept>
 #include <tuple>
 #include <utility>
 #include <vector>
 
 #include "blockchain/DownloadTask.hpp"
+#include "blockchain/bitcoin/CompactSize.hpp"
 #include "blockchain/bitcoin/Inventory.hpp"
 #include "blockchain/p2p/Peer.hpp"
+#include "blockchain/p2p/bitcoin/CompactBlock.hpp"
 #include "blockchain/p2p/bitcoin/Header.hpp"
 #include "blockchain/p2p/bitcoin/message/Cmpctblock.hpp"
 #include "blockchain/p2p/bitcoin/message/Feefilter.hpp"
@@ -28,7 +31,11 @@
 #include "blockchain/p2p/bitcoin/message/Reject.hpp"
 #include "blockchain/p2p/bitcoin/message/Sendcmpct.hpp"
 #include "blockchain/p2p/bitcoin/message/Tx.hpp"
+#include "internal/api/client/Client.hpp"
 #include "internal/blockchain/Blockchain.hpp"
+#include "internal/blockchain/bitcoin/Bitcoin.hpp"
+#include "internal/blockchain/block/bitcoin/Bitcoin.hpp"
+#include "internal/blockchain/client/Client.hpp"
 #include "internal/blockchain/p2p/P2P.hpp"
 #include "internal/blockchain/p2p/bitcoin/Factory.hpp"
 #include "internal/blockchain/p2p/bitcoin/message/Message.hpp"
@@ -44,6 +51,7 @@
 #include "opentxs/blockchain/block/Header.hpp"
 #include "opentxs/blockchain/block/bitcoin/Block.hpp"
 #include "opentxs/blockchain/block/bitcoin/Header.hpp"
+#include "opentxs/blockchain/block/bitcoin/Transaction.hpp"
 #include "opentxs/blockchain/client/BlockOracle.hpp"
 #include "opentxs/blockchain/client/FilterOracle.hpp"
 #include "opentxs/blockchain/client/HeaderOracle.hpp"
@@ -194,6 +202,11 @@ Peer::Peer(
           get_local_services(protocol_, chain_, policy, localServices))
     , relay_(relay)
     , get_headers_()
+    , header_segment_()
+    , cmpct_version_(compact_block_version(config, chain_))
+    , cmpct_high_bandwidth_(config.compact_blocks_high_bandwidth_)
+    , cmpct_negotiated_(false)
+    , cmpct_block_()
 {
     init();
 }
@@ -257,6 +270,55 @@ auto Peer::broadcast_transaction(zmq::Message& in) noexcept -> void
     send(msg.Encode());
 }
 
+auto Peer::compact_block_version(
+    const client::internal::Config& config,
+    const blockchain::Type network) noexcept -> std::uint64_t
+{
+    // Compact blocks are reconstructed from the mempool
+    if (config.disable_compact_blocks_ || (0 == config.mempool_bytes_)) {
+        return 0;
+    }
+
+    switch (network) {
+        case blockchain::Type::Bitcoin:
+        case blockchain::Type::Bitcoin_testnet3:
+        case blockchain::Type::Litecoin:
+        case blockchain::Type::Litecoin_testnet4: {
+
+            return 2;
+        }
+        case blockchain::Type::BitcoinCash:
+        case blockchain::Type::BitcoinCash_testnet3:
+        case blockchain::Type::UnitTest: {
+
+            return 1;
+        }
+        case blockchain::Type::PKT:
+        case blockchain::Type::PKT_testnet:
+        case blockchain::Type::Unknown:
+        case blockchain::Type::Ethereum_frontier:
+        case blockchain::Type::Ethereum_ropsten:
+        default: {
+
+            return 0;
+        }
+    }
+}
+
+auto Peer::finish_compact_block(const CompactBlock& block) noexcept -> void
+{
+    try {
+        const auto bytes = block.Serialize();
+        LogVerbose(OT_METHOD)(__FUNCTION__)(": reconstructed block ")(
+            block.Hash().asHex())(" from compact block")
+            .Flush();
+        receive_block(reader(bytes));
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+        request_full_block(block.Hash());
+    }
+}
+
 auto Peer::get_body_size(const zmq::Frame& header) const noexcept -> std::size_t
 {
     OT_ASSERT(HeaderType::Size() == header.size());
@@ -399,36 +461,13 @@ auto Peer::process_block(
     std::unique_ptr<HeaderType> header,
     const zmq::Frame& payload) -> void
 {
-    try {
-        if (0 == payload.size()) {
-            throw std::runtime_error("Invalid payload");
-        }
-
-        auto submit{true};
+    if (0 == payload.size()) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid payload").Flush();
 
-        if (block_job_) {
-            auto block = api_.Factory().BitcoinBlock(chain_, payload.Bytes());
-
-            if (!block) { throw std::runtime_error("Invalid block"); }
-
-            auto header = headers_.LoadHeader(block->Header().Hash());
-
-            if (!header) { throw std::runtime_error("Failed to load header"); }
-
-            submit = !block_job_.Download(header->Position(), std::move(block));
-
-            if (block_job_.isDownloaded()) { reset_block_job(); }
-        }
-
-        if (submit) {
-            using Task = client::internal::Network::Task;
-            auto work = MakeWork(Task::SubmitBlock);
-            work->AddFrame(payload);
-            network_.Submit(work);
-        }
-    } catch (const std::exception& e) {
-        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+        return;
     }
+
+    receive_block(payload.Bytes());
 }
 
 auto Peer::process_blocktxn(
@@ -450,7 +489,22 @@ auto Peer::process_blocktxn(
         return;
     }
 
-    // TODO
+    if (false == bool(cmpct_block_)) { return; }
+
+    const auto& message = *pMessage;
+    const auto pBlock = std::move(cmpct_block_);
+    const auto& block = *pBlock;
+
+    try {
+        pBlock->Fill(message.BlockTransactions()->Bytes());
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+        request_full_block(block.Hash());
+
+        return;
+    }
+
+    finish_compact_block(block);
 }
 
 auto Peer::process_cfcheckpt(
@@ -667,7 +721,59 @@ auto Peer::process_cmpctblock(
         return;
     }
 
-    // TODO
+    if (false == cmpct_negotiated_.load()) { return; }
+
+    const auto& message = *pMessage;
+    auto pBlock = std::unique_ptr<CompactBlock>{};
+
+    try {
+        const auto raw = message.getRawCmpctblock();
+        pBlock = std::make_unique<CompactBlock>(
+            api_,
+            chain_,
+            cmpct_version_,
+            raw->Bytes(),
+            network_.Mempool().Snapshot());
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return;
+    }
+
+    OT_ASSERT(pBlock);
+
+    const auto& block = *pBlock;
+
+    if (block_.LoadRaw(block.Hash()).valid()) { return; }
+
+    const auto missing = block.Missing();
+
+    if (0 == missing.size()) {
+        finish_compact_block(block);
+
+        return;
+    }
+
+    LogVerbose(OT_METHOD)(__FUNCTION__)(": requesting ")(missing.size())(
+        " transactions for compact block ")(block.Hash().asHex())
+        .Flush();
+    auto pRequest = std::unique_ptr<Message>{
+        factory::BitcoinP2PGetblocktxn(api_, chain_, block.Hash(), missing)};
+
+    if (false == bool(pRequest)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to construct getblocktxn")
+            .Flush();
+        request_full_block(block.Hash());
+
+        return;
+    }
+
+    // Only one reconstruction is tracked at a time
+    if (cmpct_block_) { request_full_block(cmpct_block_->Hash()); }
+
+    cmpct_block_ = std::move(pBlock);
+    const auto& request = *pRequest;
+    send(request.Encode());
 }
 
 auto Peer::process_feefilter(
@@ -811,7 +917,58 @@ auto Peer::process_getblocktxn(
         return;
     }
 
-    // TODO
+    const auto& message = *pMessage;
+
+    try {
+        const auto hash = message.getBlockHash();
+        const auto raw = block_.LoadRaw(hash);
+
+        if (false == raw.valid()) {
+            throw std::runtime_error("Block " + hash->asHex() + " not found");
+        }
+
+        const auto pBlock = factory::BitcoinBlockView(
+            api_, network_.Blockchain(), chain_, raw.get());
+
+        if (false == bool(pBlock)) {
+            throw std::runtime_error("Failed to parse block");
+        }
+
+        const auto& block = *pBlock;
+        const auto& indices = message.getIndices();
+        auto reply = Data::Factory(hash);
+        const auto count =
+            blockchain::bitcoin::CompactSize(indices.size()).Encode();
+        reply->Concatenate(count.data(), count.size());
+
+        for (const auto index : indices) {
+            const auto& pTx = block.at(index);
+
+            if (false == bool(pTx)) {
+                throw std::runtime_error("Invalid transaction index");
+            }
+
+            auto tx = Space{};
+
+            if (false == pTx->Serialize(writer(tx)).has_value()) {
+                throw std::runtime_error("Failed to serialize transaction");
+            }
+
+            reply->Concatenate(tx.data(), tx.size());
+        }
+
+        auto pReply = std::unique_ptr<Message>{
+            factory::BitcoinP2PBlocktxn(api_, chain_, reply)};
+
+        if (false == bool(pReply)) {
+            throw std::runtime_error("Failed to construct blocktxn");
+        }
+
+        const auto& out = *pReply;
+        send(out.Encode());
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+    }
 }
 
 auto Peer::process_getcfcheckpt(
@@ -878,10 +1035,12 @@ auto Peer::process_getcfheaders(
     const auto previous = fromGenesis ? ReadView{blank.data(), blank.size()}
                                       : previousHeader->Bytes();
 
-    for (auto i{start}; i < blocks.size(); ++i) {
-        const auto& blockHash = blocks.at(i);
-        const auto pFilter = fOracle.LoadFilter(filterType, blockHash);
+    const auto filters = fOracle.LoadFilters(
+        filterType,
+        std::vector<block::pHash>{
+            std::next(blocks.begin(), start), blocks.end()});
 
+    for (const auto& pFilter : filters) {
         if (false == bool(pFilter)) { break; }
 
         const auto& filter = *pFilter;
@@ -970,17 +1129,12 @@ auto Peer::process_getcfilters(
         return;
     }
 
-    auto data = std::vector<std::unique_ptr<const client::GCS>>{};
-    data.reserve(count);
-    const auto& filters = network_.FilterOracle();
     const auto type = message.Type();
     const auto hashes = headers_.BestHashes(startHeight, stopHash);
-
-    for (const auto& hash : hashes) {
-        const auto& pGCS = data.emplace_back(filters.LoadFilter(type, hash));
-
-        if (!pGCS) { break; }
-    }
+    auto data = network_.FilterOracleInternal().LoadFilters(type, hashes);
+    const auto missing = std::find_if(
+        data.begin(), data.end(), [](const auto& pGCS) { return !pGCS; });
+    data.erase(missing, data.end());
 
     if (data.size() != count) {
         LogOutput(OT_METHOD)(__FUNCTION__)(
@@ -1036,10 +1190,48 @@ auto Peer::process_getdata(
 
     for (const auto& inv : message) {
         switch (inv.type_) {
-            case Type::MsgTx: {
-                // TODO
+            case Type::MsgTx:
+            case Type::MsgWitnessTx: {
+                const auto pTx = network_.Mempool().Query(inv.hash_->Bytes());
+
+                if (false == bool(pTx)) {
+                    notFound.emplace_back(inv);
+
+                    break;
+                }
+
+                const auto serialized = [&] {
+                    auto output = api_.Factory().Data();
+                    pTx->Serialize(output->WriteInto());
+
+                    return output;
+                }();
+                const auto pMsg = std::unique_ptr<Message>{
+                    factory::BitcoinP2PTx(api_, chain_, serialized->Bytes())};
+
+                OT_ASSERT(pMsg);
+
+                const auto& msg = *pMsg;
+                send(msg.Encode());
             } break;
-            case Type::MsgBlock: {
+            case Type::MsgBlock:
+            case Type::MsgCmpctBlock: {
+                // Compact blocks are not generated so requests for them are
+                // answered with the full block as permitted by BIP-152.
+                //
+                // Stored blocks are framed directly from block storage
+                // without being parsed
+                if (const auto raw = block_.LoadRaw(inv.hash_); raw.valid()) {
+                    auto encoded = factory::BitcoinP2PBlockEncoded(
+                        api_, chain_, raw.get());
+
+                    if (encoded) {
+                        send(std::move(encoded));
+
+                        break;
+                    }
+                }
+
                 const auto& oracle = network_.BlockOracle();
                 auto future = oracle.LoadBitcoin(inv.hash_);
                 const auto have = std::future_status::ready ==
@@ -1070,8 +1262,6 @@ auto Peer::process_getdata(
             } break;
             case Type::None:
             case Type::MsgFilteredBlock:
-            case Type::MsgCmpctBlock:
-            case Type::MsgWitnessTx:
             case Type::MsgWitnessBlock:
             case Type::MsgFilteredWitnessBlock:
             default: {
@@ -1212,9 +1402,21 @@ auto Peer::process_headers(
         auto future = promise->get_future();
         auto pointer = reinterpret_cast<std::uintptr_t>(promise);
         using Task = client::internal::Network::Task;
-        auto work = MakeWork(Task::SubmitBlockHeader);
+        // Headers announced by the peer may arrive before the reply to a
+        // segment request, which must extend the segment from its locator
+        const auto segment =
+            header_segment_.has_value() &&
+            ((0 == message.size()) ||
+             (message.at(0).ParentHash() == header_segment_.value()));
+
+        if (segment) { header_segment_.reset(); }
+
+        auto work = MakeWork(
+            segment ? Task::SubmitHeaderSegment : Task::SubmitBlockHeader);
         work->AddFrame(pointer);
 
+        if (segment) { work->AddFrame(id()); }
+
         for (const auto& header : message) {
             work->AddFrame(header.Serialize());
         }
@@ -1248,6 +1450,7 @@ auto Peer::process_inv(
     }
 
     const auto& message = *pMessage;
+    auto txids = std::vector<block::pTxid>{};
 
     for (const auto& inv : message) {
         if (false == running_.get()) { return; }
@@ -1264,10 +1467,17 @@ auto Peer::process_inv(
                     request_headers(inv.hash_);
                 }
             } break;
+            case Inventory::Type::MsgTx: {
+                txids.emplace_back(inv.hash_);
+            } break;
             default: {
             }
         }
     }
+
+    if ((0 < txids.size()) && (State::Run == state_.value_.load())) {
+        request_transactions(network_.Mempool().Request(std::move(txids)));
+    }
 }
 
 auto Peer::process_mempool(
@@ -1284,7 +1494,35 @@ auto Peer::process_mempool(
         return;
     }
 
-    // TODO
+    using Inventory = blockchain::bitcoin::Inventory;
+    auto inventory = std::vector<Inventory>{};
+
+    for (auto& txid : network_.Mempool().Dump()) {
+        inventory.emplace_back(Inventory::Type::MsgTx, std::move(txid));
+    }
+
+    auto first = inventory.begin();
+
+    while (inventory.end() != first) {
+        const auto count = std::min<std::size_t>(
+            std::distance(first, inventory.end()), max_inv_);
+        const auto last = std::next(first, count);
+        auto items = std::vector<Inventory>{
+            std::make_move_iterator(first), std::make_move_iterator(last)};
+        auto pMsg = std::unique_ptr<Message>{
+            factory::BitcoinP2PInv(api_, chain_, std::move(items))};
+
+        if (false == bool(pMsg)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to construct inv")
+                .Flush();
+
+            return;
+        }
+
+        const auto& msg = *pMsg;
+        send(msg.Encode());
+        first = last;
+    }
 }
 
 auto Peer::process_merkleblock(
@@ -1306,6 +1544,16 @@ auto Peer::process_merkleblock(
         return;
     }
 
+    const auto& message = *pMessage;
+    auto matches = std::vector<OTData>{};
+
+    if (false == message.Verify(matches)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Invalid partial merkle tree")
+            .Flush();
+
+        return;
+    }
+
     // TODO
 }
 
@@ -1485,7 +1733,12 @@ auto Peer::process_sendcmpct(
         return;
     }
 
-    // TODO
+    const auto& message = *pMessage;
+
+    // Compact blocks are used once both peers have offered the same version
+    if ((0 != cmpct_version_) && (message.version() == cmpct_version_)) {
+        cmpct_negotiated_.store(true);
+    }
 }
 
 auto Peer::process_sendheaders(
@@ -1523,7 +1776,28 @@ auto Peer::process_tx(
         return;
     }
 
-    // TODO
+    const auto& message = *pMessage;
+
+    try {
+        const auto raw = message.getRawTx();
+        auto pTx = std::shared_ptr<const block::bitcoin::Transaction>{
+            factory::BitcoinTransaction(
+                api_,
+                network_.Blockchain(),
+                chain_,
+                false,
+                Clock::now(),
+                blockchain::bitcoin::EncodedTransaction::Deserialize(
+                    api_, chain_, raw->Bytes()))};
+
+        if (false == bool(pTx)) {
+            throw std::runtime_error("Failed to instantiate transaction");
+        }
+
+        network_.Mempool().Submit(std::move(pTx));
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+    }
 }
 
 auto Peer::process_verack(
@@ -1541,6 +1815,7 @@ auto Peer::process_verack(
     }
 
     state_.handshake_.first_action_ = true;
+    request_compact_blocks();
     check_handshake();
 }
 
@@ -1586,6 +1861,36 @@ auto Peer::process_version(
     check_handshake();
 }
 
+auto Peer::receive_block(const ReadView payload) noexcept -> void
+{
+    try {
+        auto submit{true};
+
+        if (block_job_) {
+            auto block = api_.Factory().BitcoinBlock(chain_, payload);
+
+            if (!block) { throw std::runtime_error("Invalid block"); }
+
+            auto header = headers_.LoadHeader(block->Header().Hash());
+
+            if (!header) { throw std::runtime_error("Failed to load header"); }
+
+            submit = !block_job_.Download(header->Position(), std::move(block));
+
+            if (block_job_.isDownloaded()) { reset_block_job(); }
+        }
+
+        if (submit) {
+            using Task = client::internal::Network::Task;
+            auto work = MakeWork(Task::SubmitBlock);
+            work->AddFrame(payload.data(), payload.size());
+            network_.Submit(work);
+        }
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+    }
+}
+
 auto Peer::request_addresses() noexcept -> void
 {
     auto pMessage =
@@ -1616,8 +1921,13 @@ auto Peer::request_block(zmq::Message& in) noexcept -> void
     using Type = Inventory::Type;
     auto blocks = std::vector<Inventory>{};
 
+    // The peer replies with a full block instead of a compact block if the
+    // requested block is not near its tip
+    const auto type =
+        cmpct_negotiated_.load() ? Type::MsgCmpctBlock : Type::MsgBlock;
+
     for (auto i = std::size_t{1}; i < body.size(); ++i) {
-        blocks.emplace_back(Type::MsgBlock, api_.Factory().Data(body.at(1)));
+        blocks.emplace_back(type, api_.Factory().Data(body.at(i)));
     }
 
     auto pMessage = std::unique_ptr<Message>{
@@ -1817,8 +2127,82 @@ auto Peer::request_checkpoint_filter_header() noexcept -> void
     }
 }
 
+auto Peer::request_compact_blocks() noexcept -> void
+{
+    if (0 == cmpct_version_) { return; }
+
+    // BIP-152 requires protocol version 70014
+    if (70014 > protocol_.load()) { return; }
+
+    // Peers beyond the high bandwidth limit announce blocks normally
+    const auto highBandwidth =
+        cmpct_high_bandwidth_ && manager_.AcquireCompactHighBandwidth(id());
+    auto pMessage = std::unique_ptr<Message>{factory::BitcoinP2PSendcmpct(
+        api_, chain_, highBandwidth, cmpct_version_)};
+
+    if (false == bool(pMessage)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to construct sendcmpct")
+            .Flush();
+
+        return;
+    }
+
+    const auto& message = *pMessage;
+    send(message.Encode());
+}
+
+auto Peer::request_full_block(const block::Hash& hash) noexcept -> void
+{
+    using Inventory = blockchain::bitcoin::Inventory;
+    auto blocks = std::vector<Inventory>{};
+    blocks.emplace_back(Inventory::Type::MsgBlock, hash);
+    auto pMessage = std::unique_ptr<Message>{
+        factory::BitcoinP2PGetdata(api_, chain_, std::move(blocks))};
+
+    if (false == bool(pMessage)) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to construct getdata")
+            .Flush();
+
+        return;
+    }
+
+    const auto& message = *pMessage;
+    send(message.Encode());
+}
+
 auto Peer::request_headers() noexcept -> void
 {
+    if (get_headers_.Running()) { return; }
+
+    // A single peer always follows the local tip
+    const auto segment = (1 < network_.GetPeerCount())
+                             ? network_.HeaderSegments().Assign(id())
+                             : std::nullopt;
+
+    if (segment.has_value()) {
+        auto pMessage = std::unique_ptr<Message>{factory::BitcoinP2PGetheaders(
+            api_,
+            chain_,
+            protocol_.load(),
+            {segment->start_},
+            block::pHash{segment->stop_})};
+
+        if (false == bool(pMessage)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to construct getheaders")
+                .Flush();
+
+            return;
+        }
+
+        const auto& message = *pMessage;
+        header_segment_ = segment->start_;
+        send(message.Encode());
+        get_headers_.Start();
+
+        return;
+    }
+
     request_headers(api_.Factory().Data());
 }
 
@@ -1826,6 +2210,9 @@ auto Peer::request_headers(const block::Hash& hash) noexcept -> void
 {
     if (get_headers_.Running()) { return; }
 
+    // A segment request which timed out no longer expects a reply
+    header_segment_.reset();
+
     auto pMessage = std::unique_ptr<Message>{factory::BitcoinP2PGetheaders(
         api_, chain_, protocol_.load(), headers_.RecentHashes(), hash)};
 
@@ -1841,6 +2228,34 @@ auto Peer::request_headers(const block::Hash& hash) noexcept -> void
     get_headers_.Start();
 }
 
+auto Peer::request_transactions(std::vector<block::pTxid>&& txids) noexcept
+    -> void
+{
+    if (0 == txids.size()) { return; }
+
+    try {
+        using Inventory = blockchain::bitcoin::Inventory;
+        auto items = std::vector<Inventory>{};
+        items.reserve(txids.size());
+
+        for (auto& txid : txids) {
+            items.emplace_back(Inventory::Type::MsgTx, std::move(txid));
+        }
+
+        auto pMessage = std::unique_ptr<Message>{
+            factory::BitcoinP2PGetdata(api_, chain_, std::move(items))};
+
+        if (false == bool(pMessage)) {
+            throw std::runtime_error("Failed to construct getdata");
+        }
+
+        const auto& message = *pMessage;
+        send(message.Encode());
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+    }
+}
+
 auto Peer::start_handshake() noexcept -> void
 {
     try {
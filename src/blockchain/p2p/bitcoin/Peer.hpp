@@ -10,10 +10,12 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <future>
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <type_traits>
@@ -24,6 +26,7 @@
 #include "internal/blockchain/client/Client.hpp"
 #include "internal/blockchain/p2p/bitcoin/Bitcoin.hpp"
 #include "internal/blockchain/p2p/bitcoin/message/Message.hpp"
+#include "opentxs/Bytes.hpp"
 #include "opentxs/Types.hpp"
 #include "opentxs/blockchain/Blockchain.hpp"
 #include "opentxs/blockchain/BlockchainType.hpp"
@@ -41,6 +44,11 @@ namespace blockchain
 {
 namespace p2p
 {
+namespace bitcoin
+{
+class CompactBlock;
+}  // namespace bitcoin
+
 namespace internal
 {
 struct Address;
@@ -125,6 +133,8 @@ private:
 
     static const std::map<Command, CommandFunction> command_map_;
     static const ProtocolVersion default_protocol_version_{70015};
+    // Maximum number of entries in an inv message
+    static constexpr std::size_t max_inv_{50000};
     static const std::string user_agent_;
 
     const client::internal::HeaderOracle& headers_;
@@ -133,7 +143,19 @@ private:
     const std::set<p2p::Service> local_services_;
     std::atomic<bool> relay_;
     Request get_headers_;
+    // Locator of the outstanding getheaders request if it belongs to a header
+    // segment
+    std::optional<block::pHash> header_segment_;
+    // BIP-152 version offered to the peer. 0 if compact blocks are disabled.
+    const std::uint64_t cmpct_version_;
+    const bool cmpct_high_bandwidth_;
+    std::atomic<bool> cmpct_negotiated_;
+    // Compact block waiting for a blocktxn reply
+    std::unique_ptr<CompactBlock> cmpct_block_;
 
+    static auto compact_block_version(
+        const client::internal::Config& config,
+        const blockchain::Type network) noexcept -> std::uint64_t;
     static auto get_local_services(
         const ProtocolVersion version,
         const blockchain::Type network,
@@ -146,9 +168,11 @@ private:
 
     auto broadcast_block(zmq::Message& message) noexcept -> void final;
     auto broadcast_transaction(zmq::Message& message) noexcept -> void final;
+    auto finish_compact_block(const CompactBlock& block) noexcept -> void;
     auto ping() noexcept -> void final;
     auto pong() noexcept -> void final;
     auto process_message(const zmq::Message& message) noexcept -> void final;
+    auto receive_block(const ReadView block) noexcept -> void;
     auto request_addresses() noexcept -> void final;
     auto request_block(zmq::Message& message) noexcept -> void final;
     auto request_blocks() noexcept -> void final;
@@ -156,9 +180,13 @@ private:
     auto request_cfilter() noexcept -> void final;
     auto request_checkpoint_block_header() noexcept -> void final;
     auto request_checkpoint_filter_header() noexcept -> void final;
+    auto request_compact_blocks() noexcept -> void;
+    auto request_full_block(const block::Hash& hash) noexcept -> void;
     using p2p::implementation::Peer::request_headers;
     auto request_headers() noexcept -> void final;
     auto request_headers(const block::Hash& hash) noexcept -> void;
+    auto request_transactions(std::vector<block::pTxid>&& txids) noexcept
+        -> void;
     auto start_handshake() noexcept -> void final;
 
     auto process_addr(
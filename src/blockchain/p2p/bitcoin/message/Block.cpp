@@ -7,17 +7,26 @@
 #include "1_Internal.hpp"                            // IWYU pragma: associated
 #include "blockchain/p2p/bitcoin/message/Block.hpp"  // IWYU pragma: associated
 
+#include <cstddef>
+#include <cstring>
 #include <iosfwd>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
 #include <utility>
 
 #include "blockchain/p2p/bitcoin/Header.hpp"
 #include "blockchain/p2p/bitcoin/Message.hpp"
 #include "internal/blockchain/p2p/bitcoin/Bitcoin.hpp"
+#include "internal/network/Factory.hpp"
+#include "opentxs/Bytes.hpp"
 #include "opentxs/Pimpl.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
 #include "opentxs/blockchain/p2p/Types.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/LogSource.hpp"
+#include "opentxs/network/zeromq/Frame.hpp"
 
 //#define OT_METHOD "
 // opentxs::blockchain::p2p::bitcoin::message::implementation::Block::"
@@ -58,6 +67,59 @@ auto BitcoinP2PBlock(
 
     return new ReturnType(api, network, raw_block);
 }
+
+auto BitcoinP2PBlockEncoded(
+    const api::Core& api,
+    const blockchain::Type network,
+    const ReadView raw_block) noexcept
+    -> std::unique_ptr<network::zeromq::Frame>
+{
+    namespace bitcoin = blockchain::p2p::bitcoin;
+
+    try {
+        auto checksum = Data::Factory();
+
+        if (false == blockchain::P2PMessageHash(
+                         api, network, raw_block, checksum->WriteInto())) {
+            throw std::runtime_error("Failed to calculate checksum");
+        }
+
+        const auto header = bitcoin::Header{
+            api,
+            network,
+            bitcoin::Command::block,
+            raw_block.size(),
+            checksum}
+                                .Encode();
+        // The block is copied once into a buffer which is owned by the frame
+        // and released when the last message referring to it is closed
+        auto buffer =
+            std::make_unique<Space>(header->size() + raw_block.size());
+        auto* it = buffer->data();
+        std::memcpy(it, header->data(), header->size());
+        std::advance(it, header->size());
+        std::memcpy(it, raw_block.data(), raw_block.size());
+        auto* data = static_cast<void*>(buffer->data());
+        const auto size = buffer->size();
+        auto output = ZMQFrame(
+            data,
+            size,
+            [](void*, void* hint) { delete static_cast<Space*>(hint); },
+            buffer.get());
+
+        if (false == bool(output)) {
+            throw std::runtime_error("Failed to allocate output");
+        }
+
+        buffer.release();
+
+        return output;
+    } catch (const std::exception& e) {
+        LogOutput("opentxs::factory::")(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return {};
+    }
+}
 }  // namespace opentxs::factory
 
 namespace opentxs::blockchain::p2p::bitcoin::message::implementation
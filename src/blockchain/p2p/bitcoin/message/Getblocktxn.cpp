@@ -81,6 +81,9 @@ auto BitcoinP2PGetblocktxn(
     std::vector<std::size_t> txn_indices;
 
     if (indicesCount > 0) {
+        // Indices are differentially encoded on the wire
+        std::size_t next{0};
+
         for (std::size_t ii = 0; ii < indicesCount; ii++) {
             expectedSize += sizeof(std::byte);
 
@@ -103,7 +106,8 @@ auto BitcoinP2PGetblocktxn(
                 return nullptr;
             }
 
-            txn_indices.push_back(txnIndex);
+            txn_indices.push_back(next + txnIndex);
+            next = txn_indices.back() + 1;
         }
     }
     // --------------------------------------------------------
@@ -143,9 +147,12 @@ auto Getblocktxn::payload() const noexcept -> OTData
         const auto size = CompactSize(txn_indices_.size()).Encode();
         output->Concatenate(size.data(), size.size());
         // ---------------------------
+        auto next = std::size_t{0};
+
         for (const auto& index : txn_indices_) {
-            const auto size = CompactSize(index).Encode();
+            const auto size = CompactSize(index - next).Encode();
             output->Concatenate(size.data(), size.size());
+            next = index + 1;
         }
 
         return output;
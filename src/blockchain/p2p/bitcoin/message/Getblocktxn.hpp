@@ -69,6 +69,8 @@ public:
 
 private:
     const OTData block_hash_;
+    // Absolute transaction indices in ascending order. They are differentially
+    // encoded in the payload.
     const std::vector<std::size_t> txn_indices_;
 
     auto payload() const noexcept -> OTData final;
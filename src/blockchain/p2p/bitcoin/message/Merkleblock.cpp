@@ -9,8 +9,11 @@
 
 #include <cstdint>
 #include <cstring>
+#include <exception>
+#include <stdexcept>
 #include <utility>
 
+#include "blockchain/Merkle.hpp"
 #include "blockchain/p2p/bitcoin/Header.hpp"
 #include "internal/blockchain/bitcoin/Bitcoin.hpp"
 #include "internal/blockchain/p2p/bitcoin/message/Message.hpp"
@@ -19,7 +22,7 @@
 #include "opentxs/core/Log.hpp"
 #include "opentxs/core/LogSource.hpp"
 
-//#define OT_METHOD " opentxs::blockchain::p2p::bitcoin::message::Merkleblock::"
+#define OT_METHOD "opentxs::blockchain::p2p::bitcoin::message::Merkleblock::"
 
 namespace opentxs::factory
 {
@@ -190,6 +193,52 @@ auto Merkleblock::payload() const noexcept -> OTData
     }
 }
 
+auto Merkleblock::Verify(std::vector<OTData>& matches) const noexcept -> bool
+{
+    using Digest = blockchain::Merkle::Digest;
+    // The merkle root follows the version and previous block hash
+    constexpr auto rootOffset = std::size_t{36};
+
+    try {
+        if (sizeof(BlockHeaderField) != block_header_->size()) {
+            throw std::runtime_error("Invalid block header");
+        }
+
+        auto hashes = std::vector<Digest>(hashes_.size());
+
+        for (auto i = std::size_t{0}; i < hashes_.size(); ++i) {
+            const auto& hash = hashes_[i].get();
+            auto& digest = hashes[i];
+
+            if (digest.size() != hash.size()) {
+                throw std::runtime_error("Invalid hash size");
+            }
+
+            std::memcpy(digest.data(), hash.data(), digest.size());
+        }
+
+        auto found = std::vector<Digest>{};
+        const auto root =
+            blockchain::Merkle::PartialRoot(txn_count_, hashes, flags_, found);
+        const auto* expected =
+            static_cast<const std::byte*>(block_header_->data()) + rootOffset;
+
+        if (0 != std::memcmp(root.data(), expected, root.size())) {
+            throw std::runtime_error("Merkle root mismatch");
+        }
+
+        for (const auto& txid : found) {
+            matches.emplace_back(Data::Factory(txid.data(), txid.size()));
+        }
+
+        return true;
+    } catch (const std::exception& e) {
+        LogOutput(OT_METHOD)(__FUNCTION__)(": ")(e.what()).Flush();
+
+        return false;
+    }
+}
+
 Merkleblock::Raw::Raw(
     const Data& block_header,
     const TxnCount txn_count) noexcept
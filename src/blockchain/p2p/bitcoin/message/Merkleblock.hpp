@@ -65,6 +65,10 @@ public:
     {
         return flags_;
     }
+    /// Returns false if the partial merkle tree is malformed or does not
+    /// match the merkle root of the block header, otherwise appends the
+    /// matched transactions to the matches argument
+    auto Verify(std::vector<OTData>& matches) const noexcept -> bool;
 
     Merkleblock(
         const api::Core& api,
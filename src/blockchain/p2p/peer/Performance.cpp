@@ -0,0 +1,225 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "0_stdafx.hpp"             // IWYU pragma: associated
+#include "1_Internal.hpp"           // IWYU pragma: associated
+#include "blockchain/p2p/Peer.hpp"  // IWYU pragma: associated
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <set>
+#include <utility>
+
+namespace opentxs::blockchain::p2p::internal
+{
+// Records written before the format was versioned hold the fields without a
+// version number
+constexpr auto statistics_fields_ = std::size_t{24};
+
+auto PeerStatistics::Deserialize(const ReadView in) noexcept
+    -> std::optional<PeerStatistics>
+{
+    const auto* it = reinterpret_cast<const std::byte*>(in.data());
+    auto version = std::uint32_t{};
+
+    if (statistics_fields_ == in.size()) {
+        version = 0;
+    } else if ((sizeof(version) + statistics_fields_) == in.size()) {
+        std::memcpy(&version, it, sizeof(version));
+        std::advance(it, sizeof(version));
+
+        if (version_ != version) { return std::nullopt; }
+    } else {
+
+        return std::nullopt;
+    }
+
+    auto output = std::make_optional<PeerStatistics>();
+    auto& stats = output.value();
+    const auto read = [&](auto& field) {
+        std::memcpy(&field, it, sizeof(field));
+        std::advance(it, sizeof(field));
+    };
+    read(stats.bytes_per_second_);
+    read(stats.handshake_ms_);
+    read(stats.connections_);
+    read(stats.failures_);
+    read(stats.timeouts_);
+
+    return output;
+}
+
+auto PeerStatistics::Serialize() const noexcept -> Space
+{
+    auto output = space(sizeof(version_) + statistics_fields_);
+    auto* it = output.data();
+    const auto write = [&](const auto& field) {
+        std::memcpy(it, &field, sizeof(field));
+        std::advance(it, sizeof(field));
+    };
+    write(version_);
+    write(bytes_per_second_);
+    write(handshake_ms_);
+    write(connections_);
+    write(failures_);
+    write(timeouts_);
+
+    return output;
+}
+
+auto SlowPeer(
+    const PeerRates& rates,
+    const std::set<int>& exempt,
+    const std::size_t target) noexcept -> std::optional<int>
+{
+    if (2 > rates.size()) { return std::nullopt; }
+
+    auto total = std::size_t{0};
+    auto slowest = std::optional<std::pair<int, std::size_t>>{};
+
+    for (const auto& [id, rate] : rates) {
+        total += rate;
+
+        if (0 < exempt.count(id)) { continue; }
+
+        if ((false == slowest.has_value()) || (rate < slowest->second)) {
+            slowest = std::make_pair(id, rate);
+        }
+    }
+
+    if ((total >= target) || (false == slowest.has_value())) {
+        return std::nullopt;
+    }
+
+    return slowest->first;
+}
+}  // namespace opentxs::blockchain::p2p::internal
+
+namespace opentxs::blockchain::p2p::implementation
+{
+// Weight of the most recent measurement
+constexpr auto performance_alpha_ = double{0.25};
+// Measurements are taken over download periods of at least this length
+constexpr auto performance_window_ = std::chrono::seconds{10};
+// Shorter download periods are discarded as too noisy
+constexpr auto performance_minimum_ = std::chrono::seconds{1};
+// Peers which have not downloaded anything recently report no throughput
+constexpr auto performance_idle_ = std::chrono::seconds{60};
+
+Peer::Performance::Performance(const internal::PeerStatistics& stored) noexcept
+    : lock_()
+    , stats_(stored)
+    , rate_()
+    , bytes_(0)
+    , window_()
+    , busy_()
+{
+}
+
+auto Peer::Performance::Connected() noexcept -> void
+{
+    Lock lock(lock_);
+    ++stats_.connections_;
+}
+
+auto Peer::Performance::Current() const noexcept -> internal::PeerStatistics
+{
+    Lock lock(lock_);
+
+    return stats_;
+}
+
+auto Peer::Performance::Failure() noexcept -> void
+{
+    Lock lock(lock_);
+    ++stats_.failures_;
+}
+
+auto Peer::Performance::Handshake(
+    const std::chrono::nanoseconds elapsed) noexcept -> void
+{
+    const auto ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    constexpr auto max = std::numeric_limits<std::uint32_t>::max();
+    Lock lock(lock_);
+    stats_.handshake_ms_ = static_cast<std::uint32_t>(
+        std::clamp<decltype(ms)>(ms, 1, static_cast<decltype(ms)>(max)));
+}
+
+auto Peer::Performance::measure(const Lock&, const Time now) noexcept -> void
+{
+    const auto elapsed =
+        std::chrono::duration<double>(now - window_.value()).count();
+    const auto sample = static_cast<double>(bytes_) / elapsed;
+    rate_ = rate_.has_value() ? (performance_alpha_ * sample) +
+                                    ((1.0 - performance_alpha_) * rate_.value())
+                              : sample;
+    auto& stored = stats_.bytes_per_second_;
+    const auto average =
+        (0 == stored) ? sample
+                      : (performance_alpha_ * sample) +
+                            ((1.0 - performance_alpha_) * stored);
+    stored = std::max<std::uint64_t>(static_cast<std::uint64_t>(average), 1);
+}
+
+auto Peer::Performance::Receive(const std::size_t bytes) noexcept -> void
+{
+    Lock lock(lock_);
+
+    if (window_.has_value()) { bytes_ += bytes; }
+}
+
+auto Peer::Performance::Sample(const bool busy) noexcept -> void
+{
+    const auto now = Clock::now();
+    Lock lock(lock_);
+
+    if (window_.has_value()) {
+        const auto elapsed = now - window_.value();
+
+        if (busy ? (performance_window_ <= elapsed)
+                 : (performance_minimum_ <= elapsed)) {
+            measure(lock, now);
+        }
+
+        if (busy && (performance_window_ > elapsed)) {
+            busy_ = now;
+
+            return;
+        }
+
+        window_.reset();
+        bytes_ = 0;
+    }
+
+    if (busy) {
+        window_ = now;
+        busy_ = now;
+    }
+}
+
+auto Peer::Performance::Throughput() const noexcept
+    -> std::optional<std::size_t>
+{
+    Lock lock(lock_);
+
+    if (false == rate_.has_value()) { return std::nullopt; }
+
+    if ((Clock::now() - busy_) > performance_idle_) { return std::nullopt; }
+
+    return static_cast<std::size_t>(rate_.value());
+}
+
+auto Peer::Performance::Timeout() noexcept -> void
+{
+    Lock lock(lock_);
+    ++stats_.timeouts_;
+}
+}  // namespace opentxs::blockchain::p2p::implementation
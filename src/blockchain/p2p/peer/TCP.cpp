@@ -201,9 +201,8 @@ struct TCPConnectionManager final : public Peer::ConnectionManager {
             case Peer::Task::Body: {
                 OT_ASSERT(1 < body.size());
 
-                parent_.on_pipeline(
-                    Peer::Task::ReceiveMessage,
-                    {header_->Bytes(), body.at(1).Bytes()});
+                parent_.on_receive(
+                    header_->Bytes(), message.at(message.size() - 1));
                 run();
             } break;
             default: {
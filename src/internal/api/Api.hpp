@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
+
 #include "opentxs/api/Context.hpp"
 #include "opentxs/api/Core.hpp"
 #include "opentxs/api/Factory.hpp"
@@ -86,12 +89,29 @@ struct Log {
 };
 
 struct ThreadPool : virtual public api::ThreadPool {
+    using Range =
+        std::function<void(const std::size_t first, const std::size_t last)>;
+
     enum class Work : OTZMQWorkType {
         BlockchainWallet = OT_ZMQ_INTERNAL_SIGNAL + 0,
         SyncDataFiltersIncoming = OT_ZMQ_INTERNAL_SIGNAL + 1,
         CalculateBlockFilters = OT_ZMQ_INTERNAL_SIGNAL + 2,
+        ParallelRange = OT_ZMQ_INTERNAL_SIGNAL + 3,
     };
 
+    /// Calls job for consecutive sub-ranges which together cover [0, count)
+    ///
+    /// The range is only divided between the calling thread and thread pool
+    /// workers if every thread receives at least minimum items. Sub-ranges
+    /// which no worker has claimed are processed by the calling thread, which
+    /// only waits for sub-ranges already in progress. Calling this function
+    /// from a thread pool worker can therefore not deadlock.
+    static auto Parallel(
+        const api::Core& api,
+        const std::size_t count,
+        const std::size_t minimum,
+        const Range& job) noexcept -> void;
+
     virtual auto Shutdown() noexcept -> void = 0;
 
     ~ThreadPool() override = default;
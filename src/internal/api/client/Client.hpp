@@ -169,6 +169,8 @@ struct Blockchain : virtual public api::client::Blockchain {
         const opentxs::blockchain::block::Height current,
         const opentxs::blockchain::block::Height target) const noexcept
         -> void = 0;
+    /// Asks the sync server for data following the current sync position
+    virtual auto RequestSyncData(const Chain chain) const noexcept -> void = 0;
     virtual auto RestoreNetworks() const noexcept -> void = 0;
     virtual auto UpdateBalance(
         const opentxs::blockchain::Type chain,
@@ -170,6 +170,13 @@ enum Table {
     BlockIndex = 14,
     Enabled = 15,
     SyncTips = 16,
+    FilterIndexBasic = 17,
+    FilterIndexBCH = 18,
+    FilterIndexOpentxs = 19,
+    PeerStatistics = 20,
+    FreeBlockSpace = 21,
+    FreeSyncSpace = 22,
+    FreeFilterSpace = 23,
 };
 
 auto ChainToSyncTable(const Chain chain) noexcept(false) -> int;
@@ -236,6 +236,15 @@ OPENTXS_EXPORT auto GCS(
     const ReadView key,
     const ReadView encoded) noexcept
     -> std::unique_ptr<blockchain::client::GCS>;
+// The returned filter refers to the filter bytes inside encoded instead of
+// copying them. The caller must keep encoded valid for the lifetime of the
+// filter.
+OPENTXS_EXPORT auto GCSView(
+    const api::Core& api,
+    const blockchain::filter::Type type,
+    const ReadView key,
+    const ReadView encoded) noexcept
+    -> std::unique_ptr<blockchain::client::GCS>;
 OPENTXS_EXPORT auto NumericHash(const blockchain::block::Hash& hash) noexcept
     -> std::unique_ptr<blockchain::NumericHash>;
 OPENTXS_EXPORT auto NumericHashNBits(const std::uint32_t nBits) noexcept
@@ -244,5 +253,8 @@ OPENTXS_EXPORT auto Work(const std::string& hex) -> blockchain::Work*;
 OPENTXS_EXPORT auto Work(
     const blockchain::Type chain,
     const blockchain::NumericHash& target) -> blockchain::Work*;
+OPENTXS_EXPORT auto Work(
+    const blockchain::Type chain,
+    const std::uint32_t nBits) -> blockchain::Work*;
 #endif  // OT_BLOCKCHAIN
 }  // namespace opentxs::factory
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <boost/endian/buffers.hpp>
+#include <array>
+#include <cstdint>
 #include <map>
 #include <vector>
 
@@ -34,7 +37,30 @@ namespace opentxs::blockchain::block::bitcoin::internal
 auto Opcode(const OP opcode) noexcept(false) -> ScriptElement;
 auto PushData(const ReadView data) noexcept(false) -> ScriptElement;
 
+// Fixed size serialization of a header and its local metadata
+struct HeaderRecord {
+    std::array<char, 80> header_;
+    std::array<char, 32> hash_;
+    std::array<char, 32> pow_;
+    // Work values are big endian
+    std::array<char, 32> work_;
+    std::array<char, 32> inherit_work_;
+    boost::endian::little_int64_buf_t height_;
+    boost::endian::little_uint32_buf_t subversion_;
+    boost::endian::little_uint32_buf_t status_;
+    boost::endian::little_uint32_buf_t inherit_status_;
+    std::array<char, 28> reserved_;
+
+    auto Hash() const noexcept -> ReadView
+    {
+        return {hash_.data(), hash_.size()};
+    }
+};
+
+static_assert(256 == sizeof(HeaderRecord));
+
 struct Header : virtual public bitcoin::Header {
+    virtual auto Record() const noexcept -> HeaderRecord = 0;
 };
 }  // namespace opentxs::blockchain::block::bitcoin::internal
 
@@ -45,6 +45,7 @@ namespace bitcoin
 namespace internal
 {
 struct Header;
+struct HeaderRecord;
 struct Output;
 struct Script;
 }  // namespace internal
@@ -241,6 +242,15 @@ auto BitcoinBlock(
     const blockchain::Type chain,
     const ReadView in) noexcept
     -> std::shared_ptr<blockchain::block::bitcoin::Block>;
+// The returned block refers to the bytes in "in" instead of copying them and
+// only instantiates transactions when they are accessed. The caller must keep
+// "in" valid for the lifetime of the block.
+OPENTXS_EXPORT auto BitcoinBlockView(
+    const api::Core& api,
+    const api::client::Blockchain& blockchain,
+    const blockchain::Type chain,
+    const ReadView in) noexcept
+    -> std::shared_ptr<blockchain::block::bitcoin::Block>;
 auto BitcoinBlockHeader(
     const api::Core& api,
     const opentxs::blockchain::block::Header& previous,
@@ -258,6 +268,12 @@ auto BitcoinBlockHeader(
     const blockchain::Type chain,
     const ReadView bytes) noexcept
     -> std::unique_ptr<blockchain::block::bitcoin::internal::Header>;
+// Instantiates a stored header without recalculating its hashes
+OPENTXS_EXPORT auto BitcoinBlockHeader(
+    const api::Core& api,
+    const blockchain::Type chain,
+    const blockchain::block::bitcoin::internal::HeaderRecord& record) noexcept
+    -> std::unique_ptr<blockchain::block::bitcoin::internal::Header>;
 auto BitcoinBlockHeader(
     const api::Core& api,
     const blockchain::Type chain,
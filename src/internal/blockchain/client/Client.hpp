@@ -114,11 +114,14 @@ namespace internal
 struct Database;
 }  // namespace internal
 
+class BufferPool;
+
 namespace p2p
 {
 namespace internal
 {
 struct Address;
+struct PeerStatistics;
 }  // namespace internal
 
 class Address;
@@ -216,6 +219,7 @@ using BlockJob =
 using ParsedSyncPacket = std::
     tuple<block::pHash, block::Height, filter::Type, std::uint32_t, OTData>;
 using ParsedSyncData = std::pair<block::pHash, std::vector<ParsedSyncPacket>>;
+using SyncHeaders = std::vector<std::unique_ptr<block::Header>>;
 }  // namespace opentxs::blockchain::client
 #endif  // OT_BLOCKCHAIN
 
@@ -227,8 +231,18 @@ struct BlockDatabase {
         -> bool = 0;
     virtual auto BlockLoadBitcoin(const block::Hash& block) const noexcept
         -> std::shared_ptr<const block::bitcoin::Block> = 0;
+    /// Returns the serialized block as stored without parsing it
+    ///
+    /// The returned view is invalid if the block is not in storage.
+    virtual auto BlockLoadRaw(const block::Hash& block) const noexcept
+        -> api::client::blockchain::BlockReader = 0;
     virtual auto BlockPolicy() const noexcept
         -> api::client::blockchain::BlockStorage = 0;
+    /// Removes the next batch of blocks which fall outside of the pruning
+    /// limits
+    ///
+    /// Returns true if more blocks remain to be removed.
+    virtual auto BlockPrune() const noexcept -> bool = 0;
     virtual auto BlockStore(const block::Block& block) const noexcept
         -> bool = 0;
     virtual auto BlockTip() const noexcept -> block::Position = 0;
@@ -245,8 +259,14 @@ struct BlockOracle : virtual public opentxs::blockchain::client::BlockOracle {
         Shutdown = value(WorkType::Shutdown),
     };
 
-    virtual auto GetBlockJob() const noexcept -> BlockJob = 0;
+    /// Returns a batch sized for the measured throughput of the peer
+    virtual auto GetBlockJob(const int peer) const noexcept -> BlockJob = 0;
     virtual auto Heartbeat() const noexcept -> void = 0;
+    /// Returns the serialized block from storage, bypassing the cache
+    virtual auto LoadRaw(const block::Hash& block) const noexcept
+        -> api::client::blockchain::BlockReader = 0;
+    /// Discards the download measurements of a disconnected peer
+    virtual auto RemovePeer(const int peer) const noexcept -> void = 0;
     virtual auto SubmitBlock(const ReadView in) const noexcept -> void = 0;
     virtual auto Tip() const noexcept -> block::Position = 0;
 
@@ -262,7 +282,34 @@ struct OPENTXS_EXPORT Config {
     bool provide_sync_server_{false};
     bool use_sync_server_{false};
     bool disable_wallet_{false};
+    // BIP-152 compact block relay. In high bandwidth mode peers send new
+    // blocks as cmpctblock messages without announcing them first.
+    bool disable_compact_blocks_{false};
+    bool compact_blocks_high_bandwidth_{false};
+    // Download the chain between checkpoints from several peers at once
+    bool disable_segmented_headers_{false};
     std::string sync_endpoint_{};
+    // The slowest peer is periodically replaced while the combined download
+    // rate of all peers is below this many bytes per second. 0 disables
+    // replacement.
+    std::size_t peer_target_bytes_{1024u * 1024u};
+    std::size_t block_cache_bytes_{256u * 1024u * 1024u};
+    // Downloaded blocks older than the newest block_prune_blocks_ blocks, or
+    // which do not fit in block_prune_bytes_ bytes, are removed from storage.
+    // 0 disables the corresponding limit.
+    std::size_t block_prune_blocks_{0};
+    std::size_t block_prune_bytes_{0};
+    std::size_t filter_cache_bytes_{64u * 1024u * 1024u};
+    // Unconfirmed transactions are evicted oldest first once the mempool
+    // holds more than mempool_bytes_ bytes, or after mempool_expiry_hours_.
+    // 0 bytes disables the mempool.
+    std::size_t mempool_bytes_{64u * 1024u * 1024u};
+    std::size_t mempool_expiry_hours_{336};
+    // 0 means use one scan job per hardware thread
+    std::size_t scan_parallelism_{0};
+    // Number of matched blocks each wallet subchain downloads ahead of the
+    // block it is processing
+    std::size_t block_prefetch_{16};
 
     auto print() const noexcept -> std::string;
 };
@@ -289,6 +336,18 @@ struct FilterDatabase {
         const noexcept -> Hash = 0;
     virtual auto LoadFilterHeader(const filter::Type type, const ReadView block)
         const noexcept -> Hash = 0;
+    /// Element i of the output corresponds to blocks[i] and is empty if the
+    /// header is not available
+    virtual auto LoadFilterHeaders(
+        const filter::Type type,
+        const std::vector<block::pHash>& blocks) const noexcept
+        -> std::vector<Hash> = 0;
+    /// Element i of the output corresponds to blocks[i] and is nullptr if the
+    /// filter is not available
+    virtual auto LoadFilters(
+        const filter::Type type,
+        const std::vector<block::pHash>& blocks) const noexcept
+        -> std::vector<std::unique_ptr<const GCS>> = 0;
     virtual auto SetFilterHeaderTip(
         const filter::Type type,
         const block::Position& position) const noexcept -> bool = 0;
@@ -316,17 +375,38 @@ struct FilterOracle : virtual public opentxs::blockchain::client::FilterOracle {
 
     static auto ProcessThreadPool(const zmq::Message& task) noexcept -> void;
 
-    virtual auto GetFilterJob() const noexcept -> CfilterJob = 0;
-    virtual auto GetHeaderJob() const noexcept -> CfheaderJob = 0;
+    /// Returns a batch sized for the measured throughput of the peer
+    virtual auto GetFilterJob(const int peer) const noexcept
+        -> CfilterJob = 0;
+    /// Returns a batch sized for the measured throughput of the peer
+    virtual auto GetHeaderJob(const int peer) const noexcept
+        -> CfheaderJob = 0;
     virtual auto Heartbeat() const noexcept -> void = 0;
+    virtual auto LoadFilterHeaders(
+        const filter::Type type,
+        const std::vector<block::pHash>& blocks) const noexcept
+        -> std::vector<Header> = 0;
     virtual auto LoadFilterOrResetTip(
         const filter::Type type,
         const block::Position& position) const noexcept
-        -> std::unique_ptr<const GCS> = 0;
+        -> std::shared_ptr<const GCS> = 0;
+    /// Returns a filter which may be shared with other callers
+    virtual auto LoadFilterShared(
+        const filter::Type type,
+        const block::Hash& block) const noexcept
+        -> std::shared_ptr<const GCS> = 0;
+    /// Element i of the output corresponds to blocks[i] and is nullptr if the
+    /// filter is not available
+    virtual auto LoadFilters(
+        const filter::Type type,
+        const std::vector<block::pHash>& blocks) const noexcept
+        -> std::vector<std::shared_ptr<const GCS>> = 0;
     virtual auto ProcessBlock(const block::bitcoin::Block& block) const noexcept
         -> bool = 0;
     virtual auto ProcessSyncData(const ParsedSyncData& data) const noexcept
         -> void = 0;
+    /// Discards the download measurements of a disconnected peer
+    virtual auto RemovePeer(const int peer) const noexcept -> void = 0;
     virtual auto Tip(const filter::Type type) const noexcept
         -> block::Position = 0;
 
@@ -350,8 +430,12 @@ struct HeaderOracle : virtual public opentxs::blockchain::client::HeaderOracle {
     virtual auto Init() noexcept -> void = 0;
     virtual auto LoadBitcoinHeader(const block::Hash& hash) const noexcept
         -> std::unique_ptr<block::bitcoin::Header> = 0;
+    /// Connects headers decoded from sync data
+    ///
+    /// headers[i] must correspond to out.second[i]. On success out.first
+    /// contains the hash of the parent of the first header.
     virtual auto ProcessSyncData(
-        const network::zeromq::Message& work,
+        SyncHeaders& headers,
         ParsedSyncData& out) noexcept -> bool = 0;
 
     ~HeaderOracle() override = default;
@@ -363,6 +447,9 @@ struct HeaderDatabase {
     // Throws std::out_of_range if no block at that position
     virtual auto BestBlock(const block::Height position) const noexcept(false)
         -> block::pHash = 0;
+    // Hashes of the best chain starting from the genesis block, read in a
+    // single pass
+    virtual auto BestChain() const noexcept -> std::vector<block::pHash> = 0;
     virtual auto CurrentBest() const noexcept
         -> std::unique_ptr<block::Header> = 0;
     virtual auto CurrentCheckpoint() const noexcept -> block::Position = 0;
@@ -388,6 +475,41 @@ struct HeaderDatabase {
     virtual ~HeaderDatabase() = default;
 };
 
+/// Downloads the best chain between checkpoints from several peers at once
+///
+/// Each segment starts at a checkpoint above the local tip and ends at the
+/// next checkpoint, or follows the last checkpoint. Headers received for a
+/// segment are held until the segment is complete and the header oracle has
+/// reached its first checkpoint.
+struct HeaderSegments {
+    struct Request {
+        block::pHash start_;
+        /// Empty if the segment follows the last checkpoint
+        block::pHash stop_;
+    };
+
+    /// Returns the next getheaders request for the segment assigned to the
+    /// peer, assigning a segment first if necessary
+    ///
+    /// Returns nullopt if no segment is available, in which case the peer
+    /// should request the headers which follow the local tip.
+    virtual auto Assign(const int peer) const noexcept
+        -> std::optional<Request> = 0;
+    /// Adds every complete segment which connects to the best chain to the
+    /// header oracle
+    virtual auto Flush() const noexcept -> void = 0;
+    /// Accepts a contiguous batch of headers received in response to a
+    /// request returned by Assign
+    virtual auto Receive(
+        const int peer,
+        std::vector<std::unique_ptr<block::Header>>&& headers) const noexcept
+        -> void = 0;
+    /// Makes the segment assigned to the peer available to other peers
+    virtual auto Release(const int peer) const noexcept -> void = 0;
+
+    virtual ~HeaderSegments() = default;
+};
+
 struct IO {
     using tcp = boost::asio::ip::tcp;
 
@@ -411,19 +533,15 @@ struct IO {
 
 private:
     const api::Core& api_;
-    mutable std::mutex lock_;
     OTZMQListenCallback cb_;
     OTZMQRouterSocket socket_;
-    mutable int next_buffer_;
-    mutable std::map<int, Space> buffers_;
+    // Received data is handed to peers in zero copy frames which return
+    // their buffers here when released
+    const std::shared_ptr<BufferPool> buffers_;
     mutable boost::asio::io_context context_;
     std::unique_ptr<boost::asio::io_context::work> work_;
     boost::thread_group thread_pool_;
 
-    auto clear_buffer(const int id) const noexcept -> void;
-    auto get_buffer(const std::size_t bytes) const noexcept
-        -> std::pair<int, WritableView>;
-
     auto callback(zmq::Message& in) noexcept -> void;
 
     IO() = delete;
@@ -433,11 +551,42 @@ private:
     auto operator=(IO&&) -> IO& = delete;
 };
 
+struct Mempool {
+    using Transaction = std::shared_ptr<const block::bitcoin::Transaction>;
+    using Transactions = std::vector<Transaction>;
+
+    /// Returns the txids of every transaction in the mempool
+    virtual auto Dump() const noexcept -> std::vector<block::pTxid> = 0;
+    /// Returns an empty pointer if the transaction is not in the mempool
+    virtual auto Query(const ReadView txid) const noexcept -> Transaction = 0;
+    /// Removes the transactions in a block, and every transaction which
+    /// conflicts with them, from the mempool
+    ///
+    /// The wallet is told about conflicting transactions so that it can
+    /// revert their effects.
+    virtual auto Prune(const block::bitcoin::Block& block) const noexcept
+        -> void = 0;
+    /// Returns the announced txids which should be requested from the peer
+    ///
+    /// Transactions which are already known, or which have recently been
+    /// requested from another peer, are omitted.
+    virtual auto Request(std::vector<block::pTxid>&& txids) const noexcept
+        -> std::vector<block::pTxid> = 0;
+    /// Returns every transaction in the mempool
+    virtual auto Snapshot() const noexcept -> Transactions = 0;
+    /// Returns false if the transaction is already known or if it spends an
+    /// outpoint which is already spent by a transaction in the mempool
+    virtual auto Submit(Transaction tx) const noexcept -> bool = 0;
+
+    virtual ~Mempool() = default;
+};
+
 struct PeerDatabase {
     using Address = std::unique_ptr<p2p::internal::Address>;
     using Protocol = p2p::Protocol;
     using Service = p2p::Service;
     using Type = p2p::Network;
+    using Statistics = p2p::internal::PeerStatistics;
 
     virtual auto AddOrUpdate(Address address) const noexcept -> bool = 0;
     virtual auto Get(
@@ -445,6 +594,11 @@ struct PeerDatabase {
         const std::set<Type> onNetworks,
         const std::set<Service> withServices) const noexcept -> Address = 0;
     virtual auto Import(std::vector<Address> peers) const noexcept -> bool = 0;
+    virtual auto LoadStatistics(const Identifier& address) const noexcept
+        -> Statistics = 0;
+    virtual auto StoreStatistics(
+        const Identifier& address,
+        const Statistics& statistics) const noexcept -> bool = 0;
 
     virtual ~PeerDatabase() = default;
 };
@@ -470,6 +624,10 @@ struct PeerManager {
         StateMachine = OT_ZMQ_STATE_MACHINE_SIGNAL,
     };
 
+    // Reserve one of the high bandwidth compact block slots for the peer.
+    // Returns false if every slot is already in use.
+    virtual auto AcquireCompactHighBandwidth(const int id) const noexcept
+        -> bool = 0;
     virtual auto AddIncomingPeer(const int id, std::uintptr_t endpoint)
         const noexcept -> void = 0;
     virtual auto AddPeer(const p2p::Address& address) const noexcept
@@ -491,6 +649,8 @@ struct PeerManager {
     virtual auto RequestBlocks(
         const std::vector<ReadView>& hashes) const noexcept -> bool = 0;
     virtual auto RequestHeaders() const noexcept -> bool = 0;
+    virtual auto ReleaseCompactHighBandwidth(const int id) const noexcept
+        -> void = 0;
 
     virtual auto init() noexcept -> void = 0;
     virtual auto Shutdown() noexcept -> std::shared_future<void> = 0;
@@ -504,6 +664,8 @@ struct Network : virtual public opentxs::blockchain::Network {
         SubmitBlockHeader = OT_ZMQ_INTERNAL_SIGNAL + 0,
         SubmitBlock = OT_ZMQ_INTERNAL_SIGNAL + 2,
         Heartbeat = OT_ZMQ_INTERNAL_SIGNAL + 3,
+        SubmitHeaderSegment = OT_ZMQ_INTERNAL_SIGNAL + 4,
+        SyncRequest = OT_ZMQ_INTERNAL_SIGNAL + 5,
         StateMachine = OT_ZMQ_STATE_MACHINE_SIGNAL,
         FilterUpdate = OT_ZMQ_NEW_FILTER_SIGNAL,
         SyncData = OT_ZMQ_SYNC_DATA_SIGNAL,
@@ -516,6 +678,7 @@ struct Network : virtual public opentxs::blockchain::Network {
     virtual auto Chain() const noexcept -> Type = 0;
     // amount represents satoshis per 1000 bytes
     virtual auto FeeRate() const noexcept -> Amount = 0;
+    virtual auto GetConfig() const noexcept -> const Config& = 0;
     auto FilterOracle() const noexcept -> const client::FilterOracle& final
     {
         return FilterOracleInternal();
@@ -528,10 +691,13 @@ struct Network : virtual public opentxs::blockchain::Network {
     }
     virtual auto HeaderOracleInternal() const noexcept
         -> const internal::HeaderOracle& = 0;
+    virtual auto HeaderSegments() const noexcept
+        -> const internal::HeaderSegments& = 0;
     virtual auto Heartbeat() const noexcept -> void = 0;
     virtual auto IsSynchronized() const noexcept -> bool = 0;
     virtual auto JobReady(const PeerManager::Task type) const noexcept
         -> void = 0;
+    virtual auto Mempool() const noexcept -> const internal::Mempool& = 0;
     virtual auto Reorg() const noexcept
         -> const network::zeromq::socket::Publish& = 0;
     virtual auto RequestBlock(const block::Hash& block) const noexcept
@@ -540,6 +706,10 @@ struct Network : virtual public opentxs::blockchain::Network {
         const std::vector<ReadView>& hashes) const noexcept -> bool = 0;
     virtual auto Submit(network::zeromq::Message& work) const noexcept
         -> void = 0;
+    /// Position of the most recent sync data which has been connected to the
+    /// header chain, which may be ahead of the filter tip while the
+    /// corresponding filters are being stored
+    virtual auto SyncPosition() const noexcept -> block::Position = 0;
     virtual auto UpdateHeight(const block::Height height) const noexcept
         -> void = 0;
     virtual auto UpdateLocalHeight(
@@ -575,6 +745,8 @@ struct Wallet {
         scan = OT_ZMQ_INTERNAL_SIGNAL + 1,
         process = OT_ZMQ_INTERNAL_SIGNAL + 2,
         reorg = OT_ZMQ_INTERNAL_SIGNAL + 3,
+        scan_range = OT_ZMQ_INTERNAL_SIGNAL + 4,
+        process_range = OT_ZMQ_INTERNAL_SIGNAL + 5,
     };
 
     static auto ProcessThreadPool(const zmq::Message& task) noexcept -> void;
@@ -582,6 +754,11 @@ struct Wallet {
     virtual auto ConstructTransaction(
         const proto::BlockchainTransactionProposal& tx) const noexcept
         -> std::future<block::pTxid> = 0;
+    /// Reverts the effects of transactions which left the mempool unmined
+    virtual auto ExpireMempool(std::vector<block::pTxid>&& txids)
+        const noexcept -> void = 0;
+    virtual auto ProcessMempool(Mempool::Transaction tx) const noexcept
+        -> void = 0;
 
     virtual auto Init() noexcept -> void = 0;
     virtual auto Shutdown() noexcept -> std::shared_future<void> = 0;
@@ -617,6 +794,20 @@ struct WalletDatabase {
         const block::bitcoin::Transaction& transaction,
         const VersionNumber version = DefaultIndexVersion) const noexcept
         -> bool = 0;
+    /// Records outputs created by an unconfirmed transaction
+    ///
+    /// Outputs which are already known to be confirmed are not modified.
+    /// Relayed transactions are not verified, so the state of outputs they
+    /// spend is only changed by transactions this wallet built.
+    virtual auto AddMempoolTransaction(
+        const blockchain::Type chain,
+        const NodeID& balanceNode,
+        const Subchain subchain,
+        const FilterType type,
+        const std::vector<std::uint32_t> outputIndices,
+        const block::bitcoin::Transaction& transaction,
+        const VersionNumber version = DefaultIndexVersion) const noexcept
+        -> bool = 0;
     virtual auto AddOutgoingTransaction(
         const blockchain::Type chain,
         const Identifier& proposalID,
@@ -660,6 +851,10 @@ struct WalletDatabase {
         -> std::set<OTIdentifier> = 0;
     virtual auto ReleaseChangeKey(const Identifier& proposal, const KeyID key)
         const noexcept -> bool = 0;
+    /// Undoes AddMempoolTransaction for a transaction which left the mempool
+    /// without being confirmed
+    virtual auto RemoveMempoolTransaction(const block::Txid& txid)
+        const noexcept -> bool = 0;
     virtual auto ReorgTo(
         const NodeID& balanceNode,
         const Subchain subchain,
@@ -49,7 +49,9 @@ struct FilterDatabase;
 struct FilterOracle;
 struct HeaderDatabase;
 struct HeaderOracle;
+struct HeaderSegments;
 struct IO;
+struct Mempool;
 struct Network;
 struct PeerDatabase;
 struct PeerManager;
@@ -71,6 +73,7 @@ auto BlockchainDatabase(
     const api::Core& api,
     const api::client::internal::Blockchain& blockchain,
     const blockchain::client::internal::Network& network,
+    const blockchain::client::internal::Config& config,
     const api::client::blockchain::database::implementation::Database& db,
     const blockchain::Type type) noexcept
     -> std::unique_ptr<blockchain::internal::Database>;
@@ -85,6 +88,14 @@ auto BlockchainFilterOracle(
     const blockchain::Type type,
     const std::string& shutdown) noexcept
     -> std::unique_ptr<blockchain::client::internal::FilterOracle>;
+auto BlockchainHeaderSegments(
+    const blockchain::client::internal::Config& config,
+    blockchain::client::internal::HeaderOracle& header) noexcept
+    -> std::unique_ptr<blockchain::client::internal::HeaderSegments>;
+auto BlockchainMempool(
+    const blockchain::client::internal::Config& config,
+    const blockchain::client::internal::Wallet& wallet) noexcept
+    -> std::unique_ptr<blockchain::client::internal::Mempool>;
 OPENTXS_EXPORT auto BlockchainNetworkBitcoin(
     const api::Core& api,
     const api::client::internal::Blockchain& blockchain,
@@ -117,6 +128,7 @@ OPENTXS_EXPORT auto BlockchainWallet(
     -> std::unique_ptr<blockchain::client::internal::Wallet>;
 auto BlockOracle(
     const api::Core& api,
+    const blockchain::client::internal::Config& config,
     const blockchain::client::internal::Network& network,
     const blockchain::client::internal::HeaderOracle& header,
     const blockchain::client::internal::BlockDatabase& db,
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "api/client/blockchain/database/Database.hpp"
 
 namespace opentxs::blockchain::database
@@ -20,6 +22,8 @@ enum Table {
     BlockHeaderDisconnected = 5,
     BlockFilterBest = 6,
     BlockFilterHeaderBest = 7,
+    BlockHeaderRecords = 8,
+    FreeHeaderRecords = 9,
 };
 
 enum class Key : std::size_t {
@@ -29,5 +33,12 @@ enum class Key : std::size_t {
     CheckpointHash = 3,
     BestFullBlock = 4,
     SyncPosition = 5,
+    PrunedBlockHeight = 6,
+    NextHeaderRecord = 7,
+    HeaderRecordHeight = 8,
 };
+
+// Version 2 stores block header work as an integer difficulty instead of a
+// truncated floating point value
+constexpr auto db_version_ = std::size_t{2};
 }  // namespace opentxs::blockchain::database
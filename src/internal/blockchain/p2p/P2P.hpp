@@ -6,11 +6,16 @@
 #pragma once
 
 #include <boost/asio.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <future>
+#include <map>
+#include <optional>
 #include <set>
 
 #include "core/StateMachine.hpp"
+#include "opentxs/Bytes.hpp"
 #include "opentxs/blockchain/Blockchain.hpp"
 #include "opentxs/blockchain/p2p/Address.hpp"
 #include "opentxs/blockchain/p2p/Peer.hpp"
@@ -22,6 +27,75 @@ using tcp = ip::tcp;
 
 namespace opentxs::blockchain::p2p::internal
 {
+/// Connection history of an address, persisted in the peer database
+struct PeerStatistics {
+    static constexpr auto version_ = std::uint32_t{1};
+
+    /// Parses a record written by Serialize
+    ///
+    /// Returns nullopt if the record has an unknown version or size.
+    static auto Deserialize(const ReadView in) noexcept
+        -> std::optional<PeerStatistics>;
+
+    // Moving average of the bytes per second received while downloading
+    std::uint64_t bytes_per_second_{};
+    // Duration of the most recent outgoing handshake in milliseconds
+    std::uint32_t handshake_ms_{};
+    // Number of connections which completed the handshake
+    std::uint32_t connections_{};
+    // Number of connections which failed before completing the handshake
+    std::uint32_t failures_{};
+    // Number of download jobs or connections which timed out
+    std::uint32_t timeouts_{};
+
+    /// Relative likelihood of selecting the address for a new connection
+    auto Weight() const noexcept -> double
+    {
+        // Addresses which have never been measured rank with a peer which
+        // delivered 128 KiB/s
+        constexpr auto unit = double{128u * 1024u};
+        const auto speed =
+            (0 == bytes_per_second_)
+                ? 2.0
+                : std::min(1.0 + (bytes_per_second_ / unit), 10.0);
+        const auto latency = [&] {
+            if (0 == handshake_ms_) {
+
+                return 1.0;
+            } else if (500 > handshake_ms_) {
+
+                return 1.5;
+            } else if (2000 < handshake_ms_) {
+
+                return 0.5;
+            }
+
+            return 1.0;
+        }();
+        const auto attempts =
+            double{1} + connections_ + failures_ + timeouts_;
+        const auto reliability = (double{1} + connections_) / attempts;
+
+        return speed * latency * reliability;
+    }
+    /// Encodes the statistics with a leading version number
+    auto Serialize() const noexcept -> Space;
+};
+
+/// Measured download rate in bytes per second, indexed by peer id
+using PeerRates = std::map<int, std::size_t>;
+
+/// Chooses a peer to replace when the combined download rate of the measured
+/// peers is below target
+///
+/// Peers in exempt count towards the combined rate but are never chosen.
+/// Nothing is chosen unless at least two peers have been measured, since
+/// throughput can only be compared while several peers are downloading.
+auto SlowPeer(
+    const PeerRates& rates,
+    const std::set<int>& exempt,
+    const std::size_t target) noexcept -> std::optional<int>;
+
 struct Address : virtual public p2p::Address {
     virtual auto clone_internal() const noexcept
         -> std::unique_ptr<Address> = 0;
@@ -34,6 +108,13 @@ struct Address : virtual public p2p::Address {
 
 struct Peer : virtual public p2p::Peer {
     virtual auto AddressID() const noexcept -> OTIdentifier = 0;
+    /// Statistics for the address including the current connection
+    virtual auto Statistics() const noexcept -> PeerStatistics = 0;
+    /// Bytes per second received while downloading during the current
+    /// connection
+    ///
+    /// Returns nullopt if the peer has not been downloading recently.
+    virtual auto Throughput() const noexcept -> std::optional<std::size_t> = 0;
     virtual auto Shutdown() noexcept -> std::shared_future<void> = 0;
 
     virtual ~Peer() override = default;
@@ -355,6 +355,14 @@ auto BitcoinP2PBlock(
     const blockchain::Type network,
     const Data& raw_block)
     -> blockchain::p2p::bitcoin::message::internal::Block*;
+// Frames a serialized block as an encoded block message, ready to send,
+// without parsing the block or constructing a message object. Returns nullptr
+// on error.
+OPENTXS_EXPORT auto BitcoinP2PBlockEncoded(
+    const api::Core& api,
+    const blockchain::Type network,
+    const ReadView raw_block) noexcept
+    -> std::unique_ptr<network::zeromq::Frame>;
 auto BitcoinP2PBlocktxn(
     const api::Core& api,
     std::unique_ptr<blockchain::p2p::bitcoin::Header> header,
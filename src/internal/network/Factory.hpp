@@ -5,12 +5,18 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 namespace opentxs
 {
 namespace network
 {
+namespace zeromq
+{
+class Frame;
+}  // namespace zeromq
+
 class DhtConfig;
 class OpenDHT;
 }  // namespace network
@@ -18,6 +24,20 @@ class OpenDHT;
 
 namespace opentxs::factory
 {
+using ZMQFrameCleanup = void (*)(void* data, void* hint);
+
 auto OpenDHT(const network::DhtConfig& config) noexcept
     -> std::unique_ptr<network::OpenDHT>;
+/// Wraps memory owned by the caller without copying it
+///
+/// cleanup is called with data and hint after the last message referring to
+/// the frame is released, possibly on a different thread.
+auto ZMQFrame(
+    void* data,
+    const std::size_t size,
+    ZMQFrameCleanup cleanup,
+    void* hint) noexcept -> std::unique_ptr<network::zeromq::Frame>;
+/// Returns a frame which shares the contents of the input without copying
+auto ZMQFrameShared(network::zeromq::Frame& frame) noexcept
+    -> std::unique_ptr<network::zeromq::Frame>;
 }  // namespace opentxs::factory
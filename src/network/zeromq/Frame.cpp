@@ -40,6 +40,30 @@ auto Factory::ZMQFrame(const ProtobufType& data) -> network::zeromq::Frame*
 }
 }  // namespace opentxs
 
+namespace opentxs::factory
+{
+auto ZMQFrame(
+    void* data,
+    const std::size_t size,
+    ZMQFrameCleanup cleanup,
+    void* hint) noexcept -> std::unique_ptr<network::zeromq::Frame>
+{
+    using ReturnType = network::zeromq::implementation::Frame;
+
+    return std::unique_ptr<ReturnType>{
+        new ReturnType(data, size, cleanup, hint)};
+}
+
+auto ZMQFrameShared(network::zeromq::Frame& frame) noexcept
+    -> std::unique_ptr<network::zeromq::Frame>
+{
+    using ReturnType = network::zeromq::implementation::Frame;
+
+    return std::unique_ptr<ReturnType>{
+        new ReturnType(static_cast<zmq_msg_t*>(frame))};
+}
+}  // namespace opentxs::factory
+
 namespace opentxs::network::zeromq::implementation
 {
 Frame::Frame() noexcept
@@ -71,6 +95,31 @@ Frame::Frame(const void* data, const std::size_t bytes) noexcept
     std::memcpy(zmq_msg_data(&message_), data, zmq_msg_size(&message_));
 }
 
+Frame::Frame(
+    void* data,
+    const std::size_t bytes,
+    factory::ZMQFrameCleanup cleanup,
+    void* hint) noexcept
+    : zeromq::Frame()
+    , message_()
+{
+    const auto init = zmq_msg_init_data(&message_, data, bytes, cleanup, hint);
+
+    OT_ASSERT(0 == init);
+}
+
+Frame::Frame(zmq_msg_t* shared) noexcept
+    : Frame()
+{
+    OT_ASSERT(nullptr != shared);
+
+    // Messages which hold more than a few bytes are reference counted, so
+    // the copy only shares the existing buffer
+    const auto copy = zmq_msg_copy(&message_, shared);
+
+    OT_ASSERT(0 == copy);
+}
+
 Frame::operator std::string() const noexcept { return std::string{Bytes()}; }
 
 auto Frame::Bytes() const noexcept -> ReadView
@@ -9,9 +9,12 @@
 #pragma once
 
 #include <zmq.h>
+#include <cstddef>
 #include <iosfwd>
+#include <memory>
 #include <string>
 
+#include "internal/network/Factory.hpp"
 #include "opentxs/Bytes.hpp"
 #include "opentxs/Proto.hpp"
 #include "opentxs/network/zeromq/Frame.hpp"
@@ -45,6 +48,13 @@ public:
 private:
     friend opentxs::Factory;
     friend network::zeromq::Frame;
+    friend auto factory::ZMQFrame(
+        void* data,
+        const std::size_t size,
+        factory::ZMQFrameCleanup cleanup,
+        void* hint) noexcept -> std::unique_ptr<network::zeromq::Frame>;
+    friend auto factory::ZMQFrameShared(network::zeromq::Frame& frame) noexcept
+        -> std::unique_ptr<network::zeromq::Frame>;
 
     mutable zmq_msg_t message_;
 
@@ -54,6 +64,12 @@ private:
     explicit Frame(const ProtobufType& input) noexcept;
     explicit Frame(const std::size_t bytes) noexcept;
     Frame(const void* data, const std::size_t bytes) noexcept;
+    Frame(
+        void* data,
+        const std::size_t bytes,
+        factory::ZMQFrameCleanup cleanup,
+        void* hint) noexcept;
+    explicit Frame(zmq_msg_t* shared) noexcept;
     Frame(const Frame&) = delete;
     Frame(Frame&&) = delete;
     auto operator=(Frame&&) -> Frame& = delete;
@@ -0,0 +1,102 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "opentxs/Types.hpp"
+#include "opentxs/core/Log.hpp"
+
+namespace opentxs
+{
+/// First in, first out queue which blocks producers while it is full
+///
+/// Used to connect the stages of a pipeline so that a slow stage applies
+/// backpressure to the stages ahead of it instead of accumulating an
+/// unbounded amount of work. Closing the queue wakes every waiting thread and
+/// discards any items which have not been consumed.
+template <typename Item>
+class BoundedQueue
+{
+public:
+    auto Close() noexcept -> void
+    {
+        {
+            auto lock = Lock{lock_};
+            closed_ = true;
+            items_.clear();
+        }
+
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+    /// Blocks until an item is available or the queue is closed
+    auto Pop() noexcept -> std::optional<Item>
+    {
+        auto lock = Lock{lock_};
+        not_empty_.wait(
+            lock, [this] { return closed_ || (0 < items_.size()); });
+
+        if (closed_) { return std::nullopt; }
+
+        auto output = std::optional<Item>{std::move(items_.front())};
+        items_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+
+        return output;
+    }
+    /// Blocks while the queue is full
+    ///
+    /// Returns false if the queue was closed before the item was accepted
+    auto Push(Item&& item) noexcept -> bool
+    {
+        auto lock = Lock{lock_};
+        not_full_.wait(
+            lock, [this] { return closed_ || (items_.size() < limit_); });
+
+        if (closed_) { return false; }
+
+        items_.emplace_back(std::move(item));
+        lock.unlock();
+        not_empty_.notify_one();
+
+        return true;
+    }
+
+    BoundedQueue(const std::size_t limit) noexcept
+        : limit_(limit)
+        , lock_()
+        , not_empty_()
+        , not_full_()
+        , items_()
+        , closed_(false)
+    {
+        OT_ASSERT(0 < limit_);
+    }
+
+    ~BoundedQueue() { Close(); }
+
+private:
+    const std::size_t limit_;
+    mutable std::mutex lock_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<Item> items_;
+    bool closed_;
+
+    BoundedQueue() = delete;
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue(BoundedQueue&&) = delete;
+    auto operator=(const BoundedQueue&) -> BoundedQueue& = delete;
+    auto operator=(BoundedQueue&&) -> BoundedQueue& = delete;
+};
+}  // namespace opentxs
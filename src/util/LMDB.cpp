@@ -443,7 +443,8 @@ auto LMDB::Load(
     const Table table,
     const ReadView index,
     const Callback cb,
-    const Mode multiple) const noexcept -> bool
+    const Mode multiple,
+    MDB_txn* parent) const noexcept -> bool
 {
     struct Cleanup {
         bool success_;
@@ -473,19 +474,23 @@ auto LMDB::Load(
         MDB_cursor*& cursor_;
     };
 
-    MDB_txn* transaction{nullptr};
+    // A transaction supplied by the caller is left open
+    MDB_txn* owned{nullptr};
 
-    if (0 != ::mdb_txn_begin(env_, nullptr, MDB_RDONLY, &transaction)) {
-        LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to start transaction")
-            .Flush();
+    if (nullptr == parent) {
+        if (0 != ::mdb_txn_begin(env_, nullptr, MDB_RDONLY, &owned)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Failed to start transaction")
+                .Flush();
 
-        return false;
-    }
+            return false;
+        }
 
-    OT_ASSERT(nullptr != transaction);
+        OT_ASSERT(nullptr != owned);
+    }
 
+    MDB_txn* transaction = (nullptr == parent) ? owned : parent;
     MDB_cursor* cursor{nullptr};
-    Cleanup cleanup(transaction, cursor);
+    Cleanup cleanup(owned, cursor);
     const auto database = db_.at(table);
 
     if (0 != ::mdb_cursor_open(transaction, database, &cursor)) {
@@ -528,13 +533,15 @@ auto LMDB::Load(
     const Table table,
     const std::size_t index,
     const Callback cb,
-    const Mode mode) const noexcept -> bool
+    const Mode mode,
+    MDB_txn* parent) const noexcept -> bool
 {
     return Load(
         table,
         ReadView{reinterpret_cast<const char*>(&index), sizeof(index)},
         cb,
-        mode);
+        mode,
+        parent);
 }
 
 auto LMDB::Queue(
@@ -97,12 +97,14 @@ public:
         const Table table,
         const ReadView key,
         const Callback cb,
-        const Mode mode = Mode::One) const noexcept -> bool;
+        const Mode mode = Mode::One,
+        MDB_txn* parent = nullptr) const noexcept -> bool;
     auto Load(
         const Table table,
         const std::size_t key,
         const Callback cb,
-        const Mode mode = Mode::One) const noexcept -> bool;
+        const Mode mode = Mode::One,
+        MDB_txn* parent = nullptr) const noexcept -> bool;
     auto Queue(
         const Table table,
         const ReadView key,
@@ -0,0 +1,168 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+#include "opentxs/Types.hpp"
+
+namespace opentxs
+{
+/// Thread safe least recently used cache bounded by the total size in bytes
+/// reported for each value rather than by the number of items.
+///
+/// Values are returned by copy so Value should be cheap to copy, usually a
+/// std::shared_ptr to an immutable object.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class LRU
+{
+public:
+    struct Statistics {
+        std::uint64_t hits_{};
+        std::uint64_t misses_{};
+        std::uint64_t evictions_{};
+        std::size_t items_{};
+        std::size_t bytes_{};
+        std::size_t capacity_{};
+    };
+
+    auto Capacity() const noexcept -> std::size_t
+    {
+        auto lock = Lock{lock_};
+
+        return capacity_;
+    }
+    auto Find(const Key& key) const noexcept -> std::optional<Value>
+    {
+        auto lock = Lock{lock_};
+        const auto i = index_.find(key);
+
+        if (index_.end() == i) {
+            ++misses_;
+
+            return std::nullopt;
+        }
+
+        ++hits_;
+        list_.splice(list_.begin(), list_, i->second);
+
+        return std::get<1>(*i->second);
+    }
+    auto Stats() const noexcept -> Statistics
+    {
+        auto lock = Lock{lock_};
+        auto output = Statistics{};
+        output.hits_ = hits_;
+        output.misses_ = misses_;
+        output.evictions_ = evictions_;
+        output.items_ = list_.size();
+        output.bytes_ = bytes_;
+        output.capacity_ = capacity_;
+
+        return output;
+    }
+
+    auto Clear() noexcept -> void
+    {
+        auto lock = Lock{lock_};
+        index_.clear();
+        list_.clear();
+        bytes_ = 0;
+    }
+    auto Erase(const Key& key) noexcept -> bool
+    {
+        auto lock = Lock{lock_};
+        const auto i = index_.find(key);
+
+        if (index_.end() == i) { return false; }
+
+        bytes_ -= std::get<2>(*i->second);
+        list_.erase(i->second);
+        index_.erase(i);
+
+        return true;
+    }
+    /// Items larger than the entire capacity are not cached
+    auto Insert(const Key& key, Value value, const std::size_t bytes) noexcept
+        -> bool
+    {
+        auto lock = Lock{lock_};
+
+        if (bytes > capacity_) { return false; }
+
+        if (auto i = index_.find(key); index_.end() != i) {
+            bytes_ -= std::get<2>(*i->second);
+            list_.erase(i->second);
+            index_.erase(i);
+        }
+
+        list_.emplace_front(key, std::move(value), bytes);
+        index_.emplace(key, list_.begin());
+        bytes_ += bytes;
+        trim(lock);
+
+        return true;
+    }
+    auto SetCapacity(const std::size_t bytes) noexcept -> void
+    {
+        auto lock = Lock{lock_};
+        capacity_ = bytes;
+        trim(lock);
+    }
+
+    LRU(const std::size_t capacity) noexcept
+        : lock_()
+        , capacity_(capacity)
+        , bytes_(0)
+        , list_()
+        , index_()
+        , hits_(0)
+        , misses_(0)
+        , evictions_(0)
+    {
+    }
+
+    ~LRU() = default;
+
+private:
+    using List = std::list<std::tuple<Key, Value, std::size_t>>;
+    using Index = std::map<Key, typename List::iterator, Compare>;
+
+    mutable std::mutex lock_;
+    std::size_t capacity_;
+    std::size_t bytes_;
+    mutable List list_;
+    Index index_;
+    mutable std::uint64_t hits_;
+    mutable std::uint64_t misses_;
+    std::uint64_t evictions_;
+
+    auto trim(const Lock&) noexcept -> void
+    {
+        while ((bytes_ > capacity_) && (0 < list_.size())) {
+            const auto& [key, value, bytes] = list_.back();
+            bytes_ -= bytes;
+            index_.erase(key);
+            list_.pop_back();
+            ++evictions_;
+        }
+    }
+
+    LRU() = delete;
+    LRU(const LRU&) = delete;
+    LRU(LRU&&) = delete;
+    auto operator=(const LRU&) -> LRU& = delete;
+    auto operator=(LRU&&) -> LRU& = delete;
+};
+}  // namespace opentxs
@@ -7,11 +7,21 @@
 #include "1_Internal.hpp"              // IWYU pragma: associated
 #include "util/MappedFileStorage.hpp"  // IWYU pragma: associated
 
+#ifndef _WIN32
+extern "C" {
+#include <sys/mman.h>
+}
+#endif
+
 #include <boost/filesystem.hpp>
 #include <boost/iostreams/device/mapped_file.hpp>
 #include <algorithm>
 #include <cstring>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <optional>
+#include <set>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -62,15 +72,86 @@ constexpr auto get_start_position(const std::size_t file) noexcept
 
 struct MappedFileStorage::Imp {
     using FileCounter = std::size_t;
+    using FreeSpace = std::map<MemoryPosition, ItemSize>;
+    using FreeSizes = std::set<std::pair<ItemSize, MemoryPosition>>;
 
     LMDB& lmdb_;
     const std::string path_prefix_;
     const std::string filename_prefix_;
     const int table_;
     const std::size_t key_;
+    const int free_table_;
     mutable MemoryPosition next_position_;
     mutable std::vector<boost::iostreams::mapped_file> files_;
+    // Regions which may be allocated immediately, indexed by position so
+    // adjacent regions can be merged and by size so allocations can choose
+    // the smallest region which fits. Regions abandoned by get_write_view are
+    // only recorded in the free space table and join this map when the
+    // storage is reopened.
+    mutable FreeSpace free_;
+    mutable FreeSizes sizes_;
+
+    // Adjacent regions are merged unless the result would span two files
+    static auto add_region(
+        const MemoryPosition position,
+        const ItemSize size,
+        FreeSpace& map) noexcept -> void
+    {
+        if (0 == size) { return; }
+
+        auto [it, added] = map.emplace(position, size);
+
+        if (false == added) { it->second = std::max(it->second, size); }
+
+        if (auto next = std::next(it); map.end() != next) {
+            if (mergeable(*it, *next)) {
+                it->second += next->second;
+                map.erase(next);
+            }
+        }
+
+        if (map.begin() != it) {
+            auto prior = std::prev(it);
+
+            if (mergeable(*prior, *it)) {
+                prior->second += it->second;
+                map.erase(it);
+            }
+        }
+    }
+    static auto mergeable(
+        const FreeSpace::value_type& lhs,
+        const FreeSpace::value_type& rhs) noexcept -> bool
+    {
+        return ((lhs.first + lhs.second) == rhs.first) &&
+               (get_offset(lhs.first).first ==
+                get_offset(rhs.first + (rhs.second - 1u)).first);
+    }
+
+    auto apply(Pending& pending) noexcept -> void
+    {
+        for (const auto& [position, used] : pending.claimed_) {
+            const auto size = remove_free(position);
+
+            OT_ASSERT(used <= size);
+
+            if (used < size) { insert_free(position + used, size - used); }
+        }
 
+        for (const auto position : pending.absorbed_) {
+            remove_free(position);
+        }
+
+        for (const auto& [position, size] : pending.released_) {
+            insert_free(position, size);
+        }
+
+        if (pending.next_position_.has_value()) {
+            next_position_ = pending.next_position_.value();
+        }
+
+        pending = Pending{};
+    }
     auto calculate_file_name(
         const std::string& prefix,
         const FileCounter index) noexcept -> std::string
@@ -91,6 +172,30 @@ struct MappedFileStorage::Imp {
             create_or_load(path_prefix_, files_.size(), files_);
         }
     }
+    // Records the allocation of an item at the start of a free region
+    auto claim_free(LMDB::Transaction& tx, const IndexData& index) noexcept
+        -> bool
+    {
+        const auto it = free_.find(index.position_);
+
+        OT_ASSERT(free_.end() != it);
+        OT_ASSERT(index.size_ <= it->second);
+
+        if (false == lmdb_.Delete(free_table_, index.position_, tx)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to remove free space record")
+                .Flush();
+
+            return false;
+        }
+
+        const auto remaining = it->second - index.size_;
+
+        if (0 == remaining) { return true; }
+
+        return store_region(
+            tx, IndexData{index.position_ + index.size_, remaining});
+    }
     auto create_or_load(
         const std::string& prefix,
         const FileCounter file,
@@ -134,6 +239,21 @@ struct MappedFileStorage::Imp {
             OT_FAIL;
         }
     }
+    // Returns the smallest free region which can hold the specified number of
+    // bytes and which has not already been allocated from in this transaction
+    auto find_free(const std::size_t bytes, const Pending& pending)
+        const noexcept -> std::optional<MemoryPosition>
+    {
+        const auto start = sizes_.lower_bound({bytes, MemoryPosition{0}});
+
+        for (auto it = start; sizes_.end() != it; ++it) {
+            const auto& position = it->second;
+
+            if (0 == pending.claimed_.count(position)) { return position; }
+        }
+
+        return std::nullopt;
+    }
     auto get_read_view(const IndexData& index) noexcept -> ReadView
     {
         const auto [file, offset] = get_offset(index.position_);
@@ -147,7 +267,8 @@ struct MappedFileStorage::Imp {
         std::size_t bytes) noexcept -> WritableView
     {
         auto tx = lmdb_.TransactionRW();
-        auto output = get_write_view(tx, index, std::move(cb), bytes);
+        auto pending = Pending{};
+        auto output = get_write_view(tx, index, std::move(cb), bytes, pending);
 
         if ((nullptr == output.data()) || (0u == output.size())) {
             tx.Finalize(false);
@@ -155,7 +276,11 @@ struct MappedFileStorage::Imp {
             return {};
         }
 
-        if (tx.Finalize(true)) { return output; }
+        if (tx.Finalize(true)) {
+            apply(pending);
+
+            return output;
+        }
 
         LogOutput(OT_METHOD)(__FUNCTION__)(": Database update error").Flush();
 
@@ -165,7 +290,8 @@ struct MappedFileStorage::Imp {
         LMDB::Transaction& tx,
         IndexData& index,
         UpdateCallback&& cb,
-        std::size_t bytes) noexcept -> WritableView
+        std::size_t bytes,
+        Pending& pending) noexcept -> WritableView
     {
         if (0 == bytes) { return {}; }
 
@@ -184,7 +310,17 @@ struct MappedFileStorage::Imp {
             return output();
         }
 
-        increment_index(index, bytes);
+        const auto previous = index;
+        const auto region = find_free(bytes, pending);
+
+        if (region.has_value()) {
+            index.size_ = bytes;
+            index.position_ = region.value();
+        } else {
+            increment_index(
+                index, bytes, pending.next_position_.value_or(next_position_));
+        }
+
         LogDebug(OT_METHOD)(__FUNCTION__)(": Storing new item at position ")(
             index.position_)
             .Flush();
@@ -192,20 +328,35 @@ struct MappedFileStorage::Imp {
 
         if (cb && (false == cb(tx))) { return {}; }
 
-        if (false == update_next_position(nextPosition, tx)) {
+        if (region.has_value()) {
+            if (false == claim_free(tx, index)) { return {}; }
+
+            pending.claimed_.emplace(index.position_, bytes);
+        } else if (false == update_next_position(nextPosition, tx)) {
             LogOutput(OT_METHOD)(__FUNCTION__)(
                 ": Failed to update next write position")
                 .Flush();
 
+            return {};
+        } else {
+            pending.next_position_ = nextPosition;
+        }
+
+        // The previous location may still be visible through a view returned
+        // by get_read_view so it is only recorded in the free space table
+        if ((0 < previous.size_) && (false == store_region(tx, previous))) {
             return {};
         }
 
         return output();
     }
-    auto increment_index(IndexData& index, std::size_t bytes) noexcept -> void
+    auto increment_index(
+        IndexData& index,
+        const std::size_t bytes,
+        const MemoryPosition next) noexcept -> void
     {
         index.size_ = bytes;
-        index.position_ = next_position_;
+        index.position_ = next;
 
         {
             // NOTE This check prevents writing past end of file
@@ -235,6 +386,16 @@ struct MappedFileStorage::Imp {
 
         return output;
     }
+    auto insert_free(
+        const MemoryPosition position,
+        const ItemSize size) noexcept -> void
+    {
+        const auto added = free_.emplace(position, size).second;
+
+        OT_ASSERT(added);
+
+        sizes_.emplace(size, position);
+    }
     auto load_position(opentxs::storage::lmdb::LMDB& db) noexcept
         -> MemoryPosition
     {
@@ -256,6 +417,185 @@ struct MappedFileStorage::Imp {
 
         return output;
     }
+    // Regions abandoned during the previous session are stored separately
+    // from any free space next to them. Once they are merged the table is
+    // rewritten so it contains exactly one record per free region.
+    auto load_free_space() noexcept -> void
+    {
+        auto records = std::size_t{0};
+        auto cb = [&](const auto key, const auto value) {
+            auto region = IndexData{};
+
+            if ((sizeof(region.position_) != key.size()) ||
+                (sizeof(region.size_) != value.size())) {
+                return true;
+            }
+
+            std::memcpy(&region.position_, key.data(), key.size());
+            std::memcpy(&region.size_, value.data(), value.size());
+            add_region(region.position_, region.size_, free_);
+            ++records;
+
+            return true;
+        };
+        lmdb_.Read(free_table_, cb, LMDB::Dir::Forward);
+
+        if (records != free_.size()) {
+            auto tx = lmdb_.TransactionRW();
+            auto success = lmdb_.Delete(free_table_, tx);
+
+            for (const auto& [position, size] : free_) {
+                if (false == success) { break; }
+
+                success = store_region(tx, IndexData{position, size});
+            }
+
+            if ((false == success) || (false == tx.Finalize(true))) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Failed to merge free space records")
+                    .Flush();
+                // Allocating from a merged region would leave stale records
+                // for the part of it which was stored separately
+                free_.clear();
+            }
+        }
+
+        for (const auto& [position, size] : free_) {
+            sizes_.emplace(size, position);
+        }
+    }
+    // Returns the whole pages contained in the region to the filesystem
+    auto punch(const IndexData& index) noexcept -> void
+    {
+#ifdef MADV_REMOVE
+        const auto page = static_cast<std::size_t>(
+            boost::iostreams::mapped_file::alignment());
+        const auto [file, offset] = get_offset(index.position_);
+        const auto start = ((offset + page - 1u) / page) * page;
+        const auto end = ((offset + index.size_) / page) * page;
+
+        if (end <= start) { return; }
+
+        check_file(file);
+
+        auto* data = files_.at(file).data() + start;
+
+        if (0 != ::madvise(data, end - start, MADV_REMOVE)) {
+            LogVerbose(OT_METHOD)(__FUNCTION__)(
+                ": Filesystem does not support releasing space")
+                .Flush();
+        }
+#endif  // MADV_REMOVE
+    }
+    auto release(
+        const std::vector<IndexData>& items,
+        UpdateCallback&& cb) noexcept -> bool
+    {
+        auto tx = lmdb_.TransactionRW();
+        auto pending = Pending{};
+
+        if (cb && (false == cb(tx))) {
+            tx.Finalize(false);
+
+            return false;
+        }
+
+        if (false == release(tx, items, pending)) {
+            tx.Finalize(false);
+
+            return false;
+        }
+
+        if (false == tx.Finalize(true)) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(": Database update error")
+                .Flush();
+
+            return false;
+        }
+
+        apply(pending);
+
+        for (const auto& item : items) { punch(item); }
+
+        return true;
+    }
+    // Only the free regions next to the released items are rewritten
+    auto release(
+        LMDB::Transaction& tx,
+        const std::vector<IndexData>& items,
+        Pending& pending) noexcept -> bool
+    {
+        auto& released = pending.released_;
+
+        for (const auto& [position, size] : items) {
+            add_region(position, size, released);
+        }
+
+        auto neighbors = FreeSpace{};
+
+        for (const auto& region : released) {
+            const auto& [position, size] = region;
+
+            if (auto next = free_.find(position + size); free_.end() != next) {
+                if (mergeable(region, *next)) { neighbors.emplace(*next); }
+            }
+
+            if (auto it = free_.lower_bound(position); free_.begin() != it) {
+                const auto prior = std::prev(it);
+
+                if (mergeable(*prior, region)) { neighbors.emplace(*prior); }
+            }
+        }
+
+        for (const auto& [position, size] : neighbors) {
+            if (false == lmdb_.Delete(free_table_, position, tx)) {
+                LogOutput(OT_METHOD)(__FUNCTION__)(
+                    ": Failed to remove free space record")
+                    .Flush();
+
+                return false;
+            }
+
+            pending.absorbed_.emplace_back(position);
+            add_region(position, size, released);
+        }
+
+        for (const auto& [position, size] : released) {
+            if (false == store_region(tx, IndexData{position, size})) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+    auto remove_free(const MemoryPosition position) noexcept -> ItemSize
+    {
+        const auto it = free_.find(position);
+
+        OT_ASSERT(free_.end() != it);
+
+        const auto size = it->second;
+        sizes_.erase(FreeSizes::value_type{size, position});
+        free_.erase(it);
+
+        return size;
+    }
+    auto store_region(LMDB::Transaction& tx, const IndexData& region) noexcept
+        -> bool
+    {
+        const auto result = lmdb_.Store(
+            free_table_, region.position_, tsv(region.size_), tx);
+
+        if (false == result.first) {
+            LogOutput(OT_METHOD)(__FUNCTION__)(
+                ": Failed to update free space table")
+                .Flush();
+
+            return false;
+        }
+
+        return true;
+    }
     auto update_next_position(
         MemoryPosition position,
         LMDB::Transaction& tx) noexcept -> bool
@@ -270,8 +610,6 @@ struct MappedFileStorage::Imp {
             return {};
         }
 
-        next_position_ = position;
-
         return true;
     }
 
@@ -279,14 +617,18 @@ struct MappedFileStorage::Imp {
         const std::string& basePath,
         const std::string filenamePrefix,
         int table,
-        std::size_t key) noexcept(false)
+        std::size_t key,
+        int freeTable) noexcept(false)
         : lmdb_(lmdb)
         , path_prefix_(basePath)
         , filename_prefix_(filenamePrefix)
         , table_(table)
         , key_(key)
+        , free_table_(freeTable)
         , next_position_(load_position(lmdb_))
         , files_(init_files(path_prefix_, next_position_))
+        , free_()
+        , sizes_()
     {
         static_assert(1 == get_file_count(0));
         static_assert(1 == get_file_count(1));
@@ -312,6 +654,15 @@ struct MappedFileStorage::Imp {
 
             OT_ASSERT(files_.size() == (offset.first + 1));
         }
+
+        load_free_space();
+
+        // Nothing can refer to free space before the storage is opened, so
+        // this is the first opportunity to return regions abandoned during the
+        // previous session to the filesystem
+        for (const auto& [position, size] : free_) {
+            punch(IndexData{position, size});
+        }
     }
 };
 
@@ -320,14 +671,26 @@ MappedFileStorage::MappedFileStorage(
     const std::string& basePath,
     const std::string filenamePrefix,
     int table,
-    std::size_t key) noexcept(false)
+    std::size_t key,
+    int freeSpaceTable) noexcept(false)
     : lmdb_(lmdb)
-    , imp_p_(std::make_unique<Imp>(lmdb, basePath, filenamePrefix, table, key))
+    , imp_p_(std::make_unique<Imp>(
+          lmdb,
+          basePath,
+          filenamePrefix,
+          table,
+          key,
+          freeSpaceTable))
     , imp_(*imp_p_)
 {
     OT_ASSERT(imp_p_);
 }
 
+auto MappedFileStorage::apply(Pending& pending) const noexcept -> void
+{
+    imp_.apply(pending);
+}
+
 auto MappedFileStorage::get_read_view(const IndexData& index) const noexcept
     -> ReadView
 {
@@ -345,9 +708,17 @@ auto MappedFileStorage::get_write_view(
 auto MappedFileStorage::get_write_view(
     LMDB::Transaction& tx,
     IndexData& index,
-    std::size_t size) const noexcept -> WritableView
+    std::size_t size,
+    Pending& pending) const noexcept -> WritableView
+{
+    return imp_.get_write_view(tx, index, {}, size, pending);
+}
+
+auto MappedFileStorage::release(
+    const std::vector<IndexData>& items,
+    UpdateCallback&& cb) const noexcept -> bool
 {
-    return imp_.get_write_view(tx, index, {}, size);
+    return imp_.release(items, std::move(cb));
 }
 
 MappedFileStorage::~MappedFileStorage() = default;
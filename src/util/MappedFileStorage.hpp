@@ -7,8 +7,11 @@
 
 #include <cstddef>
 #include <functional>
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "opentxs/Bytes.hpp"
 #include "opentxs/Version.hpp"
@@ -18,6 +21,10 @@
 namespace opentxs::util
 {
 // Stores items in a memory mapped, sparse backing file.
+//
+// Space which is no longer occupied by an item is tracked in a persistent free
+// space table, one record per region, and used for subsequent writes before
+// the file is extended.
 class MappedFileStorage
 {
 protected:
@@ -31,17 +38,33 @@ protected:
         ItemSize size_{};
     };
 
+    // Changes to the in-memory free space map and write position which have
+    // been recorded in a transaction. They must not be applied until that
+    // transaction has been committed.
+    struct Pending {
+        // Free regions which were allocated from, and the number of bytes
+        // taken from the start of each one
+        std::map<MemoryPosition, ItemSize> claimed_{};
+        // Free regions which were merged into a released region
+        std::vector<MemoryPosition> absorbed_{};
+        std::map<MemoryPosition, ItemSize> released_{};
+        std::optional<MemoryPosition> next_position_{};
+    };
+
     LMDB& lmdb_;
 
     // NOTE: this class performs no locking. Inheritors must ensure these
     // functions are not called simultaneously from multiple threads.
+    auto apply(Pending& pending) const noexcept -> void;
     auto get_read_view(const IndexData& index) const noexcept -> ReadView;
     // Default construct an IndexData if you just want to append a new item, or
     // supply an existing IndexData if you want to (potentially) replace the
     // existing item. An existing item will be overwritten if the size of the
     // old items matches the size of the new item; to do otherwise would be
-    // madness. If the size doesn't match then space will be allocated at the
-    // end of the file and we just forget about the old data.
+    // madness. If the size doesn't match then space will be allocated from the
+    // free space map or at the end of the file. The old space is recorded in
+    // the free space table but is not reused until the storage is reopened
+    // since views returned by get_read_view may still refer to it.
     //
     // Regardless after this function is called the supplied index will be
     // updated to the location at which the return value points so you should
@@ -52,17 +75,31 @@ protected:
         IndexData& index,
         UpdateCallback&& cb,  // will be called if index is changed
         std::size_t size) const noexcept -> WritableView;
+    // Allocates space as part of the caller's transaction. Changes to the
+    // in-memory state are added to pending, which must be passed to apply()
+    // after the transaction has been committed and discarded otherwise. Use
+    // the same Pending for every call made in one transaction.
     auto get_write_view(
         LMDB::Transaction& tx,
         IndexData& index,
-        std::size_t size) const noexcept -> WritableView;
+        std::size_t size,
+        Pending& pending) const noexcept -> WritableView;
+    // Adds the space occupied by the supplied items to the free space map and
+    // returns the underlying pages to the filesystem. The callback is executed
+    // in the same transaction and should remove the items from the index.
+    //
+    // The caller must ensure nothing refers to the items when this function is
+    // called since the space may be reused immediately.
+    auto release(const std::vector<IndexData>& items, UpdateCallback&& cb)
+        const noexcept -> bool;
 
     MappedFileStorage(
         opentxs::storage::lmdb::LMDB& lmdb,
         const std::string& basePath,
         const std::string filenamePrefix,
         int table,
-        std::size_t key) noexcept(false);
+        std::size_t key,
+        int freeSpaceTable) noexcept(false);
 
     virtual ~MappedFileStorage();
 
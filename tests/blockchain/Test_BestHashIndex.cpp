@@ -0,0 +1,201 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+
+#include "blockchain/client/HeaderOracle.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/core/Data.hpp"
+
+namespace b = ot::blockchain;
+
+namespace
+{
+using Index = b::client::implementation::HeaderOracle::BestHashIndex;
+using Height = b::block::Height;
+
+// Spans several storage chunks
+constexpr auto tip_{Height{4999}};
+constexpr auto fork_{Height{2500}};
+
+// Each chain which replaces part of the original chain uses a different
+// value of chain for its hashes
+auto hash(const Height height, const std::uint32_t chain = 0) noexcept
+    -> b::block::pHash
+{
+    return ot::Data::Factory(
+        (std::uint64_t{chain} << 32u) | static_cast<std::uint32_t>(height));
+}
+
+auto fill(
+    Index& index,
+    const Height first,
+    const Height last,
+    const std::uint32_t chain) noexcept -> bool
+{
+    for (auto i{first}; i <= last; ++i) {
+        if (false == index.Push({i, hash(i, chain)})) { return false; }
+    }
+
+    return true;
+}
+
+auto verify(
+    const Index& index,
+    const Height first,
+    const Height last,
+    const std::uint32_t chain) noexcept -> bool
+{
+    for (auto i{first}; i <= last; ++i) {
+        const auto* value = index.at(i);
+
+        if ((nullptr == value) || (false == (*value == hash(i, chain)))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+TEST(Test_BestHashIndex, empty)
+{
+    const auto index = Index{};
+    const auto tip = index.Tip();
+
+    EXPECT_EQ(tip.first, -1);
+    EXPECT_TRUE(tip.second->empty());
+    EXPECT_EQ(index.at(0), nullptr);
+    EXPECT_EQ(index.at(-1), nullptr);
+}
+
+TEST(Test_BestHashIndex, push)
+{
+    auto index = Index{};
+
+    ASSERT_TRUE(fill(index, 0, tip_, 0));
+    EXPECT_TRUE(verify(index, 0, tip_, 0));
+    EXPECT_EQ(index.Tip().first, tip_);
+    EXPECT_EQ(index.Tip().second, hash(tip_));
+    EXPECT_EQ(index.at(tip_ + 1), nullptr);
+    EXPECT_FALSE(index.Push({tip_ + 2, hash(tip_ + 2)}));
+    EXPECT_FALSE(index.Push({-1, hash(-1)}));
+    EXPECT_EQ(index.Tip().first, tip_);
+}
+
+TEST(Test_BestHashIndex, pop)
+{
+    auto index = Index{};
+
+    ASSERT_TRUE(fill(index, 0, tip_, 0));
+
+    index.Pop(tip_ + 1);
+
+    EXPECT_EQ(index.Tip().first, tip_);
+
+    index.Pop(fork_);
+
+    EXPECT_EQ(index.Tip().first, fork_);
+    EXPECT_TRUE(verify(index, 0, fork_, 0));
+    EXPECT_EQ(index.at(fork_ + 1), nullptr);
+
+    index.Pop(-1);
+
+    EXPECT_EQ(index.Tip().first, -1);
+    EXPECT_EQ(index.at(0), nullptr);
+    EXPECT_TRUE(fill(index, 0, 10, 1));
+    EXPECT_TRUE(verify(index, 0, 10, 1));
+}
+
+TEST(Test_BestHashIndex, extend_copy)
+{
+    auto original = Index{};
+
+    ASSERT_TRUE(fill(original, 0, fork_, 0));
+
+    auto copy = Index{original};
+
+    ASSERT_TRUE(fill(copy, fork_ + 1, tip_, 0));
+
+    EXPECT_EQ(original.Tip().first, fork_);
+    EXPECT_EQ(original.at(fork_ + 1), nullptr);
+    EXPECT_TRUE(verify(original, 0, fork_, 0));
+    EXPECT_EQ(copy.Tip().first, tip_);
+    EXPECT_TRUE(verify(copy, 0, tip_, 0));
+    // Chunks below the last chunk of the original are shared
+    EXPECT_EQ(original.at(0), copy.at(0));
+}
+
+TEST(Test_BestHashIndex, reorg)
+{
+    constexpr auto replacement = Height{4200};
+    auto original = Index{};
+
+    ASSERT_TRUE(fill(original, 0, tip_, 0));
+
+    // Apply a reorg to a copy the same way HeaderOracle::apply_update does
+    auto copy = Index{original};
+    copy.Pop(fork_);
+
+    ASSERT_TRUE(fill(copy, fork_ + 1, replacement, 1));
+
+    // The published index is not affected
+    EXPECT_EQ(original.Tip().first, tip_);
+    EXPECT_TRUE(verify(original, 0, tip_, 0));
+
+    EXPECT_EQ(copy.Tip().first, replacement);
+    EXPECT_EQ(copy.Tip().second, hash(replacement, 1));
+    EXPECT_TRUE(verify(copy, 0, fork_, 0));
+    EXPECT_TRUE(verify(copy, fork_ + 1, replacement, 1));
+    EXPECT_EQ(copy.at(replacement + 1), nullptr);
+
+    // Untouched chunks are shared and modified chunks are copied
+    EXPECT_EQ(original.at(0), copy.at(0));
+    EXPECT_NE(original.at(fork_), copy.at(fork_));
+}
+
+TEST(Test_BestHashIndex, replace)
+{
+    auto original = Index{};
+
+    ASSERT_TRUE(fill(original, 0, 100, 0));
+
+    auto copy = Index{original};
+
+    ASSERT_TRUE(copy.Push({50, hash(50, 1)}));
+
+    EXPECT_EQ(copy.Tip().first, 100);
+    EXPECT_TRUE(verify(copy, 50, 50, 1));
+    EXPECT_TRUE(verify(original, 0, 100, 0));
+}
+
+TEST(Test_BestHashIndex, successive_reorgs)
+{
+    auto first = Index{};
+
+    ASSERT_TRUE(fill(first, 0, tip_, 0));
+
+    auto second = Index{first};
+    second.Pop(fork_);
+
+    ASSERT_TRUE(fill(second, fork_ + 1, tip_, 1));
+
+    auto third = Index{second};
+    third.Pop(fork_ - 1000);
+
+    ASSERT_TRUE(fill(third, fork_ - 999, tip_ + 1, 2));
+
+    EXPECT_TRUE(verify(first, 0, tip_, 0));
+    EXPECT_TRUE(verify(second, 0, fork_, 0));
+    EXPECT_TRUE(verify(second, fork_ + 1, tip_, 1));
+    EXPECT_TRUE(verify(third, 0, fork_ - 1000, 0));
+    EXPECT_TRUE(verify(third, fork_ - 999, tip_ + 1, 2));
+    EXPECT_EQ(first.Tip().first, tip_);
+    EXPECT_EQ(second.Tip().first, tip_);
+    EXPECT_EQ(third.Tip().first, tip_ + 1);
+}
+}  // namespace
@@ -8,11 +8,14 @@
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <functional>
 #include <iosfwd>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <random>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -21,9 +24,11 @@
 #include "bip158/Bip158.hpp"
 #include "bip158/bch_filter_1307544.hpp"
 #include "bip158/bch_filter_1307723.hpp"
+#include "blockchain/Merkle.hpp"
 #include "blockchain/bitcoin/CompactSize.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 #include "internal/blockchain/bitcoin/Bitcoin.hpp"
+#include "internal/blockchain/block/bitcoin/Bitcoin.hpp"
 #include "opentxs/Bytes.hpp"
 #include "opentxs/OT.hpp"
 #include "opentxs/Pimpl.hpp"
@@ -38,6 +43,7 @@
 #include "opentxs/blockchain/Network.hpp"
 #include "opentxs/blockchain/block/Block.hpp"
 #include "opentxs/blockchain/block/bitcoin/Block.hpp"
+#include "opentxs/blockchain/block/bitcoin/Transaction.hpp"
 #include "opentxs/blockchain/client/FilterOracle.hpp"
 #include "opentxs/blockchain/client/HeaderOracle.hpp"
 #include "opentxs/core/Data.hpp"
@@ -373,6 +379,195 @@ TEST_F(Test_BitcoinBlock, serialization)
     }
 }
 
+TEST_F(Test_BitcoinBlock, lazy_view)
+{
+    constexpr auto chain = ot::blockchain::Type::Bitcoin_testnet3;
+    constexpr auto style = ot::blockchain::filter::Type::Basic_BIP158;
+
+    for (const auto& vector : bip_158_vectors_) {
+        const auto raw = vector.Block(api_);
+        const auto pBlock = api_.Factory().BitcoinBlock(chain, raw->Bytes());
+        const auto pView = ot::factory::BitcoinBlockView(
+            api_, api_.Blockchain(), chain, raw->Bytes());
+
+        ASSERT_TRUE(pBlock);
+        ASSERT_TRUE(pView);
+
+        const auto& block = *pBlock;
+        const auto& view = *pView;
+
+        EXPECT_EQ(block.ID(), view.ID());
+        EXPECT_EQ(block.size(), view.size());
+        EXPECT_EQ(block.CalculateSize(), view.CalculateSize());
+        EXPECT_EQ(block.ExtractElements(style), view.ExtractElements(style));
+
+        for (auto i = std::size_t{0}; i < block.size(); ++i) {
+            const auto& expected = block.at(i);
+            const auto& tx = view.at(i);
+
+            ASSERT_TRUE(expected);
+            ASSERT_TRUE(tx);
+            EXPECT_EQ(expected->ID(), tx->ID());
+            EXPECT_EQ(tx.get(), view.at(tx->ID().Bytes()).get());
+        }
+
+        auto serialized = api_.Factory().Data();
+
+        EXPECT_TRUE(view.Serialize(serialized->WriteInto()));
+        EXPECT_EQ(raw.get(), serialized);
+    }
+}
+
+TEST_F(Test_BitcoinBlock, lazy_view_pkt)
+{
+    constexpr auto chain = ot::blockchain::Type::PKT;
+    constexpr auto style = ot::blockchain::filter::Type::Basic_BIP158;
+    const auto& [genesisHex, filterMap] = genesis_block_data_.at(chain);
+    const auto raw = api_.Factory().Data(genesisHex, ot::StringStyle::Hex);
+    const auto pBlock = api_.Factory().BitcoinBlock(chain, raw->Bytes());
+    const auto pView = ot::factory::BitcoinBlockView(
+        api_, api_.Blockchain(), chain, raw->Bytes());
+
+    ASSERT_TRUE(pBlock);
+    ASSERT_TRUE(pView);
+
+    const auto& block = *pBlock;
+    const auto& view = *pView;
+
+    EXPECT_EQ(block.ID(), view.ID());
+    EXPECT_EQ(block.size(), view.size());
+    EXPECT_EQ(block.CalculateSize(), view.CalculateSize());
+    EXPECT_EQ(block.ExtractElements(style), view.ExtractElements(style));
+
+    for (auto i = std::size_t{0}; i < block.size(); ++i) {
+        const auto& expected = block.at(i);
+        const auto& tx = view.at(i);
+
+        ASSERT_TRUE(expected);
+        ASSERT_TRUE(tx);
+        EXPECT_EQ(expected->ID(), tx->ID());
+    }
+
+    auto serialized = api_.Factory().Data();
+
+    EXPECT_TRUE(view.Serialize(serialized->WriteInto()));
+    EXPECT_EQ(raw.get(), serialized);
+}
+
+TEST_F(Test_BitcoinBlock, merkle)
+{
+    using Merkle = ot::blockchain::Merkle;
+    using Digest = Merkle::Digest;
+    constexpr auto chain = ot::blockchain::Type::Bitcoin;
+    auto random = std::mt19937{};
+    const auto make = [&](const std::size_t count) {
+        auto output = std::vector<Digest>(count);
+
+        for (auto& digest : output) {
+            for (auto& byte : digest) { byte = std::byte(random()); }
+        }
+
+        return output;
+    };
+    const auto pair = [&](const Digest& lhs, const Digest& rhs) {
+        auto preimage = std::array<Digest, 2>{lhs, rhs};
+        auto output = Digest{};
+
+        EXPECT_TRUE(ot::blockchain::MerkleHash(
+            api_,
+            chain,
+            {reinterpret_cast<const char*>(preimage.data()), 64u},
+            ot::preallocated(output.size(), output.data())));
+
+        return output;
+    };
+    const auto root = [&](std::vector<Digest> row) {
+        while (1u < row.size()) {
+            auto next = std::vector<Digest>{};
+
+            for (auto i = std::size_t{0}; i < row.size(); i += 2u) {
+                const auto last = (i + 1u) == row.size();
+                next.emplace_back(pair(row[i], last ? row[i] : row[i + 1u]));
+            }
+
+            row.swap(next);
+        }
+
+        return row.front();
+    };
+
+    for (const auto kernel :
+         {Merkle::Kernel::Scalar,
+          Merkle::Kernel::SHA,
+          Merkle::Kernel::Lanes8,
+          Merkle::Kernel::Lanes16}) {
+        if (false == Merkle::Supported(kernel)) { continue; }
+
+        // The largest row is split between thread pool workers
+        for (const auto count : {1u, 2u, 3u, 17u, 33u, 10001u}) {
+            const auto in = make(count);
+            auto out = std::vector<Digest>((count + 1u) / 2u);
+            auto parallel = std::vector<Digest>(out.size());
+            Merkle::HashRow(in.data(), in.size(), out.data(), kernel);
+            Merkle::HashRow(
+                api_, in.data(), in.size(), parallel.data(), kernel);
+
+            EXPECT_EQ(out, parallel);
+
+            for (auto i = std::size_t{0}; i < out.size(); ++i) {
+                const auto& lhs = in[2u * i];
+                const auto& rhs = ((2u * i) + 1u < count) ? in[(2u * i) + 1u]
+                                                          : lhs;
+
+                EXPECT_EQ(pair(lhs, rhs), out[i]);
+            }
+        }
+    }
+
+    EXPECT_EQ(Digest{}, Merkle::Root({}));
+
+    for (const auto count : {1u, 2u, 7u, 1000u}) {
+        const auto leaves = make(count);
+
+        EXPECT_EQ(root(leaves), Merkle::Root(std::vector<Digest>{leaves}));
+        EXPECT_EQ(
+            root(leaves), Merkle::Root(api_, std::vector<Digest>{leaves}));
+    }
+
+    {
+        const auto leaves = make(20001u);
+
+        EXPECT_EQ(
+            Merkle::Root(std::vector<Digest>{leaves}),
+            Merkle::Root(api_, std::vector<Digest>{leaves}));
+    }
+
+    const auto leaves = make(7u);
+    const auto expected = root(leaves);
+    auto matches = std::vector<Digest>{};
+
+    EXPECT_EQ(
+        expected,
+        Merkle::PartialRoot(
+            leaves.size(),
+            leaves,
+            {std::byte{0xff}, std::byte{0x3f}},
+            matches));
+    EXPECT_EQ(leaves, matches);
+
+    matches.clear();
+
+    EXPECT_EQ(
+        expected,
+        Merkle::PartialRoot(
+            leaves.size(), {expected}, {std::byte{0x00}}, matches));
+    EXPECT_EQ(0u, matches.size());
+    EXPECT_THROW(
+        Merkle::PartialRoot(
+            2u, {leaves[0], leaves[0]}, {std::byte{0x07}}, matches),
+        std::runtime_error);
+}
+
 TEST_F(Test_BitcoinBlock, bch_filter_1307544)
 {
     const auto& filter = bch_filter_1307544_;
@@ -5,6 +5,7 @@
 
 #include <gtest/gtest.h>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -13,6 +14,7 @@
 #include "OTTestEnvironment.hpp"  // IWYU pragma: keep
 #include "internal/api/client/Client.hpp"
 #include "internal/blockchain/block/Block.hpp"
+#include "internal/blockchain/block/bitcoin/Bitcoin.hpp"
 #include "opentxs/Forward.hpp"
 #include "opentxs/OT.hpp"
 #include "opentxs/Pimpl.hpp"
@@ -169,4 +171,35 @@ TEST_F(Test_BlockHeader, Deserialize)
     ASSERT_TRUE(pHeader);
     EXPECT_EQ(expectedHash.get(), pHeader->Hash());
 }
+
+TEST_F(Test_BlockHeader, record_round_trip)
+{
+    std::unique_ptr<const bb::Header> pHeader{
+        ot::factory::GenesisBlockHeader(api_, b::Type::Bitcoin)};
+
+    ASSERT_TRUE(pHeader);
+
+    const auto* header =
+        dynamic_cast<const bb::bitcoin::internal::Header*>(pHeader.get());
+
+    ASSERT_NE(header, nullptr);
+
+    const auto record = header->Record();
+    const auto loaded =
+        ot::factory::BitcoinBlockHeader(api_, b::Type::Bitcoin, record);
+
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(header->Hash(), loaded->Hash());
+    EXPECT_EQ(header->ParentHash(), loaded->ParentHash());
+    EXPECT_EQ(header->MerkleRoot(), loaded->MerkleRoot());
+    EXPECT_EQ(header->Height(), loaded->Height());
+    EXPECT_EQ(header->LocalState(), loaded->LocalState());
+    EXPECT_EQ(header->InheritedState(), loaded->InheritedState());
+    EXPECT_EQ(header->Work()->asHex(), loaded->Work()->asHex());
+    EXPECT_EQ(header->Encode(), loaded->Encode());
+
+    const auto copy = loaded->Record();
+
+    EXPECT_EQ(0, std::memcmp(&record, &copy, sizeof(record)));
+}
 }  // namespace
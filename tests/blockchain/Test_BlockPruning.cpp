@@ -0,0 +1,82 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <set>
+
+#include "blockchain/database/Blocks.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+
+namespace ot = opentxs;
+
+namespace
+{
+using Blocks = ot::blockchain::database::Blocks;
+using Height = ot::blockchain::block::Height;
+
+constexpr auto block_size_ = std::size_t{1000};
+
+const auto fixed_ = [](const Height) { return block_size_; };
+
+TEST(Test_BlockPruning, disabled)
+{
+    EXPECT_EQ(Blocks::PruneTarget(1000, -1, 0, 0, fixed_), -1);
+    EXPECT_EQ(Blocks::PruneTarget(1000, 500, 0, 0, fixed_), 500);
+}
+
+TEST(Test_BlockPruning, block_limit)
+{
+    // Heights 991 through 1000 are retained
+    EXPECT_EQ(Blocks::PruneTarget(1000, -1, 10, 0, fixed_), 990);
+    EXPECT_EQ(Blocks::PruneTarget(5, -1, 10, 0, fixed_), -1);
+    EXPECT_EQ(Blocks::PruneTarget(1000, 995, 10, 0, fixed_), 995);
+}
+
+TEST(Test_BlockPruning, byte_limit)
+{
+    auto checked = std::set<Height>{};
+    const auto size = [&](const Height height) {
+        checked.emplace(height);
+
+        return block_size_;
+    };
+
+    // Heights 996 through 1000 are retained
+    EXPECT_EQ(Blocks::PruneTarget(1000, -1, 0, 5 * block_size_, size), 995);
+    // Only the retained blocks and the first excess block are examined
+    EXPECT_EQ(checked.size(), 6);
+    EXPECT_EQ(*checked.begin(), 995);
+}
+
+TEST(Test_BlockPruning, tip_is_retained)
+{
+    const auto large = [](const Height) { return 10 * block_size_; };
+
+    EXPECT_EQ(Blocks::PruneTarget(1000, -1, 0, block_size_, large), 999);
+}
+
+TEST(Test_BlockPruning, both_limits)
+{
+    // The stricter limit applies
+    EXPECT_EQ(Blocks::PruneTarget(1000, -1, 10, 5 * block_size_, fixed_), 995);
+    EXPECT_EQ(Blocks::PruneTarget(1000, -1, 3, 5 * block_size_, fixed_), 997);
+}
+
+TEST(Test_BlockPruning, cursor)
+{
+    auto checked = std::set<Height>{};
+    const auto size = [&](const Height height) {
+        checked.emplace(height);
+
+        return block_size_;
+    };
+
+    // Blocks at or below the cursor are never examined
+    EXPECT_EQ(Blocks::PruneTarget(1000, 998, 0, 5 * block_size_, size), 998);
+    EXPECT_EQ(checked.size(), 2);
+    EXPECT_EQ(*checked.begin(), 999);
+}
+}  // namespace
@@ -0,0 +1,95 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <thread>
+
+#include "blockchain/BufferPool.hpp"
+
+namespace ot = opentxs;
+
+namespace
+{
+using Pool = ot::blockchain::BufferPool;
+
+TEST(Test_BufferPool, size_class)
+{
+    auto pool = Pool::Factory();
+    const auto small = pool->Get(24);
+    const auto exact = pool->Get(4096);
+    const auto rounded = pool->Get(4097);
+
+    EXPECT_EQ(small->size(), 24);
+    EXPECT_EQ(small->Capacity(), Pool::minimum_);
+    EXPECT_EQ(exact->Capacity(), 4096);
+    EXPECT_EQ(rounded->size(), 4097);
+    EXPECT_EQ(rounded->Capacity(), 8192);
+}
+
+TEST(Test_BufferPool, reuse)
+{
+    auto pool = Pool::Factory();
+    const std::byte* address{nullptr};
+
+    {
+        auto buffer = pool->Get(1000);
+        address = buffer->data();
+    }
+
+    EXPECT_EQ(pool->Idle(), 1024);
+
+    auto buffer = pool->Get(700);
+
+    EXPECT_EQ(buffer->data(), address);
+    EXPECT_EQ(pool->Idle(), 0);
+}
+
+TEST(Test_BufferPool, oversize)
+{
+    auto pool = Pool::Factory();
+
+    {
+        auto buffer = pool->Get(Pool::maximum_ + 1);
+
+        EXPECT_EQ(buffer->Capacity(), Pool::maximum_ + 1);
+    }
+
+    EXPECT_EQ(pool->Idle(), 0);
+}
+
+TEST(Test_BufferPool, limit)
+{
+    auto pool = Pool::Factory(2048);
+
+    {
+        auto first = pool->Get(1024);
+        auto second = pool->Get(1024);
+        auto third = pool->Get(1024);
+    }
+
+    EXPECT_EQ(pool->Idle(), 2048);
+}
+
+TEST(Test_BufferPool, release_from_other_thread)
+{
+    auto pool = Pool::Factory();
+    auto buffer = pool->Get(100000);
+    auto thread = std::thread{[b = std::move(buffer)]() mutable { b.reset(); }};
+    thread.join();
+
+    EXPECT_EQ(pool->Idle(), 131072);
+}
+
+TEST(Test_BufferPool, outlives_pool)
+{
+    auto pool = Pool::Factory();
+    auto buffer = pool->Get(10);
+    pool.reset();
+    buffer.reset();
+
+    SUCCEED();
+}
+}  // namespace
@@ -0,0 +1,447 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "blockchain/Merkle.hpp"
+#include "blockchain/SipHash.hpp"
+#include "blockchain/bitcoin/CompactSize.hpp"
+#include "blockchain/p2p/bitcoin/CompactBlock.hpp"
+#include "blockchain/p2p/bitcoin/Header.hpp"
+#include "blockchain/p2p/bitcoin/message/Getblocktxn.hpp"
+#include "internal/blockchain/client/Client.hpp"
+#include "internal/blockchain/p2p/bitcoin/Factory.hpp"
+#include "internal/blockchain/p2p/bitcoin/message/Message.hpp"
+#include "opentxs/Bytes.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/crypto/Hash.hpp"
+#include "opentxs/blockchain/BlockchainType.hpp"
+#include "opentxs/blockchain/block/bitcoin/Block.hpp"
+#include "opentxs/blockchain/block/bitcoin/Transaction.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/Message.hpp"
+#include "opentxs/protobuf/Enums.pb.h"
+
+namespace b = ot::blockchain;
+namespace bc = b::client;
+namespace bitcoin = b::p2p::bitcoin;
+
+namespace
+{
+const auto transaction_hex_ = std::string{
+    "01000000035a19f341c42071f9cec7df37c4853c95d6aecc95e3bf19e3181d30d99552b8c9"
+    "000000008a473044022025bca5dc0fe42aca5f07c9b3fe1b3f72113ffbc3522f8d3ebb2457"
+    "f5bdf8f9b2022030ff687c00a63e810b21e447d3a57b2749ebea553cab763eb9b99e1b9839"
+    "653b014104469f7eb54b90d90106b1a5412b41a23516028e81ad35e0418a4460707ae39a4b"
+    "f0101b632260fb08979aba0ceea576b5400c7cf30b539b055ec4c0b96ab00984ffffffff5b"
+    "72d3f4b6b72b3511bddd9994f28a91cc03212f200f71b91df13e711d58c1da000000008c49"
+    "3046022100fbef2589b7c52a3be0fd8dd3624445da9c8930f0e51f6a33d76dc0ca0304473d"
+    "0221009ec433ca6a9f16184db46468ff39cafaa9643021e0c66a1de1e6f9a6120927900141"
+    "04b27f4de096ac6431eec4b807a0d3db3e9f9be48faab692d5559624acb1faf4334dd440eb"
+    "f32a81506b7c49d8cf40e4b3f5c6b6e99fcb6d3e8a298174bd2b348dffffffff292e947388"
+    "51718433a3168e43cab1c6a811e9a0f35b06b6cec60fea9abe0f43010000008a4730440220"
+    "582813f2c2d7cbb84521f81d6c2a1147e5296e90bee05f583b3df108fdac72010220232b43"
+    "a2e596cef59f82c8bfff1a310d85e7beb3e607076ff8966d6d374dc12b014104a8514ca511"
+    "37c6d8a4befa476a7521197b886fceafa9f5c2830bea6df62792a6dd46f2b26812b250f13f"
+    "ad473e5cab6dcceaa2d53cf2c82e8e03d95a0e70836bffffffff0240420f00000000001976"
+    "a914429e6bd3c9a9ca4be00a4b2b02fd4f5895c1405988ac4083e81c000000001976a914e5"
+    "5756cb5395a4b39369d0f1f0a640c12fd867b288ac00000000"};
+// The start of the first previous outpoint txid
+const auto prevout_prefix_ = std::string{"5a19f341"};
+constexpr auto nonce_ = std::uint64_t{0x0102030405060708};
+
+class Test_CompactBlock : public ::testing::Test
+{
+protected:
+    using Transaction = bc::internal::Mempool::Transaction;
+    using Transactions = bc::internal::Mempool::Transactions;
+    using Prefilled = std::set<std::size_t>;
+
+    static constexpr auto chain_{b::Type::Bitcoin};
+    static constexpr auto version_{std::uint64_t{1}};
+
+    const ot::api::client::Manager& api_;
+    const Transactions txs_;
+
+    static auto append(ot::Space& out, const ot::ReadView bytes) noexcept
+        -> void
+    {
+        const auto* data = reinterpret_cast<const std::byte*>(bytes.data());
+        out.insert(out.end(), data, data + bytes.size());
+    }
+    static auto append(ot::Space& out, const std::size_t value) noexcept
+        -> void
+    {
+        const auto bytes = b::bitcoin::CompactSize(value).Encode();
+        out.insert(out.end(), bytes.begin(), bytes.end());
+    }
+    static auto append(ot::Space& out, const Transaction& tx) noexcept -> void
+    {
+        const auto serialized = tx->Serialize(ot::writer(out));
+
+        OT_ASSERT(serialized.has_value());
+    }
+    static auto little_endian(
+        ot::Space& out,
+        const std::uint64_t value,
+        const std::size_t bytes) noexcept -> void
+    {
+        for (auto i = std::size_t{0}; i < bytes; ++i) {
+            const auto byte = (value >> (8u * i)) & 0xff;
+            out.emplace_back(static_cast<std::byte>(byte));
+        }
+    }
+    // The serialized block which should be reconstructed
+    static auto expected(
+        const ot::Space& header,
+        const Transactions& txs) noexcept -> ot::Space
+    {
+        auto output = header;
+        append(output, txs.size());
+
+        for (const auto& tx : txs) { append(output, tx); }
+
+        return output;
+    }
+
+    // Returns a copy of the test transaction with a unique txid
+    auto make(const std::uint8_t input) const noexcept -> Transaction
+    {
+        static constexpr auto digits{"0123456789abcdef"};
+        auto hex = transaction_hex_;
+        const auto position = hex.find(prevout_prefix_);
+
+        OT_ASSERT(std::string::npos != position);
+
+        hex.at(position) = digits[input >> 4];
+        hex.at(position + 1) = digits[input & 0x0f];
+        const auto bytes = api_.Factory().Data(hex, ot::StringStyle::Hex);
+        auto output = Transaction{
+            api_.Factory().BitcoinTransaction(chain_, bytes->Bytes(), false)};
+
+        OT_ASSERT(output);
+
+        return output;
+    }
+    auto blocktxn(
+        const bitcoin::CompactBlock& compact,
+        const Transactions& txs) const noexcept -> ot::Space
+    {
+        auto output = ot::Space{};
+        append(output, compact.Hash().Bytes());
+        append(output, txs.size());
+
+        for (const auto& tx : txs) { append(output, tx); }
+
+        return output;
+    }
+    auto cmpctblock(
+        const ot::Space& header,
+        const Transactions& txs,
+        const Prefilled& prefilled) const noexcept -> ot::Space
+    {
+        auto output = header;
+        little_endian(output, nonce_, 8);
+        auto shortTxs = Transactions{};
+
+        for (auto i = std::size_t{0}; i < txs.size(); ++i) {
+            if (0 == prefilled.count(i)) { shortTxs.emplace_back(txs.at(i)); }
+        }
+
+        append(output, shortTxs.size());
+
+        for (const auto id : short_ids(header, shortTxs)) {
+            little_endian(output, id, 6);
+        }
+
+        append(output, prefilled.size());
+        auto next = std::size_t{0};
+
+        for (const auto index : prefilled) {
+            append(output, index - next);
+            append(output, txs.at(index));
+            next = index + 1;
+        }
+
+        return output;
+    }
+    auto construct(const ot::ReadView payload, const Transactions& mempool)
+        const noexcept(false) -> std::unique_ptr<bitcoin::CompactBlock>
+    {
+        return std::make_unique<bitcoin::CompactBlock>(
+            api_, chain_, version_, payload, mempool);
+    }
+    auto make_header(const Transactions& txs, const bool validRoot = true)
+        const noexcept -> ot::Space
+    {
+        auto leaves = std::vector<b::Merkle::Digest>{};
+
+        for (const auto& tx : txs) {
+            const auto txid = tx->ID().Bytes();
+            auto& leaf = leaves.emplace_back();
+
+            OT_ASSERT(leaf.size() == txid.size());
+
+            std::memcpy(leaf.data(), txid.data(), leaf.size());
+        }
+
+        auto root = b::Merkle::Root(std::move(leaves));
+
+        if (false == validRoot) { root.at(0) ^= std::byte{0x01}; }
+
+        auto output = ot::Space{};
+        little_endian(output, 1, 4);
+        output.resize(output.size() + 32);
+        output.insert(output.end(), root.begin(), root.end());
+        little_endian(output, 1231006505, 4);
+        little_endian(output, 0x207fffff, 4);
+        little_endian(output, 0, 4);
+
+        return output;
+    }
+    auto short_ids(const ot::Space& header, const Transactions& txs)
+        const noexcept -> std::vector<std::uint64_t>
+    {
+        auto preimage = header;
+        little_endian(preimage, nonce_, 8);
+        auto digest = ot::Space{};
+        const auto hashed = api_.Crypto().Hash().Digest(
+            ot::proto::HASHTYPE_SHA256,
+            ot::reader(preimage),
+            ot::writer(digest));
+
+        OT_ASSERT(hashed);
+
+        const auto siphash = ot::gcs::SipHash{
+            ot::ReadView{reinterpret_cast<const char*>(digest.data()), 16}};
+        auto ids = std::vector<ot::ReadView>{};
+
+        for (const auto& tx : txs) { ids.emplace_back(tx->ID().Bytes()); }
+
+        auto output = siphash.Hash(ids);
+
+        for (auto& id : output) { id &= 0x0000ffffffffffff; }
+
+        return output;
+    }
+
+    Test_CompactBlock()
+        : api_(ot::Context().StartClient(OTTestEnvironment::test_args_, 0))
+        , txs_({make(0x01), make(0x02), make(0x03), make(0x04)})
+    {
+    }
+};
+
+TEST_F(Test_CompactBlock, reconstruct)
+{
+    const auto header = make_header(txs_);
+    const auto payload = cmpctblock(header, txs_, {0});
+    const auto mempool = Transactions{txs_.at(3), txs_.at(1), txs_.at(2)};
+    const auto compact = construct(ot::reader(payload), mempool);
+
+    EXPECT_TRUE(compact->Missing().empty());
+
+    const auto serialized = compact->Serialize();
+
+    EXPECT_EQ(serialized, expected(header, txs_));
+
+    const auto parsed =
+        api_.Factory().BitcoinBlock(chain_, ot::reader(serialized));
+
+    ASSERT_TRUE(parsed);
+    EXPECT_EQ(parsed->ID().asHex(), compact->Hash().asHex());
+}
+
+TEST_F(Test_CompactBlock, prefilled_indices)
+{
+    // Prefilled indices are differentially encoded
+    const auto header = make_header(txs_);
+    const auto payload = cmpctblock(header, txs_, {0, 2, 3});
+    const auto compact =
+        construct(ot::reader(payload), Transactions{txs_.at(1)});
+
+    EXPECT_TRUE(compact->Missing().empty());
+    EXPECT_EQ(compact->Serialize(), expected(header, txs_));
+}
+
+TEST_F(Test_CompactBlock, malformed)
+{
+    const auto header = make_header(txs_);
+    const auto payload = cmpctblock(header, txs_, {0});
+    const auto parse = [&](const ot::Space& bytes) {
+        construct(ot::reader(bytes), txs_);
+    };
+
+    EXPECT_THROW(
+        parse(ot::Space(header.begin(), header.begin() + 40)),
+        std::runtime_error);
+    EXPECT_THROW(parse(header), std::runtime_error);
+
+    auto excess = payload;
+    excess.emplace_back(std::byte{0x00});
+
+    EXPECT_THROW(parse(excess), std::runtime_error);
+
+    // Declares more short ids than the payload contains
+    auto truncated = header;
+    little_endian(truncated, nonce_, 8);
+    append(truncated, std::size_t{10});
+    little_endian(truncated, 0, 6);
+
+    EXPECT_THROW(parse(truncated), std::runtime_error);
+
+    // Prefilled transaction index beyond the end of the block
+    auto index = header;
+    little_endian(index, nonce_, 8);
+    append(index, std::size_t{0});
+    append(index, std::size_t{1});
+    append(index, std::size_t{1});
+    append(index, txs_.at(0));
+
+    EXPECT_THROW(parse(index), std::runtime_error);
+}
+
+TEST_F(Test_CompactBlock, fill)
+{
+    const auto header = make_header(txs_);
+    const auto payload = cmpctblock(header, txs_, {0});
+    const auto compact =
+        construct(ot::reader(payload), Transactions{txs_.at(2)});
+
+    ASSERT_EQ(compact->Missing(), (std::vector<std::size_t>{1, 3}));
+    EXPECT_THROW(compact->Serialize(), std::runtime_error);
+
+    const auto count = blocktxn(*compact, {txs_.at(1)});
+
+    EXPECT_THROW(compact->Fill(ot::reader(count)), std::runtime_error);
+
+    auto hash = blocktxn(*compact, {txs_.at(1), txs_.at(3)});
+    hash.at(0) ^= std::byte{0x01};
+
+    EXPECT_THROW(compact->Fill(ot::reader(hash)), std::runtime_error);
+
+    const auto reply = blocktxn(*compact, {txs_.at(1), txs_.at(3)});
+    compact->Fill(ot::reader(reply));
+
+    EXPECT_TRUE(compact->Missing().empty());
+    EXPECT_EQ(compact->Serialize(), expected(header, txs_));
+}
+
+TEST_F(Test_CompactBlock, duplicate_short_ids)
+{
+    // Both slots share a short id so neither can be taken from the mempool
+    const auto txs = Transactions{txs_.at(0), txs_.at(1), txs_.at(1)};
+    const auto header = make_header(txs);
+    const auto payload = cmpctblock(header, txs, {0});
+    const auto compact = construct(ot::reader(payload), txs_);
+
+    ASSERT_EQ(compact->Missing(), (std::vector<std::size_t>{1, 2}));
+
+    const auto reply = blocktxn(*compact, {txs.at(1), txs.at(2)});
+    compact->Fill(ot::reader(reply));
+
+    EXPECT_EQ(compact->Serialize(), expected(header, txs));
+}
+
+TEST_F(Test_CompactBlock, mempool_collision)
+{
+    // Two mempool entries match the same short id so the slot is requested
+    const auto header = make_header(txs_);
+    const auto payload = cmpctblock(header, txs_, {0});
+    const auto mempool =
+        Transactions{txs_.at(1), make(0x02), txs_.at(2), txs_.at(3)};
+    const auto compact = construct(ot::reader(payload), mempool);
+
+    ASSERT_EQ(compact->Missing(), (std::vector<std::size_t>{1}));
+
+    const auto reply = blocktxn(*compact, {txs_.at(1)});
+    compact->Fill(ot::reader(reply));
+
+    EXPECT_EQ(compact->Serialize(), expected(header, txs_));
+}
+
+TEST_F(Test_CompactBlock, merkle_root)
+{
+    const auto header = make_header(txs_, false);
+    const auto payload = cmpctblock(header, txs_, {0});
+    const auto compact = construct(ot::reader(payload), txs_);
+
+    EXPECT_TRUE(compact->Missing().empty());
+    EXPECT_THROW(compact->Serialize(), std::runtime_error);
+}
+
+TEST_F(Test_CompactBlock, wrong_transaction)
+{
+    const auto header = make_header(txs_);
+    const auto payload = cmpctblock(header, txs_, {0});
+    const auto compact = construct(
+        ot::reader(payload), Transactions{txs_.at(1), txs_.at(2)});
+
+    ASSERT_EQ(compact->Missing(), (std::vector<std::size_t>{3}));
+
+    const auto reply = blocktxn(*compact, {make(0x05)});
+    compact->Fill(ot::reader(reply));
+
+    EXPECT_THROW(compact->Serialize(), std::runtime_error);
+}
+
+TEST_F(Test_CompactBlock, getblocktxn_encoding)
+{
+    const auto hash = api_.Factory().Data(
+        std::string(64, 'a'), ot::StringStyle::Hex);
+    const auto indices = std::vector<std::size_t>{1, 2, 5, 300};
+    const auto message = std::unique_ptr<bitcoin::message::Getblocktxn>{
+        ot::factory::BitcoinP2PGetblocktxn(api_, chain_, hash, indices)};
+
+    ASSERT_TRUE(message);
+
+    const auto payload = message->payload();
+    auto expected = ot::Space{};
+    append(expected, hash->Bytes());
+    append(expected, indices.size());
+    // Each index is encoded relative to the previous index plus one
+    append(expected, std::size_t{1});
+    append(expected, std::size_t{0});
+    append(expected, std::size_t{2});
+    append(expected, std::size_t{294});
+
+    EXPECT_EQ(ot::space(payload->Bytes()), expected);
+
+    const auto frame = api_.ZeroMQ().Message(message->header().Encode());
+    auto pHeader = std::unique_ptr<bitcoin::Header>{
+        ot::factory::BitcoinP2PHeader(api_, frame->at(0))};
+
+    ASSERT_TRUE(pHeader);
+
+    const auto parsed = std::unique_ptr<bitcoin::message::Getblocktxn>{
+        ot::factory::BitcoinP2PGetblocktxn(
+            api_,
+            std::move(pHeader),
+            70015,
+            payload->data(),
+            payload->size())};
+
+    ASSERT_TRUE(parsed);
+    EXPECT_EQ(parsed->getIndices(), indices);
+    EXPECT_EQ(parsed->getBlockHash()->asHex(), hash->asHex());
+}
+}  // namespace
@@ -3,12 +3,14 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <boost/multiprecision/cpp_int.hpp>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -25,6 +27,8 @@
 #include "opentxs/api/Context.hpp"
 #include "opentxs/api/Factory.hpp"
 #include "opentxs/api/client/Manager.hpp"
+#include "opentxs/api/crypto/Crypto.hpp"
+#include "opentxs/api/crypto/Hash.hpp"
 #include "opentxs/blockchain/Blockchain.hpp"
 #include "opentxs/blockchain/BlockchainType.hpp"
 #include "opentxs/blockchain/BloomFilter.hpp"
@@ -33,6 +37,7 @@
 #include "opentxs/blockchain/client/FilterOracle.hpp"
 #include "opentxs/blockchain/client/HeaderOracle.hpp"
 #include "opentxs/core/Data.hpp"
+#include "opentxs/protobuf/Enums.pb.h"
 
 namespace
 {
@@ -353,6 +358,60 @@ TEST_F(Test_Filters, golomb_coding)
     }
 }
 
+TEST_F(Test_Filters, golomb_truncated)
+{
+    const auto elements = std::vector<std::uint64_t>{2, 3, 5, 8, 13};
+    const auto N = static_cast<std::uint32_t>(elements.size());
+    const auto P = std::uint8_t{19};
+    auto encoded = ot::gcs::GolombEncode(P, elements);
+
+    ASSERT_GT(encoded.size(), 1);
+
+    encoded.pop_back();
+
+    EXPECT_THROW(ot::gcs::GolombDecode(N, P, encoded), std::runtime_error);
+}
+
+TEST_F(Test_Filters, gcs_truncated)
+{
+    const auto key = std::string{"0123456789abcdef"};
+    auto included = std::vector<ot::OTData>{};
+
+    for (auto i = std::size_t{0}; i < 100u; ++i) {
+        const auto item = std::to_string(i);
+        included.emplace_back(ot::Data::Factory(item.data(), item.size()));
+    }
+
+    const auto pBuilt =
+        ot::factory::GCS(api_, params_.first, params_.second, key, included);
+
+    ASSERT_TRUE(pBuilt);
+
+    const auto& built = *pBuilt;
+    const auto compressed = built.Compressed();
+    // Too short to hold the remainder of the first element
+    const auto pTruncated = ot::factory::GCS(
+        api_,
+        params_.first,
+        params_.second,
+        key,
+        built.ElementCount(),
+        ot::reader(compressed).substr(0, 1));
+
+    ASSERT_TRUE(pTruncated);
+
+    const auto& truncated = *pTruncated;
+    auto targets = std::vector<ot::ReadView>{};
+
+    for (const auto& item : included) { targets.emplace_back(item->Bytes()); }
+
+    EXPECT_EQ(built.Match(targets).size(), included.size());
+    // The first call streams the filter and the second decodes it
+    EXPECT_TRUE(truncated.Match(targets).empty());
+    EXPECT_TRUE(truncated.Match(targets).empty());
+    EXPECT_FALSE(truncated.Test(included));
+}
+
 TEST_F(Test_Filters, gcs)
 {
     const auto s1 = std::string{"blah"};
@@ -402,6 +461,120 @@ TEST_F(Test_Filters, gcs)
     }
 }
 
+TEST_F(Test_Filters, gcs_streaming_match)
+{
+    const auto key = std::string{"0123456789abcdef"};
+    auto included = std::vector<ot::OTData>{};
+    auto targets = std::vector<std::string>{};
+
+    for (auto i = std::size_t{0}; i < 500u; ++i) {
+        const auto item = std::to_string(i);
+        included.emplace_back(ot::Data::Factory(item.data(), item.size()));
+        targets.emplace_back(item);
+        targets.emplace_back("x" + item);
+    }
+
+    const auto pBuilt =
+        ot::factory::GCS(api_, params_.first, params_.second, key, included);
+
+    ASSERT_TRUE(pBuilt);
+
+    const auto& built = *pBuilt;
+    const auto pParsed = ot::factory::GCS(
+        api_,
+        params_.first,
+        params_.second,
+        key,
+        built.ElementCount(),
+        ot::reader(built.Compressed()));
+
+    ASSERT_TRUE(pParsed);
+
+    const auto& parsed = *pParsed;
+    const auto views =
+        std::vector<ot::ReadView>{targets.begin(), targets.end()};
+    const auto expected = built.Match(views);
+    const auto streamed = parsed.Match(views);
+
+    EXPECT_GE(expected.size(), included.size());
+    EXPECT_EQ(expected, streamed);
+    EXPECT_TRUE(parsed.Test(included));
+    EXPECT_TRUE(parsed.Test(included.back()));
+}
+
+TEST_F(Test_Filters, gcs_view)
+{
+    const auto key = std::string{"0123456789abcdef"};
+    auto included = std::vector<ot::OTData>{};
+
+    for (auto i = std::size_t{0}; i < 100u; ++i) {
+        const auto item = std::to_string(i);
+        included.emplace_back(ot::Data::Factory(item.data(), item.size()));
+    }
+
+    const auto pBuilt =
+        ot::factory::GCS(api_, params_.first, params_.second, key, included);
+
+    ASSERT_TRUE(pBuilt);
+
+    const auto& built = *pBuilt;
+    const auto encoded = built.Encode();
+    const auto pView = ot::factory::GCSView(
+        api_,
+        ot::blockchain::filter::Type::Basic_BIP158,
+        key,
+        encoded->Bytes());
+
+    ASSERT_TRUE(pView);
+
+    const auto& view = *pView;
+
+    EXPECT_EQ(built.ElementCount(), view.ElementCount());
+    EXPECT_EQ(built.Hash().get(), view.Hash().get());
+    EXPECT_EQ(encoded.get(), view.Encode().get());
+    EXPECT_TRUE(view.Test(included));
+}
+
+TEST_F(Test_Filters, siphash_batch)
+{
+    namespace mp = boost::multiprecision;
+
+    const auto key = std::string{"0123456789abcdef"};
+    const auto N = std::uint32_t{1000};
+    const auto range = std::uint64_t{N} * std::uint64_t{params_.second};
+    auto data = std::vector<std::string>{};
+
+    for (auto i = std::size_t{0}; i < N; ++i) {
+        data.emplace_back(i % 67u, static_cast<char>(i));
+    }
+
+    const auto items = std::vector<ot::ReadView>{data.begin(), data.end()};
+    auto expected = std::vector<std::uint64_t>{};
+
+    for (const auto& item : items) {
+        auto hash = std::uint64_t{};
+        auto writer = [&hash](const auto) -> ot::WritableView {
+            return {&hash, sizeof(hash)};
+        };
+
+        ASSERT_TRUE(api_.Crypto().Hash().HMAC(
+            ot::proto::HASHTYPE_SIPHASH24, key, item, writer));
+
+        const auto value =
+            ((mp::uint128_t{hash} * mp::uint128_t{range}) >> 64u)
+                .convert_to<std::uint64_t>();
+        expected.emplace_back(value);
+
+        EXPECT_EQ(value, ot::gcs::HashToRange(api_, key, range, item));
+    }
+
+    std::sort(expected.begin(), expected.end());
+    const auto batch = ot::gcs::HashedSetConstruct(
+        api_, key, N, params_.second, items);
+
+    EXPECT_EQ(expected, batch);
+}
+
 TEST_F(Test_Filters, bip158_case_0) { EXPECT_TRUE(TestGCSBlock(0)); }
 
 TEST_F(Test_Filters, bip158_case_49291) { EXPECT_TRUE(TestGCSBlock(49291)); }
@@ -0,0 +1,448 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "blockchain/client/HeaderSegments.hpp"
+#include "internal/blockchain/client/Client.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/blockchain/block/Header.hpp"
+#include "opentxs/blockchain/block/bitcoin/Header.hpp"  // IWYU pragma: keep
+#include "opentxs/blockchain/client/HeaderOracle.hpp"
+#include "opentxs/core/Data.hpp"
+
+namespace b = ot::blockchain;
+namespace bb = b::block;
+namespace bc = b::client;
+
+namespace
+{
+using namespace std::literals::chrono_literals;
+
+using Headers = std::vector<std::unique_ptr<bb::Header>>;
+
+constexpr auto first_peer_{1};
+constexpr auto second_peer_{2};
+constexpr auto batch_{std::size_t{2000}};
+constexpr auto segment_limit_{std::size_t{50000}};
+
+// Best chain which only grows when headers are added which extend its tip
+class FakeHeaderOracle final : public bc::internal::HeaderOracle
+{
+public:
+    std::vector<bb::pHash> best_;
+    bb::Position checkpoint_;
+    CheckpointData default_checkpoint_;
+    bool accept_;
+    // Height of the first header of every batch which was accepted
+    std::vector<bb::Height> added_;
+
+    auto Ancestors(const bb::Position&, const bb::Position&, const std::size_t)
+        const noexcept(false) -> Positions final
+    {
+        return {};
+    }
+    auto BestChain() const noexcept -> bb::Position final
+    {
+        return {static_cast<bb::Height>(best_.size()) - 1, best_.back()};
+    }
+    auto BestChain(const bb::Position&, const std::size_t) const
+        noexcept(false) -> Positions final
+    {
+        return {};
+    }
+    auto BestHash(const bb::Height height) const noexcept -> bb::pHash final
+    {
+        const auto index = static_cast<std::size_t>(height);
+
+        if ((0 > height) || (best_.size() <= index)) {
+
+            return ot::Data::Factory();
+        }
+
+        return best_.at(index);
+    }
+    auto BestHashes(const bb::Height, const std::size_t) const noexcept
+        -> Hashes final
+    {
+        return {};
+    }
+    auto BestHashes(const bb::Height, const bb::Hash&, const std::size_t)
+        const noexcept -> Hashes final
+    {
+        return {};
+    }
+    auto BestHashes(const Hashes&, const bb::Hash&, const std::size_t)
+        const noexcept -> Hashes final
+    {
+        return {};
+    }
+    auto CalculateReorg(const bb::Position) const noexcept(false)
+        -> Positions final
+    {
+        return {};
+    }
+    auto CommonParent(const bb::Position& input) const noexcept
+        -> std::pair<bb::Position, bb::Position> final
+    {
+        return {input, BestChain()};
+    }
+    auto GetCheckpoint() const noexcept -> bb::Position final
+    {
+        return checkpoint_;
+    }
+    auto GetDefaultCheckpoint() const noexcept -> CheckpointData final
+    {
+        return default_checkpoint_;
+    }
+    auto IsInBestChain(const bb::Hash&) const noexcept -> bool final
+    {
+        return false;
+    }
+    auto IsInBestChain(const bb::Position&) const noexcept -> bool final
+    {
+        return false;
+    }
+    auto LoadBitcoinHeader(const bb::Hash&) const noexcept
+        -> std::unique_ptr<bb::bitcoin::Header> final
+    {
+        return {};
+    }
+    auto LoadHeader(const bb::Hash&) const noexcept
+        -> std::unique_ptr<bb::Header> final
+    {
+        return {};
+    }
+    auto RecentHashes() const noexcept -> Hashes final { return {}; }
+    auto Siblings() const noexcept -> std::set<bb::pHash> final { return {}; }
+
+    auto AddCheckpoint(const bb::Height, const bb::Hash&) noexcept
+        -> bool final
+    {
+        return false;
+    }
+    auto AddHeader(std::unique_ptr<bb::Header>) noexcept -> bool final
+    {
+        return false;
+    }
+    auto AddHeaders(Headers& headers) noexcept -> bool final
+    {
+        if ((false == accept_) || headers.empty()) { return false; }
+
+        added_.emplace_back(static_cast<bb::Height>(best_.size()));
+
+        for (const auto& header : headers) {
+            if (header->ParentHash() != best_.back()) { return false; }
+
+            best_.emplace_back(header->Hash());
+        }
+
+        return true;
+    }
+    auto DeleteCheckpoint() noexcept -> bool final { return false; }
+    auto Init() noexcept -> void final {}
+    auto ProcessSyncData(
+        bc::internal::SyncHeaders&,
+        bc::internal::ParsedSyncData&) noexcept -> bool final
+    {
+        return false;
+    }
+
+    FakeHeaderOracle(const bb::Hash& genesis) noexcept
+        : best_({genesis})
+        , checkpoint_(-1, ot::Data::Factory())
+        , default_checkpoint_(
+              -1,
+              ot::Data::Factory(),
+              ot::Data::Factory(),
+              ot::Data::Factory())
+        , accept_(true)
+        , added_()
+    {
+    }
+};
+
+class Test_HeaderSegments : public ::testing::Test
+{
+protected:
+    using Segments = bc::implementation::HeaderSegments;
+    using Request = bc::internal::HeaderSegments::Request;
+
+    static const bc::internal::Config config_;
+
+    const ot::api::client::Manager& api_;
+    // Every header of the test chain, indexed by height
+    Headers chain_;
+    FakeHeaderOracle oracle_;
+
+    auto hash(const bb::Height height) const noexcept -> bb::pHash
+    {
+        return chain_.at(static_cast<std::size_t>(height))->Hash();
+    }
+    // Copies of the headers from first to last inclusive
+    auto headers(const bb::Height first, const bb::Height last) const noexcept
+        -> Headers
+    {
+        auto output = Headers{};
+
+        for (auto i{first}; i <= last; ++i) {
+            const auto& header = chain_.at(static_cast<std::size_t>(i));
+            output.emplace_back(header->clone());
+        }
+
+        return output;
+    }
+    // Extends the chain until it contains the specified height
+    auto make_chain(const bb::Height height) noexcept -> void
+    {
+        while (static_cast<bb::Height>(chain_.size()) <= height) {
+            const auto next = static_cast<bb::Height>(chain_.size());
+            const auto merkle = ot::Data::Factory(
+                "merkle " + std::to_string(next), ot::Data::Mode::Raw);
+            const auto parent =
+                chain_.empty() ? ot::Data::Factory() : hash(next - 1);
+            auto header =
+                api_.Factory().BlockHeaderForUnitTests(merkle, parent, next);
+
+            ASSERT_TRUE(header);
+
+            chain_.emplace_back(std::move(header));
+        }
+    }
+    // Headers up to the specified height were downloaded by the normal sync
+    auto sync_to(const bb::Height height) noexcept -> void
+    {
+        for (auto i = static_cast<bb::Height>(oracle_.best_.size());
+             i <= height;
+             ++i) {
+            oracle_.best_.emplace_back(hash(i));
+        }
+    }
+    auto expect(
+        const std::optional<Request>& request,
+        const bb::Height start,
+        const std::optional<bb::Height> stop) const noexcept -> void
+    {
+        ASSERT_TRUE(request.has_value());
+        EXPECT_EQ(request->start_, hash(start));
+
+        if (stop.has_value()) {
+            EXPECT_EQ(request->stop_, hash(stop.value()));
+        } else {
+            EXPECT_TRUE(request->stop_->empty());
+        }
+    }
+
+    Test_HeaderSegments()
+        : api_(ot::Context().StartClient(OTTestEnvironment::test_args_, 0))
+        , chain_()
+        , oracle_([&]() -> const bb::Hash& {
+            make_chain(30);
+
+            return chain_.front()->Hash();
+        }())
+    {
+        oracle_.default_checkpoint_ = {
+            10, hash(10), hash(9), ot::Data::Factory()};
+        oracle_.checkpoint_ = {20, hash(20)};
+    }
+};
+
+const bc::internal::Config Test_HeaderSegments::config_{};
+
+TEST_F(Test_HeaderSegments, assign)
+{
+    const auto segments = Segments{config_, oracle_};
+
+    expect(segments.Assign(first_peer_), 10, 20);
+    expect(segments.Assign(second_peer_), 20, std::nullopt);
+    EXPECT_FALSE(segments.Assign(3).has_value());
+    expect(segments.Assign(first_peer_), 10, 20);
+
+    segments.Release(first_peer_);
+
+    expect(segments.Assign(3), 10, 20);
+    EXPECT_FALSE(segments.Assign(first_peer_).has_value());
+}
+
+TEST_F(Test_HeaderSegments, disabled)
+{
+    auto config = bc::internal::Config{};
+    config.disable_segmented_headers_ = true;
+    const auto segments = Segments{config, oracle_};
+
+    EXPECT_FALSE(segments.Assign(first_peer_).has_value());
+}
+
+TEST_F(Test_HeaderSegments, progress)
+{
+    const auto segments = Segments{config_, oracle_};
+
+    expect(segments.Assign(first_peer_), 10, 20);
+
+    segments.Receive(first_peer_, headers(11, 15));
+
+    // A short batch releases the segment so another peer can finish it
+    expect(segments.Assign(second_peer_), 15, 20);
+
+    // Headers which do not extend the segment are ignored
+    segments.Receive(second_peer_, headers(17, 20));
+
+    expect(segments.Assign(second_peer_), 15, 20);
+}
+
+TEST_F(Test_HeaderSegments, stalled)
+{
+    const auto segments = Segments{config_, oracle_, 50ms};
+
+    expect(segments.Assign(first_peer_), 10, 20);
+    expect(segments.Assign(second_peer_), 20, std::nullopt);
+    EXPECT_FALSE(segments.Assign(3).has_value());
+
+    std::this_thread::sleep_for(100ms);
+
+    // Asking again counts as activity for the peer which is responding
+    expect(segments.Assign(second_peer_), 20, std::nullopt);
+    expect(segments.Assign(3), 10, 20);
+
+    // The original peer no longer owns the segment
+    segments.Receive(first_peer_, headers(11, 20));
+
+    expect(segments.Assign(3), 10, 20);
+}
+
+TEST_F(Test_HeaderSegments, checkpoint_mismatch)
+{
+    const auto segments = Segments{config_, oracle_};
+
+    expect(segments.Assign(first_peer_), 10, 20);
+
+    segments.Receive(first_peer_, headers(11, 15));
+
+    expect(segments.Assign(first_peer_), 15, 20);
+
+    // The checkpoint at height 20 is replaced by a different block
+    auto received = headers(16, 19);
+    received.emplace_back(api_.Factory().BlockHeaderForUnitTests(
+        ot::Data::Factory("fork", ot::Data::Mode::Raw), hash(19), 20));
+    segments.Receive(first_peer_, std::move(received));
+
+    // Every header received for the segment is discarded
+    expect(segments.Assign(second_peer_), 10, 20);
+}
+
+TEST_F(Test_HeaderSegments, split)
+{
+    const auto last = static_cast<bb::Height>(20 + segment_limit_);
+    make_chain(last + 5);
+    const auto segments = Segments{config_, oracle_};
+
+    expect(segments.Assign(first_peer_), 10, 20);
+    expect(segments.Assign(second_peer_), 20, std::nullopt);
+
+    for (auto start = bb::Height{21}; start <= last;
+         start += static_cast<bb::Height>(batch_)) {
+        segments.Receive(
+            second_peer_,
+            headers(start, start + static_cast<bb::Height>(batch_) - 1));
+    }
+
+    // The same peer continues with the remainder of the chain
+    expect(segments.Assign(second_peer_), last, std::nullopt);
+    EXPECT_FALSE(segments.Assign(3).has_value());
+
+    segments.Receive(second_peer_, headers(last + 1, last + 5));
+    segments.Receive(first_peer_, headers(11, 20));
+    sync_to(10);
+    segments.Flush();
+
+    ASSERT_EQ(oracle_.added_.size(), 3);
+    EXPECT_EQ(oracle_.added_.at(0), 11);
+    EXPECT_EQ(oracle_.added_.at(1), 21);
+    EXPECT_EQ(oracle_.added_.at(2), last + 1);
+    EXPECT_EQ(oracle_.BestChain().second, hash(last + 5));
+}
+
+TEST_F(Test_HeaderSegments, flush_order)
+{
+    const auto segments = Segments{config_, oracle_};
+
+    expect(segments.Assign(first_peer_), 10, 20);
+    expect(segments.Assign(second_peer_), 20, std::nullopt);
+
+    // Segments which complete before the chain reaches them are buffered
+    segments.Receive(second_peer_, headers(21, 30));
+    segments.Receive(first_peer_, headers(11, 20));
+
+    EXPECT_TRUE(oracle_.added_.empty());
+
+    sync_to(9);
+    segments.Flush();
+
+    EXPECT_TRUE(oracle_.added_.empty());
+
+    sync_to(10);
+    segments.Flush();
+
+    ASSERT_EQ(oracle_.added_.size(), 2);
+    EXPECT_EQ(oracle_.added_.at(0), 11);
+    EXPECT_EQ(oracle_.added_.at(1), 21);
+    EXPECT_EQ(oracle_.BestChain().second, hash(30));
+}
+
+TEST_F(Test_HeaderSegments, flush_obsolete)
+{
+    const auto segments = Segments{config_, oracle_};
+
+    expect(segments.Assign(first_peer_), 10, 20);
+
+    segments.Receive(first_peer_, headers(11, 20));
+    // The normal sync passed the segment before it was flushed
+    sync_to(20);
+    segments.Flush();
+
+    EXPECT_TRUE(oracle_.added_.empty());
+    expect(segments.Assign(first_peer_), 20, std::nullopt);
+}
+
+TEST_F(Test_HeaderSegments, rejected)
+{
+    const auto segments = Segments{config_, oracle_};
+
+    expect(segments.Assign(first_peer_), 10, 20);
+
+    segments.Receive(first_peer_, headers(11, 20));
+    sync_to(10);
+    oracle_.accept_ = false;
+    segments.Flush();
+
+    EXPECT_TRUE(oracle_.added_.empty());
+
+    // The segment is downloaded again instead of being lost
+    expect(segments.Assign(second_peer_), 10, 20);
+
+    oracle_.accept_ = true;
+    segments.Receive(second_peer_, headers(11, 20));
+
+    ASSERT_EQ(oracle_.added_.size(), 1);
+    EXPECT_EQ(oracle_.added_.at(0), 11);
+    EXPECT_EQ(oracle_.BestChain().second, hash(20));
+}
+}  // namespace
@@ -0,0 +1,288 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "internal/blockchain/client/Client.hpp"
+#include "internal/blockchain/client/Factory.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/Types.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/blockchain/BlockchainType.hpp"
+#include "opentxs/blockchain/block/bitcoin/Block.hpp"
+#include "opentxs/blockchain/block/bitcoin/Transaction.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Log.hpp"
+
+namespace b = ot::blockchain;
+namespace bc = b::client;
+
+namespace
+{
+const auto transaction_hex_ = std::string{
+    "01000000035a19f341c42071f9cec7df37c4853c95d6aecc95e3bf19e3181d30d99552b8c9"
+    "000000008a473044022025bca5dc0fe42aca5f07c9b3fe1b3f72113ffbc3522f8d3ebb2457"
+    "f5bdf8f9b2022030ff687c00a63e810b21e447d3a57b2749ebea553cab763eb9b99e1b9839"
+    "653b014104469f7eb54b90d90106b1a5412b41a23516028e81ad35e0418a4460707ae39a4b"
+    "f0101b632260fb08979aba0ceea576b5400c7cf30b539b055ec4c0b96ab00984ffffffff5b"
+    "72d3f4b6b72b3511bddd9994f28a91cc03212f200f71b91df13e711d58c1da000000008c49"
+    "3046022100fbef2589b7c52a3be0fd8dd3624445da9c8930f0e51f6a33d76dc0ca0304473d"
+    "0221009ec433ca6a9f16184db46468ff39cafaa9643021e0c66a1de1e6f9a6120927900141"
+    "04b27f4de096ac6431eec4b807a0d3db3e9f9be48faab692d5559624acb1faf4334dd440eb"
+    "f32a81506b7c49d8cf40e4b3f5c6b6e99fcb6d3e8a298174bd2b348dffffffff292e947388"
+    "51718433a3168e43cab1c6a811e9a0f35b06b6cec60fea9abe0f43010000008a4730440220"
+    "582813f2c2d7cbb84521f81d6c2a1147e5296e90bee05f583b3df108fdac72010220232b43"
+    "a2e596cef59f82c8bfff1a310d85e7beb3e607076ff8966d6d374dc12b014104a8514ca511"
+    "37c6d8a4befa476a7521197b886fceafa9f5c2830bea6df62792a6dd46f2b26812b250f13f"
+    "ad473e5cab6dcceaa2d53cf2c82e8e03d95a0e70836bffffffff0240420f00000000001976"
+    "a914429e6bd3c9a9ca4be00a4b2b02fd4f5895c1405988ac4083e81c000000001976a914e5"
+    "5756cb5395a4b39369d0f1f0a640c12fd867b288ac00000000"};
+// The start of each previous outpoint txid and of the first output value
+const auto prevout_prefixes_ =
+    std::vector<std::string>{"5a19f341", "5b72d3f4", "292e9473"};
+const auto value_prefix_ = std::string{"40420f00"};
+
+class FakeWallet final : public bc::internal::Wallet
+{
+public:
+    mutable std::vector<std::string> processed_{};
+    mutable std::vector<std::string> expired_{};
+
+    auto ConstructTransaction(const ot::proto::BlockchainTransactionProposal&)
+        const noexcept -> std::future<b::block::pTxid> final
+    {
+        return {};
+    }
+    auto ExpireMempool(std::vector<b::block::pTxid>&& txids) const noexcept
+        -> void final
+    {
+        for (const auto& txid : txids) { expired_.emplace_back(txid->asHex()); }
+    }
+    auto ProcessMempool(bc::internal::Mempool::Transaction tx) const noexcept
+        -> void final
+    {
+        processed_.emplace_back(tx->ID().asHex());
+    }
+
+    auto Init() noexcept -> void final {}
+    auto Shutdown() noexcept -> std::shared_future<void> final
+    {
+        auto promise = std::promise<void>{};
+        promise.set_value();
+
+        return promise.get_future();
+    }
+};
+
+class Test_Mempool : public ::testing::Test
+{
+protected:
+    using Transaction = bc::internal::Mempool::Transaction;
+
+    static constexpr auto chain_{b::Type::Bitcoin};
+
+    const ot::api::client::Manager& api_;
+    FakeWallet wallet_;
+
+    // Returns a copy of the test transaction whose inputs and first output
+    // value are replaced. Transactions with the same input byte spend the
+    // same outpoints.
+    auto make(const std::uint8_t input, const std::uint8_t value) const noexcept
+        -> Transaction
+    {
+        auto hex = transaction_hex_;
+        const auto replace = [&](const std::string& prefix, std::uint8_t byte) {
+            static constexpr auto digits{"0123456789abcdef"};
+            const auto position = hex.find(prefix);
+
+            OT_ASSERT(std::string::npos != position);
+
+            hex.at(position) = digits[byte >> 4];
+            hex.at(position + 1) = digits[byte & 0x0f];
+        };
+
+        for (const auto& prefix : prevout_prefixes_) { replace(prefix, input); }
+
+        replace(value_prefix_, value);
+        const auto bytes = api_.Factory().Data(hex, ot::StringStyle::Hex);
+        auto output = Transaction{
+            api_.Factory().BitcoinTransaction(chain_, bytes->Bytes(), false)};
+
+        OT_ASSERT(output);
+
+        return output;
+    }
+    // Returns a block which contains only the specified transaction
+    auto mine(const Transaction& tx) const noexcept
+        -> std::shared_ptr<const b::block::bitcoin::Block>
+    {
+        auto raw = api_.Factory().Data();
+        const auto serialized = tx->Serialize(raw->WriteInto());
+
+        OT_ASSERT(serialized.has_value());
+
+        const auto hex = std::string{"01000000"} + std::string(64, '0') +
+                         tx->ID().asHex() + "00000000ffff7f2000000000" + "01" +
+                         raw->asHex();
+        const auto bytes = api_.Factory().Data(hex, ot::StringStyle::Hex);
+        auto output = api_.Factory().BitcoinBlock(chain_, bytes->Bytes());
+
+        OT_ASSERT(output);
+
+        return output;
+    }
+    auto mempool(const std::size_t bytes, const std::size_t hours)
+        const noexcept -> std::unique_ptr<bc::internal::Mempool>
+    {
+        auto config = bc::internal::Config{};
+        config.mempool_bytes_ = bytes;
+        config.mempool_expiry_hours_ = hours;
+
+        return ot::factory::BlockchainMempool(config, wallet_);
+    }
+
+    Test_Mempool()
+        : api_(ot::Context().StartClient(OTTestEnvironment::test_args_, 0))
+        , wallet_()
+    {
+    }
+};
+
+TEST_F(Test_Mempool, submit)
+{
+    const auto pool = mempool(1024 * 1024, 1);
+    const auto tx = make(0x01, 0x01);
+    const auto txid = tx->ID().asHex();
+
+    EXPECT_TRUE(pool->Submit(tx));
+    EXPECT_FALSE(pool->Submit(tx));
+    ASSERT_EQ(wallet_.processed_.size(), 1);
+    EXPECT_EQ(wallet_.processed_.at(0), txid);
+    EXPECT_TRUE(wallet_.expired_.empty());
+
+    const auto found = pool->Query(tx->ID().Bytes());
+
+    ASSERT_TRUE(found);
+    EXPECT_EQ(found->ID().asHex(), txid);
+
+    const auto dump = pool->Dump();
+
+    ASSERT_EQ(dump.size(), 1);
+    EXPECT_EQ(dump.at(0)->asHex(), txid);
+    EXPECT_EQ(pool->Snapshot().size(), 1);
+}
+
+TEST_F(Test_Mempool, disabled)
+{
+    const auto pool = mempool(0, 1);
+    const auto tx = make(0x01, 0x01);
+
+    EXPECT_FALSE(pool->Submit(tx));
+    EXPECT_TRUE(pool->Request({tx->ID()}).empty());
+    EXPECT_TRUE(wallet_.processed_.empty());
+}
+
+TEST_F(Test_Mempool, conflict)
+{
+    const auto pool = mempool(1024 * 1024, 1);
+    const auto first = make(0x01, 0x01);
+    const auto conflict = make(0x01, 0x02);
+    const auto independent = make(0x02, 0x01);
+
+    EXPECT_TRUE(pool->Submit(first));
+    EXPECT_FALSE(pool->Submit(conflict));
+    EXPECT_TRUE(pool->Submit(independent));
+    EXPECT_FALSE(pool->Query(conflict->ID().Bytes()));
+    EXPECT_EQ(wallet_.processed_.size(), 2);
+}
+
+TEST_F(Test_Mempool, request)
+{
+    const auto pool = mempool(1024 * 1024, 1);
+    const auto tx = make(0x01, 0x01);
+
+    EXPECT_EQ(pool->Request({tx->ID()}).size(), 1);
+    EXPECT_TRUE(pool->Request({tx->ID()}).empty());
+    EXPECT_TRUE(pool->Submit(tx));
+    EXPECT_TRUE(pool->Request({tx->ID()}).empty());
+}
+
+TEST_F(Test_Mempool, expire)
+{
+    const auto pool = mempool(1024 * 1024, 0);
+    const auto tx = make(0x01, 0x01);
+
+    EXPECT_TRUE(pool->Submit(tx));
+    EXPECT_TRUE(pool->Dump().empty());
+    ASSERT_EQ(wallet_.expired_.size(), 1);
+    EXPECT_EQ(wallet_.expired_.at(0), tx->ID().asHex());
+}
+
+TEST_F(Test_Mempool, evict)
+{
+    const auto first = make(0x01, 0x01);
+    const auto second = make(0x02, 0x01);
+    const auto third = make(0x03, 0x01);
+    const auto pool = mempool(2 * first->CalculateSize(), 1);
+
+    EXPECT_TRUE(pool->Submit(first));
+    EXPECT_TRUE(pool->Submit(second));
+    EXPECT_TRUE(wallet_.expired_.empty());
+    EXPECT_TRUE(pool->Submit(third));
+    ASSERT_EQ(wallet_.expired_.size(), 1);
+    EXPECT_EQ(wallet_.expired_.at(0), first->ID().asHex());
+    EXPECT_FALSE(pool->Query(first->ID().Bytes()));
+    EXPECT_TRUE(pool->Query(second->ID().Bytes()));
+    EXPECT_TRUE(pool->Query(third->ID().Bytes()));
+
+    // The outpoints spent by an evicted transaction are released
+    EXPECT_TRUE(pool->Submit(make(0x01, 0x02)));
+}
+
+TEST_F(Test_Mempool, prune_confirmed)
+{
+    const auto pool = mempool(1024 * 1024, 1);
+    const auto mined = make(0x01, 0x01);
+    const auto other = make(0x02, 0x01);
+
+    EXPECT_TRUE(pool->Submit(mined));
+    EXPECT_TRUE(pool->Submit(other));
+
+    pool->Prune(*mine(mined));
+
+    EXPECT_FALSE(pool->Query(mined->ID().Bytes()));
+    EXPECT_TRUE(pool->Query(other->ID().Bytes()));
+    EXPECT_EQ(pool->Dump().size(), 1);
+    EXPECT_TRUE(wallet_.expired_.empty());
+}
+
+TEST_F(Test_Mempool, prune_conflict)
+{
+    const auto pool = mempool(1024 * 1024, 1);
+    const auto replaced = make(0x01, 0x01);
+    const auto other = make(0x02, 0x01);
+
+    EXPECT_TRUE(pool->Submit(replaced));
+    EXPECT_TRUE(pool->Submit(other));
+
+    pool->Prune(*mine(make(0x01, 0x02)));
+
+    EXPECT_FALSE(pool->Query(replaced->ID().Bytes()));
+    EXPECT_TRUE(pool->Query(other->ID().Bytes()));
+    ASSERT_EQ(wallet_.expired_.size(), 1);
+    EXPECT_EQ(wallet_.expired_.at(0), replaced->ID().asHex());
+}
+}  // namespace
@@ -5,6 +5,7 @@
 
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <set>
 #include <utility>
@@ -23,10 +24,12 @@
 #include "opentxs/Pimpl.hpp"
 #include "opentxs/api/Context.hpp"
 #include "opentxs/api/client/Manager.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
 #include "opentxs/blockchain/BlockchainType.hpp"
 #include "opentxs/blockchain/p2p/Types.hpp"
 #include "opentxs/core/Data.hpp"
 #include "opentxs/network/zeromq/Context.hpp"
+#include "opentxs/network/zeromq/Frame.hpp"
 #include "opentxs/network/zeromq/Message.hpp"
 
 namespace boost
@@ -148,4 +151,40 @@ TEST_F(Test_Message, getblocks)
         ASSERT_TRUE(pMessage->payload() == pLoadedMsg->payload());
     }
 }
+
+TEST_F(Test_Message, encoded_block)
+{
+    namespace bitcoin = ot::blockchain::p2p::bitcoin;
+
+    const auto chain = ot::blockchain::Type::Bitcoin;
+    const auto headerSize = bitcoin::Header::Size();
+    auto block = ot::Data::Factory();
+    block->Randomize(300);
+    auto checksum = ot::Data::Factory();
+
+    ASSERT_TRUE(ot::blockchain::P2PMessageHash(
+        api_, chain, block->Bytes(), checksum->WriteInto()));
+
+    const auto encoded =
+        ot::factory::BitcoinP2PBlockEncoded(api_, chain, block->Bytes());
+
+    ASSERT_TRUE(encoded);
+    ASSERT_EQ(headerSize + block->size(), encoded->size());
+
+    auto frame = api_.ZeroMQ().Message(
+        ot::Data::Factory(encoded->data(), headerSize));
+    std::unique_ptr<bitcoin::Header> pHeader{
+        ot::factory::BitcoinP2PHeader(api_, frame->at(0))};
+
+    ASSERT_TRUE(pHeader);
+    EXPECT_EQ(bitcoin::Command::block, pHeader->Command());
+    EXPECT_EQ(block->size(), pHeader->PayloadSize());
+    EXPECT_EQ(checksum.get(), pHeader->Checksum());
+
+    const auto payload = ot::Data::Factory(
+        static_cast<const std::byte*>(encoded->data()) + headerSize,
+        block->size());
+
+    EXPECT_EQ(block.get(), payload.get());
+}
 }  // namespace
@@ -4,11 +4,19 @@
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <boost/endian/buffers.hpp>
+#include <boost/multiprecision/cpp_bin_float.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
 #include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <random>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "blockchain/UInt256.hpp"
 #include "internal/api/client/Client.hpp"
 #include "internal/blockchain/Blockchain.hpp"
 #include "opentxs/OT.hpp"
@@ -21,6 +29,7 @@
 #include "opentxs/core/Data.hpp"
 
 namespace be = boost::endian;
+namespace mp = boost::multiprecision;
 
 namespace
 {
@@ -29,6 +38,83 @@ class Test_NumericHash : public ::testing::Test
 public:
     const ot::api::client::internal::Manager& api_;
 
+    using Targets =
+        std::pair<std::vector<std::string>, std::vector<std::uint32_t>>;
+
+    static constexpr auto max_bits_ = std::uint32_t{0x1d00ffff};
+
+    // Random little endian hashes, most of which satisfy their target
+    static auto targets(const std::size_t count) noexcept -> Targets
+    {
+        auto rng = std::mt19937_64{};
+        auto output = Targets{};
+        auto& [hashes, bits] = output;
+
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            auto& hash = hashes.emplace_back(32, '\0');
+
+            for (auto& c : hash) { c = static_cast<char>(rng()); }
+
+            hash.at(31) = 0x0;
+            hash.at(30) = 0x0;
+            hash.at(29) = 0x0;
+            hash.at(28) = static_cast<char>(rng() % 2);
+            bits.emplace_back(
+                0x1c000000 | static_cast<std::uint32_t>(rng() >> 40));
+        }
+
+        return output;
+    }
+    // Validates each hash and sums the work of its target in the same way
+    // as the boost::multiprecision implementation of NumericHash and Work
+    static auto reference_work(
+        const std::vector<std::string>& hashes,
+        const std::vector<std::uint32_t>& bits,
+        std::vector<bool>& valid) noexcept -> mp::cpp_bin_float_double
+    {
+        using TargetType = mp::checked_cpp_int;
+        using WorkType = mp::cpp_bin_float_double;
+
+        const auto decode = [](const std::uint32_t nBits) {
+            const auto mantissa = TargetType{nBits & 0x007fffff};
+            const auto exponent = (nBits & 0xff000000) >> 24;
+
+            return TargetType{mantissa << (8 * (exponent - 3))};
+        };
+        const auto max = WorkType{decode(max_bits_)};
+        auto total = WorkType{};
+
+        for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+            const auto& hash = hashes.at(i);
+            const auto target = decode(bits.at(i));
+            auto pow = TargetType{};
+            mp::import_bits(pow, hash.begin(), hash.end(), 8, false);
+            valid.emplace_back(pow < target);
+            total += max / WorkType{target};
+        }
+
+        return total;
+    }
+    static auto fixed_work(
+        const std::vector<std::string>& hashes,
+        const std::vector<std::uint32_t>& bits,
+        std::vector<bool>& valid) noexcept -> ot::blockchain::UInt256
+    {
+        using UInt256 = ot::blockchain::UInt256;
+
+        const auto max = UInt256::FromCompact(max_bits_);
+        auto total = UInt256{};
+
+        for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+            const auto target = UInt256::FromCompact(bits.at(i));
+            const auto pow = UInt256::FromLittleEndian(hashes.at(i));
+            valid.emplace_back(pow < target);
+            total = total + (max / target);
+        }
+
+        return total;
+    }
+
     Test_NumericHash()
         : api_(dynamic_cast<const ot::api::client::internal::Manager&>(
               ot::Context().StartClient(OTTestEnvironment::test_args_, 0)))
@@ -160,4 +246,108 @@ TEST_F(Test_NumericHash, nBits_5)
             ->Decimal()
             .c_str());
 }
+
+TEST_F(Test_NumericHash, uint256)
+{
+    using UInt256 = ot::blockchain::UInt256;
+
+    const auto convert = [](const UInt256& in) {
+        const auto bytes = in.BigEndian();
+        auto out = mp::cpp_int{};
+        mp::import_bits(out, bytes.begin(), bytes.end(), 8, true);
+
+        return out;
+    };
+    const auto max = (mp::cpp_int{1} << 256) - 1;
+    auto rng = std::mt19937_64{};
+
+    for (auto i = std::size_t{0}; i < 1000; ++i) {
+        auto lhs = std::string(rng() % 33, '\0');
+        auto rhs = std::string(rng() % 33, '\0');
+
+        for (auto& c : lhs) { c = static_cast<char>(rng()); }
+        for (auto& c : rhs) { c = static_cast<char>(rng()); }
+
+        const auto a = UInt256::FromLittleEndian(lhs);
+        const auto b = UInt256::FromLittleEndian(rhs);
+        const auto A = convert(a);
+        const auto B = convert(b);
+        const auto sum = mp::cpp_int{A + B};
+
+        EXPECT_EQ(a < b, A < B);
+        EXPECT_EQ(a <= b, A <= B);
+        EXPECT_EQ(a == b, A == B);
+        EXPECT_EQ(convert(a + b), (sum > max) ? max : sum);
+        EXPECT_EQ(a.Decimal(), A.str());
+
+        if (false == b.IsZero()) { EXPECT_EQ(convert(a / b), A / B); }
+    }
+
+    static_assert(UInt256::FromCompact(0x05009234) == UInt256{2452881408});
+    static_assert(UInt256::FromCompact(0x04123456) == UInt256{305419776});
+    static_assert(UInt256::FromCompact(0x01123456) == UInt256{0x12});
+    static_assert(UInt256::FromCompact(0xff123456) == UInt256::Max());
+    static_assert(UInt256::Max() + UInt256{1} == UInt256::Max());
+}
+
+TEST_F(Test_NumericHash, work_round_trip)
+{
+    const auto chain = ot::blockchain::Type::Bitcoin;
+    const auto one = ot::OTWork{ot::factory::Work(chain, 0x1d00ffff)};
+    const auto work = ot::OTWork{ot::factory::Work(chain, 0x1b0404cb)};
+    const auto total = work + one;
+    const auto copy = ot::OTWork{ot::factory::Work(total->asHex())};
+
+    EXPECT_STREQ("1", one->Decimal().c_str());
+    EXPECT_STREQ("16307", work->Decimal().c_str());
+    EXPECT_STREQ("16308", total->Decimal().c_str());
+    EXPECT_EQ(total->asHex(), copy->asHex());
+    EXPECT_TRUE(total.get() > work.get());
+}
+
+// Compares the per header target decoding, proof of work check and work
+// accumulation of boost::multiprecision against UInt256
+TEST_F(Test_NumericHash, reference_arithmetic)
+{
+    const auto [hashes, bits] = targets(20000);
+    auto before = std::vector<bool>{};
+    auto after = std::vector<bool>{};
+
+    EXPECT_LT(0, reference_work(hashes, bits, before));
+    EXPECT_LT(ot::blockchain::UInt256{}, fixed_work(hashes, bits, after));
+    EXPECT_EQ(before, after);
+}
+
+// Run with --gtest_also_run_disabled_tests to compare the header validation
+// arithmetic with the boost::multiprecision implementation it replaced
+TEST_F(Test_NumericHash, DISABLED_reference_benchmark)
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr auto rounds = std::size_t{10};
+    const auto [hashes, bits] = targets(100000);
+    auto valid = std::vector<bool>{};
+    auto reference = Clock::duration{};
+    auto fixed = Clock::duration{};
+
+    for (auto i = std::size_t{0}; i < rounds; ++i) {
+        valid.clear();
+        const auto start = Clock::now();
+        const auto total = reference_work(hashes, bits, valid);
+        reference += Clock::now() - start;
+
+        EXPECT_LT(0, total);
+    }
+
+    for (auto i = std::size_t{0}; i < rounds; ++i) {
+        valid.clear();
+        const auto start = Clock::now();
+        const auto total = fixed_work(hashes, bits, valid);
+        fixed += Clock::now() - start;
+
+        EXPECT_LT(ot::blockchain::UInt256{}, total);
+    }
+
+    EXPECT_LT(fixed, reference);
+}
 }  // namespace
@@ -0,0 +1,151 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <set>
+
+#include "internal/blockchain/p2p/P2P.hpp"
+#include "opentxs/Bytes.hpp"
+
+namespace ot = opentxs;
+
+namespace
+{
+using Stats = ot::blockchain::p2p::internal::PeerStatistics;
+using Rates = ot::blockchain::p2p::internal::PeerRates;
+
+auto stats(
+    const std::uint64_t speed,
+    const std::uint32_t handshake,
+    const std::uint32_t connections,
+    const std::uint32_t failures,
+    const std::uint32_t timeouts) noexcept -> Stats
+{
+    auto output = Stats{};
+    output.bytes_per_second_ = speed;
+    output.handshake_ms_ = handshake;
+    output.connections_ = connections;
+    output.failures_ = failures;
+    output.timeouts_ = timeouts;
+
+    return output;
+}
+
+TEST(Test_PeerStatistics, weight_unmeasured)
+{
+    EXPECT_DOUBLE_EQ(Stats{}.Weight(), 2.0);
+}
+
+TEST(Test_PeerStatistics, weight_speed)
+{
+    const auto slow = stats(1024, 0, 0, 0, 0);
+    const auto fast = stats(1024 * 1024, 0, 0, 0, 0);
+    const auto capped = stats(1024 * 1024 * 1024, 0, 0, 0, 0);
+
+    EXPECT_LT(slow.Weight(), Stats{}.Weight());
+    EXPECT_GT(fast.Weight(), Stats{}.Weight());
+    EXPECT_DOUBLE_EQ(capped.Weight(), 10.0);
+}
+
+TEST(Test_PeerStatistics, weight_latency)
+{
+    const auto quick = stats(0, 100, 0, 0, 0);
+    const auto normal = stats(0, 1000, 0, 0, 0);
+    const auto lagging = stats(0, 5000, 0, 0, 0);
+
+    EXPECT_DOUBLE_EQ(quick.Weight(), 3.0);
+    EXPECT_DOUBLE_EQ(normal.Weight(), 2.0);
+    EXPECT_DOUBLE_EQ(lagging.Weight(), 1.0);
+}
+
+TEST(Test_PeerStatistics, weight_reliability)
+{
+    const auto reliable = stats(0, 0, 9, 0, 0);
+    const auto failing = stats(0, 0, 0, 9, 0);
+    const auto timing_out = stats(0, 0, 1, 0, 8);
+
+    EXPECT_DOUBLE_EQ(reliable.Weight(), 2.0);
+    EXPECT_DOUBLE_EQ(failing.Weight(), 0.2);
+    EXPECT_DOUBLE_EQ(timing_out.Weight(), 0.4);
+}
+
+TEST(Test_PeerStatistics, serialize)
+{
+    const auto original = stats(123456, 789, 10, 2, 3);
+    const auto bytes = original.Serialize();
+    const auto parsed = Stats::Deserialize(ot::reader(bytes));
+
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->bytes_per_second_, original.bytes_per_second_);
+    EXPECT_EQ(parsed->handshake_ms_, original.handshake_ms_);
+    EXPECT_EQ(parsed->connections_, original.connections_);
+    EXPECT_EQ(parsed->failures_, original.failures_);
+    EXPECT_EQ(parsed->timeouts_, original.timeouts_);
+}
+
+TEST(Test_PeerStatistics, deserialize_unversioned)
+{
+    const auto original = stats(123456, 789, 10, 2, 3);
+    auto bytes = original.Serialize();
+    bytes.erase(bytes.begin(), bytes.begin() + sizeof(Stats::version_));
+    const auto parsed = Stats::Deserialize(ot::reader(bytes));
+
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->bytes_per_second_, original.bytes_per_second_);
+    EXPECT_EQ(parsed->timeouts_, original.timeouts_);
+}
+
+TEST(Test_PeerStatistics, deserialize_invalid)
+{
+    auto bytes = stats(1, 2, 3, 4, 5).Serialize();
+
+    EXPECT_FALSE(Stats::Deserialize({}).has_value());
+    EXPECT_FALSE(
+        Stats::Deserialize(ot::ReadView{
+                               reinterpret_cast<const char*>(bytes.data()),
+                               bytes.size() - 1})
+            .has_value());
+
+    const auto unknown = Stats::version_ + 1;
+    std::memcpy(bytes.data(), &unknown, sizeof(unknown));
+
+    EXPECT_FALSE(Stats::Deserialize(ot::reader(bytes)).has_value());
+}
+
+TEST(Test_PeerStatistics, slow_peer)
+{
+    const auto rates = Rates{{1, 1000}, {2, 500}, {3, 2000}};
+
+    EXPECT_EQ(ot::blockchain::p2p::internal::SlowPeer(rates, {}, 10000), 2);
+}
+
+TEST(Test_PeerStatistics, slow_peer_target_met)
+{
+    const auto rates = Rates{{1, 1000}, {2, 500}, {3, 2000}};
+
+    EXPECT_FALSE(
+        ot::blockchain::p2p::internal::SlowPeer(rates, {}, 3500).has_value());
+}
+
+TEST(Test_PeerStatistics, slow_peer_exempt)
+{
+    const auto rates = Rates{{1, 1000}, {2, 500}, {3, 2000}};
+
+    EXPECT_EQ(ot::blockchain::p2p::internal::SlowPeer(rates, {2}, 10000), 1);
+    EXPECT_FALSE(ot::blockchain::p2p::internal::SlowPeer(
+                     Rates{{1, 1000}, {2, 500}}, {1, 2}, 10000)
+                     .has_value());
+}
+
+TEST(Test_PeerStatistics, slow_peer_single)
+{
+    EXPECT_FALSE(ot::blockchain::p2p::internal::SlowPeer(
+                     Rates{{1, 500}}, {}, 10000)
+                     .has_value());
+}
+}  // namespace
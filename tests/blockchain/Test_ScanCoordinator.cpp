@@ -0,0 +1,212 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "blockchain/client/wallet/ScanCoordinator.hpp"
+#include "internal/blockchain/Blockchain.hpp"
+#include "internal/blockchain/client/Client.hpp"
+#include "opentxs/Bytes.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/api/client/blockchain/Subchain.hpp"
+#include "opentxs/blockchain/FilterType.hpp"
+#include "opentxs/blockchain/client/FilterOracle.hpp"
+#include "opentxs/core/Data.hpp"
+#include "opentxs/core/Identifier.hpp"
+
+namespace b = ot::blockchain;
+namespace bw = b::client::wallet;
+
+namespace
+{
+using Coordinator = bw::ScanCoordinator;
+using Patterns = Coordinator::Patterns;
+using SubchainID = Coordinator::SubchainID;
+
+const auto params_ =
+    b::internal::GetFilterParams(b::filter::Type::Basic_BIP158);
+const auto key_ = std::string{"0123456789abcdef"};
+
+class Test_ScanCoordinator : public ::testing::Test
+{
+protected:
+    const ot::api::client::Manager& api_;
+    const SubchainID first_;
+    const SubchainID empty_;
+    const SubchainID second_;
+
+    auto id(const std::string& seed) const noexcept -> SubchainID
+    {
+        auto node = api_.Factory().Identifier();
+        node->CalculateDigest(seed);
+
+        return {ot::api::client::blockchain::Subchain::External, node};
+    }
+    // Returns count patterns owned by the subchain
+    auto patterns(const SubchainID& owner, const std::size_t count)
+        const noexcept -> Patterns
+    {
+        auto output = Patterns{};
+
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            const auto element =
+                owner.second->str() + "-" + std::to_string(i);
+            output.emplace_back(
+                std::make_pair(static_cast<ot::Bip32Index>(i), owner),
+                ot::space(element));
+        }
+
+        return output;
+    }
+    // Merges the patterns of every subchain and appends two unspent outputs
+    auto merge(Patterns& merged, b::client::GCS::Targets& targets)
+        const noexcept -> Coordinator::Owners
+    {
+        auto input = std::vector<std::pair<SubchainID, Patterns>>{};
+        input.emplace_back(first_, patterns(first_, 2));
+        input.emplace_back(empty_, Patterns{});
+        input.emplace_back(second_, patterns(second_, 3));
+        auto output = Coordinator::Merge(std::move(input), merged);
+
+        for (const auto& [id, data] : merged) {
+            targets.emplace_back(ot::reader(data));
+        }
+
+        targets.emplace_back(utxo_0_);
+        targets.emplace_back(utxo_1_);
+
+        return output;
+    }
+    auto filter(const std::vector<ot::ReadView>& elements) const noexcept
+        -> std::unique_ptr<b::client::GCS>
+    {
+        auto included = std::vector<ot::OTData>{};
+
+        for (const auto& element : elements) {
+            included.emplace_back(
+                ot::Data::Factory(element.data(), element.size()));
+        }
+
+        return ot::factory::GCS(
+            api_, params_.first, params_.second, key_, included);
+    }
+
+    Test_ScanCoordinator()
+        : api_(ot::Context().StartClient(OTTestEnvironment::test_args_, 0))
+        , first_(id("first"))
+        , empty_(id("empty"))
+        , second_(id("second"))
+    {
+    }
+
+private:
+    static constexpr auto utxo_0_{"unspent output 0"};
+    static constexpr auto utxo_1_{"unspent output 1"};
+};
+
+TEST_F(Test_ScanCoordinator, merge)
+{
+    auto merged = Patterns{};
+    merged.emplace_back(patterns(id("existing"), 1).front());
+    auto input = std::vector<std::pair<SubchainID, Patterns>>{};
+    input.emplace_back(first_, patterns(first_, 2));
+    input.emplace_back(empty_, Patterns{});
+    input.emplace_back(second_, patterns(second_, 3));
+    const auto owners = Coordinator::Merge(std::move(input), merged);
+
+    ASSERT_EQ(merged.size(), 6);
+    ASSERT_EQ(owners.size(), 2);
+    EXPECT_EQ(owners.at(3), first_);
+    EXPECT_EQ(owners.at(6), second_);
+    EXPECT_EQ(merged.at(1).first.second, first_);
+    EXPECT_EQ(merged.at(2).first.second, first_);
+    EXPECT_EQ(merged.at(3).first.second, second_);
+    EXPECT_EQ(merged.at(5).first.second, second_);
+}
+
+TEST_F(Test_ScanCoordinator, no_match)
+{
+    auto merged = Patterns{};
+    auto targets = b::client::GCS::Targets{};
+    const auto owners = merge(merged, targets);
+    const auto pFilter = filter({"unrelated"});
+
+    ASSERT_TRUE(pFilter);
+
+    const auto pass = Coordinator::Attribute(
+        targets, merged.size(), owners, pFilter->Match(targets));
+
+    EXPECT_FALSE(pass.missing_);
+    EXPECT_FALSE(pass.utxo_);
+    EXPECT_TRUE(pass.matches_.empty());
+}
+
+TEST_F(Test_ScanCoordinator, attribute_subchains)
+{
+    auto merged = Patterns{};
+    auto targets = b::client::GCS::Targets{};
+    const auto owners = merge(merged, targets);
+
+    ASSERT_EQ(merged.size(), 5);
+
+    // The last pattern of the first subchain and the first pattern of the
+    // second subchain sit on either side of an ownership boundary
+    const auto pFilter = filter({targets.at(1), targets.at(2)});
+
+    ASSERT_TRUE(pFilter);
+
+    const auto pass = Coordinator::Attribute(
+        targets, merged.size(), owners, pFilter->Match(targets));
+
+    EXPECT_FALSE(pass.utxo_);
+    EXPECT_EQ(pass.matches_.size(), 2);
+    EXPECT_EQ(pass.matches_.count(first_), 1);
+    EXPECT_EQ(pass.matches_.count(second_), 1);
+    EXPECT_EQ(pass.matches_.count(empty_), 0);
+}
+
+TEST_F(Test_ScanCoordinator, attribute_single_subchain)
+{
+    auto merged = Patterns{};
+    auto targets = b::client::GCS::Targets{};
+    const auto owners = merge(merged, targets);
+    const auto pFilter = filter({targets.at(4)});
+
+    ASSERT_TRUE(pFilter);
+
+    const auto pass = Coordinator::Attribute(
+        targets, merged.size(), owners, pFilter->Match(targets));
+
+    EXPECT_FALSE(pass.utxo_);
+    ASSERT_EQ(pass.matches_.size(), 1);
+    EXPECT_EQ(*pass.matches_.begin(), second_);
+}
+
+TEST_F(Test_ScanCoordinator, attribute_unspent_output)
+{
+    auto merged = Patterns{};
+    auto targets = b::client::GCS::Targets{};
+    const auto owners = merge(merged, targets);
+    const auto pFilter = filter({targets.back()});
+
+    ASSERT_TRUE(pFilter);
+
+    const auto pass = Coordinator::Attribute(
+        targets, merged.size(), owners, pFilter->Match(targets));
+
+    EXPECT_TRUE(pass.utxo_);
+    EXPECT_TRUE(pass.matches_.empty());
+}
+}  // namespace
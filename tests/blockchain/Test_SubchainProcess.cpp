@@ -0,0 +1,203 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "blockchain/client/wallet/SubchainJobs.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/blockchain/client/BlockOracle.hpp"
+#include "opentxs/core/Data.hpp"
+
+namespace b = ot::blockchain;
+namespace bi = b::client::internal;
+
+namespace
+{
+using Job = bi::ProcessJob;
+using Matched = bi::MatchedBlock;
+using OutstandingMap = bi::OutstandingBlocks;
+using ProcessQueue = bi::ProcessQueue;
+using Block = b::client::BlockOracle::BitcoinBlock_p;
+
+class Test_SubchainProcess : public ::testing::Test
+{
+protected:
+    const ot::api::client::Manager& api_;
+    std::vector<std::promise<Block>> downloads_;
+    OutstandingMap outstanding_;
+    ProcessQueue queue_;
+
+    auto hash(const std::uint32_t index) const noexcept -> b::block::pHash
+    {
+        return api_.Factory().Data(index);
+    }
+    // Queues blocks 0 through count - 1, none of which have been downloaded
+    auto queue(const std::uint32_t count) noexcept -> void
+    {
+        downloads_.resize(count);
+
+        for (auto i = std::uint32_t{0}; i < count; ++i) {
+            auto [it, added] = outstanding_.emplace(
+                hash(i),
+                bi::PendingBlock{
+                    downloads_.at(i).get_future().share(), nullptr});
+
+            ASSERT_TRUE(added);
+
+            queue_.push_back(it);
+        }
+    }
+    auto download(const std::size_t index) noexcept -> void
+    {
+        downloads_.at(index).set_value(nullptr);
+    }
+    auto match(const std::size_t index) noexcept -> void
+    {
+        queue_.at(index)->second.matched_ = std::make_shared<Matched>();
+    }
+
+    Test_SubchainProcess()
+        : api_(ot::Context().StartClient(OTTestEnvironment::test_args_, 0))
+        , downloads_()
+        , outstanding_()
+        , queue_()
+    {
+    }
+};
+
+TEST_F(Test_SubchainProcess, prefetch)
+{
+    queue(1);
+    auto requests =
+        std::vector<b::block::pHash>{hash(0), hash(1), hash(1), hash(2)};
+    requests.emplace_back(hash(3));
+    requests.emplace_back(hash(4));
+    const auto output = bi::PrefetchBlocks(3, outstanding_, requests);
+
+    ASSERT_EQ(output.size(), 2);
+    EXPECT_EQ(output.at(0), hash(1));
+    EXPECT_EQ(output.at(1), hash(2));
+    ASSERT_EQ(requests.size(), 2);
+    EXPECT_EQ(requests.at(0), hash(3));
+    EXPECT_EQ(requests.at(1), hash(4));
+}
+
+TEST_F(Test_SubchainProcess, prefetch_window_full)
+{
+    queue(3);
+    auto requests = std::vector<b::block::pHash>{hash(3), hash(4)};
+    const auto output = bi::PrefetchBlocks(3, outstanding_, requests);
+
+    EXPECT_TRUE(output.empty());
+    EXPECT_EQ(requests.size(), 2);
+}
+
+TEST_F(Test_SubchainProcess, prefetch_all)
+{
+    auto requests = std::vector<b::block::pHash>{hash(0), hash(1)};
+    const auto output = bi::PrefetchBlocks(16, outstanding_, requests);
+
+    EXPECT_EQ(output.size(), 2);
+    EXPECT_TRUE(requests.empty());
+}
+
+TEST_F(Test_SubchainProcess, ready)
+{
+    queue(4);
+
+    EXPECT_TRUE(bi::ReadyBlocks(queue_).empty());
+
+    download(1);
+    download(2);
+    download(3);
+    match(2);
+    const auto output = bi::ReadyBlocks(queue_);
+
+    ASSERT_EQ(output.size(), 2);
+    EXPECT_EQ(output.at(0), queue_.at(1));
+    EXPECT_EQ(output.at(1), queue_.at(3));
+}
+
+TEST_F(Test_SubchainProcess, take_matched)
+{
+    queue(4);
+    const auto original = queue_;
+    match(0);
+    match(1);
+    match(3);
+    const auto output = bi::TakeMatchedBlocks(queue_);
+
+    ASSERT_EQ(output.size(), 2);
+    EXPECT_EQ(output.at(0), original.at(0));
+    EXPECT_EQ(output.at(1), original.at(1));
+    ASSERT_EQ(queue_.size(), 2);
+    EXPECT_EQ(queue_.at(0), original.at(2));
+    EXPECT_EQ(queue_.at(1), original.at(3));
+    EXPECT_TRUE(bi::TakeMatchedBlocks(queue_).empty());
+
+    match(0);
+    const auto remaining = bi::TakeMatchedBlocks(queue_);
+
+    ASSERT_EQ(remaining.size(), 2);
+    EXPECT_EQ(remaining.at(0), original.at(2));
+    EXPECT_EQ(remaining.at(1), original.at(3));
+    EXPECT_TRUE(queue_.empty());
+}
+
+TEST_F(Test_SubchainProcess, parallel_match)
+{
+    constexpr auto count = std::uint32_t{64};
+    constexpr auto threads = std::size_t{4};
+    queue(count);
+
+    for (auto i = std::size_t{0}; i < count; ++i) { download(i); }
+
+    auto job = Job{bi::ReadyBlocks(queue_)};
+    auto claimed = std::vector<std::atomic<int>>(count);
+    auto workers = std::vector<std::thread>{};
+
+    ASSERT_EQ(job.items_.size(), count);
+
+    for (auto i = std::size_t{0}; i < threads; ++i) {
+        workers.emplace_back([&] {
+            for (auto* item = job.Next(); nullptr != item; item = job.Next()) {
+                const auto index = static_cast<std::size_t>(
+                    item - job.items_.data());
+                ++claimed.at(index);
+                item->matched_ = std::make_shared<Matched>();
+                item->promise_.set_value();
+            }
+        });
+    }
+
+    for (auto& worker : workers) { worker.join(); }
+
+    job.Finish();
+
+    for (const auto& times : claimed) { EXPECT_EQ(times.load(), 1); }
+
+    const auto output = bi::TakeMatchedBlocks(queue_);
+
+    EXPECT_EQ(output.size(), count);
+    EXPECT_TRUE(queue_.empty());
+
+    for (auto i = std::size_t{0}; i < output.size(); ++i) {
+        EXPECT_EQ(output.at(i)->first, hash(static_cast<std::uint32_t>(i)));
+    }
+}
+}  // namespace
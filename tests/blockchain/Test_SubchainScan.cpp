@@ -0,0 +1,244 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "blockchain/client/wallet/SubchainJobs.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/core/Data.hpp"
+
+namespace b = ot::blockchain;
+
+namespace
+{
+using Job = b::client::internal::ScanJob;
+using Height = b::block::Height;
+
+constexpr auto interval_{Height{50}};
+constexpr auto threads_{std::size_t{4}};
+
+class Test_SubchainScan : public ::testing::Test
+{
+protected:
+    const ot::api::client::Manager& api_;
+
+    auto hash(const Height height) const noexcept -> b::block::pHash
+    {
+        return api_.Factory().Data(static_cast<std::uint32_t>(height));
+    }
+    // Heights which would be requested by a scan from first to last, where
+    // every multiple of interval_ matches
+    auto expected(const Height first, const Height last) const noexcept
+        -> std::vector<b::block::pHash>
+    {
+        auto output = std::vector<b::block::pHash>{};
+
+        for (auto i{first}; i <= last; ++i) {
+            if (0 == (i % interval_)) { output.emplace_back(hash(i)); }
+        }
+
+        return output;
+    }
+    // Claims ranges in the same way as SubchainStateData::scan_range. The
+    // filter at the specified height is missing. Ranges near the start of the
+    // job take longer to finish so later ranges tend to complete first.
+    auto scan(Job& job, const std::optional<Height> missing) const noexcept
+        -> void
+    {
+        for (auto* range = job.Next(); nullptr != range; range = job.Next()) {
+            const auto remaining = job.ranges_.size() -
+                                   static_cast<std::size_t>(
+                                       range - job.ranges_.data());
+            std::this_thread::sleep_for(std::chrono::milliseconds(remaining));
+
+            for (auto i{range->first_}; i <= range->last_; ++i) {
+                if (i > job.stop_.load()) { break; }
+
+                if (missing.has_value() && (i == missing.value())) {
+                    range->missing_ = b::block::Position{i, hash(i)};
+                    job.Stop(i);
+
+                    break;
+                }
+
+                range->highest_ = b::block::Position{i, hash(i)};
+
+                if (0 == (i % interval_)) {
+                    range->matches_.emplace_back(hash(i));
+                }
+            }
+
+            range->promise_.set_value();
+        }
+    }
+    auto run(Job& job, const std::optional<Height> missing) const noexcept
+        -> void
+    {
+        auto workers = std::vector<std::thread>{};
+
+        for (auto i = std::size_t{0}; i < threads_; ++i) {
+            workers.emplace_back([&] { scan(job, missing); });
+        }
+
+        for (auto& worker : workers) { worker.join(); }
+    }
+
+    Test_SubchainScan()
+        : api_(ot::Context().StartClient(OTTestEnvironment::test_args_, 0))
+    {
+    }
+};
+
+TEST_F(Test_SubchainScan, ranges)
+{
+    constexpr auto first = Height{1};
+    constexpr auto last = Height{10000};
+    const auto job = Job{{}, first, last, threads_};
+
+    ASSERT_FALSE(job.ranges_.empty());
+    EXPECT_LE(job.ranges_.size(), threads_ * 4u);
+    EXPECT_EQ(job.ranges_.front().first_, first);
+    EXPECT_EQ(job.ranges_.back().last_, last);
+    EXPECT_EQ(job.stop_.load(), last);
+
+    for (auto i = std::size_t{1}; i < job.ranges_.size(); ++i) {
+        const auto& previous = job.ranges_.at(i - 1u);
+        const auto& range = job.ranges_.at(i);
+
+        EXPECT_EQ(range.first_, previous.last_ + 1);
+        EXPECT_LE(range.first_, range.last_);
+    }
+}
+
+TEST_F(Test_SubchainScan, minimum_range)
+{
+    const auto job = Job{{}, 1, 250, threads_};
+
+    ASSERT_EQ(job.ranges_.size(), 3);
+    EXPECT_EQ(job.ranges_.at(0).last_, 100);
+    EXPECT_EQ(job.ranges_.at(1).last_, 200);
+    EXPECT_EQ(job.ranges_.at(2).last_, 250);
+}
+
+TEST_F(Test_SubchainScan, serial)
+{
+    const auto job = Job{{}, 1, 10000, 1};
+
+    ASSERT_EQ(job.ranges_.size(), 1);
+    EXPECT_EQ(job.ranges_.front().first_, 1);
+    EXPECT_EQ(job.ranges_.front().last_, 10000);
+}
+
+TEST_F(Test_SubchainScan, empty)
+{
+    auto job = Job{{}, 10, 9, threads_};
+    auto output = std::vector<b::block::pHash>{};
+
+    EXPECT_TRUE(job.ranges_.empty());
+    EXPECT_EQ(job.Next(), nullptr);
+
+    const auto [highest, missing] = job.Merge(output);
+
+    EXPECT_FALSE(highest.has_value());
+    EXPECT_FALSE(missing.has_value());
+    EXPECT_TRUE(output.empty());
+}
+
+TEST_F(Test_SubchainScan, merge_order)
+{
+    constexpr auto first = Height{1};
+    constexpr auto last = Height{5000};
+    auto job = Job{{}, first, last, threads_};
+    auto output = std::vector<b::block::pHash>{hash(0)};
+    run(job, std::nullopt);
+    const auto [highest, missing] = job.Merge(output);
+    auto wanted = expected(first, last);
+    wanted.insert(wanted.begin(), hash(0));
+
+    ASSERT_TRUE(highest.has_value());
+    EXPECT_EQ(highest.value().first, last);
+    EXPECT_EQ(highest.value().second, hash(last));
+    EXPECT_FALSE(missing.has_value());
+    EXPECT_EQ(output, wanted);
+}
+
+TEST_F(Test_SubchainScan, missing_filter)
+{
+    constexpr auto first = Height{1};
+    constexpr auto last = Height{5000};
+    constexpr auto gap = Height{2375};
+    auto job = Job{{}, first, last, threads_};
+    auto output = std::vector<b::block::pHash>{};
+    run(job, gap);
+    const auto [highest, missing] = job.Merge(output);
+
+    ASSERT_TRUE(highest.has_value());
+    EXPECT_EQ(highest.value().first, gap - 1);
+    ASSERT_TRUE(missing.has_value());
+    EXPECT_EQ(missing.value().first, gap);
+    EXPECT_EQ(job.stop_.load(), gap);
+    EXPECT_EQ(output, expected(first, gap - 1));
+}
+
+TEST_F(Test_SubchainScan, missing_first_filter)
+{
+    constexpr auto first = Height{1};
+    auto job = Job{{}, first, 5000, threads_};
+    auto output = std::vector<b::block::pHash>{};
+    run(job, first);
+    const auto [highest, missing] = job.Merge(output);
+
+    EXPECT_FALSE(highest.has_value());
+    ASSERT_TRUE(missing.has_value());
+    EXPECT_EQ(missing.value().first, first);
+    EXPECT_TRUE(output.empty());
+}
+
+TEST_F(Test_SubchainScan, later_range_finished_first)
+{
+    auto job = Job{{}, 1, 300, threads_};
+
+    ASSERT_EQ(job.ranges_.size(), 3);
+
+    auto& low = job.ranges_.at(0);
+    auto& middle = job.ranges_.at(1);
+    auto& high = job.ranges_.at(2);
+
+    // The highest range finishes before the missing filter is discovered
+    high.highest_ = b::block::Position{300, hash(300)};
+    high.matches_.emplace_back(hash(250));
+    high.promise_.set_value();
+    middle.highest_ = b::block::Position{149, hash(149)};
+    middle.matches_.emplace_back(hash(120));
+    middle.missing_ = b::block::Position{150, hash(150)};
+    middle.promise_.set_value();
+    low.highest_ = b::block::Position{100, hash(100)};
+    low.matches_.emplace_back(hash(50));
+    low.promise_.set_value();
+
+    auto output = std::vector<b::block::pHash>{};
+    const auto [highest, missing] = job.Merge(output);
+
+    ASSERT_TRUE(highest.has_value());
+    EXPECT_EQ(highest.value().first, 149);
+    ASSERT_TRUE(missing.has_value());
+    EXPECT_EQ(missing.value().first, 150);
+    ASSERT_EQ(output.size(), 2);
+    EXPECT_EQ(output.at(0), hash(50));
+    EXPECT_EQ(output.at(1), hash(120));
+}
+}  // namespace
@@ -0,0 +1,88 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory>
+
+#include "api/client/blockchain/database/Sync.hpp"
+#include "opentxs/Bytes.hpp"
+#include "opentxs/blockchain/BlockchainType.hpp"
+
+namespace b = ot::blockchain;
+
+namespace
+{
+using Sync = ot::api::client::blockchain::database::implementation::Sync;
+using Cache = Sync::Cache;
+
+constexpr auto btc_{b::Type::Bitcoin};
+constexpr auto bch_{b::Type::BitcoinCash};
+constexpr auto packet_bytes_ = std::size_t{100};
+
+auto packet() noexcept -> Sync::Packet
+{
+    return std::make_shared<const ot::Space>(ot::space(packet_bytes_));
+}
+
+TEST(Test_SyncCache, find)
+{
+    auto cache = Cache{10 * packet_bytes_};
+    const auto first = packet();
+
+    EXPECT_FALSE(cache.Find(btc_, 1));
+
+    cache.Add(btc_, 1, first);
+
+    EXPECT_EQ(cache.Find(btc_, 1), first);
+    EXPECT_FALSE(cache.Find(btc_, 2));
+    EXPECT_FALSE(cache.Find(bch_, 1));
+}
+
+TEST(Test_SyncCache, evict)
+{
+    auto cache = Cache{2 * packet_bytes_};
+
+    cache.Add(btc_, 1, packet());
+    cache.Add(btc_, 2, packet());
+
+    // Touch the oldest entry so that height 2 is evicted instead
+    EXPECT_TRUE(cache.Find(btc_, 1));
+
+    cache.Add(btc_, 3, packet());
+
+    EXPECT_TRUE(cache.Find(btc_, 1));
+    EXPECT_FALSE(cache.Find(btc_, 2));
+    EXPECT_TRUE(cache.Find(btc_, 3));
+}
+
+TEST(Test_SyncCache, reorg)
+{
+    auto cache = Cache{10 * packet_bytes_};
+
+    for (auto height = b::block::Height{1}; height <= 5; ++height) {
+        cache.Add(btc_, height, packet());
+        cache.Add(bch_, height, packet());
+    }
+
+    cache.Reorg(btc_, 2, 5);
+
+    EXPECT_TRUE(cache.Find(btc_, 1));
+    EXPECT_TRUE(cache.Find(btc_, 2));
+    EXPECT_FALSE(cache.Find(btc_, 3));
+    EXPECT_FALSE(cache.Find(btc_, 4));
+    EXPECT_FALSE(cache.Find(btc_, 5));
+
+    for (auto height = b::block::Height{1}; height <= 5; ++height) {
+        EXPECT_TRUE(cache.Find(bch_, height));
+    }
+
+    // Entries removed by a reorg can be replaced by the new chain
+    const auto replacement = packet();
+    cache.Add(btc_, 3, replacement);
+
+    EXPECT_EQ(cache.Find(btc_, 3), replacement);
+}
+}  // namespace
@@ -0,0 +1,121 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "blockchain/client/network/SyncPipeline.hpp"
+#include "internal/blockchain/client/Client.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/blockchain/Blockchain.hpp"
+#include "opentxs/blockchain/FilterType.hpp"
+#include "opentxs/core/Data.hpp"
+
+namespace b = ot::blockchain;
+namespace bc = b::client;
+
+namespace
+{
+using Pipeline = bc::implementation::Network::SyncPipeline;
+using Status = Pipeline::Status;
+
+class Test_SyncPipeline : public ::testing::Test
+{
+protected:
+    const ot::api::client::Manager& api_;
+
+    // Hash of the block at the specified height
+    auto hash(const b::block::Height height) const noexcept -> b::block::pHash
+    {
+        return api_.Factory().Data(static_cast<std::uint32_t>(height));
+    }
+    auto position(const b::block::Height height) const noexcept
+        -> b::block::Position
+    {
+        return {height, hash(height)};
+    }
+    // Sync data for the inclusive range of heights
+    auto data(const b::block::Height first, const b::block::Height last)
+        const noexcept -> bc::ParsedSyncData
+    {
+        auto output = bc::ParsedSyncData{hash(first - 1), {}};
+
+        for (auto height{first}; height <= last; ++height) {
+            output.second.emplace_back(
+                hash(height),
+                height,
+                b::filter::Type::Basic_BIP158,
+                1,
+                api_.Factory().Data());
+        }
+
+        return output;
+    }
+
+    Test_SyncPipeline()
+        : api_(ot::Context().StartClient(OTTestEnvironment::test_args_, 0))
+    {
+    }
+};
+
+TEST_F(Test_SyncPipeline, connects)
+{
+    auto sync = data(11, 20);
+
+    EXPECT_EQ(Pipeline::Prepare(position(10), sync), Status::Connects);
+    EXPECT_EQ(sync.first, hash(10));
+    ASSERT_EQ(sync.second.size(), 10);
+    EXPECT_EQ(std::get<1>(sync.second.front()), 11);
+}
+
+TEST_F(Test_SyncPipeline, genesis)
+{
+    auto sync = data(0, 5);
+
+    EXPECT_EQ(Pipeline::Prepare(position(-1), sync), Status::Connects);
+    EXPECT_EQ(sync.second.size(), 6);
+}
+
+TEST_F(Test_SyncPipeline, duplicate)
+{
+    auto sync = data(11, 20);
+
+    EXPECT_EQ(Pipeline::Prepare(position(20), sync), Status::Duplicate);
+    EXPECT_EQ(Pipeline::Prepare(position(25), sync), Status::Duplicate);
+}
+
+TEST_F(Test_SyncPipeline, partial_duplicate)
+{
+    auto sync = data(11, 20);
+
+    EXPECT_EQ(Pipeline::Prepare(position(15), sync), Status::Connects);
+    EXPECT_EQ(sync.first, hash(15));
+    ASSERT_EQ(sync.second.size(), 5);
+    EXPECT_EQ(std::get<1>(sync.second.front()), 16);
+    EXPECT_EQ(std::get<1>(sync.second.back()), 20);
+}
+
+TEST_F(Test_SyncPipeline, gap)
+{
+    auto sync = data(12, 20);
+
+    EXPECT_EQ(Pipeline::Prepare(position(10), sync), Status::Gap);
+}
+
+TEST_F(Test_SyncPipeline, wrong_parent)
+{
+    auto sync = data(11, 20);
+    const auto tip = b::block::Position{10, hash(99)};
+
+    EXPECT_EQ(Pipeline::Prepare(tip, sync), Status::Gap);
+}
+}  // namespace
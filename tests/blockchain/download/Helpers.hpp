@@ -59,6 +59,10 @@ struct DownloadManager : public ManagerType {
 
         return output;
     }
+    [[maybe_unused]] auto GetBatch(const int peer) noexcept -> BatchType
+    {
+        return allocate_batch(0, peer);
+    }
     [[maybe_unused]] auto MakePositions(
         bb::Height start,
         std::vector<std::string> hashes) noexcept
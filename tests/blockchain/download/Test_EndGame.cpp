@@ -0,0 +1,102 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Helpers.hpp"
+#include "blockchain/DownloadTask.hpp"
+
+namespace
+{
+using namespace std::literals::chrono_literals;
+
+constexpr auto batchSize{3};
+constexpr auto original_{2};
+constexpr auto replacement_{3};
+
+// Measures the original peer with a single fast item and then allocates the
+// remaining items to it. The returned batch is overdue.
+auto allocate_overdue(DownloadManager& manager) noexcept
+    -> DownloadManager::BatchType
+{
+    manager.UpdatePosition(
+        manager.MakePositions(1, std::vector<std::string>{"1", "2", "3", "4"}));
+    auto probe = manager.GetBatch(original_);
+
+    EXPECT_EQ(probe.data_.size(), 1);
+    EXPECT_TRUE(probe.Download(manager.GetPosition(0), 1));
+
+    probe.Finish();
+    auto output = manager.GetBatch(original_);
+
+    EXPECT_EQ(output.data_.size(), 3);
+
+    std::this_thread::sleep_for(100ms);
+
+    return output;
+}
+
+TEST(Test_EndGame, original_finishes_first)
+{
+    auto manager = DownloadManager{batchSize, 0, 0};
+    auto original = allocate_overdue(manager);
+    const auto tasks = original.data_;
+
+    ASSERT_EQ(tasks.size(), 3);
+
+    auto reissue = manager.GetBatch(replacement_);
+
+    ASSERT_EQ(reissue.data_.size(), 1);
+    EXPECT_EQ(reissue.data_.at(0)->position_, manager.GetPosition(1));
+    EXPECT_TRUE(original.Download(manager.GetPosition(2), 2));
+
+    original.Finish();
+
+    // The reallocated item is still being downloaded by the replacement peer
+    EXPECT_EQ(tasks.at(0)->state_.load(), d::State::Downloading);
+    EXPECT_EQ(tasks.at(1)->state_.load(), d::State::Downloaded);
+    EXPECT_EQ(tasks.at(2)->state_.load(), d::State::New);
+    EXPECT_TRUE(reissue.Download(manager.GetPosition(1), 1));
+
+    reissue.Finish();
+
+    EXPECT_EQ(tasks.at(0)->state_.load(), d::State::Downloaded);
+
+    auto retry = manager.GetBatch(replacement_);
+
+    ASSERT_EQ(retry.data_.size(), 1);
+    EXPECT_EQ(retry.data_.at(0)->position_, manager.GetPosition(3));
+}
+
+TEST(Test_EndGame, replacement_finishes_first)
+{
+    auto manager = DownloadManager{batchSize, 0, 0};
+    auto original = allocate_overdue(manager);
+    const auto tasks = original.data_;
+
+    ASSERT_EQ(tasks.size(), 3);
+
+    auto reissue = manager.GetBatch(replacement_);
+
+    ASSERT_EQ(reissue.data_.size(), 1);
+
+    reissue.Finish();
+
+    // The undelivered item returns to the original batch
+    EXPECT_EQ(tasks.at(0)->state_.load(), d::State::Downloading);
+    EXPECT_TRUE(original.Download(manager.GetPosition(1), 1));
+
+    // The replacement peer lost the race without being penalized so the
+    // remaining items of the original batch can be reallocated again
+    auto second = manager.GetBatch(replacement_);
+
+    ASSERT_EQ(second.data_.size(), 1);
+    EXPECT_EQ(second.data_.at(0)->position_, manager.GetPosition(2));
+}
+}  // namespace
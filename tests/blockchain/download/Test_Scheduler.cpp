@@ -0,0 +1,114 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <optional>
+
+#include "blockchain/DownloadScheduler.hpp"
+
+namespace ot = opentxs;
+namespace d = ot::blockchain::download;
+
+namespace
+{
+using namespace std::literals::chrono_literals;
+
+constexpr auto fast_{1};
+constexpr auto slow_{2};
+constexpr auto distant_{3};
+constexpr auto unknown_{4};
+
+TEST(Test_DownloadScheduler, probe)
+{
+    auto scheduler = d::Scheduler{};
+
+    EXPECT_EQ(scheduler.Size(unknown_, 1000), 100);
+    EXPECT_EQ(scheduler.Size(unknown_, 5), 1);
+    EXPECT_EQ(scheduler.Size(unknown_, 0), 0);
+    EXPECT_FALSE(scheduler.Expected(unknown_, 10).has_value());
+}
+
+TEST(Test_DownloadScheduler, throughput)
+{
+    auto scheduler = d::Scheduler{};
+    scheduler.Record(fast_, 1000, 0s, 2s);
+    scheduler.Record(slow_, 10, 0s, 10s);
+
+    EXPECT_EQ(scheduler.Size(fast_, 100000), 5000);
+    EXPECT_EQ(scheduler.Size(fast_, 1000), 1000);
+    EXPECT_EQ(scheduler.Size(slow_, 100000), 10);
+
+    const auto expected = scheduler.Expected(slow_, 10);
+
+    ASSERT_TRUE(expected.has_value());
+    EXPECT_DOUBLE_EQ(expected.value().count(), 10.0);
+}
+
+TEST(Test_DownloadScheduler, latency)
+{
+    auto scheduler = d::Scheduler{};
+    scheduler.Record(distant_, 100, 5s, 15s);
+
+    EXPECT_EQ(scheduler.Size(distant_, 100000), 150);
+}
+
+TEST(Test_DownloadScheduler, average)
+{
+    auto scheduler = d::Scheduler{};
+    scheduler.Record(fast_, 1000, 0s, 2s);
+
+    EXPECT_EQ(scheduler.Size(fast_, 100000), 5000);
+
+    scheduler.Record(fast_, 1000, 0s, 1s);
+
+    EXPECT_EQ(scheduler.Size(fast_, 100000), 6250);
+}
+
+TEST(Test_DownloadScheduler, preferred)
+{
+    auto scheduler = d::Scheduler{};
+    scheduler.Record(fast_, 1000, 0s, 2s);
+    scheduler.Record(slow_, 10, 0s, 10s);
+
+    EXPECT_TRUE(scheduler.Preferred(fast_, slow_));
+    EXPECT_FALSE(scheduler.Preferred(slow_, fast_));
+    EXPECT_FALSE(scheduler.Preferred(fast_, fast_));
+    EXPECT_TRUE(scheduler.Preferred(unknown_, fast_));
+    EXPECT_TRUE(scheduler.Preferred(slow_, unknown_));
+}
+
+TEST(Test_DownloadScheduler, failure)
+{
+    auto scheduler = d::Scheduler{};
+    scheduler.Record(slow_, 10, 0s, 10s);
+
+    EXPECT_EQ(scheduler.Size(slow_, 100000), 10);
+
+    scheduler.Record(slow_, 0, 0s, 0s);
+
+    EXPECT_EQ(scheduler.Size(slow_, 100000), 5);
+
+    for (auto i{0}; i < 10; ++i) { scheduler.Record(slow_, 0, 0s, 0s); }
+
+    EXPECT_EQ(scheduler.Size(slow_, 100000), 1);
+}
+
+TEST(Test_DownloadScheduler, remove)
+{
+    auto scheduler = d::Scheduler{};
+    scheduler.Record(fast_, 1000, 0s, 2s);
+    scheduler.Record(slow_, 10, 0s, 10s);
+    scheduler.Remove(slow_);
+
+    EXPECT_EQ(scheduler.Size(fast_, 100000), 5000);
+    EXPECT_EQ(scheduler.Size(slow_, 1000), 100);
+    EXPECT_FALSE(scheduler.Expected(slow_, 10).has_value());
+
+    scheduler.Remove(unknown_);
+
+    EXPECT_TRUE(scheduler.Expected(fast_, 10).has_value());
+}
+}  // namespace
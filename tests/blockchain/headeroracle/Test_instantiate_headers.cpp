@@ -0,0 +1,120 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "OTTestEnvironment.hpp"  // IWYU pragma: keep
+#include "blockchain/client/Network.hpp"
+#include "opentxs/OT.hpp"
+#include "opentxs/Pimpl.hpp"
+#include "opentxs/api/Context.hpp"
+#include "opentxs/api/Factory.hpp"
+#include "opentxs/api/client/Manager.hpp"
+#include "opentxs/blockchain/block/Header.hpp"
+#include "opentxs/core/Data.hpp"
+
+namespace b = ot::blockchain;
+namespace bb = b::block;
+
+namespace
+{
+using Network = b::client::implementation::Network;
+
+class Test_InstantiateHeaders : public ::testing::Test
+{
+protected:
+    // Large enough to be divided between several thread pool workers
+    static constexpr auto count_{5000u};
+    static constexpr auto invalid_{"invalid"};
+    static constexpr auto orphan_{"orphan"};
+
+    const ot::api::client::Manager& api_;
+    std::vector<std::string> payloads_;
+    std::atomic<std::size_t> calls_;
+
+    auto hash(const std::uint32_t height) const noexcept -> bb::pHash
+    {
+        return api_.Factory().Data(height);
+    }
+    auto instantiate(const std::vector<ot::ReadView>& payloads) noexcept
+    {
+        return Network::InstantiateHeaders(
+            api_, payloads, [&](const auto payload) {
+                ++calls_;
+                const auto value = std::string{payload};
+
+                if (invalid_ == value) {
+                    return std::unique_ptr<bb::Header>{};
+                } else if (orphan_ == value) {
+
+                    return api_.Factory().BlockHeaderForUnitTests(
+                        hash(count_ + 1u), hash(count_ + 2u), 1);
+                }
+
+                const auto height =
+                    static_cast<std::uint32_t>(std::stoul(value));
+
+                return api_.Factory().BlockHeaderForUnitTests(
+                    hash(height), hash(height - 1u), height);
+            });
+    }
+    auto views() const noexcept -> std::vector<ot::ReadView>
+    {
+        return {payloads_.begin(), payloads_.end()};
+    }
+
+    Test_InstantiateHeaders()
+        : api_(ot::Context().StartClient(OTTestEnvironment::test_args_, 0))
+        , payloads_()
+        , calls_(0)
+    {
+        for (auto i = 1u; i <= count_; ++i) {
+            payloads_.emplace_back(std::to_string(i));
+        }
+    }
+};
+
+TEST_F(Test_InstantiateHeaders, empty)
+{
+    EXPECT_TRUE(instantiate({}).empty());
+    EXPECT_EQ(calls_.load(), 0);
+}
+
+TEST_F(Test_InstantiateHeaders, parallel)
+{
+    const auto headers = instantiate(views());
+
+    ASSERT_EQ(headers.size(), count_);
+    EXPECT_EQ(calls_.load(), count_);
+
+    for (auto i = std::size_t{0}; i < headers.size(); ++i) {
+        const auto& header = headers.at(i);
+
+        ASSERT_TRUE(header);
+        EXPECT_EQ(header->Height(), static_cast<bb::Height>(i + 1u));
+        EXPECT_EQ(header->Hash(), hash(static_cast<std::uint32_t>(i + 1u)));
+    }
+}
+
+TEST_F(Test_InstantiateHeaders, invalid)
+{
+    payloads_.at(count_ / 2u) = invalid_;
+
+    EXPECT_TRUE(instantiate(views()).empty());
+    EXPECT_EQ(calls_.load(), count_);
+}
+
+TEST_F(Test_InstantiateHeaders, not_contiguous)
+{
+    payloads_.at(count_ - 1u) = orphan_;
+
+    EXPECT_TRUE(instantiate(views()).empty());
+}
+}  // namespace
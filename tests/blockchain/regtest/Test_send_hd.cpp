@@ -10,6 +10,7 @@
 #include <optional>
 
 #include "UIHelpers.hpp"
+#include "internal/blockchain/client/Client.hpp"
 #include "opentxs/SharedPimpl.hpp"
 #include "opentxs/api/Wallet.hpp"
 #include "opentxs/api/client/Blockchain.hpp"
@@ -63,6 +64,27 @@ protected:
         alex_p_.reset();
         Regtest_fixture_normal::Shutdown();
     }
+    // Returns true once the presence of the transaction in the mempool of the
+    // specified node matches the expected value
+    auto wait_for_mempool(
+        const ot::api::client::Manager& api,
+        const ot::blockchain::block::Txid& txid,
+        const bool expected) const noexcept -> bool
+    {
+        const auto& network =
+            dynamic_cast<const ot::blockchain::client::internal::Network&>(
+                api.Blockchain().GetChain(test_chain_));
+        const auto& mempool = network.Mempool();
+        const auto limit = ot::Clock::now() + std::chrono::seconds{30};
+
+        while (ot::Clock::now() < limit) {
+            if (expected == bool(mempool.Query(txid.Bytes()))) { return true; }
+
+            ot::Sleep(std::chrono::milliseconds{100});
+        }
+
+        return false;
+    }
 
     Regtest_fixture_hd()
         : Regtest_fixture_normal(1)
@@ -442,6 +464,14 @@ TEST_F(Regtest_fixture_hd, account_activity_after_unconfirmed_spend)
     EXPECT_EQ(row->UUID(), transactions_.at(0)->asHex());
 }
 
+TEST_F(Regtest_fixture_hd, mempool_after_unconfirmed_spend)
+{
+    const auto& txid = transactions_.at(1).get();
+
+    EXPECT_TRUE(wait_for_mempool(client_1_, txid, true));
+    EXPECT_TRUE(wait_for_mempool(miner_, txid, true));
+}
+
 TEST_F(Regtest_fixture_hd, confirm)
 {
     account_list_.expected_ += 0;
@@ -518,6 +548,14 @@ TEST_F(Regtest_fixture_hd, account_activity_after_confirmed_spend)
     EXPECT_EQ(row->UUID(), transactions_.at(0)->asHex());
 }
 
+TEST_F(Regtest_fixture_hd, mempool_after_confirmed_spend)
+{
+    const auto& txid = transactions_.at(1).get();
+
+    EXPECT_TRUE(wait_for_mempool(client_1_, txid, false));
+    EXPECT_TRUE(wait_for_mempool(miner_, txid, false));
+}
+
 TEST_F(Regtest_fixture_hd, account_list_after_confirmed_spend)
 {
     wait_for_counter(account_list_);
@@ -0,0 +1,89 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <optional>
+
+#include "util/BoundedQueue.hpp"
+
+namespace ot = opentxs;
+
+namespace
+{
+using Queue = ot::BoundedQueue<int>;
+
+constexpr auto wait_{std::chrono::milliseconds{100}};
+constexpr auto limit_{std::chrono::seconds{10}};
+
+TEST(Test_BoundedQueue, fifo)
+{
+    auto queue = Queue{3};
+
+    EXPECT_TRUE(queue.Push(1));
+    EXPECT_TRUE(queue.Push(2));
+    EXPECT_TRUE(queue.Push(3));
+    EXPECT_EQ(queue.Pop(), std::optional<int>{1});
+    EXPECT_EQ(queue.Pop(), std::optional<int>{2});
+    EXPECT_EQ(queue.Pop(), std::optional<int>{3});
+}
+
+TEST(Test_BoundedQueue, push_blocks_while_full)
+{
+    auto queue = Queue{1};
+
+    ASSERT_TRUE(queue.Push(1));
+
+    auto pushed = std::async(std::launch::async, [&] { return queue.Push(2); });
+
+    EXPECT_EQ(pushed.wait_for(wait_), std::future_status::timeout);
+    EXPECT_EQ(queue.Pop(), std::optional<int>{1});
+    ASSERT_EQ(pushed.wait_for(limit_), std::future_status::ready);
+    EXPECT_TRUE(pushed.get());
+    EXPECT_EQ(queue.Pop(), std::optional<int>{2});
+}
+
+TEST(Test_BoundedQueue, close_wakes_pop)
+{
+    auto queue = Queue{1};
+    auto popped = std::async(std::launch::async, [&] { return queue.Pop(); });
+
+    EXPECT_EQ(popped.wait_for(wait_), std::future_status::timeout);
+
+    queue.Close();
+
+    ASSERT_EQ(popped.wait_for(limit_), std::future_status::ready);
+    EXPECT_FALSE(popped.get().has_value());
+}
+
+TEST(Test_BoundedQueue, close_wakes_push)
+{
+    auto queue = Queue{1};
+
+    ASSERT_TRUE(queue.Push(1));
+
+    auto pushed = std::async(std::launch::async, [&] { return queue.Push(2); });
+
+    EXPECT_EQ(pushed.wait_for(wait_), std::future_status::timeout);
+
+    queue.Close();
+
+    ASSERT_EQ(pushed.wait_for(limit_), std::future_status::ready);
+    EXPECT_FALSE(pushed.get());
+}
+
+TEST(Test_BoundedQueue, closed)
+{
+    auto queue = Queue{2};
+
+    ASSERT_TRUE(queue.Push(1));
+
+    queue.Close();
+
+    EXPECT_FALSE(queue.Pop().has_value());
+    EXPECT_FALSE(queue.Push(2));
+}
+}  // namespace
@@ -0,0 +1,143 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+
+#include "util/LRU.hpp"
+
+namespace ot = opentxs;
+
+namespace
+{
+using Cache = ot::LRU<int, std::string>;
+
+TEST(Test_LRU, find)
+{
+    auto cache = Cache{100};
+
+    EXPECT_FALSE(cache.Find(1).has_value());
+    EXPECT_TRUE(cache.Insert(1, "one", 10));
+    EXPECT_EQ(cache.Find(1), std::optional<std::string>{"one"});
+
+    // Inserting an existing key replaces the value and its size
+    EXPECT_TRUE(cache.Insert(1, "uno", 20));
+    EXPECT_EQ(cache.Find(1), std::optional<std::string>{"uno"});
+
+    const auto stats = cache.Stats();
+
+    EXPECT_EQ(stats.hits_, 2);
+    EXPECT_EQ(stats.misses_, 1);
+    EXPECT_EQ(stats.items_, 1);
+    EXPECT_EQ(stats.bytes_, 20);
+    EXPECT_EQ(stats.capacity_, 100);
+}
+
+TEST(Test_LRU, byte_bounded)
+{
+    auto cache = Cache{100};
+
+    // Items are evicted by total size rather than by count
+    EXPECT_TRUE(cache.Insert(1, "one", 40));
+    EXPECT_TRUE(cache.Insert(2, "two", 40));
+    EXPECT_TRUE(cache.Insert(3, "three", 10));
+    EXPECT_TRUE(cache.Insert(4, "four", 10));
+    EXPECT_EQ(cache.Stats().evictions_, 0);
+    EXPECT_TRUE(cache.Insert(5, "five", 50));
+    EXPECT_FALSE(cache.Find(1).has_value());
+    EXPECT_FALSE(cache.Find(2).has_value());
+    EXPECT_TRUE(cache.Find(3).has_value());
+    EXPECT_TRUE(cache.Find(4).has_value());
+    EXPECT_TRUE(cache.Find(5).has_value());
+
+    const auto stats = cache.Stats();
+
+    EXPECT_EQ(stats.evictions_, 2);
+    EXPECT_EQ(stats.items_, 3);
+    EXPECT_EQ(stats.bytes_, 70);
+}
+
+TEST(Test_LRU, oversized)
+{
+    auto cache = Cache{100};
+
+    EXPECT_TRUE(cache.Insert(1, "one", 60));
+    EXPECT_FALSE(cache.Insert(2, "two", 101));
+    EXPECT_FALSE(cache.Find(2).has_value());
+    EXPECT_TRUE(cache.Find(1).has_value());
+    EXPECT_EQ(cache.Stats().evictions_, 0);
+}
+
+TEST(Test_LRU, recency)
+{
+    auto cache = Cache{30};
+
+    EXPECT_TRUE(cache.Insert(1, "one", 10));
+    EXPECT_TRUE(cache.Insert(2, "two", 10));
+    EXPECT_TRUE(cache.Insert(3, "three", 10));
+
+    // A lookup makes the oldest item the most recently used
+    EXPECT_TRUE(cache.Find(1).has_value());
+    EXPECT_TRUE(cache.Insert(4, "four", 10));
+    EXPECT_TRUE(cache.Find(1).has_value());
+    EXPECT_FALSE(cache.Find(2).has_value());
+
+    // Replacing a value also counts as a use
+    EXPECT_TRUE(cache.Insert(3, "three", 10));
+    EXPECT_TRUE(cache.Insert(5, "five", 10));
+    EXPECT_FALSE(cache.Find(4).has_value());
+    EXPECT_TRUE(cache.Find(1).has_value());
+    EXPECT_TRUE(cache.Find(3).has_value());
+    EXPECT_TRUE(cache.Find(5).has_value());
+}
+
+TEST(Test_LRU, erase)
+{
+    auto cache = Cache{100};
+
+    EXPECT_TRUE(cache.Insert(1, "one", 10));
+    EXPECT_TRUE(cache.Insert(2, "two", 20));
+    EXPECT_TRUE(cache.Erase(1));
+    EXPECT_FALSE(cache.Erase(1));
+    EXPECT_FALSE(cache.Find(1).has_value());
+    EXPECT_EQ(cache.Stats().bytes_, 20);
+
+    cache.Clear();
+
+    EXPECT_FALSE(cache.Find(2).has_value());
+    EXPECT_EQ(cache.Stats().items_, 0);
+    EXPECT_EQ(cache.Stats().bytes_, 0);
+}
+
+TEST(Test_LRU, set_capacity)
+{
+    auto cache = Cache{100};
+
+    for (auto i = 0; i < 10; ++i) {
+        EXPECT_TRUE(cache.Insert(i, std::to_string(i), 10));
+    }
+
+    EXPECT_TRUE(cache.Find(0).has_value());
+
+    // Shrinking evicts the least recently used items immediately
+    cache.SetCapacity(30);
+
+    EXPECT_EQ(cache.Capacity(), 30);
+    EXPECT_EQ(cache.Stats().items_, 3);
+    EXPECT_TRUE(cache.Find(0).has_value());
+    EXPECT_TRUE(cache.Find(8).has_value());
+    EXPECT_TRUE(cache.Find(9).has_value());
+    EXPECT_FALSE(cache.Find(7).has_value());
+
+    // Growing allows more items without evicting the existing ones
+    cache.SetCapacity(50);
+
+    EXPECT_TRUE(cache.Insert(10, "10", 10));
+    EXPECT_TRUE(cache.Insert(11, "11", 10));
+    EXPECT_EQ(cache.Stats().items_, 5);
+    EXPECT_EQ(cache.Stats().evictions_, 7);
+}
+}  // namespace
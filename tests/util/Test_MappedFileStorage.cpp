@@ -0,0 +1,247 @@
+// Copyright (c) 2010-2021 The Open-Transactions developers
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "opentxs/Bytes.hpp"
+#include "opentxs/Version.hpp"
+#include "util/LMDB.hpp"
+#include "util/MappedFileStorage.hpp"
+
+namespace fs = boost::filesystem;
+namespace ot = opentxs;
+
+#if OT_STORAGE_LMDB
+namespace
+{
+using LMDB = ot::storage::lmdb::LMDB;
+using Regions = std::map<std::size_t, std::size_t>;
+
+enum Table { Config = 0, FreeSpace = 1 };
+
+class Storage final : public ot::util::MappedFileStorage
+{
+public:
+    using MappedFileStorage::IndexData;
+    using MappedFileStorage::Pending;
+
+    using MappedFileStorage::apply;
+    using MappedFileStorage::get_write_view;
+    using MappedFileStorage::release;
+
+    Storage(LMDB& lmdb, const std::string& path) noexcept(false)
+        : MappedFileStorage(lmdb, path, "test", Config, 0, FreeSpace)
+    {
+    }
+};
+
+using Index = Storage::IndexData;
+
+class Test_MappedFileStorage : public ::testing::Test
+{
+protected:
+    const fs::path path_;
+    std::unique_ptr<LMDB> lmdb_;
+    std::unique_ptr<Storage> storage_;
+
+    // Contents of the free space table
+    auto records() const noexcept -> Regions
+    {
+        auto output = Regions{};
+        lmdb_->Read(
+            FreeSpace,
+            [&](const auto key, const auto value) {
+                auto position = std::size_t{};
+                auto size = std::size_t{};
+                std::memcpy(&position, key.data(), sizeof(position));
+                std::memcpy(&size, value.data(), sizeof(size));
+                output.emplace(position, size);
+
+                return true;
+            },
+            LMDB::Dir::Forward);
+
+        return output;
+    }
+    auto release(const Index& index) noexcept -> bool
+    {
+        return storage_->release({index}, {});
+    }
+    auto reopen() noexcept -> void
+    {
+        storage_.reset();
+        lmdb_.reset();
+        lmdb_ = std::make_unique<LMDB>(
+            ot::storage::lmdb::TableNames{
+                {Config, "config"}, {FreeSpace, "free_space"}},
+            path_.string(),
+            ot::storage::lmdb::TablesToInit{
+                {Config, MDB_INTEGERKEY}, {FreeSpace, MDB_INTEGERKEY}});
+        storage_ = std::make_unique<Storage>(*lmdb_, path_.string());
+    }
+    auto store(const std::size_t bytes) noexcept -> Index
+    {
+        auto output = Index{};
+        store(output, bytes);
+
+        return output;
+    }
+    auto store(Index& index, const std::size_t bytes) noexcept -> void
+    {
+        const auto view = storage_->get_write_view(index, {}, bytes);
+
+        EXPECT_TRUE(view.valid(bytes));
+    }
+
+    Test_MappedFileStorage()
+        : path_(
+              fs::temp_directory_path() /
+              fs::unique_path("opentxs-test-%%%%-%%%%-%%%%-%%%%"))
+        , lmdb_()
+        , storage_()
+    {
+        fs::create_directories(path_);
+        reopen();
+    }
+
+    ~Test_MappedFileStorage() override
+    {
+        storage_.reset();
+        lmdb_.reset();
+        fs::remove_all(path_);
+    }
+};
+
+TEST_F(Test_MappedFileStorage, best_fit)
+{
+    const auto a = store(100);
+    store(10);
+    const auto c = store(50);
+    store(10);
+
+    ASSERT_TRUE(release(a));
+    ASSERT_TRUE(release(c));
+
+    const auto item = store(40);
+
+    EXPECT_EQ(item.position_, c.position_);
+    EXPECT_EQ(
+        records(), (Regions{{a.position_, 100}, {c.position_ + 40, 10}}));
+}
+
+TEST_F(Test_MappedFileStorage, merge_released)
+{
+    const auto a = store(100);
+    const auto b = store(50);
+    const auto c = store(25);
+    store(10);
+
+    ASSERT_TRUE(release(a));
+    ASSERT_TRUE(release(c));
+    EXPECT_EQ(records(), (Regions{{a.position_, 100}, {c.position_, 25}}));
+    ASSERT_TRUE(release(b));
+    EXPECT_EQ(records(), (Regions{{a.position_, 175}}));
+
+    const auto item = store(175);
+
+    EXPECT_EQ(item.position_, a.position_);
+    EXPECT_TRUE(records().empty());
+}
+
+TEST_F(Test_MappedFileStorage, abandoned_until_reopen)
+{
+    auto a = store(100);
+    const auto previous = a;
+    store(a, 200);
+
+    EXPECT_NE(a.position_, previous.position_);
+    EXPECT_EQ(records(), (Regions{{previous.position_, 100}}));
+    EXPECT_NE(store(50).position_, previous.position_);
+
+    reopen();
+
+    EXPECT_EQ(store(50).position_, previous.position_);
+}
+
+TEST_F(Test_MappedFileStorage, abandoned_merged_on_reopen)
+{
+    auto a = store(100);
+    const auto b = store(100);
+    store(10);
+    const auto previous = a;
+
+    ASSERT_TRUE(release(b));
+
+    store(a, 300);
+
+    EXPECT_EQ(
+        records(),
+        (Regions{{previous.position_, 100}, {b.position_, 100}}));
+
+    reopen();
+
+    EXPECT_EQ(records(), (Regions{{previous.position_, 200}}));
+    EXPECT_EQ(store(200).position_, previous.position_);
+}
+
+TEST_F(Test_MappedFileStorage, pending_discarded)
+{
+    const auto a = store(100);
+    const auto b = store(10);
+
+    ASSERT_TRUE(release(a));
+
+    {
+        auto tx = lmdb_->TransactionRW();
+        auto pending = Storage::Pending{};
+        auto first = Index{};
+        auto second = Index{};
+
+        EXPECT_TRUE(storage_->get_write_view(tx, first, 40, pending).valid(40));
+        EXPECT_TRUE(
+            storage_->get_write_view(tx, second, 200, pending).valid(200));
+        EXPECT_TRUE(tx.Finalize(false));
+    }
+
+    EXPECT_EQ(records(), (Regions{{a.position_, 100}}));
+    EXPECT_EQ(store(40).position_, a.position_);
+    EXPECT_EQ(store(200).position_, b.position_ + 10);
+}
+
+TEST_F(Test_MappedFileStorage, pending_shared)
+{
+    const auto a = store(100);
+    const auto b = store(10);
+    auto first = Index{};
+    auto second = Index{};
+
+    ASSERT_TRUE(release(a));
+
+    {
+        auto tx = lmdb_->TransactionRW();
+        auto pending = Storage::Pending{};
+
+        EXPECT_TRUE(storage_->get_write_view(tx, first, 40, pending).valid(40));
+        EXPECT_TRUE(
+            storage_->get_write_view(tx, second, 40, pending).valid(40));
+        ASSERT_TRUE(tx.Finalize(true));
+
+        storage_->apply(pending);
+    }
+
+    EXPECT_EQ(first.position_, a.position_);
+    EXPECT_EQ(second.position_, b.position_ + 10);
+    EXPECT_EQ(records(), (Regions{{a.position_ + 40, 60}}));
+    EXPECT_EQ(store(60).position_, a.position_ + 40);
+    EXPECT_EQ(store(10).position_, second.position_ + 40);
+}
+}  // namespace
+#endif  // OT_STORAGE_LMDB